@@ -3,7 +3,7 @@
 using adventure::AdventureApp;
 
 void prepareSettings(AdventureApp::Settings* settings) {
-  settings->setResizable(false);
+  settings->setResizable(true);
 }
 
 // This line is a macro that expands into an "int main()" function.
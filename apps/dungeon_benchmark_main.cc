@@ -0,0 +1,124 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "map/dungeon.h"
+#include "memory/allocation_counter.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using adventure::Dungeon;
+using adventure::GetNumberOfAllocations;
+using adventure::GetNumberOfFrees;
+
+namespace {
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start).count();
+}
+
+// Nicknames are at most five characters, so rooms are numbered in base 36
+std::string Nickname(size_t room) {
+  const char kDigits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  std::string nickname = "R";
+
+  for (size_t digit = 0; digit < 4; ++digit) {
+    nickname.insert(nickname.begin() + 1, kDigits[room % 36]);
+    room /= 36;
+  }
+
+  return nickname;
+}
+
+// A corridor of rooms, each with a door to either neighbour, a pack of
+// BATs, and a SWORD, which is what the shipped dungeons look like at scale
+std::string GenerateDungeon(size_t number_of_rooms) {
+  std::ostringstream os;
+  os << "DUNGEON_LOAD_FINAL_PROJECT\n{\n  [\n";
+
+  for (size_t room = 0; room < number_of_rooms; ++room) {
+    os << "    {\n      ROOM" << room << "\n      " << Nickname(room) << "\n"
+       << "      [\n";
+    if (room + 1 < number_of_rooms) {
+      os << "        {\n          UP\n          " << Nickname(room + 1)
+         << "\n          FALSE\n        }\n";
+    }
+    if (room > 0) {
+      os << "        {\n          DOWN\n          " << Nickname(room - 1)
+         << "\n          FALSE\n        }\n";
+    }
+    os << "      ]\n      [\n";
+    for (size_t enemy = 0; enemy < 3; ++enemy) {
+      os << "        {\n          BAT\n          BAT\n          20\n"
+            "          5\n          5\n        }\n";
+    }
+    os << "      ]\n      [\n        {\n          SWORD\n          SWORD\n"
+          "          20\n          5\n        }\n      ]\n      1\n    }\n";
+  }
+
+  os << "  ]\n}\n";
+  return os.str();
+}
+
+}   // namespace
+
+// Loads and tears down a generated dungeon over and over, printing how many
+// heap allocations and frees each load and teardown costs, how many bytes a
+// loaded dungeon takes up in its arena, and how long they take.
+//
+// Usage: dungeon-benchmark [rooms] [loads]
+int main(int argc, char* argv[]) {
+  size_t number_of_rooms = 1000;
+  if (argc > 1) {
+    number_of_rooms = (size_t)std::stoul(argv[1]);
+  }
+
+  size_t loads = 100;
+  if (argc > 2) {
+    loads = (size_t)std::stoul(argv[2]);
+  }
+
+  std::string text = GenerateDungeon(number_of_rooms);
+
+  size_t load_allocations = 0;
+  size_t load_bytes = 0;
+  size_t teardown_frees = 0;
+  double load_seconds = 0.0;
+  double teardown_seconds = 0.0;
+
+  for (size_t load = 0; load < loads; ++load) {
+    std::istringstream is(text);
+    std::chrono::steady_clock::time_point start;
+    size_t frees;
+
+    {
+      Dungeon dungeon;
+
+      size_t allocations = GetNumberOfAllocations();
+      start = std::chrono::steady_clock::now();
+      is >> dungeon;
+      load_seconds += SecondsSince(start);
+      load_allocations += GetNumberOfAllocations() - allocations;
+      load_bytes += dungeon.GetArena().GetNumberOfBytes();
+
+      frees = GetNumberOfFrees();
+      start = std::chrono::steady_clock::now();
+    }
+    teardown_seconds += SecondsSince(start);
+    teardown_frees += GetNumberOfFrees() - frees;
+  }
+
+  std::cout << "ROOMS: " << number_of_rooms << std::endl;
+  std::cout << "ALLOCATIONS PER LOAD: " << load_allocations / loads
+            << std::endl;
+  std::cout << "ARENA BYTES PER LOAD: " << load_bytes / loads << std::endl;
+  std::cout << "FREES PER TEARDOWN: " << teardown_frees / loads << std::endl;
+  std::cout << "LOAD: " << load_seconds * 1000.0 / (double)loads << " MS"
+            << std::endl;
+  std::cout << "TEARDOWN: " << teardown_seconds * 1000.0 / (double)loads
+            << " MS" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "map/dungeon_image.h"
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using adventure::Dungeon;
+using adventure::DungeonImage;
+
+// Builds the shared image of a dungeon, or maps an existing image and walks
+// every door in it to check that it can be queried. Server processes on the
+// same machine that map one image (e.g. /dev/shm/dungeon.img) share its
+// pages instead of each holding a parsed copy.
+//
+// Usage: dungeon-image <dungeon file> <image file>
+//        dungeon-image <image file>
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "USAGE: dungeon-image [dungeon file] <image file>"
+              << std::endl;
+    return 2;
+  }
+
+  try {
+    if (argc > 2) {
+      Dungeon dungeon;
+      std::ifstream dungeon_file(argv[1]);
+      if (!dungeon_file.is_open()) {
+        std::cerr << "DUNGEON FILE NOT FOUND" << std::endl;
+        return 2;
+      }
+      dungeon_file >> dungeon;
+
+      DungeonImage::Write(dungeon, argv[2]);
+    }
+
+    DungeonImage image(argv[argc > 2 ? 2 : 1]);
+    size_t doors = 0;
+    size_t dead_ends = 0;
+
+    for (size_t room = 0; room < image.GetNumberOfRooms(); ++room) {
+      for (size_t door = 0; door < image.GetNumberOfDoors(room); ++door) {
+        ++doors;
+        if (image.GetAdjacentRoomIndex(room, door) == DungeonImage::kNoRoom) {
+          ++dead_ends;
+        }
+      }
+    }
+
+    std::cout << "BYTES: " << image.GetSize() << std::endl;
+    std::cout << "ROOMS: " << image.GetNumberOfRooms() << std::endl;
+    std::cout << "DOORS: " << doors << " (" << dead_ends
+              << " LEAD OUT OF THE MAP)" << std::endl;
+  } catch (const std::invalid_argument& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "jobs/job_system.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using adventure::JobHandle;
+using adventure::JobSystem;
+
+namespace {
+
+// Stands in for a small piece of real work, like decoding one glyph
+size_t SpinWork(size_t iterations) {
+  volatile size_t sum = 0;
+
+  for (size_t iteration = 0; iteration < iterations; ++iteration) {
+    sum = sum + iteration;
+  }
+  return sum;
+}
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start).count();
+}
+
+// Submits empty jobs from the calling thread and waits for all of them
+double MeasureExternalSpawn(JobSystem& jobs, size_t number_of_jobs) {
+  std::vector<JobHandle> handles;
+  handles.reserve(number_of_jobs);
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (size_t job = 0; job < number_of_jobs; ++job) {
+    handles.push_back(jobs.Submit([] {}));
+  }
+  for (const JobHandle& handle : handles) {
+    jobs.Wait(handle);
+  }
+  return SecondsSince(start);
+}
+
+// Submits jobs from a root job so they land on one worker's deque and the
+// other workers have to steal them
+double MeasureNestedSpawn(JobSystem& jobs, size_t number_of_jobs,
+                          size_t iterations) {
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  JobHandle root = jobs.Submit([&jobs, number_of_jobs, iterations] {
+    std::vector<JobHandle> children;
+    children.reserve(number_of_jobs);
+
+    for (size_t job = 0; job < number_of_jobs; ++job) {
+      children.push_back(jobs.Submit([iterations] { SpinWork(iterations); }));
+    }
+    for (const JobHandle& child : children) {
+      jobs.Wait(child);
+    }
+  });
+  jobs.Wait(root);
+
+  return SecondsSince(start);
+}
+
+}   // namespace
+
+// Measures how much it costs to spawn a job and how well idle workers steal
+// fine-grained jobs that were all spawned from a single worker.
+//
+// Usage: job-benchmark [jobs] [max workers] [iterations per job]
+int main(int argc, char* argv[]) {
+  size_t number_of_jobs = 100000;
+  size_t max_workers = JobSystem::GetDefaultNumberOfWorkers();
+  size_t iterations = 200;
+
+  if (argc > 1) {
+    number_of_jobs = (size_t)std::stoul(argv[1]);
+  }
+  if (argc > 2) {
+    max_workers = (size_t)std::stoul(argv[2]);
+  }
+  if (argc > 3) {
+    iterations = (size_t)std::stoul(argv[3]);
+  }
+
+  if (number_of_jobs == 0 || max_workers == 0) {
+    std::cerr << "USAGE: job-benchmark [jobs] [max workers] "
+                 "[iterations per job]" << std::endl;
+    return 2;
+  }
+
+  {
+    JobSystem jobs(max_workers);
+
+    double external = MeasureExternalSpawn(jobs, number_of_jobs);
+    double nested = MeasureNestedSpawn(jobs, number_of_jobs, 0);
+
+    std::cout << "SPAWN OVERHEAD (" << max_workers << " WORKERS)" << std::endl;
+    std::cout << "  FROM OUTSIDE: " << external * 1e9 / number_of_jobs
+              << " NS/JOB" << std::endl;
+    std::cout << "  FROM A JOB:   " << nested * 1e9 / number_of_jobs
+              << " NS/JOB" << std::endl;
+  }
+
+  std::cout << "STEAL EFFICIENCY (" << number_of_jobs << " JOBS OF "
+            << iterations << " ITERATIONS)" << std::endl;
+
+  double single_worker = 0.0;
+  for (size_t workers = 1; workers <= max_workers; workers *= 2) {
+    JobSystem jobs(workers);
+
+    double seconds = MeasureNestedSpawn(jobs, number_of_jobs, iterations);
+    if (workers == 1) {
+      single_worker = seconds;
+    }
+
+    std::cout << "  " << workers << " WORKERS: " << seconds * 1000.0
+              << " MS, SPEEDUP " << single_worker / seconds << ", "
+              << 100.0 * jobs.GetNumberOfSteals() / number_of_jobs
+              << "% STOLEN" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,220 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "server/protocol.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using adventure::Command;
+using adventure::DecodeStateUpdate;
+using adventure::EncodeRequest;
+using adventure::Request;
+using adventure::StateUpdate;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// The commands every simulated player cycles through
+const Request kScript[] = {
+    {0, Command::kGo, "UP"},     {0, Command::kGo, "DOWN"},
+    {0, Command::kTake, "KEY"},  {0, Command::kDrop, "KEY"},
+    {0, Command::kFight, "BAT"}, {0, Command::kUndo, ""},
+    {0, Command::kRedo, ""}};
+const size_t kScriptSize = sizeof(kScript) / sizeof(kScript[0]);
+
+/**
+ * A simulated player and the Requests it has in flight.
+ */
+struct Session {
+  int fd;
+  size_t sent;
+  size_t received;
+  std::string input;
+  std::string output;
+  size_t output_offset;
+  std::deque<Clock::time_point> send_times;
+};
+
+int Connect(const std::string& socket_path) {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, socket_path.c_str(),
+               sizeof(address.sun_path) - 1);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0 || connect(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    return -1;
+  }
+
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  return fd;
+}
+
+double Percentile(const std::vector<double>& sorted, double percentile) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+
+  size_t index = (size_t)(percentile * (double)(sorted.size() - 1));
+  return sorted[index];
+}
+
+}   // namespace
+
+// Drives many concurrent sessions against a game-server and reports command
+// latency percentiles and how many sessions one server core can sustain.
+//
+// Usage: load-generator <socket path> <sessions> <commands per session>
+//                       [pipeline depth] [server threads]
+//                       [commands/sec per session]
+int main(int argc, char* argv[]) {
+  if (argc < 4) {
+    std::cerr << "USAGE: load-generator <socket path> <sessions> "
+                 "<commands per session> [pipeline depth] [server threads] "
+                 "[commands/sec per session]" << std::endl;
+    return 2;
+  }
+
+  std::string socket_path = argv[1];
+  size_t number_of_sessions = (size_t)std::stoul(argv[2]);
+  size_t commands_per_session = (size_t)std::stoul(argv[3]);
+  size_t pipeline_depth = argc > 4 ? (size_t)std::stoul(argv[4]) : 1;
+  size_t server_threads = argc > 5 ? (size_t)std::stoul(argv[5]) : 1;
+  double session_rate = argc > 6 ? std::stod(argv[6]) : 2.0;
+
+  int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  std::vector<Session> sessions(number_of_sessions);
+
+  for (size_t index = 0; index < number_of_sessions; ++index) {
+    Session& session = sessions[index];
+    session.fd = Connect(socket_path);
+    session.sent = 0;
+    session.received = 0;
+    session.output_offset = 0;
+
+    if (session.fd < 0) {
+      std::cerr << "COULD NOT CONNECT SESSION " << index << std::endl;
+      return 1;
+    }
+
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLOUT;
+    event.data.u64 = index;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, session.fd, &event);
+  }
+
+  std::vector<double> latencies_us;
+  latencies_us.reserve(number_of_sessions * commands_per_session);
+
+  size_t finished = 0;
+  std::vector<epoll_event> events(256);
+  Clock::time_point start = Clock::now();
+
+  while (finished < number_of_sessions) {
+    int ready = epoll_wait(epoll_fd, events.data(), (int)events.size(), 1000);
+
+    for (int event_index = 0; event_index < ready; ++event_index) {
+      Session& session = sessions[events[(size_t)event_index].data.u64];
+
+      // Reads every StateUpdate that has arrived
+      char chunk[16 * 1024];
+      ssize_t received = 0;
+      while ((received = read(session.fd, chunk, sizeof(chunk))) > 0) {
+        session.input.append(chunk, (size_t)received);
+      }
+
+      size_t consumed = 0;
+      size_t frame_size = 0;
+      StateUpdate update;
+      Clock::time_point now = Clock::now();
+
+      while ((frame_size = DecodeStateUpdate(session.input.data() + consumed,
+                                             session.input.size() - consumed,
+                                             update)) > 0) {
+        consumed += frame_size;
+        latencies_us.push_back(std::chrono::duration<double, std::micro>(
+            now - session.send_times.front()).count());
+        session.send_times.pop_front();
+        ++session.received;
+      }
+      session.input.erase(0, consumed);
+
+      // Keeps up to the pipeline depth of Requests in flight
+      while (session.sent < commands_per_session &&
+             session.sent - session.received < pipeline_depth) {
+        Request request = kScript[session.sent % kScriptSize];
+        request.id = session.sent;
+
+        EncodeRequest(request, session.output);
+        session.send_times.push_back(Clock::now());
+        ++session.sent;
+      }
+
+      while (session.output_offset < session.output.size()) {
+        ssize_t sent = send(session.fd,
+                            session.output.data() + session.output_offset,
+                            session.output.size() - session.output_offset,
+                            MSG_NOSIGNAL);
+        if (sent <= 0) {
+          break;
+        }
+        session.output_offset += (size_t)sent;
+      }
+      if (session.output_offset == session.output.size()) {
+        session.output.clear();
+        session.output_offset = 0;
+      }
+
+      if (session.received == commands_per_session) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, session.fd, nullptr);
+        close(session.fd);
+        ++finished;
+      } else {
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events = (uint32_t)EPOLLIN |
+                       (session.output.empty() ? 0u : (uint32_t)EPOLLOUT);
+        event.data.u64 = events[(size_t)event_index].data.u64;
+        epoll_ctl(epoll_fd, EPOLL_CTL_MOD, session.fd, &event);
+      }
+    }
+  }
+
+  double seconds = std::chrono::duration<double>(Clock::now() - start)
+                       .count();
+  close(epoll_fd);
+
+  std::sort(latencies_us.begin(), latencies_us.end());
+  double throughput = (double)latencies_us.size() / seconds;
+
+  std::cout << "SESSIONS: " << number_of_sessions << std::endl;
+  std::cout << "COMMANDS: " << latencies_us.size() << " IN " << seconds
+            << " SEC (" << throughput << " COMMANDS/SEC)" << std::endl;
+  std::cout << "P50 LATENCY: " << Percentile(latencies_us, 0.50) << " US"
+            << std::endl;
+  std::cout << "P99 LATENCY: " << Percentile(latencies_us, 0.99) << " US"
+            << std::endl;
+  std::cout << "SESSIONS PER CORE AT " << session_rate
+            << " COMMANDS/SEC EACH: "
+            << throughput / ((double)server_threads * session_rate)
+            << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,203 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "mechanics/engine.h"
+#include "persistence/session_store.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using adventure::ArenaVector;
+using adventure::Command;
+using adventure::Door;
+using adventure::Dungeon;
+using adventure::Engine;
+using adventure::Player;
+using adventure::SessionStore;
+
+namespace {
+
+/**
+ * How much of the persistence each measured session pays for.
+ */
+enum class Mode {
+  kNone,
+  kLogged,
+  kDurable
+};
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start).count();
+}
+
+// Walks through the doors of the dungeon, which every dungeon has, and
+// returns the seconds spent on commands
+double RunSession(SessionStore* store, uint64_t session, Engine& engine,
+                  size_t commands, Mode mode) {
+  double seconds = 0.0;
+
+  for (size_t command = 0; command < commands; ++command) {
+    const ArenaVector<Door>& doors =
+        engine.FindRoom(engine.GetPlayer().GetCurrentLocation()).GetDoors();
+    std::string direction =
+        doors.empty() ? "" : doors[command % doors.size()].GetDirection();
+
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    engine.Execute(Command::kGo, direction);
+    if (mode != Mode::kNone) {
+      uint64_t ticket = store->Record(session, Command::kGo, direction,
+                                      engine);
+
+      if (mode == Mode::kDurable) {
+        store->WaitUntilDurable(ticket);
+      }
+    }
+
+    seconds += SecondsSince(start);
+  }
+
+  return seconds;
+}
+
+// Runs every session on its own thread and returns the mean seconds per
+// command
+double RunSessions(SessionStore* store, const Engine& initial,
+                   size_t sessions, size_t commands, Mode mode) {
+  std::vector<Engine> engines(sessions, initial);
+  std::vector<double> seconds(sessions, 0.0);
+  std::atomic<bool> is_started(false);
+
+  if (store != nullptr) {
+    for (size_t session = 0; session < sessions; ++session) {
+      store->Open(session, engines[session]);
+    }
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t session = 0; session < sessions; ++session) {
+    threads.emplace_back([&, session] {
+      while (!is_started) {
+        std::this_thread::yield();
+      }
+      seconds[session] = RunSession(store, session, engines[session],
+                                    commands, mode);
+    });
+  }
+
+  is_started = true;
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  double total = 0.0;
+  for (double session_seconds : seconds) {
+    total += session_seconds;
+  }
+  return total / (double)(sessions * commands);
+}
+
+}   // namespace
+
+// Measures what crash safety costs each command, with commands only queued
+// for the log and with every command waiting for its group commit, and how
+// long recovery takes, as the number of concurrent sessions grows.
+//
+// Usage: persistence-benchmark <dungeon file> <empty directory>
+//            [max sessions] [commands per session] [snapshot interval ms]
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::cerr << "USAGE: persistence-benchmark <dungeon file> "
+                 "<empty directory> [max sessions] [commands per session] "
+                 "[snapshot interval ms]" << std::endl;
+    return 2;
+  }
+
+  std::shared_ptr<Dungeon> dungeon = std::make_shared<Dungeon>();
+  std::ifstream dungeon_file(argv[1]);
+  if (!dungeon_file.is_open()) {
+    std::cerr << "DUNGEON FILE NOT FOUND" << std::endl;
+    return 2;
+  }
+  dungeon_file >> *dungeon;
+
+  std::string directory = argv[2];
+  size_t max_sessions = argc > 3 ? (size_t)std::stoul(argv[3]) : 16;
+  size_t commands = argc > 4 ? (size_t)std::stoul(argv[4]) : 2000;
+  std::chrono::milliseconds interval(argc > 5 ? std::stol(argv[5]) : 100);
+
+  if (max_sessions == 0 || commands == 0 || interval.count() <= 0 ||
+      !adventure::MakeDirectory(directory)) {
+    std::cerr << "USAGE: persistence-benchmark <dungeon file> "
+                 "<empty directory> [max sessions] [commands per session] "
+                 "[snapshot interval ms]" << std::endl;
+    return 2;
+  }
+
+  std::shared_ptr<const Dungeon> shared_dungeon = dungeon;
+  Engine initial(Player(), shared_dungeon);
+
+  std::cout << "SESSIONS, NO LOG US/CMD, LOGGED US/CMD, DURABLE US/CMD, "
+               "CMDS/SYNC, SNAPSHOTS, RECOVERY MS" << std::endl;
+
+  for (size_t sessions = 1; sessions <= max_sessions; sessions *= 2) {
+    double none = RunSessions(nullptr, initial, sessions, commands,
+                              Mode::kNone);
+
+    std::string round = directory + "/" + std::to_string(sessions);
+    std::string logged_directory = round + "-logged";
+    std::string durable_directory = round + "-durable";
+
+    double logged;
+    {
+      SessionStore store(logged_directory, interval);
+      if (!store.Recover(initial).empty()) {
+        std::cerr << "DIRECTORY IS NOT EMPTY" << std::endl;
+        return 2;
+      }
+      logged = RunSessions(&store, initial, sessions, commands,
+                           Mode::kLogged);
+    }
+
+    double durable;
+    double commands_per_sync;
+    size_t snapshots;
+    {
+      SessionStore store(durable_directory, interval);
+      if (!store.Recover(initial).empty()) {
+        std::cerr << "DIRECTORY IS NOT EMPTY" << std::endl;
+        return 2;
+      }
+      durable = RunSessions(&store, initial, sessions, commands,
+                            Mode::kDurable);
+
+      commands_per_sync = (double)(sessions * commands) /
+                          (double)store.GetLog().GetNumberOfSyncs();
+      snapshots = store.GetNumberOfSnapshots();
+    }
+
+    // Recovery reads the latest snapshots and replays the log tail
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    double recovery;
+    {
+      SessionStore store(durable_directory, interval);
+      store.Recover(initial);
+      recovery = SecondsSince(start);
+    }
+
+    std::cout << sessions << ", " << none * 1e6 << ", " << logged * 1e6
+              << ", " << durable * 1e6 << ", " << commands_per_sync << ", "
+              << snapshots << ", " << recovery * 1000.0 << std::endl;
+  }
+
+  return 0;
+}
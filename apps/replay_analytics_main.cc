@@ -0,0 +1,122 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "analytics/replay_analyzer.h"
+#include "persistence/mapped_file.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using adventure::Dungeon;
+using adventure::JobSystem;
+using adventure::ListFiles;
+using adventure::Player;
+using adventure::ReplayAnalyzer;
+using adventure::ReplayReport;
+
+// Replays every recorded session in a directory and prints how the Dungeon
+// was played: how often each Room was visited and for how long, the paths
+// that most often led to a death, and how often each Weapon was taken once
+// seen. The room visits are written out as a heatmap the map view can draw.
+//
+// Usage: replay-analytics <dungeon file> <log directory> [heatmap file]
+//                         [workers]
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::cerr << "USAGE: replay-analytics <dungeon file> <log directory> "
+                 "[heatmap file] [workers]" << std::endl;
+    return 2;
+  }
+
+  std::shared_ptr<Dungeon> dungeon = std::make_shared<Dungeon>();
+  std::ifstream dungeon_file(argv[1]);
+  if (!dungeon_file.is_open()) {
+    std::cerr << "DUNGEON FILE NOT FOUND" << std::endl;
+    return 2;
+  }
+  dungeon_file >> *dungeon;
+
+  std::vector<std::string> paths;
+  try {
+    paths = ListFiles(argv[2]);
+  } catch (const std::invalid_argument& e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  }
+
+  size_t workers = 1;
+  if (argc > 4) {
+    workers = (size_t)std::stoul(argv[4]);
+  }
+
+  ReplayAnalyzer analyzer(dungeon, Player());
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  ReplayReport report;
+  {
+    JobSystem jobs(workers);
+    report = analyzer.AnalyzeFiles(paths, jobs);
+  }
+  double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  std::cout << "ANALYZED " << report.number_of_logs << " LOGS ("
+            << report.number_of_skipped_logs << " SKIPPED), "
+            << report.number_of_commands << " COMMANDS IN "
+            << seconds * 1000.0 << " MS" << std::endl;
+  if (seconds > 0.0) {
+    std::cout << "THROUGHPUT: "
+              << (double)report.number_of_bytes / seconds / 1e6 << " MB/SEC"
+              << std::endl;
+  }
+
+  std::cout << std::endl << "ROOM VISITS" << std::endl;
+  for (size_t room = 0; room < dungeon->GetMap().size(); ++room) {
+    std::cout << dungeon->GetMap()[room].GetNickname() << " "
+              << report.room_visits[room];
+
+    if (report.room_exits[room] > 0) {
+      std::cout << " (" << report.room_milliseconds[room] /
+                               report.room_exits[room]
+                << " MS BEFORE LEAVING)";
+    }
+    std::cout << std::endl;
+  }
+
+  std::vector<std::pair<uint64_t, std::string>> death_paths;
+  for (const std::pair<const std::string, uint64_t>& path :
+       report.death_paths) {
+    death_paths.emplace_back(path.second, path.first);
+  }
+  std::sort(death_paths.rbegin(), death_paths.rend());
+
+  std::cout << std::endl << "DEATH PATHS" << std::endl;
+  for (size_t path = 0; path < death_paths.size() && path < 10; ++path) {
+    std::cout << death_paths[path].first << " " << death_paths[path].second
+              << std::endl;
+  }
+
+  std::cout << std::endl << "WEAPON PICKUPS" << std::endl;
+  for (size_t weapon = 0; weapon < analyzer.GetWeapons().size(); ++weapon) {
+    std::cout << analyzer.GetWeapons()[weapon] << " "
+              << report.weapon_pickups[weapon] << "/"
+              << report.weapon_sightings[weapon] << std::endl;
+  }
+
+  if (argc > 3) {
+    std::ofstream heatmap_file(argv[3]);
+    if (!heatmap_file.is_open()) {
+      std::cerr << "HEATMAP FILE COULD NOT BE WRITTEN" << std::endl;
+      return 1;
+    }
+    heatmap_file << analyzer.CreateHeatmap(report);
+  }
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "jobs/job_system.h"
+#include "mechanics/engine.h"
+#include "serialization/replay_log.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using adventure::Dungeon;
+using adventure::Engine;
+using adventure::JobHandle;
+using adventure::JobSystem;
+using adventure::Player;
+using adventure::ReplayLog;
+
+// Replays a recorded session headlessly and checks that the final state
+// matches, printing the replay throughput so it can be tracked over time.
+// Repetitions are independent sessions, so they are spread across workers.
+//
+// Usage: replay-game <dungeon file> <log file> [repetitions] [workers]
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::cerr << "USAGE: replay-game <dungeon file> <log file> [repetitions] "
+                 "[workers]" << std::endl;
+    return 2;
+  }
+
+  std::shared_ptr<Dungeon> dungeon = std::make_shared<Dungeon>();
+  std::ifstream dungeon_file(argv[1]);
+  if (!dungeon_file.is_open()) {
+    std::cerr << "DUNGEON FILE NOT FOUND" << std::endl;
+    return 2;
+  }
+  dungeon_file >> *dungeon;
+
+  ReplayLog log;
+  std::ifstream log_file(argv[2], std::ios::binary);
+  if (!log_file.is_open()) {
+    std::cerr << "LOG FILE NOT FOUND" << std::endl;
+    return 2;
+  }
+  log_file >> log;
+
+  size_t repetitions = 1;
+  if (argc > 3) {
+    repetitions = (size_t)std::stoul(argv[3]);
+  }
+
+  size_t workers = 1;
+  if (argc > 4) {
+    workers = (size_t)std::stoul(argv[4]);
+  }
+
+  std::shared_ptr<const Dungeon> shared_dungeon = dungeon;
+  std::atomic<bool> matches(true);
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  {
+    JobSystem jobs(workers);
+
+    std::vector<JobHandle> replays;
+    for (size_t repetition = 0; repetition < repetitions; ++repetition) {
+      replays.push_back(jobs.Submit([&log, &shared_dungeon, &matches] {
+        Engine engine(Player(), shared_dungeon);
+
+        if (!log.Replay(engine)) {
+          matches = false;
+        }
+      }));
+    }
+    for (const JobHandle& replay : replays) {
+      jobs.Wait(replay);
+    }
+  }
+
+  double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  double commands = (double)(log.GetEntries().size() * repetitions);
+
+  std::cout << "REPLAYED " << (size_t)commands << " COMMANDS IN "
+            << seconds * 1000.0 << " MS" << std::endl;
+  if (seconds > 0.0) {
+    std::cout << "THROUGHPUT: " << commands / seconds << " COMMANDS/SEC"
+              << std::endl;
+  }
+
+  if (matches) {
+    std::cout << "FINAL STATE MATCHES" << std::endl;
+    return 0;
+  } else {
+    std::cout << "FINAL STATE DIFFERS" << std::endl;
+    return 1;
+  }
+}
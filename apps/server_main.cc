@@ -0,0 +1,123 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "server/game_server.h"
+#include "server/replication_primary.h"
+#include "statistics/game_statistics.h"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using adventure::Dungeon;
+using adventure::GameServer;
+using adventure::GameStatistics;
+using adventure::Player;
+using adventure::ReplicationPrimary;
+
+namespace {
+
+// How many commands each session runs between checksums sent to the standby
+const size_t kHashInterval = 64;
+
+// How many of the fastest wins are ranked, and how often the statistics are
+// exported while the server runs
+const size_t kLeaderboardSize = 10;
+const std::chrono::seconds kExportInterval(5);
+
+GameServer* running_server = nullptr;
+
+void HandleSignal(int) {
+  if (running_server != nullptr) {
+    running_server->Stop();
+  }
+}
+
+}   // namespace
+
+// Hosts one game session per client on a Unix domain socket until
+// interrupted, replicating every session to a game-standby if one is given
+// (or "-" for none), and periodically exporting gameplay statistics to a
+// file if one is given.
+//
+// Usage: game-server <dungeon file> <socket path> [threads]
+//            [standby socket path] [statistics file]
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::cerr << "USAGE: game-server <dungeon file> <socket path> [threads] "
+                 "[standby socket path] [statistics file]" << std::endl;
+    return 2;
+  }
+
+  std::shared_ptr<Dungeon> dungeon = std::make_shared<Dungeon>();
+  std::ifstream dungeon_file(argv[1]);
+  if (!dungeon_file.is_open()) {
+    std::cerr << "DUNGEON FILE NOT FOUND" << std::endl;
+    return 2;
+  }
+  dungeon_file >> *dungeon;
+
+  size_t number_of_threads = 1;
+  if (argc > 3) {
+    number_of_threads = (size_t)std::stoul(argv[3]);
+  }
+
+  GameServer server(argv[2], dungeon, Player(), number_of_threads);
+  if (argc > 4 && std::string(argv[4]) != "-") {
+    server.ReplicateTo(
+        std::make_shared<ReplicationPrimary>(argv[4], kHashInterval));
+    std::cout << "REPLICATING TO " << argv[4] << std::endl;
+  }
+
+  std::shared_ptr<GameStatistics> statistics;
+  std::string statistics_path;
+  if (argc > 5) {
+    statistics = std::make_shared<GameStatistics>(*dungeon, number_of_threads,
+                                                  kLeaderboardSize);
+    statistics_path = argv[5];
+    server.ReportTo(statistics);
+  }
+  running_server = &server;
+
+  std::signal(SIGINT, HandleSignal);
+  std::signal(SIGTERM, HandleSignal);
+
+  std::cout << "LISTENING ON " << argv[2] << " WITH " << number_of_threads
+            << " THREAD(S)" << std::endl;
+  // Exporting only reads the statistics, so it never slows the sessions
+  std::atomic<bool> is_exporting(statistics != nullptr);
+  std::thread exporter([&] {
+    std::chrono::steady_clock::time_point next_export =
+        std::chrono::steady_clock::now() + kExportInterval;
+
+    while (is_exporting) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+      if (std::chrono::steady_clock::now() >= next_export) {
+        try {
+          statistics->Export(statistics_path);
+        } catch (const std::invalid_argument& error) {
+          std::cerr << error.what() << std::endl;
+        }
+        next_export += kExportInterval;
+      }
+    }
+  });
+
+  server.Run();
+
+  is_exporting = false;
+  exporter.join();
+  if (statistics != nullptr) {
+    statistics->Export(statistics_path);
+    std::cout << "STATISTICS EXPORTED TO " << statistics_path << std::endl;
+  }
+
+  running_server = nullptr;
+  return 0;
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "mechanics/shared_world.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using adventure::Command;
+using adventure::Dungeon;
+using adventure::Player;
+using adventure::SharedWorld;
+using adventure::Weapon;
+
+namespace {
+
+/**
+ * Where the measured Players are placed.
+ */
+enum class Placement {
+  kSpread,
+  kSameRoom
+};
+
+// Runs one Player per thread, each trading a key with its Room, and returns
+// the commands per second and the fraction of Room locks that had to wait
+double RunPlayers(std::shared_ptr<const Dungeon> dungeon, size_t threads,
+                  size_t commands, Placement placement,
+                  double& contention) {
+  SharedWorld world(dungeon, threads);
+  const std::vector<adventure::Room>& rooms = dungeon->GetMap();
+
+  for (size_t thread = 0; thread < threads; ++thread) {
+    size_t room = placement == Placement::kSpread ? thread % rooms.size() : 0;
+    world.AddPlayer(Player(rooms[room].GetNickname(), 100, 1,
+                           std::vector<Weapon>()));
+  }
+
+  std::atomic<bool> is_started(false);
+  std::vector<std::thread> workers;
+  for (size_t thread = 0; thread < threads; ++thread) {
+    workers.emplace_back([&world, &is_started, thread, commands] {
+      while (!is_started) {
+        std::this_thread::yield();
+      }
+
+      for (size_t command = 0; command < commands; ++command) {
+        world.Execute(thread,
+                      command % 2 == 0 ? Command::kDrop : Command::kTake,
+                      "KEY");
+      }
+    });
+  }
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  is_started = true;
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  contention = (double)world.GetNumberOfContendedLocks() /
+               (double)(threads * commands);
+  return (double)(threads * commands) / seconds;
+}
+
+}   // namespace
+
+// Measures how shared-world throughput scales with threads when every
+// Player is in a different Room and when they all crowd into one.
+//
+// Usage: shared-world-benchmark <dungeon file> [max threads]
+//            [commands per thread]
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "USAGE: shared-world-benchmark <dungeon file> "
+                 "[max threads] [commands per thread]" << std::endl;
+    return 2;
+  }
+
+  std::shared_ptr<Dungeon> dungeon = std::make_shared<Dungeon>();
+  std::ifstream dungeon_file(argv[1]);
+  if (!dungeon_file.is_open()) {
+    std::cerr << "DUNGEON FILE NOT FOUND" << std::endl;
+    return 2;
+  }
+  dungeon_file >> *dungeon;
+
+  size_t max_threads =
+      argc > 2 ? (size_t)std::stoul(argv[2])
+               : std::max<size_t>(1, std::thread::hardware_concurrency());
+  size_t commands = argc > 3 ? (size_t)std::stoul(argv[3]) : 200000;
+
+  std::cout << "ROOMS: " << dungeon->GetMap().size() << std::endl;
+  std::cout << "THREADS, SPREAD CMDS/S, SPREAD CONTENTION, "
+               "SAME ROOM CMDS/S, SAME ROOM CONTENTION" << std::endl;
+
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    double spread_contention;
+    double spread = RunPlayers(dungeon, threads, commands, Placement::kSpread,
+                               spread_contention);
+    double same_contention;
+    double same = RunPlayers(dungeon, threads, commands, Placement::kSameRoom,
+                             same_contention);
+
+    std::cout << threads << ", " << spread << ", " << spread_contention
+              << ", " << same << ", " << same_contention << std::endl;
+  }
+
+  return 0;
+}
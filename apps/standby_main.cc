@@ -0,0 +1,97 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "server/replication_standby.h"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+
+using adventure::Dungeon;
+using adventure::Engine;
+using adventure::ReplicationStandby;
+
+namespace {
+
+ReplicationStandby* running_standby = nullptr;
+
+void HandleSignal(int) {
+  if (running_standby != nullptr) {
+    running_standby->Stop();
+  }
+}
+
+}   // namespace
+
+// Keeps a hot copy of every session of a game-server that replicates to it,
+// reporting replication lag and checksum results, and takes the sessions
+// over as soon as the primary goes away or on interrupt.
+//
+// Usage: game-standby <dungeon file> <socket path> [report interval ms]
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::cerr << "USAGE: game-standby <dungeon file> <socket path> "
+                 "[report interval ms]" << std::endl;
+    return 2;
+  }
+
+  std::shared_ptr<Dungeon> dungeon = std::make_shared<Dungeon>();
+  std::ifstream dungeon_file(argv[1]);
+  if (!dungeon_file.is_open()) {
+    std::cerr << "DUNGEON FILE NOT FOUND" << std::endl;
+    return 2;
+  }
+  dungeon_file >> *dungeon;
+
+  std::chrono::milliseconds interval(argc > 3 ? std::stol(argv[3]) : 1000);
+  if (interval.count() <= 0) {
+    std::cerr << "USAGE: game-standby <dungeon file> <socket path> "
+                 "[report interval ms]" << std::endl;
+    return 2;
+  }
+
+  ReplicationStandby standby(argv[2], dungeon);
+  running_standby = &standby;
+
+  std::signal(SIGINT, HandleSignal);
+  std::signal(SIGTERM, HandleSignal);
+
+  std::cout << "STANDING BY ON " << argv[2] << std::endl;
+
+  std::atomic<bool> is_reporting(true);
+  std::thread reporter([&] {
+    while (is_reporting) {
+      std::this_thread::sleep_for(interval);
+
+      std::cout << "SESSIONS " << standby.GetNumberOfSessions()
+                << ", FRAMES " << standby.GetNumberOfAppliedFrames()
+                << ", LAG US " << standby.GetLastLag()
+                << ", MAX LAG US " << standby.GetMaxLag()
+                << ", HASH CHECKS " << standby.GetNumberOfHashChecks()
+                << ", DIVERGENCES " << standby.GetNumberOfDivergences()
+                << std::endl;
+    }
+  });
+
+  bool is_disconnected = standby.Run();
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  std::map<uint64_t, Engine> engines = standby.TakeOver();
+  double milliseconds = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count();
+
+  is_reporting = false;
+  reporter.join();
+  running_standby = nullptr;
+
+  std::cout << (is_disconnected ? "PRIMARY DISCONNECTED" : "INTERRUPTED")
+            << ", TOOK OVER " << engines.size() << " SESSION(S) IN "
+            << milliseconds << " MS" << std::endl;
+  return 0;
+}
@@ -6,21 +6,27 @@
 #include "cinder/app/RendererGl.h"
 #include "cinder/gl/gl.h"
 
-#include "mechanics/engine.h"
+#include "mechanics/game_thread.h"
 #include "visualizer.h"
 
+#include <memory>
+
 namespace adventure {
 
 /**
- * Holds an Engine, Visualizer, and last button index to display an adventure
- * game as a separate application.
+ * Holds a Visualizer and a GameThread to display an adventure game as a
+ * separate application. The game runs on its own thread; the app only
+ * forwards keys to it and draws the snapshots it publishes.
  */
 class AdventureApp : public ci::app::App {
  public:
   /**
-   * Internally loads an Engine based off its default constructor and a
-   * Visualizer based on the window height and width constants. Also sets the
-   * app window size and the last button index to three.
+   * Internally starts a GameThread with a GameController based off its
+   * default constructor and a Visualizer based on the window height and
+   * width constants. Also sets the app window size, seeds the game from the
+   * clock, starts recording the session if the app was launched with
+   * "--record <log file>", and draws a heatmap of room visits over the map
+   * if it was launched with "--heatmap <heatmap file>".
    */
   AdventureApp();
 
@@ -31,75 +37,57 @@ class AdventureApp : public ci::app::App {
   void draw() override;
 
   /**
-   * Overrides the original keyDown function to respond to inputs from the
-   * left arrow, right arrow, return, and escape keys. The arrows call their
-   * respective helper methods to change button selection, the return key
-   * makes a selection, and the escape key exits either the sub-panels or the
-   * app itself as well as resetting the last button index to three.
+   * Overrides the original keyDown function to forward the left arrow, right
+   * arrow, return, and escape keys to the game thread, along with the up and
+   * down arrow keys that page through a long list of sub-actions.
    * @param event The key event created from pressing a key
    */
   void keyDown(ci::app::KeyEvent event) override;
 
   /**
-   * Overrides the original update function to change the Visualizer's
-   * various text variables to reflect updates in the actual game using,
-   * helper methods depending on the state.
+   * Overrides the original update function to pass the latest snapshot of
+   * the game to the Visualizer, and to quit once the game asks to. Once no
+   * key has been pressed and no snapshot has arrived for a while, the frame
+   * rate drops until there is something new to draw. New snapshots are
+   * found by polling on every frame, not by a notification.
    */
   void update() override;
 
- private:
-  const int kWindowHeight = 1080;
-  const int kWindowWidth = 1440;
-  const size_t kFirstButton = 0;
-  const size_t kSecondButton = 1;
-  const size_t kThirdButton = 2;
-  const size_t kFourthButton = 3;
-
-  Engine engine_;
-  Visualizer visualizer_;
-  size_t last_button_index_;
-
-  void ExecuteCommand();
-
   /**
-   * Moves the current button selection to the left or to the opposite end
-   * depending on whether the Visualizer has toggled panels shown or not, the
-   * current sub-selection, and the current main selection.
+   * Overrides the original resize function to lay the Visualizer out again
+   * for the new window size.
    */
-  void MoveSelectionLeft();
+  void resize() override;
 
   /**
-   * Moves the current button selection to the right or to the opposite end
-   * depending on whether the Visualizer has toggled panels shown or not, the
-   * current sub-selection, and the current main selection.
+   * Overrides the original cleanup function to stop the game thread and
+   * write the recorded session to its log file when recording.
    */
-  void MoveSelectionRight();
+  void cleanup() override;
 
-  /**
-   * Loads in the current Room's Enemies to serve as sub-action buttons and
-   * changes the last button index according to the number of Enemies.
-   */
-  void LoadFightOptions();
+ private:
+  const int kWindowHeight = 1080;
+  const int kWindowWidth = 1440;
 
-  /**
-   * Loads in the current Room's Weapons and number of keys to serve as
-   * sub-action buttons and changes the last button index according to both the
-   * number of Weapons and the number of keys.
-   */
-  void LoadTakeOptions();
+  const float kActiveFrameRate = 60.0f;
+  // Cinder's loop runs on a timer that the game thread cannot wake, so an
+  // idle app still polls for snapshots and redraws at this rate. Low enough
+  // to barely use the processor, but high enough that a snapshot published
+  // just after a frame still shows up promptly
+  const float kIdleFrameRate = 4.0f;
+  const double kIdleSeconds = 2.0;
 
-  /**
-   * Loads in the Player's Weapons and number of keys to serve as sub-action
-   * buttons and changes the last button index according to both the number
-   * of Weapons and the number of keys.
-   */
-  void LoadDropOptions();
+  Visualizer visualizer_;
+  std::unique_ptr<GameThread> game_thread_;
+
+  double last_activity_time_;
+  bool is_idle_;
 
   /**
-   * Loads in the current Room's Doors to serve as sub-action buttons and
-   * changes the last button index according to the number of Doors.
+   * Records that something new has to be drawn, raising the frame rate
+   * back up if the app was idle.
    */
-  void LoadGoOptions();
+  void MarkActive();
 };
 
 }
@@ -0,0 +1,69 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Initializes an empty Heatmap of how often each Room was visited, which can
+ * be written to and read from a small text file so it can be produced
+ * offline and drawn over the map view.
+ */
+class Heatmap {
+ public:
+  /**
+   * Internally loads a Heatmap with no Rooms.
+   */
+  Heatmap();
+
+  size_t GetNumberOfRooms() const;
+
+  const std::string &GetRoom(size_t cell) const;
+
+  uint64_t GetVisits(size_t cell) const;
+
+  /**
+   * Returns how often a Room was visited compared to the most visited Room.
+   * @param cell The index of the Room in the Heatmap
+   * @return The Room's visits over the most visits, from 0 to 1
+   */
+  float GetIntensity(size_t cell) const;
+
+  /**
+   * Appends a Room and how often it was visited. Throws an error if the
+   * Room's nickname is empty or contains whitespace.
+   * @param room The nickname of the Room
+   * @param visits The number of visits
+   */
+  void Add(const std::string& room, uint64_t visits);
+
+  /**
+   * Writes a header line followed by one line per Room with its nickname and
+   * number of visits.
+   * @param os The out-stream being written to
+   * @param heatmap The Heatmap being written
+   * @return The out-stream that went into the operator
+   */
+  friend std::ostream &operator<<(std::ostream& os, const Heatmap& heatmap);
+
+  /**
+   * Reads a Heatmap written by the operator<< overload. Throws an error if
+   * the file is invalid.
+   * @param is The in-stream being read from
+   * @param heatmap The Heatmap being loaded into
+   * @return The in-stream that went into the operator
+   */
+  friend std::istream &operator>>(std::istream& is, Heatmap& heatmap);
+
+ private:
+  std::vector<std::string> rooms_;
+  std::vector<uint64_t> visits_;
+  uint64_t max_visits_;
+};
+
+}   // namespace adventure
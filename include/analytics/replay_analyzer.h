@@ -0,0 +1,141 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "analytics/heatmap.h"
+#include "entities/player.h"
+#include "jobs/job_system.h"
+#include "map/dungeon.h"
+#include "serialization/replay_log.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * What a set of replayed sessions add up to. Reports over separate logs can
+ * be merged, so logs can be analyzed in parallel. Rooms and Weapons are
+ * indexed as in the ReplayAnalyzer that made the report.
+ */
+struct ReplayReport {
+  uint64_t number_of_logs;
+  uint64_t number_of_skipped_logs;
+  uint64_t number_of_commands;
+  uint64_t number_of_bytes;
+
+  // How often each Room was entered, how often it was left, and the
+  // milliseconds spent in it before leaving
+  std::vector<uint64_t> room_visits;
+  std::vector<uint64_t> room_exits;
+  std::vector<uint64_t> room_milliseconds;
+
+  // The last Rooms before each death, joined with " > "
+  std::map<std::string, uint64_t> death_paths;
+
+  // How many sessions saw each Weapon in a Room, and how many took it
+  std::vector<uint64_t> weapon_sightings;
+  std::vector<uint64_t> weapon_pickups;
+};
+
+/**
+ * Takes in a Dungeon and the Player sessions started with for an analyzer
+ * of recorded sessions. Each session is replayed on a fresh Engine, and
+ * what happened is added up into a ReplayReport: which Rooms were visited,
+ * how long was spent in each, the paths that led to deaths, and how often
+ * each Weapon was picked up once seen. Logs are read straight out of mapped
+ * files, and groups of files are analyzed in parallel and merged.
+ */
+class ReplayAnalyzer {
+ public:
+  /**
+   * The number of Rooms leading up to a death that make up its path.
+   */
+  static const size_t kDeathPathLength = 3;
+
+  /**
+   * Loads in the Dungeon and the Player the recorded sessions started with.
+   * Logs recorded over a different Dungeon are skipped. Throws an error if
+   * the Dungeon is not specified.
+   * @param dungeon The shared Dungeon the sessions played through
+   * @param player The Player every session started with
+   */
+  ReplayAnalyzer(std::shared_ptr<const Dungeon> dungeon, const Player& player);
+
+  /**
+   * Lists the nickname of every Weapon in the Dungeon, in the order the
+   * report indexes them.
+   * @return The nicknames of the Weapons
+   */
+  const std::vector<std::string> &GetWeapons() const;
+
+  /**
+   * Creates a report of no sessions, sized for the Dungeon.
+   * @return An empty report
+   */
+  ReplayReport CreateReport() const;
+
+  /**
+   * Replays every log in a buffer and adds them to a report. A log that is
+   * invalid or cut short is counted as skipped and ends the buffer, since
+   * the logs after it cannot be found.
+   * @param data The bytes of one or more logs written back to back
+   * @param size The number of bytes
+   * @param report The report being added to
+   */
+  void Analyze(const uint8_t* data, size_t size, ReplayReport& report) const;
+
+  /**
+   * Maps every file, splits the files into groups of about the same size,
+   * analyzes each group as its own job, and merges the results. Files that
+   * cannot be mapped are counted as skipped logs.
+   * @param paths The paths of the log files
+   * @param jobs The JobSystem the groups run on
+   * @return The merged report
+   */
+  ReplayReport AnalyzeFiles(const std::vector<std::string>& paths,
+                            JobSystem& jobs) const;
+
+  /**
+   * Adds one report to another made by the same analyzer.
+   * @param from The report being added
+   * @param into The report being added to
+   */
+  static void Merge(const ReplayReport& from, ReplayReport& into);
+
+  /**
+   * Creates a Heatmap of how often each Room was visited.
+   * @param report The report holding the visits
+   * @return The Heatmap of every Room, in the Dungeon's order
+   */
+  Heatmap CreateHeatmap(const ReplayReport& report) const;
+
+ private:
+  // Groups of files per worker, so that one slow group does not hold up
+  // the rest
+  const size_t kGroupsPerWorker = 4;
+
+  std::shared_ptr<const Dungeon> dungeon_;
+  Player player_;
+  uint64_t dungeon_checksum_;
+
+  std::vector<std::string> weapons_;
+  std::unordered_map<std::string, size_t> weapon_indices_;
+
+  /**
+   * Replays the next log of a reader and adds it to a report. Throws an
+   * error if the log is invalid.
+   */
+  void AnalyzeLog(ReplayReader& reader, ReplayReport& report) const;
+
+  /**
+   * Marks every Weapon lying in a Room as seen.
+   */
+  void SeeWeapons(const Room& room, std::vector<bool>& is_seen) const;
+};
+
+}   // namespace adventure
@@ -0,0 +1,183 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace adventure {
+
+/**
+ * What a reader of a BroadcastRing found at its position.
+ */
+enum class BroadcastRead : uint8_t {
+  kMessage,
+  kEmpty,
+  kOverrun
+};
+
+/**
+ * Takes in a capacity for a lock-free ring buffer of messages with one
+ * writer thread and any number of reader threads. Each reader keeps its own
+ * position, so every reader sees every message, and the writer never waits
+ * for readers: once the ring is full it overwrites the oldest messages, and
+ * a reader that falls that far behind is told it was overrun. Publishing
+ * therefore costs the same however many readers there are.
+ */
+class BroadcastRing {
+ public:
+  /**
+   * Loads in the number of bytes the ring can hold, rounded up to a power of
+   * two. Throws an error if the capacity is zero.
+   * @param capacity The minimum number of bytes the ring can hold
+   */
+  explicit BroadcastRing(size_t capacity);
+
+  BroadcastRing(const BroadcastRing&) = delete;
+
+  BroadcastRing &operator=(const BroadcastRing&) = delete;
+
+  size_t GetCapacity() const;
+
+  /**
+   * Returns the position just after the newest message, where a reader that
+   * only wants new messages starts.
+   * @return The end position
+   */
+  uint64_t GetEnd() const;
+
+  /**
+   * Appends a message, overwriting the oldest ones if the ring is full. Only
+   * the writer thread should call this. Throws an error if the message takes
+   * up more than half of the ring.
+   * @param data The bytes of the message
+   * @param size The number of bytes in the message
+   * @return The position of the message
+   */
+  uint64_t Publish(const char* data, size_t size);
+
+  /**
+   * Reads the message at a position and moves the position past it. Safe to
+   * call from any number of threads, each with its own position.
+   * @param position The reader's position, advanced past a read message
+   * @param message Set to the message, if one was read
+   * @return Whether a message was read, there was none yet, or the message
+   * at the position has been overwritten
+   */
+  BroadcastRead Read(uint64_t& position, std::string& message) const;
+
+ private:
+  // Messages are stored as a length word followed by their bytes packed
+  // into words, which are atomic so that a reader racing the writer reads
+  // stale or torn words rather than undefined behavior, and then notices
+  static const size_t kWordSize = sizeof(uint64_t);
+
+  std::unique_ptr<std::atomic<uint64_t>[]> words_;
+  size_t number_of_words_;
+  size_t mask_;
+
+  // Positions are counted in words and never wrap. Everything before
+  // reclaimed_ may have been overwritten
+  std::atomic<uint64_t> end_;
+  std::atomic<uint64_t> reclaimed_;
+};
+
+inline BroadcastRing::BroadcastRing(size_t capacity)
+    : words_(), number_of_words_(1), mask_(0), end_(0), reclaimed_(0) {
+  if (capacity == 0) {
+    throw std::invalid_argument("CAPACITY NOT SPECIFIED");
+  }
+
+  while (number_of_words_ * kWordSize < capacity) {
+    number_of_words_ *= 2;
+  }
+
+  words_.reset(new std::atomic<uint64_t>[number_of_words_]);
+  for (size_t word = 0; word < number_of_words_; ++word) {
+    words_[word].store(0, std::memory_order_relaxed);
+  }
+  mask_ = number_of_words_ - 1;
+}
+
+inline size_t BroadcastRing::GetCapacity() const {
+  return number_of_words_ * kWordSize;
+}
+
+inline uint64_t BroadcastRing::GetEnd() const {
+  return end_.load(std::memory_order_acquire);
+}
+
+inline uint64_t BroadcastRing::Publish(const char* data, size_t size) {
+  uint64_t payload_words = (size + kWordSize - 1) / kWordSize;
+  if (1 + payload_words > number_of_words_ / 2) {
+    throw std::invalid_argument("MESSAGE TOO LARGE");
+  }
+
+  uint64_t start = end_.load(std::memory_order_relaxed);
+  uint64_t end = start + 1 + payload_words;
+
+  // Readers are warned before the words they might be reading change, and
+  // check the warning again after reading
+  if (end > number_of_words_) {
+    reclaimed_.store(end - number_of_words_, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  words_[start & mask_].store(size, std::memory_order_relaxed);
+  for (uint64_t word = 0; word < payload_words; ++word) {
+    uint64_t value = 0;
+    size_t offset = (size_t)word * kWordSize;
+    std::memcpy(&value, data + offset,
+                size - offset < kWordSize ? size - offset : kWordSize);
+
+    words_[(start + 1 + word) & mask_].store(value,
+                                             std::memory_order_relaxed);
+  }
+
+  end_.store(end, std::memory_order_release);
+  return start;
+}
+
+inline BroadcastRead BroadcastRing::Read(uint64_t& position,
+                                         std::string& message) const {
+  uint64_t end = end_.load(std::memory_order_acquire);
+
+  if (position >= end) {
+    return BroadcastRead::kEmpty;
+  } else if (position < reclaimed_.load(std::memory_order_acquire)) {
+    return BroadcastRead::kOverrun;
+  }
+
+  uint64_t size = words_[position & mask_].load(std::memory_order_relaxed);
+  uint64_t payload_words = (size + kWordSize - 1) / kWordSize;
+
+  // A length overwritten mid-read can be anything, so it is only trusted
+  // once it fits before the end
+  if (payload_words >= end - position) {
+    return BroadcastRead::kOverrun;
+  }
+
+  message.resize((size_t)size);
+  for (uint64_t word = 0; word < payload_words; ++word) {
+    uint64_t value =
+        words_[(position + 1 + word) & mask_].load(std::memory_order_relaxed);
+    size_t offset = (size_t)word * kWordSize;
+    std::memcpy(&message[offset], &value,
+                size - offset < kWordSize ? (size_t)size - offset
+                                          : kWordSize);
+  }
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (position < reclaimed_.load(std::memory_order_relaxed)) {
+    return BroadcastRead::kOverrun;
+  }
+
+  position += 1 + payload_words;
+  return BroadcastRead::kMessage;
+}
+
+}   // namespace adventure
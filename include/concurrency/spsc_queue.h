@@ -0,0 +1,116 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Takes in a capacity for a bounded lock-free queue with exactly one
+ * producer thread and one consumer thread. Neither side ever blocks: pushing
+ * onto a full queue and popping from an empty one simply fail.
+ */
+template <typename T>
+class SpscQueue {
+ public:
+  /**
+   * Loads in the number of items the queue can hold, rounded up to a power
+   * of two. Throws an error if the capacity is zero.
+   * @param capacity The minimum number of items the queue can hold
+   */
+  explicit SpscQueue(size_t capacity);
+
+  SpscQueue(const SpscQueue&) = delete;
+
+  SpscQueue &operator=(const SpscQueue&) = delete;
+
+  size_t GetCapacity() const;
+
+  /**
+   * Adds an item at the back. Only the producer thread should call this.
+   * @param item The item to add
+   * @return Whether there was room for the item
+   */
+  bool TryPush(const T& item);
+
+  /**
+   * Removes the item at the front. Only the consumer thread should call
+   * this.
+   * @param item Set to the removed item
+   * @return Whether there was an item to remove
+   */
+  bool TryPop(T& item);
+
+  bool empty() const;
+
+ private:
+  // Keeps the two indices on separate cache lines so the producer and the
+  // consumer do not invalidate each other's line on every operation
+  static const size_t kCacheLineSize = 64;
+
+  std::vector<T> items_;
+  size_t mask_;
+
+  char padding_before_head_[kCacheLineSize];
+  std::atomic<size_t> head_;
+  char padding_before_tail_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> tail_;
+  char padding_after_tail_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+};
+
+template <typename T>
+SpscQueue<T>::SpscQueue(size_t capacity) : items_(), mask_(0), head_(0),
+                                            tail_(0) {
+  if (capacity == 0) {
+    throw std::invalid_argument("CAPACITY NOT SPECIFIED");
+  }
+
+  size_t rounded = 1;
+  while (rounded < capacity) {
+    rounded *= 2;
+  }
+
+  items_.resize(rounded);
+  mask_ = rounded - 1;
+}
+
+template <typename T>
+size_t SpscQueue<T>::GetCapacity() const { return items_.size(); }
+
+template <typename T>
+bool SpscQueue<T>::TryPush(const T& item) {
+  size_t tail = tail_.load(std::memory_order_relaxed);
+
+  if (tail - head_.load(std::memory_order_acquire) == items_.size()) {
+    return false;
+  }
+
+  items_[tail & mask_] = item;
+  tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+bool SpscQueue<T>::TryPop(T& item) {
+  size_t head = head_.load(std::memory_order_relaxed);
+
+  if (head == tail_.load(std::memory_order_acquire)) {
+    return false;
+  }
+
+  item = items_[head & mask_];
+  head_.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+bool SpscQueue<T>::empty() const {
+  return head_.load(std::memory_order_acquire) ==
+         tail_.load(std::memory_order_acquire);
+}
+
+}   // namespace adventure
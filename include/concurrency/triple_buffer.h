@@ -0,0 +1,94 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace adventure {
+
+/**
+ * Hands whole values from one writer thread to one reader thread without
+ * locks. The writer fills the back buffer and publishes it, the reader picks
+ * up the most recently published buffer, and a third buffer in between
+ * means neither side ever waits for the other. Published values the reader
+ * never picked up are simply overwritten.
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  TripleBuffer();
+
+  TripleBuffer(const TripleBuffer&) = delete;
+
+  TripleBuffer &operator=(const TripleBuffer&) = delete;
+
+  /**
+   * Returns the buffer the writer fills next. Its previous contents are
+   * stale, so the writer should overwrite all of it. Only the writer thread
+   * should call this.
+   * @return The back buffer
+   */
+  T &GetBack();
+
+  /**
+   * Makes the back buffer the most recently published one. Only the writer
+   * thread should call this.
+   */
+  void Publish();
+
+  /**
+   * Picks up the most recently published buffer, if there is a new one.
+   * Only the reader thread should call this.
+   * @return Whether a newly published buffer was picked up
+   */
+  bool Update();
+
+  /**
+   * Returns the buffer the reader last picked up, which the writer will not
+   * touch until the reader picks up another one. Only the reader thread
+   * should call this.
+   * @return The front buffer
+   */
+  const T &GetFront() const;
+
+ private:
+  // Set on the shared index while it holds a buffer the reader has not seen
+  static const uint8_t kFreshBit = 4;
+  static const uint8_t kIndexMask = 3;
+
+  T buffers_[3];
+
+  uint8_t back_;
+  std::atomic<uint8_t> middle_;
+  uint8_t front_;
+};
+
+template <typename T>
+TripleBuffer<T>::TripleBuffer() : back_(0), middle_(1), front_(2) {}
+
+template <typename T>
+T &TripleBuffer<T>::GetBack() { return buffers_[back_]; }
+
+template <typename T>
+void TripleBuffer<T>::Publish() {
+  uint8_t previous = middle_.exchange(back_ | kFreshBit,
+                                      std::memory_order_acq_rel);
+  back_ = previous & kIndexMask;
+}
+
+template <typename T>
+bool TripleBuffer<T>::Update() {
+  if ((middle_.load(std::memory_order_relaxed) & kFreshBit) == 0) {
+    return false;
+  }
+
+  uint8_t previous = middle_.exchange(front_, std::memory_order_acq_rel);
+  front_ = previous & kIndexMask;
+  return true;
+}
+
+template <typename T>
+const T &TripleBuffer<T>::GetFront() const { return buffers_[front_]; }
+
+}   // namespace adventure
@@ -6,9 +6,30 @@
 
 namespace adventure {
 
+/**
+ * The name, nickname, starting health, strength, and critical hit chance
+ * every Enemy of one kind shares. Each kind is interned once per process,
+ * however many Enemies of that kind are loaded.
+ */
+struct EnemyArchetype {
+  std::string name;
+  std::string nickname;
+  size_t health;
+  size_t strength;
+  size_t critical_chance;
+
+  struct Hash {
+    size_t operator()(const EnemyArchetype& archetype) const;
+  };
+};
+
+bool operator==(const EnemyArchetype& lhs, const EnemyArchetype& rhs);
+
 /**
  * Takes in a name, nickname, health, strength, and critical hit chance for an
- * enemy in a dungeon room.
+ * enemy in a dungeon room. An Enemy holds only its current health and a
+ * pointer to its interned archetype, so copies are cheap and Enemies of the
+ * same kind share one copy of their names and stats.
  */
 class Enemy {
  public:
@@ -17,22 +38,33 @@ class Enemy {
    * chance value as two strings and three size_ts, respectively. Throws an
    * error if the name string and/or nickname string are empty, if the nickname
    * string is greater than five characters, and/or if the health and/or
-   * strength equal zero.
+   * strength equal zero. The strings are taken by value and moved into the
+   * archetype if it is the first of its kind.
    * @param name The Enemy's name
    * @param nickname The Enemy's shortened name
    * @param health The Enemy's health
    * @param attack The Enemy's strength
    * @param critical_chance The Enemy's critical hit chance
    */
-  Enemy(const std::string& name, const std::string& nickname, size_t health,
-         size_t strength, size_t critical_chance);
+  Enemy(std::string name, std::string nickname, size_t health,
+        size_t strength, size_t critical_chance);
 
   const std::string &GetName() const;
 
   const std::string &GetNickname() const;
 
+  /**
+   * Returns the archetype this Enemy shares with every Enemy of its kind.
+   * Two Enemies are of the same kind exactly when their archetypes have the
+   * same address.
+   * @return The interned archetype
+   */
+  const EnemyArchetype &GetArchetype() const;
+
   size_t GetHealth() const;
 
+  void SetHealth(size_t health);
+
   size_t GetStrength() const;
 
   size_t GetCriticalChance() const;
@@ -44,6 +76,14 @@ class Enemy {
    */
   size_t DealDamage() const;
 
+  /**
+   * Generates and returns attack damage from a random number between 0 and
+   * 99 supplied by the caller.
+   * @param roll The random number between 0 and 99
+   * @return The generated attack damage
+   */
+  size_t DealDamage(size_t roll) const;
+
   /**
    * Diminishes the health by the specified amount. If the Enemy would end up
    * with health below 0, the health will be set to 0.
@@ -59,20 +99,24 @@ class Enemy {
   bool IsAlive();
 
  private:
-  std::string name_;
-  std::string nickname_;
+  const EnemyArchetype* archetype_;
   size_t health_;
-  size_t strength_;
-  size_t critical_chance_;
 
   /**
    * Calculates damage to deal based on the current strength and critical hit
    * chance (based on random number generation between 0 and 99). If the
    * number is less than or equal to the critical hit chance, it returns
    * double the strength. Otherwise, it returns just the strength.
+   * @param roll The random number between 0 and 99
    * @return The calculated damage
    */
-  size_t CalculateDamage() const;
+  size_t CalculateDamage(size_t roll) const;
 };
 
+/**
+ * Returns the number of distinct kinds of Enemy interned so far.
+ * @return The number of Enemy archetypes
+ */
+size_t GetNumberOfEnemyArchetypes();
+
 }   // namespace adventure
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "items/inventory.h"
 #include "items/weapon.h"
 
 #include <string>
@@ -11,10 +12,14 @@ namespace adventure {
 
 /**
  * Takes in a current location, starting health, starting number of keys, and
- * a set of Weapons for a Player in a dungeon.
+ * a set of Weapons for a Player in a dungeon. The Weapons are kept in an
+ * Inventory, so attacking with the strongest Weapon and finding a Weapon by
+ * name take constant time however many Weapons the Player carries.
  */
 class Player {
  public:
+  // The most Weapons a Player can carry at once, unless set otherwise
+  static const size_t kDefaultMaxWeapons = 4;
 
   /**
    * Internally loads a name, current location, starting health, starting number
@@ -45,10 +50,22 @@ class Player {
 
   size_t GetNumberOfKeys() const;
 
-  const std::vector<Weapon> &GetWeapons() const;
+  const Inventory::Weapons &GetWeapons() const;
+
+  size_t GetMaxWeapons() const;
 
   void SetCurrentLocation(const std::string& new_location);
 
+  void SetHealth(size_t health);
+
+  /**
+   * Sets the most Weapons the Player can carry at once. Weapons already
+   * carried past a lower limit are kept. Throws an error if the limit equals
+   * zero.
+   * @param max_weapons The most Weapons the Player can carry
+   */
+  void SetMaxWeapons(size_t max_weapons);
+
   /**
    * Augments the health by 5% of the max health. If the health ends up
    * exceeding the max health, it gets set to the max health.
@@ -62,6 +79,14 @@ class Player {
    */
   size_t DealDamage() const;
 
+  /**
+   * Generates and returns attack damage from the strongest Weapon using a
+   * random number between 0 and 99 supplied by the caller.
+   * @param roll The random number between 0 and 99
+   * @return The generated attack damage
+   */
+  size_t DealDamage(size_t roll) const;
+
   /**
    * Diminishes the health by the specified amount. If the Player would end up
    * with health below 0, the health will be set to 0.
@@ -95,31 +120,39 @@ class Player {
   void AddWeapon(const Weapon& weapon);
 
   /**
-   * Removes the specified Weapon by iterating through the vector until it
-   * finds the specified Weapon. Throws an error if the vector is empty or
-   * the Weapon is not in the vector.
+   * Removes the specified Weapon, found by its name, moving every later
+   * Weapon forward by one. Throws an error if the vector is empty or the
+   * Weapon is not in the vector.
    * @param weapon The specified Weapon to remove from the vector
    */
   void RemoveWeapon(const Weapon& weapon);
 
   /**
-   * Iterates through the vector of Weapons and returns the specified Weapon
-   * based on a name string. Throws an error if the name string is empty or
-   * the Weapon is not in the vector.
-   * @param name The name of the Weapon being searched for
+   * Inserts the specified Weapon at the given index of the vector of Weapons.
+   * Throws an error if the index is past the end of the vector.
+   * @param index The position the Weapon is inserted at
+   * @param weapon The specified Weapon to insert into the vector
+   */
+  void InsertWeapon(size_t index, const Weapon& weapon);
+
+  /**
+   * Returns the specified Weapon based on a nickname string. Throws an error
+   * if the name string is empty or the Weapon is not in the vector.
+   * @param name The nickname of the Weapon being searched for
    * @return The Weapon being searched for
    */
-  Weapon &RetrieveWeapon(const std::string& name);
+  const Weapon &RetrieveWeapon(const std::string& name) const;
 
  private:
   std::string current_location_;
   size_t max_health_;
   size_t health_;
   size_t number_of_keys_;
-  std::vector<Weapon> weapons_;
+  size_t max_weapons_;
+  Inventory weapons_;
 
   /**
-   * Iterates through the vector of Weapons and returns the strongest Weapon.
+   * Returns the strongest Weapon, which the Inventory keeps at hand.
    * @return The strongest Weapon being searched for
    */
   const Weapon &RetrieveStrongestWeapon() const;
@@ -0,0 +1,174 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "items/weapon.h"
+#include "memory/small_vector.h"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Takes in Weapons for an ordered list of them that keeps the strongest
+ * Weapon at hand and finds Weapons by name or nickname without a scan. Up
+ * to kInlineWeapons Weapons are kept inside the Inventory with no heap
+ * memory at all, and looked up by comparing every one; past that, the
+ * Weapons move to the heap and are indexed by their interned names and by
+ * their strength. The indexes name each Weapon by a handle that stays the
+ * same while the Weapon moves, so only the list of handles moves along with
+ * the Weapons.
+ */
+class Inventory {
+ public:
+  static const size_t kInlineWeapons = 4;
+  static const size_t kNotFound = (size_t)-1;
+
+  using Weapons = SmallVector<Weapon, kInlineWeapons>;
+
+  /**
+   * Internally loads an empty Inventory.
+   */
+  Inventory();
+
+  /**
+   * Loads in Weapons, in order.
+   * @param weapons The Weapons
+   */
+  template <typename Iterator>
+  Inventory(Iterator first, Iterator last) : Inventory() {
+    for (; first != last; ++first) {
+      Insert(weapons_.size(), *first);
+    }
+  }
+
+  const Weapons &GetWeapons() const;
+
+  /**
+   * Returns where the first Weapon with the given name is.
+   * @param name The name of the Weapon
+   * @return The index of the Weapon, or kNotFound if there is none
+   */
+  size_t FindName(const std::string& name) const;
+
+  /**
+   * Returns where the first Weapon with the given nickname is.
+   * @param nickname The nickname of the Weapon
+   * @return The index of the Weapon, or kNotFound if there is none
+   */
+  size_t FindNickname(const std::string& nickname) const;
+
+  /**
+   * Returns where the strongest Weapon is, the first one if several are
+   * equally strong.
+   * @return The index of the Weapon, or kNotFound if there are no Weapons
+   */
+  size_t GetStrongest() const;
+
+  /**
+   * Places a Weapon at an index, moving every Weapon from there on back by
+   * one. Only the new Weapon's index entries are added, so adding to the
+   * back takes constant time apart from the indexes' own lookups. Throws an
+   * error if the index is past the end.
+   * @param index Where the Weapon goes, up to the number of Weapons
+   * @param weapon The Weapon
+   */
+  void Insert(size_t index, const Weapon& weapon);
+
+  /**
+   * Removes the Weapon at an index, moving every later Weapon forward by
+   * one. Only the removed Weapon's index entries are dropped, and a new
+   * strongest Weapon is taken from the strength index rather than found by
+   * a scan. Throws an error if the index is out of range.
+   * @param index The index of the Weapon
+   */
+  void Erase(size_t index);
+
+ private:
+  /**
+   * Hashes an interned name by its characters, so the index can be looked
+   * up with any string.
+   */
+  struct NameHash {
+    size_t operator()(const std::string* name) const;
+  };
+
+  struct NameEqual {
+    bool operator()(const std::string* lhs, const std::string* rhs) const;
+  };
+
+  // Both map to the handles of the Weapons, and several Weapons can share a
+  // name or a strength
+  using NameIndex = std::unordered_multimap<const std::string*, size_t,
+                                            NameHash, NameEqual>;
+  using StrengthIndex = std::multimap<int, size_t, std::greater<int>>;
+
+  Weapons weapons_;
+  size_t strongest_;
+
+  // Everything below is empty until there are more Weapons than fit inline.
+  // The handle of the Weapon at each index, and the index of the Weapon
+  // with each handle. Handles of removed Weapons are used again
+  std::vector<size_t> handles_;
+  std::vector<size_t> positions_;
+  std::vector<size_t> free_handles_;
+
+  // Keys point at the names in the Weapons' archetypes, which never move
+  NameIndex names_;
+  NameIndex nicknames_;
+  StrengthIndex strengths_;
+
+  bool IsIndexed() const;
+
+  /**
+   * Gives the Weapon at an index a handle and moves the handles of the
+   * Weapons after it back by one.
+   */
+  void AddHandle(size_t index);
+
+  /**
+   * Records the Weapon at an index in the indexes and as the strongest, if
+   * it comes before every Weapon already recorded.
+   */
+  void Record(size_t index);
+
+  /**
+   * Records the Weapon at an index as the strongest, if it is stronger than
+   * the one recorded or as strong and before it.
+   */
+  void RecordStrongest(size_t index);
+
+  /**
+   * Returns where the first of the Weapons with the given handles is.
+   * @param first The first entry with the handles
+   * @param last Past the last entry with the handles
+   * @return The index of the first Weapon, or kNotFound if there is none
+   */
+  template <typename Iterator>
+  size_t FindFirst(Iterator first, Iterator last) const;
+
+  /**
+   * Drops the entry of the Weapon with a handle from an index.
+   * @param index The names, nicknames, or strengths
+   * @param key The key the Weapon was recorded under
+   * @param handle The handle of the Weapon
+   */
+  template <typename Index, typename Key>
+  static void Forget(Index& index, const Key& key, size_t handle);
+
+  /**
+   * Records every Weapon, once there are more than fit inline.
+   */
+  void Rebuild();
+
+  /**
+   * Drops every index, once the Weapons fit inline again.
+   */
+  void Clear();
+};
+
+}   // namespace adventure
@@ -6,8 +6,28 @@
 
 namespace adventure {
 
+/**
+ * The name, nickname, strength, and critical hit chance every Weapon of one
+ * kind shares. Each kind is interned once per process, however many Weapons
+ * of that kind are loaded.
+ */
+struct WeaponArchetype {
+  std::string name;
+  std::string nickname;
+  size_t strength;
+  size_t critical_chance;
+
+  struct Hash {
+    size_t operator()(const WeaponArchetype& archetype) const;
+  };
+};
+
+bool operator==(const WeaponArchetype& lhs, const WeaponArchetype& rhs);
+
 /**
  * Takes in a name, nickname, strength, and critical hit chance for a Weapon.
+ * A Weapon has no state of its own, so it is only a pointer to its interned
+ * archetype.
  */
 class Weapon {
  public:
@@ -15,19 +35,29 @@ class Weapon {
    * Loads in a name, nickname, strength value, and critical hit chance value
    * as two strings and two size_ts, respectively. Throws an error if the
    * name string and/or nickname string is empty, if the nickname string is
-   * greater than five characters, and/or if the strength equals zero.
+   * greater than five characters, and/or if the strength equals zero. The
+   * strings are taken by value and moved into the archetype if it is the
+   * first of its kind.
    * @param name The Weapon's name
    * @param nickname The Weapon's shortened name
    * @param strength The Weapon's strength
    * @param critical_chance The Weapon's critical hit chance
    */
-  Weapon(const std::string& name, const std::string& nickname, size_t strength,
+  Weapon(std::string name, std::string nickname, size_t strength,
          size_t critical_chance);
 
   const std::string &GetName() const;
 
   const std::string &GetNickname() const;
 
+  /**
+   * Returns the archetype this Weapon shares with every Weapon of its kind.
+   * Two Weapons are of the same kind exactly when their archetypes have the
+   * same address.
+   * @return The interned archetype
+   */
+  const WeaponArchetype &GetArchetype() const;
+
   size_t GetStrength() const;
 
   size_t GetCriticalChance() const;
@@ -41,11 +71,22 @@ class Weapon {
    */
   size_t CalculateDamage() const;
 
+  /**
+   * Calculates damage to deal the same way as above, except that the random
+   * number between 0 and 99 is supplied by the caller.
+   * @param roll The random number between 0 and 99
+   * @return The calculated damage
+   */
+  size_t CalculateDamage(size_t roll) const;
+
  private:
-  std::string name_;
-  std::string nickname_;
-  size_t strength_;
-  size_t critical_chance_;
+  const WeaponArchetype* archetype_;
 };
 
+/**
+ * Returns the number of distinct kinds of Weapon interned so far.
+ * @return The number of Weapon archetypes
+ */
+size_t GetNumberOfWeaponArchetypes();
+
 }   // namespace adventure
\ No newline at end of file
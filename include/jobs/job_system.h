@@ -0,0 +1,259 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "jobs/work_stealing_deque.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * The order in which queued jobs are picked up. Workers always look for
+ * high priority work, on every worker, before lower priority work.
+ */
+enum class JobPriority : uint8_t {
+  kHigh,
+  kNormal,
+  kLow
+};
+
+/**
+ * A shared flag that asks jobs not to run. Copies share the same flag, so
+ * one token can be handed to a whole group of jobs and canceled at once.
+ * Jobs that have already started are not interrupted, but their work can
+ * check the token itself.
+ */
+class CancellationToken {
+ public:
+  /**
+   * Creates a new token that is not canceled.
+   */
+  CancellationToken();
+
+  void Cancel();
+
+  bool IsCanceled() const;
+
+ private:
+  friend class JobSystem;
+
+  std::shared_ptr<std::atomic<bool>> is_canceled_;
+};
+
+/**
+ * The shared state of a submitted job. Only the JobSystem touches it
+ * directly; everyone else goes through a JobHandle.
+ */
+struct Job {
+  std::function<void()> work;
+  JobPriority priority;
+
+  // The flag of the job's CancellationToken, or null if it has none
+  std::shared_ptr<std::atomic<bool>> is_canceled;
+
+  // The number of unfinished jobs this one continues from
+  std::atomic<size_t> dependencies;
+
+  std::mutex mutex;
+  std::condition_variable finished;
+  bool is_finished;
+  bool was_canceled;
+  std::exception_ptr error;
+  std::vector<std::shared_ptr<Job>> continuations;
+};
+
+/**
+ * Refers to a submitted job so that it can be waited on or continued.
+ */
+class JobHandle {
+ public:
+  /**
+   * Creates a handle that refers to no job.
+   */
+  JobHandle();
+
+  bool IsValid() const;
+
+  /**
+   * Returns whether the job has either run or been skipped because it was
+   * canceled. Handles that refer to no job are always finished.
+   * @return Whether the job is finished
+   */
+  bool IsFinished() const;
+
+  /**
+   * Returns whether the job was skipped because its token was canceled
+   * before it started.
+   * @return Whether the job was canceled
+   */
+  bool WasCanceled() const;
+
+ private:
+  friend class JobSystem;
+
+  std::shared_ptr<Job> job_;
+
+  explicit JobHandle(std::shared_ptr<Job> job);
+};
+
+/**
+ * Takes in a number of worker threads for a work-stealing job system. Each
+ * worker keeps its own deque of jobs per priority; jobs spawned from a
+ * worker go onto that worker's deques and idle workers steal from the
+ * others. Jobs can be canceled through tokens and can have continuations
+ * that run once the jobs they depend on have finished.
+ */
+class JobSystem {
+ public:
+  /**
+   * Loads in the number of worker threads and starts them. With no workers,
+   * jobs only run when a thread waits on them.
+   * @param number_of_workers The number of worker threads
+   */
+  explicit JobSystem(size_t number_of_workers);
+
+  /**
+   * Stops and joins the workers. Jobs that have not started yet are
+   * discarded.
+   */
+  ~JobSystem();
+
+  JobSystem(const JobSystem&) = delete;
+
+  JobSystem &operator=(const JobSystem&) = delete;
+
+  /**
+   * Returns one worker per hardware thread, leaving one for the thread that
+   * owns the JobSystem (e.g. the app's main thread), but at least one.
+   * @return The default number of workers
+   */
+  static size_t GetDefaultNumberOfWorkers();
+
+  size_t GetNumberOfWorkers() const;
+
+  /**
+   * Returns how many jobs have been taken from another worker's deque.
+   * @return The number of steals so far
+   */
+  size_t GetNumberOfSteals() const;
+
+  /**
+   * Queues a job to run as soon as a worker is free.
+   * @param work The function the job runs
+   * @param priority The priority of the job
+   * @return The handle of the queued job
+   */
+  JobHandle Submit(const std::function<void()>& work,
+                   JobPriority priority = JobPriority::kNormal);
+
+  /**
+   * Queues a job that is skipped if the given token is canceled before the
+   * job starts.
+   * @param work The function the job runs
+   * @param priority The priority of the job
+   * @param token The token that can cancel the job
+   * @return The handle of the queued job
+   */
+  JobHandle Submit(const std::function<void()>& work, JobPriority priority,
+                   const CancellationToken& token);
+
+  /**
+   * Queues a job to run once the given job has finished, whether it ran,
+   * threw, or was canceled.
+   * @param predecessor The job to continue from
+   * @param work The function the continuation runs
+   * @param priority The priority of the continuation
+   * @return The handle of the continuation
+   */
+  JobHandle Then(const JobHandle& predecessor,
+                 const std::function<void()>& work,
+                 JobPriority priority = JobPriority::kNormal);
+
+  /**
+   * Queues a job to run once all of the given jobs have finished. The
+   * continuation is skipped if the given token is canceled before it starts.
+   * @param predecessors The jobs to continue from
+   * @param work The function the continuation runs
+   * @param priority The priority of the continuation
+   * @param token The token that can cancel the continuation
+   * @return The handle of the continuation
+   */
+  JobHandle Then(const std::vector<JobHandle>& predecessors,
+                 const std::function<void()>& work,
+                 JobPriority priority = JobPriority::kNormal,
+                 const CancellationToken& token = CancellationToken());
+
+  /**
+   * Blocks until the given job has finished, running queued jobs on the
+   * calling thread in the meantime. Rethrows anything the job's work threw.
+   * @param handle The job to wait on
+   */
+  void Wait(const JobHandle& handle);
+
+ private:
+  static const size_t kNumberOfPriorities = 3;
+
+  /**
+   * The deques and statistics of one worker, kept in separate allocations
+   * so that workers do not share cache lines.
+   */
+  struct Worker {
+    WorkStealingDeque<std::shared_ptr<Job>> queues[kNumberOfPriorities];
+    std::atomic<size_t> steals;
+    std::thread thread;
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // Jobs that were submitted from threads other than the workers
+  WorkStealingDeque<std::shared_ptr<Job>> injected_[kNumberOfPriorities];
+
+  std::atomic<size_t> number_of_queued_;
+  std::atomic<size_t> number_of_sleeping_;
+  std::atomic<bool> is_stopping_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_up_;
+
+  /**
+   * Creates a job that has not been queued yet.
+   */
+  std::shared_ptr<Job> CreateJob(
+      const std::function<void()>& work, JobPriority priority,
+      const std::shared_ptr<std::atomic<bool>>& is_canceled) const;
+
+  /**
+   * Queues a job whose dependencies have all finished, on the current
+   * worker's deque if called from a worker.
+   */
+  void Schedule(const std::shared_ptr<Job>& job);
+
+  /**
+   * Finds the next job to run from the given worker's point of view: its own
+   * deques first, then the injected jobs, then the other workers' deques,
+   * one priority level at a time.
+   * @param worker The index of the worker, or the number of workers for
+   *     threads outside the JobSystem
+   * @param job Set to the job found
+   * @return Whether a job was found
+   */
+  bool FindJob(size_t worker, std::shared_ptr<Job>& job);
+
+  /**
+   * Runs a job (or skips it if canceled), then schedules the continuations
+   * that no longer depend on anything.
+   */
+  void Execute(const std::shared_ptr<Job>& job);
+
+  void RunWorker(size_t worker);
+};
+
+}   // namespace adventure
@@ -0,0 +1,97 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+
+namespace adventure {
+
+/**
+ * Holds the queued items of a single worker thread. The owning worker pushes
+ * and pops at the back so it keeps working on what it spawned most recently
+ * (which is still warm in its cache), while other workers steal from the
+ * front, taking the oldest and usually largest pieces of work.
+ */
+template <typename T>
+class WorkStealingDeque {
+ public:
+  WorkStealingDeque() = default;
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+
+  WorkStealingDeque &operator=(const WorkStealingDeque&) = delete;
+
+  /**
+   * Adds an item at the owner's end.
+   * @param item The item to add
+   */
+  void Push(const T& item);
+
+  /**
+   * Removes the most recently pushed item. Only the owning worker should
+   * call this.
+   * @param item Set to the removed item
+   * @return Whether there was an item to remove
+   */
+  bool Pop(T& item);
+
+  /**
+   * Removes the oldest item on behalf of another worker.
+   * @param item Set to the removed item
+   * @return Whether there was an item to remove
+   */
+  bool Steal(T& item);
+
+  bool empty() const;
+
+  size_t size() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::deque<T> items_;
+};
+
+template <typename T>
+void WorkStealingDeque<T>::Push(const T& item) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  items_.push_back(item);
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::Pop(T& item) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (items_.empty()) {
+    return false;
+  }
+
+  item = items_.back();
+  items_.pop_back();
+  return true;
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::Steal(T& item) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (items_.empty()) {
+    return false;
+  }
+
+  item = items_.front();
+  items_.pop_front();
+  return true;
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::empty() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return items_.empty();
+}
+
+template <typename T>
+size_t WorkStealingDeque<T>::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return items_.size();
+}
+
+}   // namespace adventure
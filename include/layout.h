@@ -0,0 +1,144 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "cinder/gl/gl.h"
+
+#include "text_renderer.h"
+
+#include <vector>
+
+namespace adventure {
+
+/**
+ * The solid rectangles of the interface that appear once each.
+ */
+enum class LayoutPanel {
+  kActionPanel,
+  kTopBorderBar,
+  kBottomBorderBar,
+  kLeftSubPanel,
+  kRightSubPanel,
+  kMap,
+  kLocationBar,
+  kStatusBar,
+  kNumberOfPanels
+};
+
+/**
+ * The lines of text of the interface that appear once each.
+ */
+enum class LayoutText {
+  kGameOver,
+  kMessage,
+  kLocation,
+  kHealth,
+  kKeys,
+  kWeapons,
+  kSubInformation,
+  kSubPage,
+  kNumberOfTexts
+};
+
+/**
+ * Where a line of text is drawn, how big it is, and how it is aligned to
+ * its position.
+ */
+struct TextAnchor {
+  glm::vec2 position;
+  float size;
+  TextAlignment alignment;
+};
+
+/**
+ * Takes in a window width and window height for a Layout which holds where
+ * every panel, button, and line of text of the interface goes. Every
+ * position is worked out once, from a table of fractions of the window's
+ * size, when the Layout is made; drawing a frame only looks them up. A
+ * window that changes size gets a new Layout.
+ */
+class Layout {
+ public:
+  static const size_t kNumberOfActionButtons = 4;
+
+  // The sub-buttons fill a two by two grid, the most that fits in their
+  // panel, and longer lists are shown a page at a time
+  static const size_t kNumberOfSubActionButtons = 4;
+
+  /**
+   * Internally loads a Layout for an empty window.
+   */
+  Layout();
+
+  /**
+   * Loads in a window width and window height and works out every position
+   * of the interface in that window.
+   * @param window_width The width of the app window
+   * @param window_height The height of the app window
+   */
+  Layout(float window_width, float window_height);
+
+  const glm::vec2 &GetBounds() const;
+
+  const ci::Rectf &GetPanel(LayoutPanel panel) const;
+
+  const TextAnchor &GetText(LayoutText text) const;
+
+  /**
+   * Returns where a main action button is. Throws an error if there is no
+   * such button.
+   * @param button The index of the button
+   * @return The button's rectangle
+   */
+  const ci::Rectf &GetActionButton(size_t button) const;
+
+  /**
+   * Returns where the label of a main action button is drawn. Throws an
+   * error if there is no such button.
+   * @param button The index of the button
+   * @return The label's anchor
+   */
+  const TextAnchor &GetActionButtonLabel(size_t button) const;
+
+  /**
+   * Returns where an action sub-button is. Throws an error if there is no
+   * such button.
+   * @param button The index of the button
+   * @return The button's rectangle
+   */
+  const ci::Rectf &GetSubActionButton(size_t button) const;
+
+  /**
+   * Returns where the label of an action sub-button is drawn. Throws an
+   * error if there is no such button.
+   * @param button The index of the button
+   * @return The label's anchor
+   */
+  const TextAnchor &GetSubActionButtonLabel(size_t button) const;
+
+  /**
+   * Returns where a line of the sub-panel information is drawn. The lines
+   * are centered around the information anchor as a block, so where each
+   * line goes depends on how many there are.
+   * @param line The index of the line
+   * @param number_of_lines The number of lines drawn
+   * @return The line's anchor
+   */
+  TextAnchor GetSubInformationLine(size_t line,
+                                   size_t number_of_lines) const;
+
+ private:
+  glm::vec2 bounds_;
+
+  std::vector<ci::Rectf> panels_;
+  std::vector<TextAnchor> texts_;
+
+  std::vector<ci::Rectf> action_buttons_;
+  std::vector<TextAnchor> action_button_labels_;
+  std::vector<ci::Rectf> sub_action_buttons_;
+  std::vector<TextAnchor> sub_action_button_labels_;
+
+  float sub_information_line_height_;
+};
+
+}   // namespace adventure
@@ -0,0 +1,121 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "map/dungeon.h"
+#include "map/room.h"
+
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Takes in a shared, immutable Dungeon for a dungeon map that only copies a
+ * Room the first time it is modified. Unmodified Rooms are read straight
+ * from the Dungeon, so many maps can share one Dungeon while each keeps only
+ * the Rooms it has changed. Reads mirror a const std::vector of Rooms.
+ */
+class CopyOnWriteMap {
+ public:
+  /**
+   * Iterates over the Rooms of a CopyOnWriteMap in order, yielding each
+   * Room's modified copy if it has one.
+   */
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Room;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Room*;
+    using reference = const Room&;
+
+    const_iterator(const CopyOnWriteMap* map, size_t index);
+
+    const Room &operator*() const;
+
+    const Room *operator->() const;
+
+    const_iterator &operator++();
+
+    bool operator==(const const_iterator& other) const;
+
+    bool operator!=(const const_iterator& other) const;
+
+   private:
+    const CopyOnWriteMap* map_;
+    size_t index_;
+  };
+
+  /**
+   * Loads in the shared Dungeon the map reads from. Throws an error if the
+   * Dungeon is missing. No Rooms are copied.
+   * @param dungeon The shared Dungeon being read from
+   */
+  explicit CopyOnWriteMap(std::shared_ptr<const Dungeon> dungeon);
+
+  const Dungeon &GetDungeon() const;
+
+  /**
+   * Returns the shared Dungeon itself, so that it can be read elsewhere for
+   * as long as it is needed.
+   * @return The shared Dungeon
+   */
+  const std::shared_ptr<const Dungeon> &GetSharedDungeon() const;
+
+  size_t GetNumberOfModifiedRooms() const;
+
+  /**
+   * Returns whether the Room at the given index has been copied out of the
+   * Dungeon.
+   * @param index The position of the Room
+   * @return Whether the Room has a modified copy
+   */
+  bool IsModified(size_t index) const;
+
+  /**
+   * Returns the indices of the Rooms that have been copied out of the
+   * Dungeon, in increasing order.
+   * @return The indices of the modified Rooms
+   */
+  std::vector<size_t> GetModifiedRoomIndices() const;
+
+  size_t size() const;
+
+  bool empty() const;
+
+  const Room &at(size_t index) const;
+
+  const Room &operator[](size_t index) const;
+
+  const Room &front() const;
+
+  const Room &back() const;
+
+  const_iterator begin() const;
+
+  const_iterator end() const;
+
+  /**
+   * Returns a modifiable Room at the given index, copying it out of the
+   * Dungeon the first time. References stay valid as other Rooms are
+   * modified. Throws an error if the index is not in the map.
+   * @param index The position of the Room being modified
+   * @return The modifiable Room
+   */
+  Room &Modify(size_t index);
+
+  /**
+   * Drops every modified Room, so the map reads straight from the Dungeon
+   * again.
+   */
+  void Reset();
+
+ private:
+  std::shared_ptr<const Dungeon> dungeon_;
+  std::unordered_map<size_t, Room> modified_rooms_;
+};
+
+}   // namespace adventure
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <string>
+#include <utility>
 
 namespace adventure {
 
@@ -16,13 +17,13 @@ class Door {
      * Loads a direction, room that it leads into, and its lock status as two
      * strings and a boolean, respectively. Throws an error if the direction
      * and/or adjacent room strings are empty and/or if the adjacent room string
-     * is greater than five characters.
+     * is greater than five characters. The strings are taken by value so
+     * that a caller done with them can move them in.
      * @param direction The direction of the Door with respect to its Room
      * @param adjacent_room The Room the Door leads into
      * @param is_locked Whether the given Door is locked or not
      */
-  Door(const std::string& direction, const std::string& adjacent_room,
-       bool is_locked);
+  Door(std::string direction, std::string adjacent_room, bool is_locked);
 
   const std::string &GetDirection() const;
 
@@ -3,16 +3,25 @@
 #pragma once
 
 #include "map/room.h"
+#include "memory/arena.h"
 
 #include <vector>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
 
 namespace adventure {
 
 /**
  * Initializes a Dungeon which holds a dungeon map that can be filled using an
- * operator overload.
+ * operator overload. Once loaded, a Dungeon is never modified, so it can be
+ * shared between many Engines and threads as a read-only template.
+ * Everything a loaded Dungeon holds is placed in an arena it owns, so a load
+ * is a few large allocations and unloading frees them all at once.
  */
 class Dungeon {
  public:
@@ -21,8 +30,41 @@ class Dungeon {
    */
   Dungeon();
 
+  /**
+   * Copies the map of another Dungeon onto the heap, leaving this Dungeon's
+   * arena empty.
+   * @param other The Dungeon being copied
+   */
+  Dungeon(const Dungeon& other);
+
+  Dungeon(Dungeon&& other) = default;
+
+  Dungeon &operator=(const Dungeon&) = delete;
+
   const std::vector<Room> &GetMap() const;
 
+  /**
+   * Returns the arena the loaded Rooms are placed in.
+   * @return The Dungeon's arena
+   */
+  const Arena &GetArena() const;
+
+  /**
+   * Looks up the index of a Room in the map based on its nickname in
+   * constant time. Throws an error if the name string is empty or the Room
+   * is not in the map.
+   * @param name The nickname of the Room being searched for
+   * @return The index of the Room being searched for
+   */
+  size_t FindRoomIndex(const std::string& name) const;
+
+  /**
+   * Checks whether a Room with a nickname is in the map, in constant time.
+   * @param name The nickname of the Room
+   * @return Whether the Room is in the map
+   */
+  bool HasRoom(const std::string& name) const;
+
   /**
    * Loads an in-stream and parses through a dungeon file, loading in all of
    * its information into a vector of Rooms using various helper methods.
@@ -34,16 +76,29 @@ class Dungeon {
   friend std::istream &operator>>(std::istream& is, Dungeon& dungeon);
 
  private:
+  using RoomIndices = std::unordered_map<
+      std::string, size_t, std::hash<std::string>, std::equal_to<std::string>,
+      ArenaAllocator<std::pair<const std::string, size_t>>>;
+
+  // Declared first so that it is destroyed after everything placed in it
+  std::unique_ptr<Arena> arena_;
+
   std::vector<Room> map_;
+  RoomIndices room_indices_;
 
   /**
    * Generates a Room by parsing through a following portion of the dungeon
-   * file's text lines.
+   * file's text lines and constructs it in place at the back of the map,
+   * with its lists in the arena.
    * @param is The in-stream that holds the file
    * @param line The current line being examined by the operator
-   * @return The generated Room
+   * @param doors Scratch space for the Room's Doors, reused between Rooms
+   * @param enemies Scratch space for the Room's Enemies
+   * @param weapons Scratch space for the Room's Weapons
    */
-  static Room GenerateRoom(std::istream& is, std::string& line);
+  void GenerateRoom(std::istream& is, std::string& line,
+                    std::vector<Door>& doors, std::vector<Enemy>& enemies,
+                    std::vector<Weapon>& weapons);
 
   /**
    * Generates a Door by parsing through a following portion of the dungeon
@@ -0,0 +1,125 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "entities/enemy.h"
+#include "items/weapon.h"
+#include "map/dungeon.h"
+#include "persistence/mapped_file.h"
+
+#include <cstdint>
+#include <string>
+
+namespace adventure {
+
+/**
+ * Takes in the path of a read-only image of a Dungeon, built once with
+ * Write, and maps it into memory so it can be queried without being parsed
+ * or copied. Everything in the image refers to everything else by offset
+ * rather than by pointer, and Doors refer to their adjacent Rooms by index,
+ * so the image reads the same wherever it is mapped. Every process that maps
+ * the same file (e.g. one under /dev/shm) therefore shares one copy of its
+ * pages.
+ */
+class DungeonImage {
+ public:
+  /**
+   * Returned as the adjacent Room index of a Door leading out of the map.
+   */
+  static const size_t kNoRoom = (size_t)-1;
+
+  /**
+   * Builds the image of a Dungeon and atomically replaces the file at the
+   * given path with it, so processes mapping the old image are not
+   * disturbed. Throws an error if the Dungeon has no Rooms, or if the file
+   * cannot be written.
+   * @param dungeon The Dungeon being imaged
+   * @param path The path of the image file
+   */
+  static void Write(const Dungeon& dungeon, const std::string& path);
+
+  /**
+   * Loads in the path of an image file and maps it read-only. The whole
+   * image is checked once here, so queries never read outside of it. Throws
+   * an error if the file cannot be mapped or is not a valid image.
+   * @param path The path of the image file
+   */
+  explicit DungeonImage(const std::string& path);
+
+  DungeonImage(const DungeonImage&) = delete;
+
+  DungeonImage &operator=(const DungeonImage&) = delete;
+
+  size_t GetSize() const;
+
+  size_t GetNumberOfRooms() const;
+
+  /**
+   * Looks up the index of a Room based on its nickname, using a hash table
+   * stored in the image. Throws an error if the name string is empty or the
+   * Room is not in the image.
+   * @param name The nickname of the Room being searched for
+   * @return The index of the Room being searched for
+   */
+  size_t FindRoomIndex(const std::string& name) const;
+
+  std::string GetRoomName(size_t room) const;
+
+  std::string GetRoomNickname(size_t room) const;
+
+  size_t GetNumberOfKeys(size_t room) const;
+
+  size_t GetNumberOfDoors(size_t room) const;
+
+  /**
+   * Looks up the index of a Door of a Room based on its direction. Throws an
+   * error if the Room has no Door in that direction.
+   * @param room The index of the Room
+   * @param direction The direction of the Door being searched for
+   * @return The index of the Door within the Room
+   */
+  size_t FindDoorIndex(size_t room, const std::string& direction) const;
+
+  std::string GetDoorDirection(size_t room, size_t door) const;
+
+  /**
+   * Returns the index of the Room a Door leads to, without looking it up
+   * by name.
+   * @param room The index of the Room the Door is in
+   * @param door The index of the Door within the Room
+   * @return The index of the adjacent Room, or kNoRoom if it is not in the
+   * image
+   */
+  size_t GetAdjacentRoomIndex(size_t room, size_t door) const;
+
+  bool IsDoorLocked(size_t room, size_t door) const;
+
+  size_t GetNumberOfEnemies(size_t room) const;
+
+  Enemy GetEnemy(size_t room, size_t enemy) const;
+
+  size_t GetNumberOfWeapons(size_t room) const;
+
+  Weapon GetWeapon(size_t room, size_t weapon) const;
+
+ private:
+  MappedFile file_;
+  const char* data_;
+  size_t size_;
+
+  /**
+   * Checks that every offset in the image stays inside of it. Throws an
+   * error if one does not.
+   */
+  void Validate() const;
+
+  /**
+   * Returns where the record of a Room starts. Throws an error if the index
+   * is out of range.
+   * @param room The index of the Room
+   * @return The offset of the Room's record
+   */
+  size_t RetrieveRoomOffset(size_t room) const;
+};
+
+}   // namespace adventure
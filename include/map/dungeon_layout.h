@@ -0,0 +1,119 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "map/dungeon.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Where a Room sits on the grid of a DungeonLayout, counted in Rooms from
+ * the first Room, with y growing downwards.
+ */
+struct GridPosition {
+  int32_t x;
+  int32_t y;
+};
+
+/**
+ * Takes in a Dungeon for a DungeonLayout which places every Room on a grid
+ * by following its Doors: a Door to the LEFT leads one cell left, a Door UP
+ * one cell up, and so on. The Rooms reachable from the first Room are
+ * placed around it, and every other group of connected Rooms is placed to
+ * the right of the groups before it. Doors that contradict each other can
+ * place two Rooms in one cell, which the layout allows.
+ *
+ * The Rooms are also indexed by square buckets of the grid, so the Rooms
+ * inside a small window of the grid are found in time proportional to the
+ * Rooms near the window rather than to the whole Dungeon.
+ */
+class DungeonLayout {
+ public:
+  // The side of a bucket of the index, in cells
+  static const int32_t kBucketSize = 16;
+
+  /**
+   * Internally loads a layout with no Rooms.
+   */
+  DungeonLayout();
+
+  /**
+   * Loads in a Dungeon and places all of its Rooms, in time proportional to
+   * its number of Rooms and Doors.
+   * @param dungeon The Dungeon being laid out
+   */
+  explicit DungeonLayout(const Dungeon& dungeon);
+
+  size_t size() const;
+
+  /**
+   * Returns where a Room is on the grid. Throws an error if the index is
+   * out of range.
+   * @param room The index of the Room in the Dungeon
+   * @return The Room's cell
+   */
+  const GridPosition &GetPosition(size_t room) const;
+
+  /**
+   * Returns the top left corner of the cells any Room is in.
+   * @return The smallest x and y of any Room
+   */
+  const GridPosition &GetMinimum() const;
+
+  /**
+   * Returns the bottom right corner of the cells any Room is in.
+   * @return The largest x and y of any Room
+   */
+  const GridPosition &GetMaximum() const;
+
+  /**
+   * Finds every Room inside a window of the grid, edges included.
+   * @param minimum The top left cell of the window
+   * @param maximum The bottom right cell of the window
+   * @param rooms Filled with the indices of the Rooms, in no particular
+   * order. It is cleared first, so reusing it keeps its storage
+   */
+  void FindRooms(const GridPosition& minimum, const GridPosition& maximum,
+                 std::vector<size_t>& rooms) const;
+
+  /**
+   * Returns the offset a Door's direction leads along the grid.
+   * @param direction The direction of the Door
+   * @param offset Set to the offset, if the direction is one of LEFT,
+   * RIGHT, UP, and DOWN
+   * @return Whether the direction has an offset
+   */
+  static bool FindOffset(const std::string& direction, GridPosition& offset);
+
+ private:
+  std::vector<GridPosition> positions_;
+  GridPosition minimum_;
+  GridPosition maximum_;
+
+  // Every Room sorted by bucket, and the run of them each bucket holds
+  std::vector<uint32_t> bucket_rooms_;
+  std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>> buckets_;
+
+  /**
+   * Places every Room connected to a starting Room, breadth first.
+   */
+  void PlaceGroup(const Dungeon& dungeon, size_t start,
+                  const GridPosition& position, std::vector<bool>& is_placed);
+
+  void IndexBuckets();
+
+  /**
+   * Returns the bucket a coordinate falls in, rounding towards negative
+   * infinity so that bucket 0 holds the coordinates 0 to kBucketSize - 1.
+   */
+  static int32_t FindBucket(int32_t coordinate);
+
+  static uint64_t FindBucketKey(int32_t bucket_x, int32_t bucket_y);
+};
+
+}   // namespace adventure
@@ -5,8 +5,13 @@
 #include "door.h"
 #include "entities/enemy.h"
 #include "items/weapon.h"
+#include "memory/arena.h"
+#include "memory/slot_map.h"
 
+#include <functional>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace adventure {
@@ -30,19 +35,35 @@ class Room {
      * @param weapons The Room's vector of Weapons
      * @param number_of_keys The Room's number of keys
      */
-  Room(const std::string& name, const std::string& nickname,
-       const std::vector<Door>& doors, const std::vector<Enemy>& enemies,
-       const std::vector<Weapon>& weapons, size_t number_of_keys);
+  Room(std::string name, std::string nickname, const std::vector<Door>& doors,
+       const std::vector<Enemy>& enemies, const std::vector<Weapon>& weapons,
+       size_t number_of_keys);
+
+  /**
+   * Loads a Room the same way, but places its Doors, Enemies, and Weapons in
+   * an arena. Copies of the Room keep theirs on the heap. The names are
+   * taken by value so that a loader done with them can move them in.
+   * @param name The Room's name
+   * @param nickname The Room's shortened name
+   * @param doors The Room's vector of Doors
+   * @param enemies The Room's vector of Enemies
+   * @param weapons The Room's vector of Weapons
+   * @param number_of_keys The Room's number of keys
+   * @param arena The arena the Room's lists are placed in
+   */
+  Room(std::string name, std::string nickname, const std::vector<Door>& doors,
+       const std::vector<Enemy>& enemies, const std::vector<Weapon>& weapons,
+       size_t number_of_keys, Arena* arena);
 
   const std::string &GetName() const;
 
   const std::string &GetNickname() const;
 
-  const std::vector<Door> &GetDoors() const;
+  const ArenaVector<Door> &GetDoors() const;
 
-  const std::vector<Enemy> &GetEnemies() const;
+  const ArenaVector<Enemy> &GetEnemies() const;
 
-  const std::vector<Weapon> &GetWeapons() const;
+  const ArenaVector<Weapon> &GetWeapons() const;
 
   size_t GetNumberOfKeys() const;
 
@@ -61,24 +82,81 @@ class Room {
    * Adds the specified Weapon to the back of the vector of Weapons. Throws an
    * error if the Weapon is already in the vector.
    * @param weapon The specified Weapon to add to the vector
+   * @return The handle of the added Weapon
    */
-  void AddWeapon(const Weapon& weapon);
+  SlotHandle AddWeapon(const Weapon& weapon);
 
   /**
-   * Removes the specified Weapon by iterating through the vector until it
-   * finds the specified Weapon. Throws an error if the vector is empty or
-   * the Weapon is not in the vector.
-   * @param weapon The specified Weapon to remove from the vector
+   * Removes the Weapon a handle names in constant time, moving the last
+   * Weapon into its place. Throws an error if the handle is stale.
+   * @param handle The handle of the Weapon to remove
    */
-  void RemoveWeapon(const Weapon& weapon);
+  void RemoveWeapon(SlotHandle handle);
 
   /**
-   * Removes the specified Enemy by iterating through the vector until it
-   * finds the specified Enemy. Throws an error if the vector is empty or
-   * the Enemy is not in the vector.
-   * @param enemy The specified Enemy to remove from the vector
+   * Removes the Weapon at the given index of the vector of Weapons, moving
+   * the last Weapon into its place. Throws an error if the index is not in
+   * the vector.
+   * @param index The position of the Weapon to remove
+   */
+  void RemoveWeaponAt(size_t index);
+
+  /**
+   * Removes the Enemy a handle names in constant time, moving the last Enemy
+   * into its place. Throws an error if the handle is stale.
+   * @param handle The handle of the Enemy to remove
+   */
+  void RemoveEnemy(SlotHandle handle);
+
+  /**
+   * Makes room for a number of Weapons up front, so that adding Weapons up
+   * to that number does not allocate.
+   * @param capacity The number of Weapons
+   */
+  void ReserveWeapons(size_t capacity);
+
+  /**
+   * Places the specified Weapon at the given index of the vector of Weapons,
+   * moving the Weapon there to the back, which undoes removing a Weapon
+   * from that index. Throws an error if the index is past the end of the
+   * vector.
+   * @param index The position the Weapon is inserted at
+   * @param weapon The specified Weapon to insert into the vector
+   */
+  void InsertWeapon(size_t index, const Weapon& weapon);
+
+  /**
+   * Places the specified Enemy at the given index of the vector of Enemies,
+   * moving the Enemy there to the back, which undoes removing an Enemy from
+   * that index. Throws an error if the index is past the end of the vector.
+   * @param index The position the Enemy is inserted at
+   * @param enemy The specified Enemy to insert into the vector
+   */
+  void InsertEnemy(size_t index, const Enemy& enemy);
+
+  /**
+   * Removes the Enemy at the given index of the vector of Enemies, moving
+   * the last Enemy into its place. Throws an error if the index is not in
+   * the vector.
+   * @param index The position of the Enemy to remove
    */
-  void RemoveEnemy(const Enemy& enemy);
+  void RemoveEnemyAt(size_t index);
+
+  /**
+   * Returns the handle of the first Weapon with the given nickname. Throws
+   * an error if the name string is empty or the Weapon is not in the vector.
+   * @param name The nickname of the Weapon being searched for
+   * @return The handle of the Weapon being searched for
+   */
+  SlotHandle FindWeapon(const std::string& name) const;
+
+  /**
+   * Returns the position of the Weapon a handle names in the vector of
+   * Weapons. Throws an error if the handle is stale.
+   * @param handle The handle of the Weapon
+   * @return The index of the Weapon
+   */
+  size_t GetWeaponIndex(SlotHandle handle) const;
 
   /**
    * Iterates through the vector of Weapons and returns the specified Weapon
@@ -89,6 +167,14 @@ class Room {
    */
   Weapon &RetrieveWeapon(const std::string& name);
 
+  /**
+   * Returns the Weapon a handle names. Throws an error if the handle is
+   * stale.
+   * @param handle The handle of the Weapon being searched for
+   * @return The Weapon being searched for
+   */
+  Weapon &RetrieveWeapon(SlotHandle handle);
+
   /**
    * Iterates through the vector of Doors and returns the specified Door
    * based on a direction string. Throws an error if the Door is not in the
@@ -98,6 +184,35 @@ class Room {
    */
   Door &RetrieveDoor(const std::string& direction);
 
+  const Door &RetrieveDoor(const std::string& direction) const;
+
+  /**
+   * Returns the handle of the first Enemy with the given nickname. Rooms
+   * can hold several Enemies of the same name, so the handle is what tells
+   * them apart afterwards. Throws an error if the name string is empty or
+   * the Enemy is not in the vector.
+   * @param name The nickname of the Enemy being searched for
+   * @return The handle of the Enemy being searched for
+   */
+  SlotHandle FindEnemy(const std::string& name) const;
+
+  /**
+   * Returns how many Enemies in the Room are of the given kind, which the
+   * Room keeps count of as Enemies come and go. Enemies are compared by the
+   * address of their archetype, not by their names.
+   * @param archetype The interned archetype of the kind
+   * @return The number of Enemies of that kind
+   */
+  size_t CountEnemies(const EnemyArchetype& archetype) const;
+
+  /**
+   * Returns the position of the Enemy a handle names in the vector of
+   * Enemies. Throws an error if the handle is stale.
+   * @param handle The handle of the Enemy
+   * @return The index of the Enemy
+   */
+  size_t GetEnemyIndex(SlotHandle handle) const;
+
   /**
    * Iterates through the vector of Enemies and returns the specified Enemy
    * based on a name string. Throws an error if the name string is empty or
@@ -107,13 +222,46 @@ class Room {
    */
   Enemy &RetrieveEnemy(const std::string& name);
 
+  /**
+   * Returns the Enemy a handle names. Throws an error if the handle is
+   * stale.
+   * @param handle The handle of the Enemy being searched for
+   * @return The Enemy being searched for
+   */
+  Enemy &RetrieveEnemy(SlotHandle handle);
+
+  /**
+   * Returns the Enemy at the given index of the vector of Enemies. Throws an
+   * error if the index is not in the vector.
+   * @param index The position of the Enemy being searched for
+   * @return The Enemy being searched for
+   */
+  Enemy &RetrieveEnemyAt(size_t index);
+
+  /**
+   * Returns the Door at the given index of the vector of Doors. Throws an
+   * error if the index is not in the vector.
+   * @param index The position of the Door being searched for
+   * @return The Door being searched for
+   */
+  Door &RetrieveDoorAt(size_t index);
+
  private:
+  using EnemyCounts = std::unordered_map<
+      const EnemyArchetype*, size_t, std::hash<const EnemyArchetype*>,
+      std::equal_to<const EnemyArchetype*>,
+      ArenaAllocator<std::pair<const EnemyArchetype* const, size_t>>>;
+
   std::string name_;
   std::string nickname_;
-  std::vector<Door> doors_;
-  std::vector<Enemy> enemies_;
-  std::vector<Weapon> weapons_;
+  ArenaVector<Door> doors_;
+  SlotMap<Enemy> enemies_;
+  SlotMap<Weapon> weapons_;
   size_t number_of_keys_;
+
+  // The number of Enemies of each kind. Kinds that leave the Room keep a
+  // count of zero, so an Enemy put back by an undo does not allocate
+  EnemyCounts enemy_counts_;
 };
 
 }   // namespace adventure
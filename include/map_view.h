@@ -0,0 +1,130 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "cinder/gl/Texture.h"
+#include "cinder/gl/gl.h"
+
+#include "map/dungeon.h"
+#include "map/dungeon_layout.h"
+
+#include "quad_batch.h"
+#include "text_renderer.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Draws the Dungeon around the player: the Rooms within a few cells of the
+ * current Room with the Doors between them, locked ones in red, and a
+ * minimap of the whole Dungeon in the corner. Only the Rooms inside the view
+ * are looked at each time the player moves, so the cost of drawing does not
+ * grow with the Dungeon.
+ *
+ * The minimap is baked once into a texture with at most one pixel per Room,
+ * shrinking the Dungeon further when it is too wide, and only the pixels of
+ * the Rooms the player leaves and enters are uploaded again.
+ */
+class MapView {
+ public:
+  // The number of cells the view shows across and down, centered on the
+  // current Room
+  static const int32_t kVisibleColumns = 9;
+  static const int32_t kVisibleRows = 7;
+
+  // The largest side of the minimap texture, in pixels
+  static const int32_t kMaxMinimapSize = 256;
+
+  /**
+   * Internally loads a MapView with no Dungeon, which draws nothing.
+   */
+  MapView();
+
+  /**
+   * Lays out a Dungeon to draw, with no Room visited yet. Every Door starts
+   * out locked or unlocked as the Dungeon has it.
+   * @param dungeon The Dungeon being drawn
+   */
+  void SetDungeon(const std::shared_ptr<const Dungeon>& dungeon);
+
+  /**
+   * Moves the view to the player's Room, marking it visited. Does nothing
+   * if the Room is not in the Dungeon.
+   * @param location The nickname of the Room the player is in
+   * @param locked_doors Bit i is set when Door i of the Room is locked
+   */
+  void Update(const std::string& location, uint64_t locked_doors);
+
+  /**
+   * Draws the view and the minimap inside a rectangle, building the Rooms'
+   * rectangles again only if the player, a Door, or the rectangle changed.
+   * @param bounds Where the map is drawn
+   * @param text_renderer Draws the nicknames of the visited Rooms
+   */
+  void Draw(const ci::Rectf& bounds, TextRenderer& text_renderer);
+
+  /**
+   * Returns the number of Rooms inside the view as of the last draw.
+   */
+  size_t GetNumberOfVisibleRooms() const;
+
+ private:
+  std::shared_ptr<const Dungeon> dungeon_;
+  DungeonLayout layout_;
+
+  std::vector<bool> is_visited_;
+  // The locked Doors of each Room as a bit mask, as last seen
+  std::vector<uint64_t> locked_doors_;
+  size_t current_room_;
+  bool has_current_room_;
+
+  // The Rooms inside the view, found again only when the view changes
+  std::vector<size_t> visible_rooms_;
+  QuadBatch quads_;
+  ci::Rectf bounds_;
+  float cell_size_;
+  glm::vec2 origin_;
+  bool is_dirty_;
+
+  int32_t minimap_width_;
+  int32_t minimap_height_;
+  // The number of cells along each side of a minimap pixel
+  int32_t minimap_scale_;
+  std::vector<uint8_t> minimap_pixels_;
+  // The pixels changed since the texture was last uploaded to
+  std::vector<size_t> changed_pixels_;
+  ci::gl::Texture2dRef minimap_texture_;
+
+  /**
+   * Finds the Rooms inside the view and fills the QuadBatch with them.
+   */
+  void LoadQuads();
+
+  /**
+   * Adds the short bars between a Room and its neighbouring cells, one for
+   * each Door with a direction.
+   */
+  void AddDoors(size_t room, const ci::Rectf& box);
+
+  /**
+   * Draws the minimap in the top right corner of the map, uploading the
+   * pixels that changed first.
+   */
+  void DrawMinimap();
+
+  /**
+   * Returns where a Room's cell is on the window in the current view.
+   */
+  ci::Rectf FindCell(size_t room) const;
+
+  size_t FindMinimapPixel(size_t room) const;
+
+  void SetMinimapPixel(size_t pixel, const ci::ColorA& color);
+
+  bool IsDoorLocked(size_t room, size_t door) const;
+};
+
+}   // namespace adventure
@@ -3,18 +3,39 @@
 #pragma once
 
 #include "entities/player.h"
+#include "map/copy_on_write_map.h"
 #include "map/dungeon.h"
 #include "map/room.h"
+#include "mechanics/journal.h"
+#include "mechanics/random.h"
+#include "statistics/game_statistics.h"
 
+#include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace adventure {
 
+/**
+ * The commands an Engine can execute, in the same order as the action
+ * buttons of the AdventureApp.
+ */
+enum class Command : uint8_t {
+  kFight,
+  kTake,
+  kDrop,
+  kGo,
+  kUndo,
+  kRedo
+};
+
 /**
  * Takes in a Player and a Dungeon for a game Engine, or initializes the
  * Engine based on the default constructor, which provides all the mechanics
- * of an adventure game.
+ * of an adventure game. The Dungeon is shared rather than copied, and only
+ * the Rooms an Engine changes are copied, so each Engine is a lightweight
+ * session over a common dungeon.
  */
 class Engine {
  public:
@@ -22,7 +43,7 @@ class Engine {
   /**
    * Internally loads a Player based on its default constructor and a
    * Dungeon using its operator overloads. This is recommended for use with
-   * the AdventureApp code.
+   * the AdventureApp code. Throws an error if the dungeon file is not found.
    */
   Engine();
 
@@ -34,16 +55,92 @@ class Engine {
    */
   Engine(const Player& player, const Dungeon& dungeon);
 
+  /**
+   * Loads in a Player and takes ownership of a Dungeon, moving it into
+   * shared storage instead of copying its Rooms. Throws an error if the
+   * Dungeon's vector of Rooms is empty.
+   * @param player The Player playing through the game
+   * @param dungeon The Dungeon the Player will be playing through
+   */
+  Engine(const Player& player, Dungeon&& dungeon);
+
+  /**
+   * Loads in a Player and a shared Dungeon to work with the Engine in
+   * constant time, without copying any Rooms. The Dungeon must not be
+   * modified while it is shared. Throws an error if the Dungeon's vector of
+   * Rooms is empty.
+   * @param player The Player playing through the game
+   * @param dungeon The shared Dungeon the Player will be playing through
+   */
+  Engine(const Player& player, std::shared_ptr<const Dungeon> dungeon);
+
   const Player &GetPlayer() const;
 
-  const std::vector<Room> &GetMap() const;
+  const CopyOnWriteMap &GetMap() const;
 
   const std::string &GetMessage() const;
 
+  const Journal &GetJournal() const;
+
+  /**
+   * Returns the state changes made by the most recent call to Execute, in
+   * the order they were made. An undo lists the changes it reverted and a
+   * redo the changes it reapplied, so observers can tell what changed
+   * without comparing whole states.
+   * @return The Deltas of the most recent command
+   */
+  const std::vector<Delta> &GetLastDeltas() const;
+
+  uint64_t GetRandomState() const;
+
+  void SetRandomState(uint64_t state);
+
   void SetQualifier(const std::string& qualifier);
 
   void SetMessage(const std::string& message);
 
+  /**
+   * Copies a message straight into the message's storage, without making a
+   * string out of it first.
+   * @param message The message
+   */
+  void SetMessage(const char* message);
+
+  /**
+   * Returns a number that changes every time something an observer can see
+   * may have changed: a command runs, the message is set to a new text, a
+   * Room is handed out to be changed, or a snapshot is restored. Observers that remember
+   * the revision they last caught up with can skip work while it stays the
+   * same. Nothing is notified when it changes, so observers have to poll.
+   * @return The revision of the game state
+   */
+  uint64_t GetRevision() const;
+
+  /**
+   * Reports the kills, deaths, and wins of this session to shared
+   * statistics from now on. Wins are ranked by the number of commands this
+   * Engine has executed.
+   * @param statistics The statistics being reported to, or nullptr to stop
+   * reporting
+   * @param id The id wins are ranked under
+   */
+  void ReportTo(std::shared_ptr<GameStatistics> statistics, uint64_t id);
+
+  /**
+   * Sets the qualifier and runs the matching command.
+   * @param command The command being executed
+   * @param qualifier The qualifier the command acts on
+   */
+  void Execute(Command command, const std::string& qualifier);
+
+  /**
+   * Hashes the whole game state (the Player, every Room, the message, and the
+   * random number generator), so two Engines can be checked for identical
+   * behavior.
+   * @return The checksum of the game state
+   */
+  uint64_t ComputeChecksum() const;
+
   /**
    * Attempts to move to an adjacent room based on the current qualifier from
    * a whole command input.
@@ -70,21 +167,138 @@ class Engine {
   void Fight();
 
   /**
-   * Iterates through the vector of Rooms and returns the specified Room
-   * based on a name string. Throws an error if the name string is empty or
-   * the Room is not in the vector.
+   * Reverts every state change made by the most recent command that has not
+   * already been undone, in time proportional to the number of changes.
+   */
+  void Undo();
+
+  /**
+   * Reapplies every state change made by the most recently undone command.
+   */
+  void Redo();
+
+  /**
+   * Returns the specified Room based on a name string, copying it out of the
+   * shared Dungeon so that it can be modified. Throws an error if the name
+   * string is empty or the Room is not in the map.
    * @param name The name of the Room being searched for
    * @return The Room being searched for
    */
   Room &RetrieveRoom(const std::string& name);
 
+  /**
+   * Returns the specified Room based on a name string without copying it.
+   * Throws an error if the name string is empty or the Room is not in the
+   * map.
+   * @param name The name of the Room being searched for
+   * @return The Room being searched for
+   */
+  const Room &FindRoom(const std::string& name) const;
+
+  /**
+   * Writes a compact snapshot of the game state to an out-stream: the
+   * Player, only the Rooms that differ from the Dungeon, the message, the
+   * random number generator, and the Journal.
+   * @param os The out-stream being written to
+   * @param engine The Engine being saved
+   * @return The out-stream that went into the operator
+   */
+  friend std::ostream &operator<<(std::ostream& os, const Engine& engine);
+
+  /**
+   * Restores a snapshot written by operator<< into an Engine over the same
+   * Dungeon. Throws an error, leaving the Engine unchanged, if the snapshot
+   * is malformed or was taken over a different Dungeon.
+   * @param is The in-stream being read from
+   * @param engine The Engine being restored
+   * @return The in-stream that went into the operator
+   */
+  friend std::istream &operator>>(std::istream& is, Engine& engine);
+
  private:
-  const int kMaxPlayerWeapons = 4;
+  const size_t kJournalCapacity = 256;
+  const uint64_t kDefaultSeed = 126;
+
+  // The longest message is a fixed sentence and a five character nickname
+  const size_t kMessageCapacity = 64;
+  // More than any one command, undone or redone, records
+  const size_t kDeltaCapacity = 16;
 
   Player player_;
-  std::vector<Room> map_;
+  CopyOnWriteMap map_;
   std::string qualifier_;
   std::string message_;
+  Random random_;
+
+  Journal journal_;
+  std::vector<Delta> last_deltas_;
+
+  std::shared_ptr<GameStatistics> statistics_;
+  uint64_t statistics_id_;
+  uint64_t number_of_commands_;
+
+  // Enemies removed by recorded fights, kept so the removal can be undone
+  std::vector<Enemy> fallen_enemies_;
+  size_t next_fallen_enemy_;
+
+  uint64_t revision_;
+
+  /**
+   * Loads the dungeon file used by the default constructor. Throws an error
+   * if the file is not found.
+   * @return The loaded Dungeon
+   */
+  static std::shared_ptr<const Dungeon> LoadDefaultDungeon();
+
+  /**
+   * Returns the index of the specified Room based on a name string. Throws an
+   * error if the name string is empty or the Room is not in the map.
+   * @param name The name of the Room being searched for
+   * @return The index of the Room being searched for
+   */
+  size_t RetrieveRoomIndex(const std::string& name) const;
+
+  /**
+   * Returns a modifiable Room at the given index, copying it out of the
+   * shared Dungeon the first time with room to spare for Weapons dropped
+   * in it.
+   * @param index The position of the Room being modified
+   * @return The modifiable Room
+   */
+  Room &ModifyRoom(size_t index);
+
+  /**
+   * Records a Delta in the Journal and among the most recent command's
+   * Deltas.
+   * @param delta The Delta being recorded
+   */
+  void Record(const Delta& delta);
+
+  /**
+   * Records a change in the Player's health since the given value, if any.
+   * @param before The Player's health before the change
+   */
+  void RecordPlayerHealth(size_t before);
+
+  /**
+   * Stores a copy of the Enemy that is about to be removed and returns the
+   * slot it was stored in.
+   * @param enemy The Enemy about to be removed
+   * @return The slot the Enemy was stored in
+   */
+  size_t StoreFallenEnemy(const Enemy& enemy);
+
+  /**
+   * Applies a recorded Delta in reverse.
+   * @param delta The Delta being reverted
+   */
+  void Revert(const Delta& delta);
+
+  /**
+   * Applies a recorded Delta again after it was reverted.
+   * @param delta The Delta being reapplied
+   */
+  void Reapply(const Delta& delta);
 };
 
 }   // namespace adventure
\ No newline at end of file
@@ -0,0 +1,207 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "mechanics/engine.h"
+#include "mechanics/game_snapshot.h"
+#include "mechanics/spectator_channel.h"
+#include "serialization/replay_log.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace adventure {
+
+/**
+ * The keys the game responds to.
+ */
+enum class Key : uint8_t {
+  kLeft,
+  kRight,
+  kReturn,
+  kEscape,
+  kUp,
+  kDown
+};
+
+/**
+ * Holds an Engine along with the button selection state of the game's
+ * interface, turning key presses into Engine commands. It has no Cinder
+ * dependency, so it can run on its own thread away from rendering and be
+ * driven headlessly.
+ */
+class GameController {
+ public:
+  /**
+   * Internally loads an Engine based off its default constructor, with the
+   * main action buttons shown and the first one selected.
+   */
+  GameController();
+
+  /**
+   * Loads in the Engine to play through, with the main action buttons shown
+   * and the first one selected.
+   * @param engine The Engine holding the game
+   */
+  explicit GameController(const Engine& engine);
+
+  const Engine &GetEngine() const;
+
+  /**
+   * Seeds the Engine's random number generator.
+   * @param seed The seed of the Engine's rolls
+   */
+  void Seed(uint64_t seed);
+
+  /**
+   * Starts recording every command from the Engine's current state on, so
+   * the session can be saved to the given path and replayed.
+   * @param replay_path The path of the replay log to save
+   */
+  void StartRecording(const std::string& replay_path);
+
+  /**
+   * Writes the recorded session to its replay log, if recording, along
+   * with the checksum of the game as it is when saved.
+   */
+  void SaveRecording();
+
+  /**
+   * Publishes the Engine's current state to a spectator channel, and what
+   * every command changes from then on. Should be called before the
+   * controller is handed to a GameThread, which then publishes from the game
+   * thread.
+   * @param spectators The channel spectators watch
+   */
+  void BroadcastTo(std::shared_ptr<SpectatorChannel> spectators);
+
+  /**
+   * Responds to a key the way the action buttons do: left and right change
+   * the selection, up and down turn the page of the sub-actions, return
+   * toggles the sub-panels or executes the selected command, and escape
+   * closes the sub-panels or asks to quit. Once the game is over, every key
+   * closes the sub-panels or asks to quit.
+   * @param key The key that was pressed
+   */
+  void HandleKey(Key key);
+
+  bool IsQuitRequested() const;
+
+  /**
+   * Copies the current state into a snapshot, reusing its storage.
+   * @param snapshot The snapshot to fill in
+   */
+  void FillSnapshot(GameSnapshot& snapshot) const;
+
+ private:
+  const size_t kFirstButton = 0;
+  const size_t kSecondButton = 1;
+  const size_t kThirdButton = 2;
+  const size_t kFourthButton = 3;
+
+  Engine engine_;
+
+  size_t main_selection_;
+  size_t sub_selection_;
+  size_t last_button_index_;
+  bool has_toggled_panels_;
+  bool is_quit_requested_;
+  SubPanel sub_panel_;
+
+  bool is_recording_;
+  std::string replay_path_;
+  ReplayLog replay_log_;
+  std::chrono::steady_clock::time_point last_command_time_;
+
+  std::shared_ptr<SpectatorChannel> spectators_;
+
+  bool IsGameOver() const;
+
+  /**
+   * Closes the sub-panels and goes back to the main action buttons.
+   */
+  void CloseSubPanels();
+
+  /**
+   * Executes the command of the selected main action button on the
+   * selected sub-action.
+   */
+  void ExecuteCommand();
+
+  /**
+   * Executes a command on the Engine and, when recording, appends it to the
+   * replay log along with the checksum of the resulting state. When
+   * broadcasting, publishes what the command changed.
+   * @param command The command being executed
+   * @param qualifier The qualifier the command acts on
+   */
+  void RunCommand(Command command, const std::string& qualifier);
+
+  /**
+   * Returns the label of the given sub-action button, which is also the
+   * qualifier of its command.
+   */
+  std::string FindSubAction(size_t index) const;
+
+  /**
+   * Moves the current button selection to the left or to the opposite end
+   * depending on whether the sub-panels are toggled or not, the current
+   * sub-selection, and the current main selection.
+   */
+  void MoveSelectionLeft();
+
+  /**
+   * Moves the current button selection to the right or to the opposite end
+   * depending on whether the sub-panels are toggled or not, the current
+   * sub-selection, and the current main selection.
+   */
+  void MoveSelectionRight();
+
+  /**
+   * Moves the sub-selection back by a page of sub-actions, stopping at the
+   * first one. Does nothing unless the sub-panels are toggled.
+   */
+  void MoveSelectionUp();
+
+  /**
+   * Moves the sub-selection forward by a page of sub-actions, stopping at
+   * the last one. Does nothing unless the sub-panels are toggled.
+   */
+  void MoveSelectionDown();
+
+  /**
+   * Loads the sub-actions of the selected main action button, or closes the
+   * sub-panels with the command's failure message if there are none.
+   */
+  void LoadOptions();
+
+  /**
+   * Loads in the current Room's Enemies to serve as sub-action buttons and
+   * changes the last button index according to the number of Enemies.
+   */
+  void LoadFightOptions();
+
+  /**
+   * Loads in the current Room's Weapons and number of keys to serve as
+   * sub-action buttons and changes the last button index according to both the
+   * number of Weapons and the number of keys.
+   */
+  void LoadTakeOptions();
+
+  /**
+   * Loads in the Player's Weapons and number of keys to serve as sub-action
+   * buttons and changes the last button index according to both the number
+   * of Weapons and the number of keys.
+   */
+  void LoadDropOptions();
+
+  /**
+   * Loads in the current Room's Doors to serve as sub-action buttons and
+   * changes the last button index according to the number of Doors.
+   */
+  void LoadGoOptions();
+};
+
+}   // namespace adventure
@@ -0,0 +1,73 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "entities/enemy.h"
+#include "entities/player.h"
+#include "items/weapon.h"
+#include "map/door.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * What the sub-panels list when they are toggled.
+ */
+enum class SubPanel : uint8_t {
+  kNone,
+  kEnemies,
+  kWeapons,
+  kDoors
+};
+
+/**
+ * Everything the Visualizer needs to draw one frame, copied out of a
+ * GameController so that it can be read on the render thread while the
+ * game keeps running on its own thread.
+ */
+struct GameSnapshot {
+  // The number of sub-actions shown at once; a longer list is shown a page
+  // at a time
+  static const size_t kSubPanelPageSize = 4;
+
+  // Increases with every published snapshot
+  uint64_t version;
+
+  // The Engine's revision, which only changes when the game itself does
+  // rather than just the selection
+  uint64_t engine_revision;
+
+  Player player;
+  std::string message;
+  bool is_game_over;
+  bool is_quit_requested;
+
+  // Bit i is set when door i of the current room is locked, for the map to
+  // draw; doors past the 64th are left out
+  uint64_t locked_doors;
+
+  size_t main_selection;
+  size_t sub_selection;
+  bool has_toggled_panels;
+
+  // Only the list matching the sub-panel is filled in, and only with the
+  // page of it holding the sub-selection. On the Weapons panel, the keys
+  // are listed after the Weapons
+  SubPanel sub_panel;
+  std::vector<Enemy> enemies;
+  std::vector<Weapon> weapons;
+  std::vector<Door> doors;
+  size_t number_of_keys;
+
+  // The index of the page's first sub-action, and how many there are on
+  // every page together
+  size_t first_sub_action;
+  size_t number_of_sub_actions;
+
+  GameSnapshot();
+};
+
+}   // namespace adventure
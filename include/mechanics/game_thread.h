@@ -0,0 +1,101 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "concurrency/spsc_queue.h"
+#include "concurrency/triple_buffer.h"
+#include "mechanics/game_controller.h"
+#include "mechanics/game_snapshot.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace adventure {
+
+/**
+ * Takes in a GameController and runs it on its own thread, so that slow
+ * commands never hold up rendering. Keys reach the game through a lock-free
+ * queue and the game's state comes back as snapshots through a triple
+ * buffer, so the thread that pushes keys and reads snapshots (the render
+ * thread) never waits on the game. Pushing a key only briefly takes the
+ * mutex the idle game thread sleeps on, which is never held while a key
+ * is handled.
+ */
+class GameThread {
+ public:
+  /**
+   * Loads in the GameController to run, publishes its starting state, and
+   * starts the game thread.
+   * @param controller The GameController to run
+   */
+  explicit GameThread(std::unique_ptr<GameController> controller);
+
+  /**
+   * Stops the game thread if it is still running.
+   */
+  ~GameThread();
+
+  GameThread(const GameThread&) = delete;
+
+  GameThread &operator=(const GameThread&) = delete;
+
+  /**
+   * Queues a key for the game. Keys pressed while the queue is full are
+   * dropped. Only one thread should push keys.
+   * @param key The key that was pressed
+   * @return Whether the key was queued
+   */
+  bool PushKey(Key key);
+
+  /**
+   * Picks up the most recently published snapshot, if there is a new one.
+   * Only one thread should read snapshots.
+   * @return Whether there was a new snapshot
+   */
+  bool UpdateSnapshot();
+
+  /**
+   * Returns the snapshot last picked up by UpdateSnapshot, which stays
+   * unchanged until the next call.
+   * @return The current snapshot
+   */
+  const GameSnapshot &GetSnapshot() const;
+
+  /**
+   * Finishes the queued keys, then stops and joins the game thread.
+   */
+  void Stop();
+
+  /**
+   * Returns the GameController, which may only be used once the game thread
+   * has been stopped.
+   * @return The GameController
+   */
+  GameController &GetController();
+
+ private:
+  const size_t kKeyCapacity = 64;
+
+  std::unique_ptr<GameController> controller_;
+  SpscQueue<Key> keys_;
+  TripleBuffer<GameSnapshot> snapshots_;
+  uint64_t version_;
+
+  std::atomic<bool> is_stopping_;
+  std::mutex idle_mutex_;
+  std::condition_variable key_pushed_;
+  std::thread thread_;
+
+  /**
+   * Copies the controller's state into the back snapshot and publishes it.
+   */
+  void Publish();
+
+  void Run();
+};
+
+}   // namespace adventure
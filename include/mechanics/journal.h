@@ -0,0 +1,178 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * The kinds of state changes an Engine command can make. A kCommand record
+ * marks the start of each command so that whole commands can be undone.
+ */
+enum class DeltaType : uint8_t {
+  kCommand,
+  kLocation,
+  kPlayerHealth,
+  kPlayerKeys,
+  kRoomKeys,
+  kWeaponTaken,
+  kWeaponDropped,
+  kEnemyHealth,
+  kEnemyRemoved,
+  kLockSwitched
+};
+
+/**
+ * A single compact state change. Which fields are meaningful depends on the
+ * type (e.g. a kLocation stores the previous and new Room indices in before
+ * and after, while a kWeaponTaken stores the Room and the Weapon's index).
+ */
+struct Delta {
+  DeltaType type;
+  uint32_t room;
+  uint32_t index;
+  uint32_t before;
+  uint32_t after;
+};
+
+/**
+ * Takes in a capacity for a bounded ring buffer of Deltas that records the
+ * commands of an Engine so they can be undone and redone. The buffer is
+ * allocated once on the first record, and the oldest commands are dropped
+ * once it is full.
+ */
+class Journal {
+ public:
+  /**
+   * Loads in the maximum number of Deltas the Journal can hold. A capacity
+   * of zero turns the Journal off.
+   * @param capacity The maximum number of Deltas held
+   */
+  explicit Journal(size_t capacity);
+
+  size_t GetCapacity() const;
+
+  size_t GetSize() const;
+
+  bool CanUndo() const;
+
+  bool CanRedo() const;
+
+  /**
+   * Marks the start of a new command. The marker is only written once the
+   * command records its first Delta, so commands that change nothing leave
+   * no trace and do not discard the redo history.
+   */
+  void BeginCommand();
+
+  /**
+   * Appends a Delta to the current command, dropping any undone commands
+   * and evicting the oldest commands if the buffer is full.
+   * @param delta The Delta to record
+   */
+  void Record(const Delta& delta);
+
+  /**
+   * Passes every Delta of the most recent command to the given function in
+   * reverse order and moves the cursor before that command.
+   * @param revert The function that reverts a single Delta
+   */
+  template <typename Function>
+  void Undo(Function revert);
+
+  /**
+   * Passes every Delta of the next undone command to the given function in
+   * recorded order and moves the cursor after that command.
+   * @param reapply The function that reapplies a single Delta
+   */
+  template <typename Function>
+  void Redo(Function reapply);
+
+  /**
+   * Forgets every recorded command without releasing the buffer.
+   */
+  void Clear();
+
+  /**
+   * Writes every recorded Delta and the undo cursor to an out-stream, so
+   * undo and redo keep working after a restore.
+   * @param os The out-stream being written to
+   * @param journal The Journal being saved
+   * @return The out-stream that went into the operator
+   */
+  friend std::ostream &operator<<(std::ostream& os, const Journal& journal);
+
+  /**
+   * Restores a Journal written by operator<<. Throws an error if the saved
+   * Journal is malformed or does not fit in this Journal's capacity.
+   * @param is The in-stream being read from
+   * @param journal The Journal being restored
+   * @return The in-stream that went into the operator
+   */
+  friend std::istream &operator>>(std::istream& is, Journal& journal);
+
+ private:
+  size_t capacity_;
+  std::vector<Delta> records_;
+
+  // Logical positions relative to the oldest record in the ring buffer
+  size_t begin_;
+  size_t cursor_;
+  size_t end_;
+  size_t command_start_;
+
+  bool is_command_pending_;
+  bool is_recording_;
+
+  /**
+   * Returns the Delta at the given logical position.
+   */
+  Delta &At(size_t position);
+
+  /**
+   * Writes a Delta at the end of the ring buffer, evicting if needed.
+   */
+  void Push(const Delta& delta);
+
+  /**
+   * Drops the oldest whole command to make room for a new Delta, so a
+   * command that fits keeps as many older commands as there is room for. If
+   * the command being recorded fills the entire buffer by itself, only that
+   * command is dropped and the rest of it is not recorded.
+   */
+  void Evict();
+};
+
+template <typename Function>
+void Journal::Undo(Function revert) {
+  while (cursor_ > 0) {
+    --cursor_;
+    const Delta& delta = At(cursor_);
+
+    if (delta.type == DeltaType::kCommand) {
+      break;
+    }
+
+    revert(delta);
+  }
+}
+
+template <typename Function>
+void Journal::Redo(Function reapply) {
+  if (cursor_ == end_) {
+    return;
+  }
+
+  // Skips the marker of the command being redone
+  ++cursor_;
+
+  while (cursor_ < end_ && At(cursor_).type != DeltaType::kCommand) {
+    reapply(At(cursor_));
+    ++cursor_;
+  }
+}
+
+}   // namespace adventure
@@ -0,0 +1,42 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace adventure {
+
+/**
+ * Takes in a seed for a small xorshift random number generator whose whole
+ * state is a single integer, so that an Engine's rolls can be saved,
+ * restored, and replayed exactly.
+ */
+class Random {
+ public:
+  /**
+   * Loads in a seed as the starting state. A seed of zero is replaced by a
+   * fixed non-zero value since xorshift cannot leave the zero state.
+   * @param seed The starting state
+   */
+  explicit Random(uint64_t seed);
+
+  uint64_t GetState() const;
+
+  void SetState(uint64_t state);
+
+  /**
+   * Advances the state and returns a number between 0 and the bound
+   * (exclusive).
+   * @param bound The exclusive upper bound of the number
+   * @return The generated number
+   */
+  size_t Roll(size_t bound);
+
+ private:
+  const uint64_t kZeroReplacement = 0x9E3779B97F4A7C15ULL;
+
+  uint64_t state_;
+};
+
+}   // namespace adventure
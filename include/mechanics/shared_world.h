@@ -0,0 +1,158 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "entities/player.h"
+#include "map/dungeon.h"
+#include "map/room.h"
+#include "mechanics/engine.h"
+#include "mechanics/random.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Takes in a shared Dungeon and a maximum number of players for a world that
+ * many Players act in at once, so an Enemy fought or a Weapon taken by one
+ * Player is gone for everyone. Every Room has its own lock, and a command
+ * only locks the Rooms it touches: the current Room for Take, Drop, and
+ * Fight, and both Rooms for Go. Players spread across Rooms therefore run in
+ * parallel, while Players in the same Room take turns. Each Player must only
+ * be driven from one thread at a time.
+ */
+class SharedWorld {
+ public:
+  /**
+   * Copies the Rooms out of the Dungeon and makes room for the Players.
+   * Throws an error if the Dungeon has no Rooms or the maximum number of
+   * players is zero.
+   * @param dungeon The shared Dungeon the world starts as
+   * @param max_players The most Players the world can hold
+   */
+  SharedWorld(std::shared_ptr<const Dungeon> dungeon, size_t max_players);
+
+  SharedWorld(const SharedWorld&) = delete;
+
+  SharedWorld &operator=(const SharedWorld&) = delete;
+
+  /**
+   * Adds a Player to the world. Safe to call while other Players act.
+   * Throws an error if the world is full or the Player is not in one of
+   * its Rooms.
+   * @param player The Player joining the world
+   * @return The id of the new Player
+   */
+  size_t AddPlayer(const Player& player);
+
+  size_t GetNumberOfPlayers() const;
+
+  size_t GetNumberOfRooms() const;
+
+  /**
+   * Returns a Player, which is only safe while the Player is not acting.
+   * Throws an error if there is no such Player.
+   * @param player The id of the Player
+   * @return The Player
+   */
+  const Player &GetPlayer(size_t player) const;
+
+  /**
+   * Returns the message of a Player's most recent command, which is only
+   * safe while the Player is not acting. Throws an error if there is no such
+   * Player.
+   * @param player The id of the Player
+   * @return The Player's message
+   */
+  const std::string &GetMessage(size_t player) const;
+
+  /**
+   * Runs a command for a Player, locking only the Rooms it touches. Undo and
+   * Redo are not available, since other Players may have changed the Rooms
+   * since. Throws an error if there is no such Player, the command is not
+   * available, or its qualifier does not name anything in the Room.
+   * @param player The id of the Player acting
+   * @param command The command being executed
+   * @param qualifier The qualifier the command acts on
+   */
+  void Execute(size_t player, Command command, const std::string& qualifier);
+
+  /**
+   * Copies a Room under its lock. Throws an error if the index is not in the
+   * map.
+   * @param index The position of the Room
+   * @return A consistent copy of the Room
+   */
+  Room CopyRoom(size_t index) const;
+
+  /**
+   * Returns how many times a Room has been changed, so readers can skip
+   * copying Rooms that have not changed since they last looked. Throws an
+   * error if the index is not in the map.
+   * @param index The position of the Room
+   * @return The version of the Room
+   */
+  uint64_t GetRoomVersion(size_t index) const;
+
+  /**
+   * Returns how many times a command had to wait for a Room another Player
+   * was holding.
+   * @return The number of contended Room locks
+   */
+  uint64_t GetNumberOfContendedLocks() const;
+
+ private:
+  const uint64_t kDefaultSeed = 126;
+
+  /**
+   * A Room together with its lock and version.
+   */
+  struct RoomSlot {
+    std::mutex mutex;
+    Room room;
+    std::atomic<uint64_t> version;
+  };
+
+  /**
+   * A Player with the state each of its commands leaves behind.
+   */
+  struct PlayerSlot {
+    Player player;
+    std::string message;
+    Random random;
+  };
+
+  std::shared_ptr<const Dungeon> dungeon_;
+  std::vector<std::unique_ptr<RoomSlot>> rooms_;
+
+  // Slots are allocated up front and published by the count, so Players can
+  // be added without locking out the ones already acting
+  std::vector<std::unique_ptr<PlayerSlot>> players_;
+  std::atomic<size_t> number_of_players_;
+  std::mutex adding_mutex_;
+
+  mutable std::atomic<uint64_t> number_of_contended_locks_;
+
+  PlayerSlot &RetrievePlayer(size_t player) const;
+
+  /**
+   * Locks a Room, counting the lock as contended if it has to wait.
+   * @param index The position of the Room
+   * @return The held lock
+   */
+  std::unique_lock<std::mutex> LockRoom(size_t index) const;
+
+  void Go(PlayerSlot& slot, const std::string& qualifier);
+
+  void Take(PlayerSlot& slot, const std::string& qualifier);
+
+  void Drop(PlayerSlot& slot, const std::string& qualifier);
+
+  void Fight(PlayerSlot& slot, const std::string& qualifier);
+};
+
+}   // namespace adventure
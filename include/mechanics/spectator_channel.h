@@ -0,0 +1,152 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "concurrency/broadcast_ring.h"
+#include "entities/player.h"
+#include "map/copy_on_write_map.h"
+#include "map/dungeon.h"
+#include "mechanics/engine.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace adventure {
+
+/**
+ * Takes in a ring capacity and a keyframe interval for a channel that lets
+ * any number of spectators watch a live game. After every command the game
+ * thread publishes only what the command changed (the location, the
+ * Player's health, keys, and Weapons, and a Room's keys, Weapons, Enemies,
+ * or locks), compactly encoded and read off the Engine's Deltas. Every so
+ * often it publishes a keyframe of the whole state instead, so spectators
+ * who join late or fall behind can catch up. Frames go into one shared
+ * BroadcastRing, so the game thread's cost does not depend on the number of
+ * spectators.
+ */
+class SpectatorChannel {
+ public:
+  /**
+   * Loads in how many bytes of frames are kept and how often a keyframe is
+   * published. Throws an error if either is zero.
+   * @param capacity The minimum number of bytes of frames kept
+   * @param keyframe_interval The number of commands between keyframes
+   */
+  SpectatorChannel(size_t capacity, size_t keyframe_interval);
+
+  SpectatorChannel(const SpectatorChannel&) = delete;
+
+  SpectatorChannel &operator=(const SpectatorChannel&) = delete;
+
+  /**
+   * Publishes what the Engine's most recent command changed, or a keyframe
+   * if one is due. Only the game thread should call this, once after every
+   * command, starting from the Engine's initial state.
+   * @param engine The Engine that just executed a command
+   */
+  void Publish(const Engine& engine);
+
+  /**
+   * Publishes a keyframe of the Engine's whole state. Only the game thread
+   * should call this.
+   * @param engine The Engine being published
+   */
+  void PublishKeyframe(const Engine& engine);
+
+  const BroadcastRing &GetRing() const;
+
+  /**
+   * Returns the ring position of the newest keyframe, where new spectators
+   * start reading.
+   * @return The position of the newest keyframe
+   */
+  uint64_t GetKeyframePosition() const;
+
+  /**
+   * Returns whether any keyframe has been published yet.
+   * @return Whether a keyframe has been published
+   */
+  bool HasKeyframe() const;
+
+  uint64_t GetNumberOfFrames() const;
+
+ private:
+  size_t keyframe_interval_;
+  BroadcastRing ring_;
+
+  // Only touched by the game thread
+  size_t commands_since_keyframe_;
+  std::string frame_;
+
+  std::atomic<uint64_t> keyframe_position_;
+  std::atomic<bool> has_keyframe_;
+  std::atomic<uint64_t> number_of_frames_;
+};
+
+/**
+ * Takes in a SpectatorChannel and the Dungeon the watched game plays
+ * through for one spectator's view of the game. The view starts at the
+ * newest keyframe and is brought up to date by reading the frames published
+ * since. A spectator that falls so far behind that frames it has not read
+ * are overwritten waits for the next keyframe. Each Spectator should only be
+ * used from one thread, but any number of them can read the same channel at
+ * once.
+ */
+class Spectator {
+ public:
+  /**
+   * Loads in the channel to watch and the Dungeon the game plays through.
+   * Throws an error if the Dungeon is missing.
+   * @param channel The channel being watched
+   * @param dungeon The shared Dungeon the watched game plays through
+   */
+  Spectator(const SpectatorChannel& channel,
+            std::shared_ptr<const Dungeon> dungeon);
+
+  /**
+   * Applies every frame published since the last update. Throws an error if
+   * a frame is malformed.
+   * @return Whether the view changed
+   */
+  bool Update();
+
+  /**
+   * Returns whether the view has caught up with a keyframe and follows the
+   * game since.
+   * @return Whether the view is in sync
+   */
+  bool IsSynced() const;
+
+  const Player &GetPlayer() const;
+
+  const CopyOnWriteMap &GetMap() const;
+
+  const std::string &GetMessage() const;
+
+  /**
+   * Returns how many times the spectator fell behind and had to wait for a
+   * keyframe.
+   * @return The number of times the view was overrun
+   */
+  uint64_t GetNumberOfOverruns() const;
+
+ private:
+  const SpectatorChannel& channel_;
+  uint64_t position_;
+  std::string frame_;
+
+  Player player_;
+  CopyOnWriteMap map_;
+  std::string message_;
+  bool is_synced_;
+  uint64_t number_of_overruns_;
+
+  /**
+   * Applies a single frame to the view.
+   */
+  void Apply(const std::string& frame);
+};
+
+}   // namespace adventure
@@ -0,0 +1,33 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+
+namespace adventure {
+
+/**
+ * Returns whether heap allocations are being counted. They are only counted
+ * in builds with ADVENTURE_COUNT_ALLOCATIONS defined, which replace the
+ * global operator new and delete with ones that count before calling into
+ * malloc and free.
+ * @return Whether this build counts allocations
+ */
+bool IsCountingAllocations();
+
+/**
+ * Returns the number of heap allocations the calling thread has made, so a
+ * piece of code can be measured by the difference before and after it.
+ * Always zero in builds that do not count allocations.
+ * @return The number of allocations
+ */
+size_t GetNumberOfAllocations();
+
+/**
+ * Returns the number of heap allocations the calling thread has freed.
+ * Always zero in builds that do not count allocations.
+ * @return The number of frees
+ */
+size_t GetNumberOfFrees();
+
+}   // namespace adventure
@@ -0,0 +1,68 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+
+namespace adventure {
+
+/**
+ * Takes in the type of archetype and how to hash it for a table that
+ * interns archetypes, the parts of an object that every object of its kind
+ * shares. Equal archetypes are stored once, and an interned archetype never
+ * moves or changes for as long as the table lives, so objects can point at
+ * it instead of holding their own copy, and two objects are of the same
+ * kind exactly when they point at the same archetype. Interning is
+ * thread-safe; reading an interned archetype needs no lock at all.
+ */
+template <typename T, typename Hash>
+class ArchetypeTable {
+ public:
+  ArchetypeTable() = default;
+
+  ArchetypeTable(const ArchetypeTable&) = delete;
+
+  ArchetypeTable &operator=(const ArchetypeTable&) = delete;
+
+  /**
+   * Returns the archetype equal to the given one, moving it into the table
+   * first if no equal archetype is stored.
+   * @param archetype The archetype
+   * @return The interned archetype, which lives as long as the table
+   */
+  const T* Intern(T&& archetype) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Elements of an unordered set keep their addresses through rehashing
+    return &*archetypes_.insert(std::move(archetype)).first;
+  }
+
+  /**
+   * Returns the number of distinct archetypes interned.
+   * @return The number of archetypes
+   */
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return archetypes_.size();
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_set<T, Hash> archetypes_;
+};
+
+/**
+ * Mixes the hash of one field of an archetype into the hash of the fields
+ * before it.
+ * @param seed The hash of the fields before
+ * @param value The hash of the field
+ * @return The hash of every field so far
+ */
+inline size_t CombineHash(size_t seed, size_t value) {
+  return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+}   // namespace adventure
@@ -0,0 +1,161 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Takes in the size of its first block for a monotonic arena. Allocations
+ * are carved out of large blocks one after another and are never freed on
+ * their own; every block is freed at once when the arena is destroyed. Each
+ * block is twice the size of the one before, up to a limit, so a load of
+ * any size takes a handful of blocks. An arena is not thread-safe, which is
+ * fine for objects that are built on one thread and only read afterwards.
+ */
+class Arena {
+ public:
+  /**
+   * Internally loads an arena whose first block is the default size. No
+   * memory is allocated until the first allocation.
+   */
+  Arena();
+
+  /**
+   * Loads in the size of the first block. Throws an error if it is zero.
+   * @param first_block_size The number of bytes in the first block
+   */
+  explicit Arena(size_t first_block_size);
+
+  Arena(const Arena&) = delete;
+
+  Arena &operator=(const Arena&) = delete;
+
+  /**
+   * Frees every block.
+   */
+  ~Arena();
+
+  /**
+   * Carves out memory from the current block, or from a new block if it
+   * does not fit. An allocation larger than a block gets a block of its
+   * own. Throws an error if the alignment is not a power of two.
+   * @param size The number of bytes
+   * @param alignment The alignment of the memory, in bytes
+   * @return The memory, which lives as long as the arena
+   */
+  void* Allocate(size_t size, size_t alignment);
+
+  size_t GetNumberOfBlocks() const;
+
+  /**
+   * Returns the number of bytes handed out, not counting padding.
+   * @return The number of bytes allocated out of the arena
+   */
+  size_t GetNumberOfBytes() const;
+
+  /**
+   * Returns the number of bytes held in blocks, used or not.
+   * @return The total size of every block
+   */
+  size_t GetCapacity() const;
+
+ private:
+  static const size_t kDefaultFirstBlockSize = 4096;
+  static const size_t kMaxBlockSize = 1 << 20;
+
+  /**
+   * The start of every block, which links it to the block before.
+   */
+  struct Block {
+    Block* previous;
+    size_t size;
+  };
+
+  Block* current_block_;
+  char* cursor_;
+  char* end_;
+
+  size_t next_block_size_;
+  size_t number_of_blocks_;
+  size_t number_of_bytes_;
+  size_t capacity_;
+
+  /**
+   * Allocates a block with room for at least the given bytes and makes it
+   * the current block.
+   */
+  void AddBlock(size_t minimum_size);
+};
+
+/**
+ * Takes in an arena for an allocator that containers can use to place their
+ * memory in it. An allocator without an arena uses the heap. Copying a
+ * container gives the copy a heap allocator, so copies made from objects in
+ * an arena, for example by a game that changes a room, never write into
+ * another object's arena.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  /**
+   * Internally loads an allocator that uses the heap.
+   */
+  ArenaAllocator() : arena_(nullptr) {}
+
+  /**
+   * Loads in the arena memory is placed in.
+   * @param arena The arena, or nullptr for the heap
+   */
+  explicit ArenaAllocator(Arena* arena) : arena_(arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.GetArena()) {}
+
+  Arena* GetArena() const { return arena_; }
+
+  T* allocate(size_t n) {
+    if (arena_ == nullptr) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* memory, size_t) {
+    // Memory in an arena is freed with the arena
+    if (arena_ == nullptr) {
+      ::operator delete(memory);
+    }
+  }
+
+  ArenaAllocator select_on_container_copy_construction() const {
+    return ArenaAllocator();
+  }
+
+ private:
+  Arena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+  return lhs.GetArena() == rhs.GetArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+/**
+ * A vector whose buffer can be placed in an arena.
+ */
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+}   // namespace adventure
@@ -0,0 +1,246 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "memory/arena.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace adventure {
+
+/**
+ * Names a value in a SlotMap. A handle stays valid until its value is
+ * removed, and is never mistaken for a value that later takes the same slot.
+ */
+struct SlotHandle {
+  uint32_t slot;
+  uint32_t generation;
+};
+
+inline bool operator==(const SlotHandle& lhs, const SlotHandle& rhs) {
+  return lhs.slot == rhs.slot && lhs.generation == rhs.generation;
+}
+
+inline bool operator!=(const SlotHandle& lhs, const SlotHandle& rhs) {
+  return !(lhs == rhs);
+}
+
+/**
+ * Takes in an allocator for a container that hands out a SlotHandle for
+ * every value it holds. Values are kept packed in one vector, so they can be
+ * iterated like one; each handle names a slot that knows where its value is
+ * and which generation of value it holds. Looking up, removing, and telling
+ * whether a handle is stale all take constant time. Removing a value moves
+ * the last value into its place.
+ */
+template <typename T>
+class SlotMap {
+ public:
+  /**
+   * Internally loads an empty SlotMap on the heap.
+   */
+  SlotMap() : SlotMap(ArenaAllocator<T>()) {}
+
+  /**
+   * Loads in the allocator the values and slots are placed with.
+   * @param allocator The allocator, which may place them in an arena
+   */
+  explicit SlotMap(const ArenaAllocator<T>& allocator)
+      : values_(allocator), value_slots_(allocator), slots_(allocator),
+        free_slot_(kNoSlot) {}
+
+  size_t size() const { return values_.size(); }
+
+  bool empty() const { return values_.empty(); }
+
+  /**
+   * Makes room for a number of values up front, so that filling the
+   * SlotMap does not grow it one step at a time.
+   * @param capacity The number of values
+   */
+  void reserve(size_t capacity) {
+    values_.reserve(capacity);
+    value_slots_.reserve(capacity);
+    slots_.reserve(capacity);
+  }
+
+  /**
+   * Returns every value, packed in the order removals have left them.
+   * @return The values
+   */
+  const ArenaVector<T> &GetValues() const { return values_; }
+
+  /**
+   * Checks whether a handle still names a value.
+   * @param handle The handle
+   * @return Whether the handle's value has not been removed
+   */
+  bool Contains(SlotHandle handle) const {
+    if (handle.slot >= slots_.size()) {
+      return false;
+    }
+
+    const Slot& slot = slots_[handle.slot];
+    return slot.generation == handle.generation &&
+           slot.index < values_.size() &&
+           value_slots_[slot.index] == handle.slot;
+  }
+
+  /**
+   * Returns the value a handle names. Throws an error if the handle is
+   * stale.
+   * @param handle The handle
+   * @return The value
+   */
+  T &Get(SlotHandle handle) { return values_[GetIndex(handle)]; }
+
+  const T &Get(SlotHandle handle) const { return values_[GetIndex(handle)]; }
+
+  /**
+   * Returns a value by where it is in the packed values. Throws an error if
+   * the index is out of range.
+   * @param index The index of the value
+   * @return The value
+   */
+  T &GetAt(size_t index) {
+    if (index >= values_.size()) {
+      throw std::invalid_argument("INDEX OUT OF RANGE");
+    }
+
+    return values_[index];
+  }
+
+  /**
+   * Returns where the value a handle names is in the packed values. Throws
+   * an error if the handle is stale.
+   * @param handle The handle
+   * @return The index of the value
+   */
+  size_t GetIndex(SlotHandle handle) const {
+    if (!Contains(handle)) {
+      throw std::invalid_argument("STALE HANDLE");
+    }
+
+    return slots_[handle.slot].index;
+  }
+
+  /**
+   * Returns the handle of a value in the packed values. Throws an error if
+   * the index is out of range.
+   * @param index The index of the value
+   * @return The value's handle
+   */
+  SlotHandle GetHandle(size_t index) const {
+    if (index >= values_.size()) {
+      throw std::invalid_argument("INDEX OUT OF RANGE");
+    }
+
+    uint32_t slot = value_slots_[index];
+    return SlotHandle{slot, slots_[slot].generation};
+  }
+
+  /**
+   * Appends a value.
+   * @param value The value
+   * @return The value's handle
+   */
+  SlotHandle Insert(const T& value) {
+    return InsertAt(values_.size(), value);
+  }
+
+  /**
+   * Places a value at an index of the packed values, moving the value there
+   * to the back. This undoes removing the value at that index. Throws an
+   * error if the index is out of range.
+   * @param index Where the value goes, up to the number of values
+   * @param value The value
+   * @return The value's handle
+   */
+  SlotHandle InsertAt(size_t index, const T& value) {
+    if (index > values_.size()) {
+      throw std::invalid_argument("INDEX OUT OF RANGE");
+    }
+
+    uint32_t slot = free_slot_;
+    if (slot == kNoSlot) {
+      slot = (uint32_t)slots_.size();
+      slots_.push_back(Slot{0, 0});
+    } else {
+      free_slot_ = slots_[slot].index;
+    }
+
+    values_.push_back(value);
+    value_slots_.push_back(slot);
+    slots_[slot].index = (uint32_t)values_.size() - 1;
+
+    if (index + 1 < values_.size()) {
+      Swap(index, values_.size() - 1);
+    }
+
+    return SlotHandle{slot, slots_[slot].generation};
+  }
+
+  /**
+   * Removes the value a handle names, moving the last value into its
+   * place. Throws an error if the handle is stale.
+   * @param handle The handle
+   */
+  void Remove(SlotHandle handle) { RemoveAt(GetIndex(handle)); }
+
+  /**
+   * Removes a value from the packed values, moving the last value into its
+   * place. Throws an error if the index is out of range.
+   * @param index The index of the value
+   */
+  void RemoveAt(size_t index) {
+    if (index >= values_.size()) {
+      throw std::invalid_argument("INDEX OUT OF RANGE");
+    }
+
+    if (index + 1 < values_.size()) {
+      Swap(index, values_.size() - 1);
+    }
+
+    uint32_t slot = value_slots_.back();
+    values_.pop_back();
+    value_slots_.pop_back();
+
+    // Handles to the removed value go stale, and the slot is reused
+    ++slots_[slot].generation;
+    slots_[slot].index = free_slot_;
+    free_slot_ = slot;
+  }
+
+ private:
+  static const uint32_t kNoSlot = UINT32_MAX;
+
+  /**
+   * Where a slot's value is, or the next free slot if it has none.
+   */
+  struct Slot {
+    uint32_t generation;
+    uint32_t index;
+  };
+
+  ArenaVector<T> values_;
+  ArenaVector<uint32_t> value_slots_;
+  ArenaVector<Slot> slots_;
+  uint32_t free_slot_;
+
+  /**
+   * Swaps two packed values and points their slots at their new places.
+   */
+  void Swap(size_t first, size_t second) {
+    std::swap(values_[first], values_[second]);
+    std::swap(value_slots_[first], value_slots_[second]);
+    slots_[value_slots_[first]].index = (uint32_t)first;
+    slots_[value_slots_[second]].index = (uint32_t)second;
+  }
+};
+
+template <typename T>
+const uint32_t SlotMap<T>::kNoSlot;
+
+}   // namespace adventure
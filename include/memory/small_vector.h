@@ -0,0 +1,228 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace adventure {
+
+/**
+ * Takes in a type and a number of values for a vector that keeps up to that
+ * many values inside itself and only moves them to the heap once it holds
+ * more. A SmallVector that never outgrows its inline storage never touches
+ * the heap, which suits lists that are almost always short but must not be
+ * capped.
+ */
+template <typename T, size_t N>
+class SmallVector {
+ public:
+  using value_type = T;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  /**
+   * Internally loads an empty SmallVector using its inline storage.
+   */
+  SmallVector() : data_(GetInlineData()), size_(0), capacity_(N) {}
+
+  SmallVector(const SmallVector& other) : SmallVector() {
+    reserve(other.size_);
+    for (const T& value : other) {
+      push_back(value);
+    }
+  }
+
+  /**
+   * Takes the other SmallVector's heap storage if it has any, and moves its
+   * values one at a time otherwise.
+   */
+  SmallVector(SmallVector&& other) : SmallVector() { Take(other); }
+
+  ~SmallVector() { Release(); }
+
+  SmallVector &operator=(const SmallVector& other) {
+    if (this != &other) {
+      clear();
+      reserve(other.size_);
+      for (const T& value : other) {
+        push_back(value);
+      }
+    }
+
+    return *this;
+  }
+
+  SmallVector &operator=(SmallVector&& other) {
+    if (this != &other) {
+      Release();
+      data_ = GetInlineData();
+      capacity_ = N;
+      Take(other);
+    }
+
+    return *this;
+  }
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  size_t capacity() const { return capacity_; }
+
+  /**
+   * Returns whether the values are still in the inline storage.
+   * @return Whether the SmallVector has not allocated any memory
+   */
+  bool IsInline() const { return data_ == GetInlineData(); }
+
+  T &operator[](size_t index) { return data_[index]; }
+
+  const T &operator[](size_t index) const { return data_[index]; }
+
+  T &front() { return data_[0]; }
+
+  const T &front() const { return data_[0]; }
+
+  T &back() { return data_[size_ - 1]; }
+
+  const T &back() const { return data_[size_ - 1]; }
+
+  iterator begin() { return data_; }
+
+  const_iterator begin() const { return data_; }
+
+  iterator end() { return data_ + size_; }
+
+  const_iterator end() const { return data_ + size_; }
+
+  /**
+   * Makes room for a number of values, moving them to the heap if they do
+   * not fit inline.
+   * @param capacity The number of values
+   */
+  void reserve(size_t capacity) {
+    if (capacity <= capacity_) {
+      return;
+    }
+
+    T* data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+    for (size_t index = 0; index < size_; ++index) {
+      new (data + index) T(std::move(data_[index]));
+      data_[index].~T();
+    }
+
+    if (!IsInline()) {
+      ::operator delete(data_);
+    }
+
+    data_ = data;
+    capacity_ = capacity;
+  }
+
+  void push_back(const T& value) {
+    if (size_ == capacity_) {
+      // Copied first, since the value may live in the storage being moved
+      T copy(value);
+      reserve(2 * capacity_);
+      new (data_ + size_) T(std::move(copy));
+    } else {
+      new (data_ + size_) T(value);
+    }
+
+    ++size_;
+  }
+
+  void pop_back() {
+    --size_;
+    data_[size_].~T();
+  }
+
+  /**
+   * Places a value at an index, moving every value from there on back by
+   * one. Throws an error if the index is past the end.
+   * @param index Where the value goes, up to the number of values
+   * @param value The value
+   */
+  void insert(size_t index, const T& value) {
+    if (index > size_) {
+      throw std::invalid_argument("INDEX OUT OF RANGE");
+    }
+
+    push_back(value);
+    for (size_t position = size_ - 1; position > index; --position) {
+      std::swap(data_[position], data_[position - 1]);
+    }
+  }
+
+  /**
+   * Removes the value at an index, moving every value after it forward by
+   * one. Throws an error if the index is out of range.
+   * @param index The index of the value
+   */
+  void erase(size_t index) {
+    if (index >= size_) {
+      throw std::invalid_argument("INDEX OUT OF RANGE");
+    }
+
+    for (size_t position = index; position + 1 < size_; ++position) {
+      data_[position] = std::move(data_[position + 1]);
+    }
+
+    pop_back();
+  }
+
+  void clear() {
+    while (size_ > 0) {
+      pop_back();
+    }
+  }
+
+ private:
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type inline_data_[N];
+  T* data_;
+  size_t size_;
+  size_t capacity_;
+
+  T* GetInlineData() { return reinterpret_cast<T*>(inline_data_); }
+
+  const T* GetInlineData() const {
+    return reinterpret_cast<const T*>(inline_data_);
+  }
+
+  /**
+   * Destroys every value and frees the heap storage, if any.
+   */
+  void Release() {
+    clear();
+    if (!IsInline()) {
+      ::operator delete(data_);
+    }
+  }
+
+  /**
+   * Moves the values of an empty-handed SmallVector out of another, leaving
+   * the other empty and inline.
+   */
+  void Take(SmallVector& other) {
+    if (other.IsInline()) {
+      for (T& value : other) {
+        push_back(std::move(value));
+      }
+      other.clear();
+      return;
+    }
+
+    data_ = other.data_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    other.data_ = other.GetInlineData();
+    other.size_ = 0;
+    other.capacity_ = N;
+  }
+};
+
+}   // namespace adventure
@@ -0,0 +1,54 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Takes in the path of a file and maps it read-only into memory, so it can
+ * be read without being copied, and so every process mapping the same file
+ * shares its pages. An empty file maps to no bytes.
+ */
+class MappedFile {
+ public:
+  /**
+   * Loads in the path of the file and maps it. Throws an error if the file
+   * cannot be opened or mapped.
+   * @param path The path of the file
+   */
+  explicit MappedFile(const std::string& path);
+
+  /**
+   * Unmaps the file.
+   */
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+
+  MappedFile &operator=(const MappedFile&) = delete;
+
+  const uint8_t* GetData() const;
+
+  size_t GetSize() const;
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+
+  // The file mapping handle on Windows, unused elsewhere
+  void* mapping_;
+};
+
+/**
+ * Lists the regular files directly inside a directory, sorted by name.
+ * Throws an error if the directory cannot be opened.
+ * @param directory The directory being listed
+ * @return The paths of the files, each prefixed with the directory
+ */
+std::vector<std::string> ListFiles(const std::string& directory);
+
+}   // namespace adventure
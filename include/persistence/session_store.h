@@ -0,0 +1,189 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "mechanics/engine.h"
+#include "persistence/write_ahead_log.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Takes in a directory and a snapshot interval for a store that keeps game
+ * sessions safe across crashes. Every command a session runs goes to a
+ * WriteAheadLog, and once per interval each active session's Engine is
+ * saved as a compact snapshot on a background thread, after which the log
+ * segments every session has moved past are removed. Recovery loads each
+ * session's latest snapshot and replays only the commands logged after it.
+ */
+class SessionStore {
+ public:
+  /**
+   * Loads in the directory holding the store, creating it if needed, and
+   * starts the snapshot thread. Throws an error if the snapshot interval is
+   * not positive.
+   * @param directory The directory holding the log and snapshots
+   * @param snapshot_interval How often active sessions are snapshotted
+   */
+  SessionStore(const std::string& directory,
+               std::chrono::milliseconds snapshot_interval);
+
+  /**
+   * Writes the snapshots still queued, then stops the snapshot thread.
+   */
+  ~SessionStore();
+
+  SessionStore(const SessionStore&) = delete;
+
+  SessionStore &operator=(const SessionStore&) = delete;
+
+  /**
+   * Rebuilds every session left by earlier runs: each starts as a copy of
+   * the given Engine, loads its latest snapshot, and replays the commands
+   * logged after it. Recovered sessions can go on recording right away.
+   * Must be called before any session is opened. Throws an error if a
+   * snapshot is corrupted or does not match the Engine's Dungeon.
+   * @param initial The Engine every session was started from
+   * @return The recovered Engines by session
+   */
+  std::map<uint64_t, Engine> Recover(const Engine& initial);
+
+  /**
+   * Starts a new session and saves its starting state before returning, so
+   * the session can be recovered however it was set up (e.g. its seed).
+   * Throws an error if the session is already open.
+   * @param session The id of the session
+   * @param engine The session's Engine before its first command
+   */
+  void Open(uint64_t session, const Engine& engine);
+
+  /**
+   * Logs a command a session has just executed, without waiting for the
+   * disk. If the session is due for a snapshot, its Engine is also saved to
+   * be written in the background. Throws an error if the session is not
+   * open. Each session must only be recorded from one thread at a time.
+   * @param session The id of the session
+   * @param command The command that was executed
+   * @param qualifier The qualifier the command acted on
+   * @param engine The session's Engine after the command
+   * @return The ticket to pass to WaitUntilDurable
+   */
+  uint64_t Record(uint64_t session, Command command,
+                  const std::string& qualifier, const Engine& engine);
+
+  /**
+   * Blocks until a recorded command is safely on disk.
+   * @param ticket The ticket returned by Record
+   */
+  void WaitUntilDurable(uint64_t ticket);
+
+  /**
+   * Queues a snapshot of a session right away, e.g. when it goes idle, so
+   * the log segments only it still needs can be removed. Throws an error if
+   * the session is not open or an earlier snapshot could not be written.
+   * @param session The id of the session
+   * @param engine The session's current Engine
+   */
+  void Snapshot(uint64_t session, const Engine& engine);
+
+  /**
+   * Blocks until every snapshot queued so far has been written. Throws an
+   * error if any snapshot, or the log's manifest, could not be written; the
+   * log segments it would have freed are kept.
+   */
+  void WaitForSnapshots();
+
+  const WriteAheadLog &GetLog() const;
+
+  size_t GetNumberOfSnapshots() const;
+
+ private:
+  /**
+   * What the store tracks about one session.
+   */
+  struct SessionState {
+    uint64_t last_sequence;
+    uint64_t snapshot_sequence;
+    uint64_t snapshot_round;
+
+    // The first sequence logged to each segment since the latest snapshot,
+    // so the front is the oldest segment the session still needs
+    std::deque<std::pair<uint64_t, uint64_t>> segment_starts;
+  };
+
+  /**
+   * A serialized Engine waiting to be written.
+   */
+  struct PendingSnapshot {
+    uint64_t session;
+    uint64_t sequence;
+    std::string engine;
+  };
+
+  std::string directory_;
+  std::chrono::milliseconds snapshot_interval_;
+  WriteAheadLog log_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable snapshot_queued_;
+  std::condition_variable snapshots_written_;
+  std::map<uint64_t, SessionState> sessions_;
+  std::vector<PendingSnapshot> pending_snapshots_;
+  size_t number_of_writing_;
+  uint64_t round_;
+  // Set for good once the snapshot thread fails to write a file, which is
+  // reported to the caller instead of ending the thread
+  bool has_failed_;
+  bool is_stopping_;
+
+  std::atomic<size_t> number_of_snapshots_;
+  std::thread snapshot_thread_;
+
+  std::string GetSnapshotPath(uint64_t session) const;
+
+  std::string GetIndexPath() const;
+
+  /**
+   * Saves an Engine and queues it to be written as a session's snapshot.
+   */
+  void QueueSnapshot(uint64_t session, uint64_t sequence,
+                     const Engine& engine);
+
+  /**
+   * Writes a snapshot file for a session.
+   */
+  void WriteSnapshot(const PendingSnapshot& snapshot) const;
+
+  /**
+   * Reads a session's snapshot file into an Engine and returns the sequence
+   * it was taken at.
+   */
+  uint64_t ReadSnapshot(uint64_t session, Engine& engine) const;
+
+  /**
+   * Marks a snapshot as written, releasing the log segments it covers. Must
+   * be called with the mutex held.
+   */
+  void CompleteSnapshot(const PendingSnapshot& snapshot);
+
+  /**
+   * Returns the oldest log segment any session still needs. Must be called
+   * with the mutex held.
+   */
+  uint64_t FindOldestSegment() const;
+
+  void Run();
+};
+
+}   // namespace adventure
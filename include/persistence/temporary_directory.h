@@ -0,0 +1,40 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <string>
+
+namespace adventure {
+
+/**
+ * Takes in a name prefix for a TemporaryDirectory which creates a new,
+ * uniquely named directory under the system's temporary path, and removes
+ * it along with every file and empty directory in it once it goes out of
+ * scope.
+ */
+class TemporaryDirectory {
+ public:
+  /**
+   * Loads in the prefix and creates the directory. Throws an error if it
+   * cannot be created.
+   * @param prefix The start of the directory's name
+   */
+  explicit TemporaryDirectory(const std::string& prefix);
+
+  /**
+   * Removes the files and empty directories directly inside the directory,
+   * then the directory.
+   */
+  ~TemporaryDirectory();
+
+  TemporaryDirectory(const TemporaryDirectory&) = delete;
+
+  TemporaryDirectory &operator=(const TemporaryDirectory&) = delete;
+
+  const std::string &GetPath() const;
+
+ private:
+  std::string path_;
+};
+
+}   // namespace adventure
@@ -0,0 +1,213 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "mechanics/engine.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * One command logged for a session. Sequences start at 1 and count up by one
+ * per command within each session.
+ */
+struct WalRecord {
+  uint64_t session;
+  uint64_t sequence;
+  Command command;
+  std::string qualifier;
+};
+
+/**
+ * Takes in a directory for a write-ahead log of commands, split into numbered
+ * segment files. Appending only copies the record into memory; a background
+ * thread writes everything appended since its last pass and syncs it to disk
+ * once, so many commands share one sync (group commit). Each record carries a
+ * checksum, so a record torn by a crash ends its segment instead of being
+ * replayed. Once a write or a sync fails, nothing more is reported durable
+ * and the log refuses further records.
+ */
+class WriteAheadLog {
+ public:
+  /**
+   * Loads in the directory holding the log, creating it if needed, and
+   * starts a fresh segment after any that are already there, so records
+   * from an earlier run are never appended to. Throws an error if the
+   * directory or the segment cannot be created.
+   * @param directory The directory holding the log
+   */
+  explicit WriteAheadLog(const std::string& directory);
+
+  /**
+   * Syncs everything appended so far, then stops the background thread.
+   */
+  ~WriteAheadLog();
+
+  WriteAheadLog(const WriteAheadLog&) = delete;
+
+  WriteAheadLog &operator=(const WriteAheadLog&) = delete;
+
+  /**
+   * Queues a record to be written without waiting for the disk. Throws an
+   * error if the log has already failed to write or sync.
+   * @param record The record being logged
+   * @param segment The segment the record will be written to
+   * @return The ticket to pass to WaitUntilDurable
+   */
+  uint64_t Append(const WalRecord& record, uint64_t& segment);
+
+  /**
+   * Blocks until the record with the given ticket, and every record
+   * appended before it, has been synced to disk. Throws an error if a write
+   * or sync fails first.
+   * @param ticket The ticket returned by Append
+   */
+  void WaitUntilDurable(uint64_t ticket);
+
+  /**
+   * Sends every record appended from now on to a new segment, so the older
+   * segments can be removed once they are covered by snapshots. Does nothing
+   * if no record has been appended to the current segment.
+   * @return The segment records are now appended to
+   */
+  uint64_t Rotate();
+
+  /**
+   * Removes every segment before the given one. The first segment kept is
+   * written to the log's manifest before any file is removed.
+   * @param segment The oldest segment still needed
+   */
+  void RemoveSegmentsBefore(uint64_t segment);
+
+  /**
+   * Calls the given function on every record from the earlier runs of the
+   * log, in the order they were appended. Records appended by this run are
+   * not read.
+   * @param apply The function called on each record
+   */
+  void Replay(const std::function<void(const WalRecord&)>& apply) const;
+
+  uint64_t GetCurrentSegment() const;
+
+  uint64_t GetFirstSegment() const;
+
+  /**
+   * Returns how many times the log has been synced to disk, which divided
+   * into the number of appended records gives the average group size.
+   * @return The number of syncs
+   */
+  uint64_t GetNumberOfSyncs() const;
+
+  /**
+   * Encodes a record with its length and checksum, as it is laid out in a
+   * segment.
+   * @param record The record being encoded
+   * @param buffer The buffer the encoded record is appended to
+   */
+  static void Encode(const WalRecord& record, std::string& buffer);
+
+  /**
+   * Decodes a record from the front of a buffer.
+   * @param buffer The buffer being read from
+   * @param size The number of bytes available in the buffer
+   * @param record The decoded record
+   * @return The number of bytes read, or 0 if the buffer holds no whole,
+   * intact record
+   */
+  static size_t Decode(const uint8_t* buffer, size_t size, WalRecord& record);
+
+ private:
+  /**
+   * Records waiting to be written to one segment.
+   */
+  struct Batch {
+    uint64_t segment;
+    std::string bytes;
+  };
+
+  std::string directory_;
+
+  // Segments from first_segment_ up to but not including first_new_segment_
+  // were written by earlier runs
+  uint64_t first_segment_;
+  uint64_t first_new_segment_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable appended_;
+  std::condition_variable synced_;
+  std::vector<Batch> pending_;
+  uint64_t current_segment_;
+  uint64_t next_ticket_;
+  uint64_t rotation_ticket_;
+  uint64_t durable_ticket_;
+  // Set for good once a write or sync fails, after which durable_ticket_
+  // never moves again
+  bool has_failed_;
+  bool is_stopping_;
+
+  std::atomic<uint64_t> number_of_syncs_;
+  std::FILE* file_;
+  uint64_t file_segment_;
+  std::thread flusher_;
+
+  /**
+   * Returns the path of the file holding the given segment.
+   */
+  std::string GetSegmentPath(uint64_t segment) const;
+
+  /**
+   * Returns the path of the manifest holding the first segment kept.
+   */
+  std::string GetManifestPath() const;
+
+  /**
+   * Opens the file of a new segment for writing. Throws an error if it
+   * cannot be created.
+   */
+  void OpenSegment(uint64_t segment);
+
+  /**
+   * Writes a batch to its segment, switching segments first if needed.
+   * @return Whether the batch, and the segment it switched from, were
+   * written
+   */
+  bool Write(const Batch& batch);
+
+  void Flush();
+};
+
+/**
+ * Flushes a file and forces its contents onto the disk.
+ * @param file The file being synced
+ * @return Whether the file was synced
+ */
+bool SyncFile(std::FILE* file);
+
+/**
+ * Creates a directory if it does not already exist. Parent directories are
+ * not created.
+ * @param path The path of the directory
+ * @return Whether the directory exists
+ */
+bool MakeDirectory(const std::string& path);
+
+/**
+ * Replaces a file with the given bytes by writing and syncing a temporary
+ * file and renaming it over the original, so a crash leaves either the old
+ * or the new contents and never a mix. Throws an error if the file cannot be
+ * written.
+ * @param path The path of the file being replaced
+ * @param bytes The new contents of the file
+ */
+void WriteFileAtomically(const std::string& path, const std::string& bytes);
+
+}   // namespace adventure
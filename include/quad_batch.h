@@ -0,0 +1,61 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "cinder/TriMesh.h"
+#include "cinder/gl/Batch.h"
+#include "cinder/gl/gl.h"
+
+namespace adventure {
+
+/**
+ * Collects solid rectangles, each with its own color, into one mesh that is
+ * drawn with a single call. The mesh is uploaded the first time it is drawn
+ * after it changes, and drawn straight from the graphics card's copy every
+ * other time, so rectangles that stay put cost nothing to redraw. Later
+ * rectangles are drawn over earlier ones.
+ */
+class QuadBatch {
+ public:
+  /**
+   * Internally loads an empty QuadBatch. Nothing is uploaded until it is
+   * drawn, so a QuadBatch can be made before there is a graphics context.
+   */
+  QuadBatch();
+
+  /**
+   * Removes every rectangle, to be filled with new ones.
+   */
+  void Clear();
+
+  /**
+   * Adds a solid rectangle over every rectangle added before it.
+   * @param rectangle Where the rectangle is
+   * @param color The color of the rectangle
+   */
+  void AddRectangle(const ci::Rectf& rectangle, const ci::ColorA& color);
+
+  /**
+   * Draws every rectangle with one call, uploading them first if they have
+   * changed since they were last drawn.
+   */
+  void Draw();
+
+  size_t GetNumberOfRectangles() const;
+
+  /**
+   * Returns whether the next draw uploads the rectangles.
+   * @return Whether the rectangles changed since they were last drawn
+   */
+  bool IsDirty() const;
+
+ private:
+  ci::TriMesh mesh_;
+  size_t number_of_rectangles_;
+  bool is_dirty_;
+
+  ci::gl::GlslProgRef shader_;
+  ci::gl::BatchRef batch_;
+};
+
+}   // namespace adventure
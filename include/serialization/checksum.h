@@ -0,0 +1,62 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "entities/enemy.h"
+#include "entities/player.h"
+#include "items/weapon.h"
+#include "map/copy_on_write_map.h"
+#include "map/door.h"
+#include "map/room.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Accumulates a 64-bit FNV-1a hash over game state, so that two states can be
+ * compared for byte-for-byte equality without keeping both around.
+ */
+class Checksum {
+ public:
+  /**
+   * Internally starts the hash at the FNV-1a offset basis.
+   */
+  Checksum();
+
+  uint64_t GetValue() const;
+
+  void Add(uint64_t value);
+
+  void Add(const std::string& text);
+
+  void Add(const Weapon& weapon);
+
+  void Add(const Enemy& enemy);
+
+  void Add(const Door& door);
+
+  void Add(const Room& room);
+
+  void Add(const Player& player);
+
+  /**
+   * Hashes every Room of a dungeon map in order.
+   * @param map The vector of Rooms being hashed
+   */
+  void Add(const std::vector<Room>& map);
+
+  /**
+   * Hashes every Room of a copy-on-write dungeon map in order, giving the same
+   * value as the equivalent vector of Rooms.
+   * @param map The CopyOnWriteMap being hashed
+   */
+  void Add(const CopyOnWriteMap& map);
+
+ private:
+  uint64_t value_;
+};
+
+}   // namespace adventure
@@ -0,0 +1,154 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "mechanics/engine.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * A single command executed during a recorded session, along with the time
+ * since the command before it.
+ */
+struct ReplayEntry {
+  Command command;
+  uint32_t elapsed_ms;
+  std::string qualifier;
+};
+
+/**
+ * Takes in a random seed and a dungeon checksum for a log of every command
+ * executed in a session, which can be written to and read from a compact
+ * varint-encoded binary file and replayed headlessly on a fresh Engine.
+ */
+class ReplayLog {
+ public:
+  /**
+   * Internally loads an empty log with a seed and checksums of zero. This is
+   * recommended for use with the operator>> overload.
+   */
+  ReplayLog();
+
+  /**
+   * Loads in the seed the Engine's random number generator started from and
+   * the checksum of the dungeon map the session started on.
+   * @param seed The starting random seed
+   * @param dungeon_checksum The checksum of the starting dungeon map
+   */
+  ReplayLog(uint64_t seed, uint64_t dungeon_checksum);
+
+  uint64_t GetSeed() const;
+
+  uint64_t GetDungeonChecksum() const;
+
+  uint64_t GetFinalChecksum() const;
+
+  const std::vector<ReplayEntry> &GetEntries() const;
+
+  void SetFinalChecksum(uint64_t final_checksum);
+
+  /**
+   * Appends an executed command to the back of the log.
+   * @param command The command that was executed
+   * @param qualifier The qualifier the command acted on
+   * @param elapsed_ms The milliseconds since the previous command
+   */
+  void Record(Command command, const std::string& qualifier,
+              uint32_t elapsed_ms);
+
+  /**
+   * Seeds the Engine and re-executes every command in the log as fast as
+   * possible. Throws an error if the Engine's dungeon map does not match the
+   * recorded dungeon checksum.
+   * @param engine The freshly constructed Engine being replayed on
+   * @return Whether the final state matches the recorded final checksum
+   */
+  bool Replay(Engine& engine) const;
+
+  /**
+   * Writes the log as a magic string followed by varints for the seed,
+   * dungeon checksum, every command, an end marker, and the final checksum.
+   * @param os The out-stream being written to
+   * @param log The ReplayLog being written
+   * @return The out-stream that went into the operator
+   */
+  friend std::ostream &operator<<(std::ostream& os, const ReplayLog& log);
+
+  /**
+   * Reads a log written by the operator<< overload. Throws an error if the
+   * file is invalid or cut short.
+   * @param is The in-stream being read from
+   * @param log The ReplayLog being loaded into
+   * @return The in-stream that went into the operator
+   */
+  friend std::istream &operator>>(std::istream& is, ReplayLog& log);
+
+ private:
+  uint64_t seed_;
+  uint64_t dungeon_checksum_;
+  uint64_t final_checksum_;
+  std::vector<ReplayEntry> entries_;
+};
+
+/**
+ * Takes in a buffer, such as a mapped file, holding one or more logs written
+ * by ReplayLog's operator<< back to back, and decodes them one command at a
+ * time without copying the whole log.
+ */
+class ReplayReader {
+ public:
+  /**
+   * Loads in the buffer being read. Nothing is decoded until Begin is
+   * called.
+   * @param data The bytes of the logs
+   * @param size The number of bytes
+   */
+  ReplayReader(const uint8_t* data, size_t size);
+
+  /**
+   * Returns whether there are bytes left after the last log read.
+   * @return Whether another log may follow
+   */
+  bool HasNext() const;
+
+  /**
+   * Decodes the header of the next log. Throws an error if it is invalid.
+   * @param seed Set to the log's starting random seed
+   * @param dungeon_checksum Set to the checksum of the log's starting map
+   */
+  void Begin(uint64_t& seed, uint64_t& dungeon_checksum);
+
+  /**
+   * Decodes the log's next command. Throws an error if the log is invalid
+   * or cut short.
+   * @param entry Set to the command, if there is one
+   * @return Whether a command was decoded, or false once the log has ended
+   */
+  bool Next(ReplayEntry& entry);
+
+  /**
+   * Returns the checksum of the final state of the log just ended.
+   * @return The log's final checksum
+   */
+  uint64_t GetFinalChecksum() const;
+
+  size_t GetPosition() const;
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t position_;
+  uint64_t final_checksum_;
+
+  /**
+   * Decodes a varint and moves past it. Throws an error if it is cut short.
+   */
+  uint64_t ReadVarint();
+};
+
+}   // namespace adventure
@@ -0,0 +1,64 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace adventure {
+
+// The most bytes a 64-bit varint can take up
+const size_t kMaxVarintSize = 10;
+
+/**
+ * Encodes an unsigned integer as a little-endian base-128 varint, where each
+ * byte holds seven bits and the high bit marks that more bytes follow.
+ * @param value The integer being encoded
+ * @param buffer The buffer of at least kMaxVarintSize bytes written to
+ * @return The number of bytes written
+ */
+size_t EncodeVarint(uint64_t value, uint8_t* buffer);
+
+/**
+ * Decodes a varint from the front of a buffer.
+ * @param buffer The buffer being read from
+ * @param size The number of bytes available in the buffer
+ * @param value The decoded integer
+ * @return The number of bytes read, or 0 if the buffer ends mid-varint or
+ * the varint is malformed
+ */
+size_t DecodeVarint(const uint8_t* buffer, size_t size, uint64_t& value);
+
+/**
+ * Writes an unsigned integer to an out-stream as a varint.
+ * @param os The out-stream being written to
+ * @param value The integer being written
+ */
+void WriteVarint(std::ostream& os, uint64_t value);
+
+/**
+ * Reads a varint from an in-stream. Throws an error if the stream ends
+ * mid-varint or the varint is malformed.
+ * @param is The in-stream being read from
+ * @return The decoded integer
+ */
+uint64_t ReadVarint(std::istream& is);
+
+/**
+ * Writes a string to an out-stream as a varint length followed by its bytes.
+ * @param os The out-stream being written to
+ * @param text The string being written
+ */
+void WriteVarintString(std::ostream& os, const std::string& text);
+
+/**
+ * Reads a string written by WriteVarintString. Throws an error if the stream
+ * ends early.
+ * @param is The in-stream being read from
+ * @return The decoded string
+ */
+std::string ReadVarintString(std::istream& is);
+
+}   // namespace adventure
@@ -0,0 +1,146 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "entities/player.h"
+#include "map/dungeon.h"
+#include "mechanics/engine.h"
+#include "server/replication_primary.h"
+#include "statistics/game_statistics.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Takes in a Unix domain socket path, a shared Dungeon, a starting Player,
+ * and a number of threads for a headless server that hosts one Engine
+ * session per client connection. Each thread runs its own epoll event loop
+ * and accepts its own connections, so sessions never move between threads
+ * and need no locking. Linux only.
+ */
+class GameServer {
+ public:
+  /**
+   * Loads in where to listen, what every session starts from, and how many
+   * event loops to run. Throws an error if the socket cannot be bound or the
+   * number of threads is zero.
+   * @param socket_path The path of the Unix domain socket to listen on
+   * @param dungeon The shared Dungeon every session plays through
+   * @param player The Player every session starts as
+   * @param number_of_threads The number of event loop threads
+   */
+  GameServer(const std::string& socket_path,
+             std::shared_ptr<const Dungeon> dungeon, const Player& player,
+             size_t number_of_threads);
+
+  /**
+   * Stops the server and removes the socket file.
+   */
+  ~GameServer();
+
+  GameServer(const GameServer&) = delete;
+
+  GameServer &operator=(const GameServer&) = delete;
+
+  /**
+   * Runs the event loops until Stop is called, blocking the calling thread,
+   * which serves as the first event loop.
+   */
+  void Run();
+
+  /**
+   * Wakes every event loop and makes Run return. Safe to call from any
+   * thread or a signal handler.
+   */
+  void Stop();
+
+  /**
+   * Replicates every session to a standby from now on: each new session's
+   * starting Engine and every command it executes. Must be called before
+   * Run.
+   * @param replication The primary side of the connection to the standby
+   */
+  void ReplicateTo(std::shared_ptr<ReplicationPrimary> replication);
+
+  /**
+   * Reports the kills, deaths, and wins of every new session to shared
+   * statistics, with wins ranked under their session. Must be called before
+   * Run.
+   * @param statistics The statistics being reported to
+   */
+  void ReportTo(std::shared_ptr<GameStatistics> statistics);
+
+ private:
+  // A connection stops being read from once this many response bytes are
+  // waiting to be sent, and resumes once they drain below the low mark
+  const size_t kHighWaterMark = 64 * 1024;
+  const size_t kLowWaterMark = 16 * 1024;
+  const int kMaxEvents = 64;
+
+  /**
+   * A client connection and the session it plays.
+   */
+  struct Connection {
+    int fd;
+    uint64_t session;
+    Engine engine;
+    std::string input;
+    std::string output;
+    size_t output_offset;
+    bool is_reading;
+    bool is_writing;
+  };
+
+  std::string socket_path_;
+  std::shared_ptr<const Dungeon> dungeon_;
+  Player player_;
+  size_t number_of_threads_;
+
+  int listen_fd_;
+  int wake_fd_;
+  std::atomic<bool> is_running_;
+  std::atomic<uint64_t> next_session_;
+  std::shared_ptr<ReplicationPrimary> replication_;
+  std::shared_ptr<GameStatistics> statistics_;
+
+  /**
+   * Runs a single event loop until the server stops.
+   */
+  void RunEventLoop();
+
+  /**
+   * Accepts every pending connection onto the given event loop.
+   */
+  void AcceptConnections(int epoll_fd,
+                         std::unordered_map<int, std::unique_ptr<Connection>>&
+                             connections);
+
+  /**
+   * Reads whatever is available, executes every complete Request in order,
+   * and queues the matching StateUpdates.
+   * @return Whether the connection is still open
+   */
+  bool ReadRequests(Connection& connection);
+
+  /**
+   * Writes as much queued output as the socket accepts.
+   * @return Whether the connection is still open
+   */
+  bool WriteUpdates(Connection& connection);
+
+  /**
+   * Updates which events the loop waits for on a connection, pausing reads
+   * while too much output is queued and waiting for writability while any
+   * output is queued.
+   */
+  void UpdateInterest(int epoll_fd, Connection& connection);
+};
+
+}   // namespace adventure
@@ -0,0 +1,143 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "mechanics/engine.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace adventure {
+
+// The largest frame payload either side will accept
+const size_t kMaxFrameSize = 4096;
+
+// Replication frames can carry a whole Engine snapshot, so they may be larger
+const size_t kMaxReplicationFrameSize = 1024 * 1024;
+
+/**
+ * A command sent by a client. The id is echoed back in the matching
+ * StateUpdate so that many requests can be pipelined on one connection.
+ */
+struct Request {
+  uint64_t id;
+  Command command;
+  std::string qualifier;
+};
+
+/**
+ * The state of a session after a Request was executed, as sent back to the
+ * client.
+ */
+struct StateUpdate {
+  uint64_t id;
+  std::string message;
+  std::string location;
+  uint64_t health;
+  uint64_t number_of_keys;
+  uint64_t number_of_weapons;
+};
+
+/**
+ * The kinds of frames on a replication stream. The primary sends the first
+ * four; the standby sends acknowledgements and resync requests back.
+ */
+enum class ReplicationType : uint8_t {
+  kSessionStarted,
+  kCommand,
+  kStateHash,
+  kSessionEnded,
+  kAcknowledgement,
+  kResyncRequested
+};
+
+/**
+ * One frame of a replication stream. Which fields are meaningful depends on
+ * the type:
+ * - kSessionStarted: data holds a snapshot of the session's Engine,
+ *   including its random number generator
+ * - kCommand: command and data (the qualifier) were executed as the
+ *   session's sequence-th command, and value is when the primary sent it in
+ *   steady clock microseconds
+ * - kStateHash: value is the session's Engine checksum after its sequence-th
+ *   command
+ * - kAcknowledgement: sequence counts every frame the standby has applied
+ * - kResyncRequested: the standby wants a new snapshot of the session
+ */
+struct ReplicationFrame {
+  ReplicationType type;
+  uint64_t session;
+  uint64_t sequence;
+  uint64_t value;
+  Command command;
+  std::string data;
+};
+
+/**
+ * Appends a Request to a buffer as a frame: a varint payload length followed
+ * by varints for the id and command and a varint-prefixed qualifier.
+ * @param request The Request being encoded
+ * @param buffer The buffer the frame is appended to
+ */
+void EncodeRequest(const Request& request, std::string& buffer);
+
+/**
+ * Decodes a Request frame from the front of a buffer. Throws an error if the
+ * frame is malformed or larger than kMaxFrameSize.
+ * @param data The buffer being read from
+ * @param size The number of bytes available in the buffer
+ * @param request The decoded Request
+ * @return The number of bytes in the frame, or 0 if the frame is incomplete
+ */
+size_t DecodeRequest(const char* data, size_t size, Request& request);
+
+/**
+ * Appends a StateUpdate to a buffer as a frame: a varint payload length
+ * followed by varints for every field, with strings prefixed by their
+ * varint lengths.
+ * @param update The StateUpdate being encoded
+ * @param buffer The buffer the frame is appended to
+ */
+void EncodeStateUpdate(const StateUpdate& update, std::string& buffer);
+
+/**
+ * Decodes a StateUpdate frame from the front of a buffer. Throws an error if
+ * the frame is malformed or larger than kMaxFrameSize.
+ * @param data The buffer being read from
+ * @param size The number of bytes available in the buffer
+ * @param update The decoded StateUpdate
+ * @return The number of bytes in the frame, or 0 if the frame is incomplete
+ */
+size_t DecodeStateUpdate(const char* data, size_t size, StateUpdate& update);
+
+/**
+ * Appends a ReplicationFrame to a buffer as a frame: a varint payload length
+ * followed by varints for every field, with the data prefixed by its varint
+ * length.
+ * @param frame The ReplicationFrame being encoded
+ * @param buffer The buffer the frame is appended to
+ */
+void EncodeReplicationFrame(const ReplicationFrame& frame,
+                            std::string& buffer);
+
+/**
+ * Decodes a ReplicationFrame from the front of a buffer. Throws an error if
+ * the frame is malformed or larger than kMaxReplicationFrameSize.
+ * @param data The buffer being read from
+ * @param size The number of bytes available in the buffer
+ * @param frame The decoded ReplicationFrame
+ * @return The number of bytes in the frame, or 0 if the frame is incomplete
+ */
+size_t DecodeReplicationFrame(const char* data, size_t size,
+                              ReplicationFrame& frame);
+
+/**
+ * Fills a StateUpdate from the current state of an Engine.
+ * @param id The id of the Request that was executed
+ * @param engine The Engine the Request was executed on
+ * @param update The StateUpdate being filled
+ */
+void FillStateUpdate(uint64_t id, const Engine& engine, StateUpdate& update);
+
+}   // namespace adventure
@@ -0,0 +1,136 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "mechanics/engine.h"
+#include "server/protocol.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace adventure {
+
+/**
+ * Takes in the Unix domain socket path of a ReplicationStandby and a hash
+ * interval for the primary side of hot-standby replication. Each session is
+ * sent as a snapshot of its Engine when it starts, followed by every command
+ * it executes, and every hash interval commands by a checksum of its state
+ * so the standby can detect divergence. Frames are queued without blocking
+ * and sent by a background thread, which also reads the standby's
+ * acknowledgements to measure replication lag. Linux only.
+ */
+class ReplicationPrimary {
+ public:
+  /**
+   * Connects to the standby and starts the sender thread. Throws an error if
+   * the hash interval is zero or the standby cannot be reached.
+   * @param socket_path The path of the standby's Unix domain socket
+   * @param hash_interval How many commands a session runs between checksums
+   */
+  ReplicationPrimary(const std::string& socket_path, size_t hash_interval);
+
+  /**
+   * Sends the frames still queued, then stops the sender thread and
+   * disconnects.
+   */
+  ~ReplicationPrimary();
+
+  ReplicationPrimary(const ReplicationPrimary&) = delete;
+
+  ReplicationPrimary &operator=(const ReplicationPrimary&) = delete;
+
+  /**
+   * Queues a snapshot of a new session. Safe to call from any thread.
+   * @param session The id of the session
+   * @param engine The session's Engine before its first command
+   */
+  void StartSession(uint64_t session, const Engine& engine);
+
+  /**
+   * Queues a command a session has just executed, followed by a checksum if
+   * one is due, or by a new snapshot if the standby asked for one. Safe to
+   * call from any thread, but each session must only be replicated from one
+   * thread at a time.
+   * @param session The id of the session
+   * @param command The command that was executed
+   * @param qualifier The qualifier the command acted on
+   * @param engine The session's Engine after the command
+   */
+  void Replicate(uint64_t session, Command command,
+                 const std::string& qualifier, const Engine& engine);
+
+  /**
+   * Queues the end of a session.
+   * @param session The id of the session
+   */
+  void EndSession(uint64_t session);
+
+  /**
+   * Returns whether the standby is still connected. Once it disconnects,
+   * nothing more is queued.
+   * @return Whether the standby is connected
+   */
+  bool IsConnected() const;
+
+  uint64_t GetNumberOfSentFrames() const;
+
+  uint64_t GetNumberOfAcknowledgedFrames() const;
+
+  /**
+   * Returns how many frames have been queued but not yet applied by the
+   * standby.
+   * @return The replication lag in frames
+   */
+  uint64_t GetLag() const;
+
+ private:
+  const std::chrono::milliseconds kIdleInterval =
+      std::chrono::milliseconds(5);
+
+  size_t hash_interval_;
+  int fd_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable queued_;
+  std::string pending_;
+  std::unordered_map<uint64_t, uint64_t> sequences_;
+  std::unordered_set<uint64_t> resync_requests_;
+  bool is_stopping_;
+
+  std::atomic<bool> is_connected_;
+  std::atomic<uint64_t> number_of_queued_;
+  std::atomic<uint64_t> number_of_sent_;
+  std::atomic<uint64_t> number_of_acknowledged_;
+  std::thread sender_;
+
+  /**
+   * Encodes a frame onto the pending bytes. Must be called with the mutex
+   * held.
+   */
+  void Queue(const ReplicationFrame& frame);
+
+  /**
+   * Reads whatever the standby has sent back without blocking.
+   * @return Whether the standby is still connected
+   */
+  bool ReadReplies(std::string& input);
+
+  void Run();
+};
+
+/**
+ * Returns the current time on the steady clock in microseconds, which on
+ * Linux is the same for every process on the machine, so it can timestamp
+ * frames sent between processes.
+ * @return The current steady clock time in microseconds
+ */
+uint64_t GetSteadyMicroseconds();
+
+}   // namespace adventure
@@ -0,0 +1,121 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "entities/player.h"
+#include "map/dungeon.h"
+#include "mechanics/engine.h"
+#include "server/protocol.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace adventure {
+
+/**
+ * Takes in a Unix domain socket path and a shared Dungeon for the standby
+ * side of hot-standby replication. It accepts one ReplicationPrimary and
+ * applies every session's commands as they arrive, so its Engines are always
+ * current and taking over only means handing them out. It measures how far
+ * behind the primary it is and compares the checksums the primary sends,
+ * asking for a new snapshot of any session that diverged. Linux only.
+ */
+class ReplicationStandby {
+ public:
+  /**
+   * Loads in where to listen and the Dungeon every replicated session plays
+   * through. Throws an error if the socket cannot be bound.
+   * @param socket_path The path of the Unix domain socket to listen on
+   * @param dungeon The shared Dungeon every session plays through
+   */
+  ReplicationStandby(const std::string& socket_path,
+                     std::shared_ptr<const Dungeon> dungeon);
+
+  /**
+   * Removes the socket file.
+   */
+  ~ReplicationStandby();
+
+  ReplicationStandby(const ReplicationStandby&) = delete;
+
+  ReplicationStandby &operator=(const ReplicationStandby&) = delete;
+
+  /**
+   * Waits for a primary, then applies what it sends until it disconnects or
+   * Stop is called, blocking the calling thread.
+   * @return Whether the primary disconnected, rather than Stop being called
+   */
+  bool Run();
+
+  /**
+   * Makes Run return. Safe to call from any thread or a signal handler.
+   */
+  void Stop();
+
+  /**
+   * Hands out the replicated Engines by session so they can be served in
+   * place of the primary's. Must only be called once Run has returned.
+   * @return The replicated Engines by session
+   */
+  std::map<uint64_t, Engine> TakeOver();
+
+  size_t GetNumberOfSessions() const;
+
+  uint64_t GetNumberOfAppliedFrames() const;
+
+  uint64_t GetNumberOfHashChecks() const;
+
+  /**
+   * Returns how many checksums did not match, each of which made the
+   * standby ask for a new snapshot of that session.
+   * @return The number of divergences detected
+   */
+  uint64_t GetNumberOfDivergences() const;
+
+  /**
+   * Returns how long the most recently applied command took from being sent
+   * by the primary to being applied here.
+   * @return The replication lag in microseconds
+   */
+  uint64_t GetLastLag() const;
+
+  uint64_t GetMaxLag() const;
+
+ private:
+  std::string socket_path_;
+  std::shared_ptr<const Dungeon> dungeon_;
+
+  int listen_fd_;
+  int wake_fd_;
+  std::atomic<bool> is_running_;
+
+  // Only the thread in Run touches the Engines until it returns
+  std::map<uint64_t, Engine> engines_;
+  std::set<uint64_t> diverged_sessions_;
+
+  std::atomic<size_t> number_of_sessions_;
+  std::atomic<uint64_t> number_of_applied_;
+  std::atomic<uint64_t> number_of_hash_checks_;
+  std::atomic<uint64_t> number_of_divergences_;
+  std::atomic<uint64_t> last_lag_;
+  std::atomic<uint64_t> max_lag_;
+
+  /**
+   * Applies one frame from the primary, queuing any reply.
+   */
+  void Apply(const ReplicationFrame& frame, std::string& output);
+
+  /**
+   * Reads and applies frames from a connected primary until it disconnects
+   * or the standby stops.
+   * @return Whether the primary disconnected
+   */
+  bool Serve(int fd);
+};
+
+}   // namespace adventure
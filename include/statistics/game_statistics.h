@@ -0,0 +1,125 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "entities/enemy.h"
+#include "map/dungeon.h"
+#include "statistics/leaderboard.h"
+#include "statistics/sharded_counters.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Takes in a Dungeon, a number of shards, and a leaderboard size for live
+ * statistics gathered across every session playing through the Dungeon:
+ * kills per type of Enemy, deaths per Room, wins, how many commands wins
+ * took, and the fastest wins. Events are recorded into per-thread shards,
+ * so recording from many sessions at once never contends, and are merged
+ * when read.
+ */
+class GameStatistics {
+ public:
+  /**
+   * Loads in the Dungeon whose Enemies and Rooms are counted, how many
+   * shards events are recorded into, and how many of the fastest wins are
+   * ranked. Throws an error if the Dungeon has no Rooms, or if the number of
+   * shards or the leaderboard size is zero.
+   * @param dungeon The Dungeon being played through
+   * @param number_of_shards The number of shards, ideally at least the
+   * number of threads recording events
+   * @param leaderboard_size The number of fastest wins ranked
+   */
+  GameStatistics(const Dungeon& dungeon, size_t number_of_shards,
+                 size_t leaderboard_size);
+
+  GameStatistics(const GameStatistics&) = delete;
+
+  GameStatistics &operator=(const GameStatistics&) = delete;
+
+  /**
+   * Counts an Enemy being killed, found by the address of its interned
+   * archetype rather than by its nickname. Enemies that are not in the
+   * Dungeon are not counted.
+   * @param enemy The archetype of the Enemy killed
+   */
+  void RecordKill(const EnemyArchetype& enemy);
+
+  /**
+   * Counts a Player dying. Throws an error if the Room is out of range.
+   * @param room The index of the Room the Player died in
+   */
+  void RecordDeath(size_t room);
+
+  /**
+   * Counts a win and ranks how many commands it took.
+   * @param id What won, e.g. the session
+   * @param number_of_commands The number of commands the win took
+   */
+  void RecordWin(uint64_t id, uint64_t number_of_commands);
+
+  /**
+   * Returns how many times an Enemy was killed. Throws an error if the
+   * Enemy is not in the Dungeon.
+   * @param enemy The nickname of the Enemy
+   * @return The number of kills
+   */
+  uint64_t GetKills(const std::string& enemy) const;
+
+  /**
+   * Returns how many Players died in a Room. Throws an error if the Room is
+   * out of range.
+   * @param room The index of the Room
+   * @return The number of deaths
+   */
+  uint64_t GetDeaths(size_t room) const;
+
+  uint64_t GetWins() const;
+
+  /**
+   * Returns how many wins took each power-of-two range of commands, as
+   * bucketed by ShardedHistogram.
+   * @return The number of wins in each bucket
+   */
+  std::vector<uint64_t> GetWinHistogram() const;
+
+  /**
+   * Returns the fastest wins, by number of commands.
+   * @return The fastest wins, fastest first
+   */
+  std::vector<LeaderboardEntry> GetFastestWins() const;
+
+  /**
+   * Writes a snapshot of every statistic to a text file, atomically
+   * replacing it. Throws an error if the file cannot be written.
+   * @param path The path of the snapshot file
+   */
+  void Export(const std::string& path) const;
+
+ private:
+  // Counter zero counts wins, followed by the kills of each type of Enemy
+  // and then the deaths in each Room
+  static const size_t kWinsCounter = 0;
+
+  std::vector<std::string> enemies_;
+  std::unordered_map<std::string, size_t> enemy_indices_;
+  // The kinds of Enemy that share a nickname share its counter
+  std::unordered_map<const EnemyArchetype*, size_t> archetype_indices_;
+  std::vector<std::string> rooms_;
+
+  ShardedCounters counters_;
+  ShardedHistogram win_commands_;
+  Leaderboard fastest_wins_;
+
+  /**
+   * Lists the nickname of every type of Enemy in the Dungeon, in the order
+   * they first appear.
+   */
+  static std::vector<std::string> ListEnemies(const Dungeon& dungeon);
+};
+
+}   // namespace adventure
@@ -0,0 +1,75 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * One ranked result. Lower scores rank higher.
+ */
+struct LeaderboardEntry {
+  uint64_t id;
+  uint64_t score;
+};
+
+/**
+ * Takes in a capacity and a number of shards for a leaderboard of the best
+ * (lowest) scores submitted from any number of threads. Each thread submits
+ * to its own shard, which keeps its own best entries, and reading merges
+ * the shards. A shard publishes the score an entry must match or beat, so
+ * the many submissions that would not rank are turned away without taking
+ * a lock.
+ */
+class Leaderboard {
+ public:
+  /**
+   * Loads in how many entries are ranked and how many shards they are
+   * submitted to. Throws an error if either is zero.
+   * @param capacity The number of entries ranked
+   * @param number_of_shards The number of shards entries are submitted to
+   */
+  Leaderboard(size_t capacity, size_t number_of_shards);
+
+  Leaderboard(const Leaderboard&) = delete;
+
+  Leaderboard &operator=(const Leaderboard&) = delete;
+
+  size_t GetCapacity() const;
+
+  /**
+   * Submits a score to the calling thread's shard, where it is kept if it
+   * ranks among the shard's best.
+   * @param id What the score belongs to
+   * @param score The score, where lower ranks higher
+   */
+  void Submit(uint64_t id, uint64_t score);
+
+  /**
+   * Merges every shard into the overall best entries.
+   * @return Up to capacity entries, from the lowest score up, with ties in
+   * order of id
+   */
+  std::vector<LeaderboardEntry> GetTop() const;
+
+ private:
+  struct Shard {
+    std::mutex mutex;
+    std::vector<LeaderboardEntry> entries;
+
+    // The worst score kept once the shard is full. Entries scoring worse
+    // are turned away, and ties are ranked by id
+    std::atomic<uint64_t> cutoff;
+  };
+
+  size_t capacity_;
+  size_t number_of_shards_;
+  std::unique_ptr<Shard[]> shards_;
+};
+
+}   // namespace adventure
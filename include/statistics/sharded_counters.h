@@ -0,0 +1,110 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Returns the shard the calling thread records into. Threads are numbered
+ * in the order they first ask, so as long as there are at least as many
+ * shards as threads, no two threads share a shard.
+ * @return The calling thread's shard number, before being wrapped around
+ * the number of shards
+ */
+size_t GetThreadShard();
+
+/**
+ * Takes in a number of counters and a number of shards for a set of
+ * counters that many threads can add to at once without contending. Every
+ * shard holds its own copy of each counter on its own cache lines, each
+ * thread adds to its own shard, and reading a counter adds up its copies,
+ * so recording is a single uncontended atomic add while reading costs one
+ * load per shard.
+ */
+class ShardedCounters {
+ public:
+  /**
+   * Loads in the number of counters and shards. Throws an error if either
+   * is zero.
+   * @param number_of_counters The number of counters
+   * @param number_of_shards The number of copies of each counter
+   */
+  ShardedCounters(size_t number_of_counters, size_t number_of_shards);
+
+  ShardedCounters(const ShardedCounters&) = delete;
+
+  ShardedCounters &operator=(const ShardedCounters&) = delete;
+
+  size_t GetNumberOfCounters() const;
+
+  size_t GetNumberOfShards() const;
+
+  /**
+   * Adds to a counter in the calling thread's shard. Throws an error if the
+   * counter is out of range.
+   * @param counter The index of the counter
+   * @param amount The amount being added
+   */
+  void Add(size_t counter, uint64_t amount = 1);
+
+  /**
+   * Adds up a counter's copies across every shard. Adds made at the same
+   * time may or may not be included.
+   * @param counter The index of the counter
+   * @return The counter's total
+   */
+  uint64_t Get(size_t counter) const;
+
+ private:
+  static const size_t kCacheLineWords = 64 / sizeof(uint64_t);
+
+  size_t number_of_counters_;
+  size_t number_of_shards_;
+
+  // Each shard starts on its own cache line, so shards never falsely share
+  std::unique_ptr<std::atomic<uint64_t>[]> words_;
+  size_t first_word_;
+  size_t shard_stride_;
+};
+
+/**
+ * Takes in a number of shards for a histogram of unsigned values that many
+ * threads can record into at once. Values are grouped into power-of-two
+ * buckets: bucket zero holds zero, and bucket b holds the values from
+ * 2^(b - 1) to 2^b - 1.
+ */
+class ShardedHistogram {
+ public:
+  static const size_t kNumberOfBuckets = 65;
+
+  /**
+   * Loads in the number of shards. Throws an error if it is zero.
+   * @param number_of_shards The number of copies of each bucket
+   */
+  explicit ShardedHistogram(size_t number_of_shards);
+
+  /**
+   * Returns the bucket a value falls into.
+   * @param value The value being bucketed
+   * @return The index of the value's bucket
+   */
+  static size_t GetBucket(uint64_t value);
+
+  void Record(uint64_t value);
+
+  /**
+   * Merges every shard into the count of values in each bucket.
+   * @return The counts of the buckets, from the smallest values up
+   */
+  std::vector<uint64_t> GetCounts() const;
+
+ private:
+  ShardedCounters counters_;
+};
+
+}   // namespace adventure
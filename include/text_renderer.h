@@ -0,0 +1,101 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#pragma once
+
+#include "cinder/gl/gl.h"
+#include "cinder/gl/TextureFont.h"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace adventure {
+
+/**
+ * Where a line of text is placed relative to the point it is drawn at.
+ */
+enum class TextAlignment {
+  kLeft,
+  kCenter,
+  kRight
+};
+
+/**
+ * Takes in the name of a font for a TextRenderer which draws lines of text
+ * out of glyph atlases. Each size of the font is rasterized into its own
+ * atlas the first time it is drawn, and each string is laid out into glyph
+ * placements the first time it is drawn at a size. Drawing a string that has
+ * not changed only hands its cached placements to the atlas, which draws
+ * them with one call, instead of rasterizing the string into a new texture.
+ */
+class TextRenderer {
+ public:
+  /**
+   * Loads in the name of the font every line of text is drawn with. No
+   * atlas is made until text is drawn, so a TextRenderer can be made before
+   * there is a graphics context.
+   * @param font_name The name of the font
+   */
+  explicit TextRenderer(const std::string& font_name);
+
+  /**
+   * Draws a line of text with its top at a point.
+   * @param text The text
+   * @param position Where the top of the text is, aligned by the alignment
+   * @param size The size of the font in pixels
+   * @param alignment Whether the point is the left, center, or right of
+   * the text
+   * @param color The color of the text
+   */
+  void Draw(const std::string& text, const glm::vec2& position, float size,
+            TextAlignment alignment, const ci::ColorA& color);
+
+  /**
+   * Returns the number of strings laid out and cached across every size.
+   * @return The number of cached layouts
+   */
+  size_t GetNumberOfLayouts() const;
+
+ private:
+  // Labels repeat, but messages and hit points keep making new strings, so
+  // an atlas forgets its layouts once it has this many
+  const size_t kMaxLayoutsPerSize = 256;
+
+  /**
+   * Where every glyph of a string goes relative to the start of its
+   * baseline, and how wide the string is.
+   */
+  struct Layout {
+    std::vector<std::pair<ci::Font::Glyph, glm::vec2>> placements;
+    float width;
+  };
+
+  /**
+   * The glyph atlas of one size of the font and the strings laid out in it.
+   */
+  struct Atlas {
+    ci::gl::TextureFontRef font;
+    std::unordered_map<std::string, Layout> layouts;
+  };
+
+  std::string font_name_;
+
+  // Keyed by the size of the font in whole pixels
+  std::map<int, Atlas> atlases_;
+
+  /**
+   * Returns the atlas of a size of the font, rasterizing it first if no
+   * text of that size has been drawn.
+   */
+  Atlas &FindAtlas(float size);
+
+  /**
+   * Returns the layout of a string in an atlas, laying it out first if it
+   * has not been drawn in that atlas.
+   */
+  const Layout &FindLayout(Atlas& atlas, const std::string& text);
+};
+
+}   // namespace adventure
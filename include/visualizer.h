@@ -4,6 +4,8 @@
 
 #include "cinder/gl/gl.h"
 
+#include "analytics/heatmap.h"
+
 #include "entities/enemy.h"
 #include "entities/player.h"
 
@@ -12,6 +14,13 @@
 #include "map/door.h"
 #include "map/room.h"
 
+#include "mechanics/game_snapshot.h"
+
+#include "layout.h"
+#include "map_view.h"
+#include "quad_batch.h"
+#include "text_renderer.h"
+
 namespace adventure {
 
 /**
@@ -21,8 +30,8 @@ namespace adventure {
 class Visualizer {
  public:
   /**
-   * Loads in a window width and window height as integers to initialize the
-   * bounds (plus initializes the main and sub-selections as 0, has toggled
+   * Loads in a window width and window height as integers to lay out the
+   * interface (plus initializes the main and sub-selections as 0, has toggled
    * panels as false, player information as a vector of four empty strings,
    * sub-actions as an empty vector of strings, action information as an
    * empty vector of strings, message as an empty string, and whether it is
@@ -74,8 +83,36 @@ class Visualizer {
    */
   void Display();
 
+  /**
+   * Lays the interface out again for a new window size.
+   * @param window_width The width of the app window
+   * @param window_height The height of the app window
+   */
+  void Resize(int window_width, int window_height);
+
+  /**
+   * Updates the selection and all the text that gets displayed from a
+   * snapshot of the game.
+   * @param snapshot The snapshot where the information is found
+   */
+  void Update(const GameSnapshot& snapshot);
+
   void UpdateMessage(const std::string& message, bool is_game_over);
 
+  /**
+   * Sets the Heatmap drawn over the map, where each Room is a cell shaded by
+   * how often it was visited. An empty Heatmap draws nothing.
+   * @param heatmap The Heatmap of room visits
+   */
+  void SetHeatmap(const Heatmap& heatmap);
+
+  /**
+   * Sets the Dungeon drawn on the map around the player, when there is no
+   * Heatmap to draw instead.
+   * @param dungeon The Dungeon being played
+   */
+  void SetDungeon(const std::shared_ptr<const Dungeon>& dungeon);
+
   /**
    * Updates the player information text that gets displayed.
    * @param player The Player where the information is found
@@ -84,103 +121,156 @@ class Visualizer {
 
   /**
    * Updates the sub-action text that gets displayed.
-   * @param enemies The vector of Enemies where the information is found
+   * @param enemies The page of Enemies where the information is found
    */
   void UpdateSubActionText(const std::vector<Enemy>& enemies);
 
   /**
    * Updates the sub-action text that gets displayed.
-   * @param weapons The vector of Weapons where the information is found
-   * @param number_of_keys The number of keys where the information is found
+   * @param weapons The page of Weapons where the information is found
+   * @param number_of_keys The number of keys listed on the page after the
+   * Weapons
    */
   void UpdateSubActionText(const std::vector<Weapon>& weapons,
                            size_t number_of_keys);
 
   /**
    * Updates the sub-action text that gets displayed.
-   * @param doors The vector of Doors where the information is found
+   * @param doors The page of Doors where the information is found
    */
   void UpdateSubActionText(const std::vector<Door>& doors);
 
   /**
    * Updates the sub-action text that gets displayed.
-   * @param enemies The vector of Enemies where the information is found
+   * @param enemies The page of Enemies where the information is found
    */
   void UpdateSubInformationText(const std::vector<Enemy>& enemies);
 
   /**
    * Updates the sub-information text that gets displayed.
-   * @param weapons The vector of Weapons where the information is found
+   * @param weapons The page of Weapons where the information is found
    */
   void UpdateSubInformationText(const std::vector<Weapon>& weapons);
 
   /**
    * Updates the sub-information text that gets displayed.
-   * @param doors The vector of Doors where the information is found
+   * @param doors The page of Doors where the information is found
    */
   void UpdateSubInformationText(const std::vector<Door>& doors);
 
 private:
-  const size_t kMaxBoxes = 4;
-
-  glm::vec2 bounds_;
+  Layout layout_;
 
   std::vector<std::string> player_information_;
+  // Only the labels of the page of sub-actions being shown
   std::vector<std::string> sub_actions_;
   std::vector<std::string> action_information_;
   std::string message_;
+  std::string sub_page_;
 
   size_t main_selection_;
   size_t sub_selection_;
+  size_t first_sub_action_;
+  size_t number_of_sub_actions_;
   bool has_toggled_panels_;
+  SubPanel sub_panel_;
 
   bool is_game_over_;
 
+  // The revision of the Engine the player information and sub-panel were
+  // last built from, so snapshots that only move the selection skip
+  // rebuilding the player information. The message is compared by its text
+  // and the map view keeps track of what it shows
+  uint64_t engine_revision_;
+
+  Heatmap heatmap_;
+  // Where each Heatmap cell is on the map in the current Layout, and the
+  // room name and number of visits written over it
+  std::vector<ci::Rectf> heatmap_cells_;
+  std::vector<std::string> heatmap_labels_;
+
+  MapView map_view_;
+
+  TextRenderer text_renderer_;
+
+  // The rectangles only change with the layout, so they are collected again
+  // when it changes instead of on every frame. The bars that go over the
+  // map view are kept apart, to be drawn after it
+  QuadBatch quads_;
+  QuadBatch overlay_quads_;
+  bool has_layout_changed_;
+
+  /**
+   * Fills the QuadBatch with every rectangle of the current layout.
+   */
+  void LoadQuads();
+
+  /**
+   * Lays the Heatmap's cells out over the map of the current Layout and
+   * makes their labels.
+   */
+  void LoadHeatmapCells();
+
   /**
    * Draws the game over display.
    */
   void DrawGameOver();
 
   /**
-   * Draws the panel with the main action buttons.
+   * Adds the panel with the main action buttons.
+   */
+  void AddActionPanel();
+
+  /**
+   * Adds the panels with the action sub-buttons and relevant information.
+   */
+  void AddSubPanels();
+
+  /**
+   * Adds the main action buttons.
+   */
+  void AddActionButtons();
+
+  /**
+   * Adds the action sub-buttons.
    */
-  void DrawActionPanel();
+  void AddSubActionButtons();
 
   /**
-   * Draws the panels with the action sub-buttons and relevant information.
+   * Draws the text labels for the main action buttons.
    */
-  void DrawSubPanels();
+  void DrawActionButtonText();
 
   /**
-   * Draws the main action buttons.
+   * Draws the text labels for the action sub-buttons.
    */
-  void DrawActionButtons(const glm::vec2& panel_center);
+  void DrawSubActionButtonText();
 
   /**
-   * Draws the action sub-buttons.
+   * Adds the bars that border the map portion of the app.
    */
-  void DrawSubActionButtons(const glm::vec2& panel_center);
+  void AddBorderBars();
 
   /**
-   * Draws the text label for a button.
+   * Adds a map that backdrops a message display.
    */
-  void DrawButtonText(const glm::vec2& button_center,
-                      const std::string &text) const;
+  void AddMap();
 
   /**
-   * Draws the bars that border the map portion of the app.
+   * Adds the Heatmap as a grid of cells over the map.
    */
-  void DrawBorderBars() const;
+  void AddHeatmap();
 
   /**
-   * Draws a map that backdrops a message display.
+   * Draws the room name and number of visits over each Heatmap cell the
+   * map shows.
    */
-  void DrawMap() const;
+  void DrawHeatmapText();
 
   /**
-   * Draws the bars that show player information.
+   * Adds the bars that show player information.
    */
-  void DrawInformationBars() const;
+  void AddInformationBars();
 
   /**
    * Draws the text label for information bars.
@@ -192,16 +282,36 @@ private:
    */
   void DrawSubInformationText();
 
+  /**
+   * Draws which page of the sub-actions is shown, if there is more than one.
+   */
+  void DrawSubPageText();
+
   /**
    * Draws the message displayer over the map.
    */
   void DrawMessage();
 
   /**
-   * Draws a solid rectangle based on a width, height, and center.
+   * Draws a line of text where an anchor of the Layout says.
+   */
+  void DrawText(const std::string& text, const TextAnchor& anchor,
+                const ci::ColorA& color);
+
+  /**
+   * Returns the number of sub-actions that have a button in the Layout.
+   */
+  size_t GetNumberOfSubActionButtons() const;
+
+  /**
+   * Returns the button of the sub-selection on the page being shown.
+   */
+  size_t GetSelectedSubActionButton() const;
+
+  /**
+   * Returns the color of a button, lighter when it is selected.
    */
-  static void DrawSolidRectangle(float width, float height,
-                                 const glm::vec2& center);
+  static ci::ColorA GetButtonColor(bool is_selected);
 };
 
 }   // namespace adventure
\ No newline at end of file
@@ -2,14 +2,43 @@
 
 #include "adventure_app.h"
 
+#include <chrono>
+#include <fstream>
+
 namespace adventure {
 
-AdventureApp::AdventureApp() : engine_(),
-                               visualizer_(kWindowWidth, kWindowHeight),
-                               last_button_index_(3) {
+AdventureApp::AdventureApp() : visualizer_(kWindowWidth, kWindowHeight),
+                               game_thread_(), last_activity_time_(0.0),
+                               is_idle_(false) {
   ci::app::setWindowSize(kWindowWidth, kWindowHeight);
+  setFrameRate(kActiveFrameRate);
+
+  std::unique_ptr<GameController> controller(new GameController());
+
+  uint64_t seed = (uint64_t)std::chrono::system_clock::now()
+                      .time_since_epoch().count();
+  controller->Seed(seed);
+
+  const std::vector<std::string>& args = getCommandLineArgs();
+  for (size_t arg = 0; arg + 1 < args.size(); ++arg) {
+    if (args[arg] == "--record") {
+      controller->StartRecording(args[arg + 1]);
+    } else if (args[arg] == "--heatmap") {
+      std::ifstream heatmap_file(args[arg + 1]);
+      Heatmap heatmap;
+
+      if (heatmap_file.is_open()) {
+        heatmap_file >> heatmap;
+        visualizer_.SetHeatmap(heatmap);
+      }
+    }
+  }
+
+  visualizer_.SetDungeon(controller->GetEngine().GetMap()
+                             .GetSharedDungeon());
 
-  engine_.SetMessage("WHAT WILL YOU DO?");
+  game_thread_.reset(new GameThread(std::move(controller)));
+  visualizer_.Update(game_thread_->GetSnapshot());
 }
 
 void AdventureApp::draw() {
@@ -19,203 +48,73 @@ void AdventureApp::draw() {
 }
 
 void AdventureApp::keyDown(ci::app::KeyEvent event) {
+  MarkActive();
+
   switch (event.getCode()) {
     case ci::app::KeyEvent::KEY_RIGHT:
-      if (!visualizer_.IsGameOver()) {
-        MoveSelectionRight();
-        break;
-      }
+      game_thread_->PushKey(Key::kRight);
+      break;
 
     case ci::app::KeyEvent::KEY_LEFT:
-      if (!visualizer_.IsGameOver()) {
-        MoveSelectionLeft();
-        break;
-      }
+      game_thread_->PushKey(Key::kLeft);
+      break;
 
     case ci::app::KeyEvent::KEY_RETURN:
-      if (!visualizer_.IsGameOver()) {
-        if (visualizer_.HasToggledPanels()) {
-          ExecuteCommand();
-
-          visualizer_.SetSubSelection(kFirstButton);
-          visualizer_.SetHasToggledPanels(false);
-
-          last_button_index_ = 3;
-        } else {
-          visualizer_.SetHasToggledPanels(true);
-        }
-        break;
-      }
+      game_thread_->PushKey(Key::kReturn);
+      break;
 
     case ci::app::KeyEvent::KEY_ESCAPE:
-      if (visualizer_.HasToggledPanels()) {
-        visualizer_.SetSubSelection(kFirstButton);
-        visualizer_.SetHasToggledPanels(false);
-
-        last_button_index_ = 3;
-        break;
-      } else {
-        ci::app::App::quit();
-        break;
-      }
-  }
-}
-
-void AdventureApp::update() {
-  visualizer_.UpdatePlayerInformationText(engine_.GetPlayer());
+      game_thread_->PushKey(Key::kEscape);
+      break;
 
-  if (engine_.GetMessage() == "YOU WIN" || engine_.GetMessage() == "YOU LOSE") {
-    visualizer_.UpdateMessage(engine_.GetMessage(), true);
-  } else {
-    visualizer_.UpdateMessage(engine_.GetMessage(), false);
-  }
-
-
-  if (visualizer_.HasToggledPanels()) {
-    if (visualizer_.GetMainSelection() == kFirstButton) {
-      LoadFightOptions();
-    } else if (visualizer_.GetMainSelection() == kSecondButton) {
-      LoadTakeOptions();
-    } else if (visualizer_.GetMainSelection() == kThirdButton) {
-      LoadDropOptions();
-    } else if (visualizer_.GetMainSelection() == kFourthButton) {
-      LoadGoOptions();
-    }
-  }
-}
+    case ci::app::KeyEvent::KEY_UP:
+      game_thread_->PushKey(Key::kUp);
+      break;
 
-void AdventureApp::ExecuteCommand() {
-  engine_.SetQualifier(visualizer_.GetSubActions()
-                           .at(visualizer_.GetSubSelection()));
-
-  if (visualizer_.GetMainSelection() == kFirstButton) {
-    engine_.Fight();
-  } else if (visualizer_.GetMainSelection() == kSecondButton) {
-    engine_.Take();
-  } else if (visualizer_.GetMainSelection() == kThirdButton) {
-    engine_.Drop();
-  } else if (visualizer_.GetMainSelection() == kFourthButton) {
-    engine_.Go();
+    case ci::app::KeyEvent::KEY_DOWN:
+      game_thread_->PushKey(Key::kDown);
+      break;
   }
 }
 
-void AdventureApp::MoveSelectionLeft() {
-  if (visualizer_.HasToggledPanels()) {
-    if (visualizer_.GetSubSelection() == kFirstButton) {
-      visualizer_.SetSubSelection(last_button_index_);
-    } else {
-      visualizer_.DecrementSubSelection();
-    }
-  } else {
-    if (visualizer_.GetMainSelection() == kFirstButton) {
-      visualizer_.SetMainSelection(last_button_index_);
-    } else {
-      visualizer_.DecrementMainSelection();
+void AdventureApp::update() {
+  if (!game_thread_->UpdateSnapshot()) {
+    if (!is_idle_ &&
+        ci::app::getElapsedSeconds() - last_activity_time_ > kIdleSeconds) {
+      setFrameRate(kIdleFrameRate);
+      is_idle_ = true;
     }
+    return;
   }
-}
 
-void AdventureApp::MoveSelectionRight() {
-  if (visualizer_.HasToggledPanels()) {
-    if (visualizer_.GetSubSelection() == last_button_index_) {
-      visualizer_.SetSubSelection(kFirstButton);
-    } else {
-      visualizer_.IncrementSubSelection();
-    }
-  } else {
-    if (visualizer_.GetMainSelection() == last_button_index_) {
-      visualizer_.SetMainSelection(kFirstButton);
-    } else {
-      visualizer_.IncrementMainSelection();
-    }
-  }
-}
-void AdventureApp::LoadFightOptions() {
-  Room current_room = engine_.RetrieveRoom(engine_.GetPlayer()
-                                               .GetCurrentLocation());
-
-  if (current_room.GetEnemies().empty()) {
-    visualizer_.SetHasToggledPanels(false);
-
-    // Attempts to execute a command because the failure will produce the
-    // desired visual output message
-    engine_.Fight();
-  } else {
-    engine_.SetMessage("WHAT WILL YOU DO?");
-    last_button_index_ = current_room.GetEnemies().size() - 1;
-
-    visualizer_.UpdateSubActionText(current_room.GetEnemies());
-    visualizer_.UpdateSubInformationText(current_room.GetEnemies());
-  }
+  MarkActive();
 
+  const GameSnapshot& snapshot = game_thread_->GetSnapshot();
+  if (snapshot.is_quit_requested) {
+    ci::app::App::quit();
+    return;
+  }
 
+  visualizer_.Update(snapshot);
 }
 
-void AdventureApp::LoadTakeOptions() {
-  Room current_room = engine_.RetrieveRoom(engine_.GetPlayer()
-                                               .GetCurrentLocation());
-
-  if (current_room.GetWeapons().empty() &&
-      current_room.GetNumberOfKeys() == 0) {
-    visualizer_.SetHasToggledPanels(false);
-
-    // Attempts to execute a command because the failure will produce the
-    // desired visual output message
-    engine_.Take();
-  } else {
-    engine_.SetMessage("WHAT WILL YOU DO?");
-    last_button_index_ = (current_room.GetWeapons().size() +
-                          current_room.GetNumberOfKeys()) - 1;
-
-    visualizer_.UpdateSubActionText(current_room.GetWeapons(),
-                                    current_room.GetNumberOfKeys());
-
-    if (!current_room.GetWeapons().empty()) {
-      visualizer_.UpdateSubInformationText(current_room.GetWeapons());
-    }
-  }
+void AdventureApp::resize() {
+  visualizer_.Resize(ci::app::getWindowWidth(), ci::app::getWindowHeight());
+  MarkActive();
 }
 
-void AdventureApp::LoadDropOptions() {
-  Player player = engine_.GetPlayer();
-
-  if (player.GetWeapons().empty() && player.GetNumberOfKeys() == 0) {
-    visualizer_.SetHasToggledPanels(false);
-
-    // Attempts to execute a command because the failure will produce the
-    // desired visual output message
-    engine_.Drop();
-  } else {
-    engine_.SetMessage("WHAT WILL YOU DO?");
-    last_button_index_ = (player.GetWeapons().size() +
-                          player.GetNumberOfKeys()) - 1;
-
-    visualizer_.UpdateSubActionText(player.GetWeapons(),
-                                    player.GetNumberOfKeys());
+void AdventureApp::MarkActive() {
+  last_activity_time_ = ci::app::getElapsedSeconds();
 
-    if (!player.GetWeapons().empty()) {
-      visualizer_.UpdateSubInformationText(player.GetWeapons());
-    }
+  if (is_idle_) {
+    setFrameRate(kActiveFrameRate);
+    is_idle_ = false;
   }
 }
 
-void AdventureApp::LoadGoOptions() {
-  Room current_room = engine_.RetrieveRoom(engine_.GetPlayer()
-                                               .GetCurrentLocation());
-
-  if (current_room.GetDoors().empty()) {
-    visualizer_.SetHasToggledPanels(false);
-
-    // Attempts to execute a command because the failure will produce the
-    // desired visual output message
-    engine_.Go();
-  } else {
-    engine_.SetMessage("WHAT WILL YOU DO?");
-    last_button_index_ = current_room.GetDoors().size() - 1;
-
-    visualizer_.UpdateSubActionText(current_room.GetDoors());
-    visualizer_.UpdateSubInformationText(current_room.GetDoors());
-  }
+void AdventureApp::cleanup() {
+  game_thread_->Stop();
+  game_thread_->GetController().SaveRecording();
 }
 
 }
@@ -0,0 +1,86 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "analytics/heatmap.h"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+
+namespace adventure {
+
+namespace {
+
+const char kHeader[] = "HEATMAP_ROOM_VISITS";
+
+}   // namespace
+
+Heatmap::Heatmap() : rooms_(), visits_(), max_visits_(0) {}
+
+size_t Heatmap::GetNumberOfRooms() const { return rooms_.size(); }
+
+const std::string &Heatmap::GetRoom(size_t cell) const {
+  return rooms_.at(cell);
+}
+
+uint64_t Heatmap::GetVisits(size_t cell) const { return visits_.at(cell); }
+
+float Heatmap::GetIntensity(size_t cell) const {
+  if (max_visits_ == 0) {
+    return 0.0f;
+  }
+
+  return (float)((double)visits_.at(cell) / (double)max_visits_);
+}
+
+void Heatmap::Add(const std::string& room, uint64_t visits) {
+  if (room.empty()) {
+    throw std::invalid_argument("ROOM NAME NOT SPECIFIED");
+  } else if (std::any_of(room.begin(), room.end(), isspace)) {
+    throw std::invalid_argument("INVALID ROOM NAME");
+  }
+
+  rooms_.push_back(room);
+  visits_.push_back(visits);
+  max_visits_ = std::max(max_visits_, visits);
+}
+
+std::ostream &operator<<(std::ostream& os, const Heatmap& heatmap) {
+  os << kHeader << "\n";
+
+  for (size_t cell = 0; cell < heatmap.rooms_.size(); ++cell) {
+    os << heatmap.rooms_[cell] << " " << heatmap.visits_[cell] << "\n";
+  }
+
+  return os;
+}
+
+std::istream &operator>>(std::istream& is, Heatmap& heatmap) {
+  std::string line;
+  std::getline(is, line);
+
+  if (line != kHeader) {
+    throw std::invalid_argument("INVALID FILE");
+  }
+
+  Heatmap loaded;
+  while (std::getline(is, line)) {
+    if (line.empty()) {
+      continue;
+    }
+
+    std::istringstream cell(line);
+    std::string room;
+    uint64_t visits;
+    if (!(cell >> room >> visits)) {
+      throw std::invalid_argument("INVALID FILE");
+    }
+
+    loaded.Add(room, visits);
+  }
+
+  heatmap = loaded;
+  return is;
+}
+
+}   // namespace adventure
@@ -0,0 +1,258 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "analytics/replay_analyzer.h"
+
+#include "mechanics/engine.h"
+#include "persistence/mapped_file.h"
+#include "serialization/checksum.h"
+
+#include <stdexcept>
+
+namespace adventure {
+
+const size_t ReplayAnalyzer::kDeathPathLength;
+
+ReplayAnalyzer::ReplayAnalyzer(std::shared_ptr<const Dungeon> dungeon,
+                               const Player& player)
+    : dungeon_(std::move(dungeon)), player_(player), dungeon_checksum_(0),
+      weapons_(), weapon_indices_() {
+  if (dungeon_ == nullptr) {
+    throw std::invalid_argument("DUNGEON NOT SPECIFIED");
+  }
+
+  // Matches the checksum a recording takes of its Engine's starting map
+  Engine engine(player_, dungeon_);
+  Checksum checksum;
+  checksum.Add(engine.GetMap());
+  dungeon_checksum_ = checksum.GetValue();
+
+  for (const Room& room : dungeon_->GetMap()) {
+    for (const Weapon& weapon : room.GetWeapons()) {
+      if (weapon_indices_.emplace(weapon.GetNickname(), weapons_.size())
+              .second) {
+        weapons_.push_back(weapon.GetNickname());
+      }
+    }
+  }
+}
+
+const std::vector<std::string> &ReplayAnalyzer::GetWeapons() const {
+  return weapons_;
+}
+
+ReplayReport ReplayAnalyzer::CreateReport() const {
+  size_t number_of_rooms = dungeon_->GetMap().size();
+
+  return ReplayReport{0, 0, 0, 0,
+                      std::vector<uint64_t>(number_of_rooms, 0),
+                      std::vector<uint64_t>(number_of_rooms, 0),
+                      std::vector<uint64_t>(number_of_rooms, 0),
+                      std::map<std::string, uint64_t>(),
+                      std::vector<uint64_t>(weapons_.size(), 0),
+                      std::vector<uint64_t>(weapons_.size(), 0)};
+}
+
+void ReplayAnalyzer::Analyze(const uint8_t* data, size_t size,
+                             ReplayReport& report) const {
+  ReplayReader reader(data, size);
+  report.number_of_bytes += size;
+
+  while (reader.HasNext()) {
+    try {
+      AnalyzeLog(reader, report);
+    } catch (const std::invalid_argument&) {
+      ++report.number_of_skipped_logs;
+      return;
+    }
+  }
+}
+
+ReplayReport ReplayAnalyzer::AnalyzeFiles(
+    const std::vector<std::string>& paths, JobSystem& jobs) const {
+  std::vector<MappedFile*> files(paths.size(), nullptr);
+  std::vector<std::unique_ptr<MappedFile>> mapped;
+  uint64_t number_of_unmapped = 0;
+  uint64_t total_size = 0;
+
+  for (size_t path = 0; path < paths.size(); ++path) {
+    try {
+      mapped.emplace_back(new MappedFile(paths[path]));
+      files[path] = mapped.back().get();
+      total_size += files[path]->GetSize();
+    } catch (const std::invalid_argument&) {
+      ++number_of_unmapped;
+    }
+  }
+
+  // Consecutive files are grouped until each group holds about its share
+  // of the bytes
+  size_t number_of_groups = jobs.GetNumberOfWorkers() * kGroupsPerWorker;
+  uint64_t group_size = total_size / number_of_groups + 1;
+
+  std::vector<std::vector<const MappedFile*>> groups(1);
+  uint64_t current_size = 0;
+  for (const MappedFile* file : files) {
+    if (file == nullptr) {
+      continue;
+    } else if (current_size >= group_size) {
+      groups.emplace_back();
+      current_size = 0;
+    }
+
+    groups.back().push_back(file);
+    current_size += file->GetSize();
+  }
+
+  std::vector<ReplayReport> reports(groups.size(), CreateReport());
+  std::vector<JobHandle> handles;
+  for (size_t group = 0; group < groups.size(); ++group) {
+    handles.push_back(jobs.Submit([this, &groups, &reports, group] {
+      for (const MappedFile* file : groups[group]) {
+        Analyze(file->GetData(), file->GetSize(), reports[group]);
+      }
+    }));
+  }
+
+  ReplayReport report = CreateReport();
+  report.number_of_skipped_logs = number_of_unmapped;
+  for (size_t group = 0; group < groups.size(); ++group) {
+    jobs.Wait(handles[group]);
+    Merge(reports[group], report);
+  }
+
+  return report;
+}
+
+void ReplayAnalyzer::Merge(const ReplayReport& from, ReplayReport& into) {
+  into.number_of_logs += from.number_of_logs;
+  into.number_of_skipped_logs += from.number_of_skipped_logs;
+  into.number_of_commands += from.number_of_commands;
+  into.number_of_bytes += from.number_of_bytes;
+
+  for (size_t room = 0; room < into.room_visits.size(); ++room) {
+    into.room_visits[room] += from.room_visits[room];
+    into.room_exits[room] += from.room_exits[room];
+    into.room_milliseconds[room] += from.room_milliseconds[room];
+  }
+
+  for (const std::pair<const std::string, uint64_t>& path :
+       from.death_paths) {
+    into.death_paths[path.first] += path.second;
+  }
+
+  for (size_t weapon = 0; weapon < into.weapon_sightings.size(); ++weapon) {
+    into.weapon_sightings[weapon] += from.weapon_sightings[weapon];
+    into.weapon_pickups[weapon] += from.weapon_pickups[weapon];
+  }
+}
+
+Heatmap ReplayAnalyzer::CreateHeatmap(const ReplayReport& report) const {
+  Heatmap heatmap;
+
+  for (size_t room = 0; room < dungeon_->GetMap().size(); ++room) {
+    heatmap.Add(dungeon_->GetMap()[room].GetNickname(),
+                report.room_visits[room]);
+  }
+
+  return heatmap;
+}
+
+void ReplayAnalyzer::AnalyzeLog(ReplayReader& reader,
+                                ReplayReport& report) const {
+  uint64_t seed;
+  uint64_t dungeon_checksum;
+  reader.Begin(seed, dungeon_checksum);
+
+  ReplayEntry entry;
+  if (dungeon_checksum != dungeon_checksum_) {
+    while (reader.Next(entry)) {}
+
+    ++report.number_of_skipped_logs;
+    return;
+  }
+
+  Engine engine(player_, dungeon_);
+  engine.SetRandomState(seed);
+
+  size_t room =
+      dungeon_->FindRoomIndex(engine.GetPlayer().GetCurrentLocation());
+  std::vector<size_t> path{room};
+  uint64_t milliseconds_in_room = 0;
+  bool is_dead = false;
+
+  std::vector<bool> is_seen(weapons_.size(), false);
+  std::vector<bool> is_taken(weapons_.size(), false);
+  SeeWeapons(engine.GetMap()[room], is_seen);
+  ++report.room_visits[room];
+
+  while (reader.Next(entry)) {
+    ++report.number_of_commands;
+    milliseconds_in_room += entry.elapsed_ms;
+
+    size_t number_of_weapons = engine.GetPlayer().GetWeapons().size();
+    try {
+      engine.Execute(entry.command, entry.qualifier);
+    } catch (const std::invalid_argument&) {
+      continue;
+    }
+
+    const Player& player = engine.GetPlayer();
+    size_t next_room = dungeon_->FindRoomIndex(player.GetCurrentLocation());
+    if (next_room != room) {
+      ++report.room_exits[room];
+      report.room_milliseconds[room] += milliseconds_in_room;
+      milliseconds_in_room = 0;
+
+      room = next_room;
+      path.push_back(room);
+      ++report.room_visits[room];
+      SeeWeapons(engine.GetMap()[room], is_seen);
+    }
+
+    if (entry.command == Command::kTake &&
+        player.GetWeapons().size() > number_of_weapons) {
+      std::unordered_map<std::string, size_t>::const_iterator weapon =
+          weapon_indices_.find(player.GetWeapons().back().GetNickname());
+
+      if (weapon != weapon_indices_.end()) {
+        is_taken[weapon->second] = true;
+      }
+    }
+
+    if (!is_dead && engine.GetMessage() == "YOU LOSE") {
+      is_dead = true;
+
+      std::string death_path;
+      size_t first = path.size() > kDeathPathLength
+                         ? path.size() - kDeathPathLength
+                         : 0;
+      for (size_t step = first; step < path.size(); ++step) {
+        if (step > first) {
+          death_path.append(" > ");
+        }
+        death_path.append(dungeon_->GetMap()[path[step]].GetNickname());
+      }
+      ++report.death_paths[death_path];
+    }
+  }
+
+  for (size_t weapon = 0; weapon < weapons_.size(); ++weapon) {
+    report.weapon_sightings[weapon] += is_seen[weapon] ? 1 : 0;
+    report.weapon_pickups[weapon] += is_taken[weapon] ? 1 : 0;
+  }
+  ++report.number_of_logs;
+}
+
+void ReplayAnalyzer::SeeWeapons(const Room& room,
+                                std::vector<bool>& is_seen) const {
+  for (const Weapon& weapon : room.GetWeapons()) {
+    std::unordered_map<std::string, size_t>::const_iterator index =
+        weapon_indices_.find(weapon.GetNickname());
+
+    if (index != weapon_indices_.end()) {
+      is_seen[index->second] = true;
+    }
+  }
+}
+
+}   // namespace adventure
@@ -2,12 +2,45 @@
 
 #include "entities/enemy.h"
 
+#include "memory/archetype_table.h"
+
+#include <functional>
+#include <utility>
+
 namespace adventure {
 
-Enemy::Enemy(const std::string& name, const std::string& nickname,
-             size_t health, size_t strength, size_t critical_chance)
-    : name_(name), nickname_(nickname), health_(health), strength_(strength),
-      critical_chance_(critical_chance) {
+namespace {
+
+ArchetypeTable<EnemyArchetype, EnemyArchetype::Hash> &GetArchetypeTable() {
+  static ArchetypeTable<EnemyArchetype, EnemyArchetype::Hash> table;
+  return table;
+}
+
+}   // namespace
+
+size_t EnemyArchetype::Hash::operator()(
+    const EnemyArchetype& archetype) const {
+  std::hash<std::string> hash_string;
+  std::hash<size_t> hash_size;
+
+  size_t hash = hash_string(archetype.name);
+  hash = CombineHash(hash, hash_string(archetype.nickname));
+  hash = CombineHash(hash, hash_size(archetype.health));
+  hash = CombineHash(hash, hash_size(archetype.strength));
+  return CombineHash(hash, hash_size(archetype.critical_chance));
+}
+
+bool operator==(const EnemyArchetype& lhs, const EnemyArchetype& rhs) {
+  return lhs.name == rhs.name && lhs.nickname == rhs.nickname &&
+         lhs.health == rhs.health && lhs.strength == rhs.strength &&
+         lhs.critical_chance == rhs.critical_chance;
+}
+
+size_t GetNumberOfEnemyArchetypes() { return GetArchetypeTable().size(); }
+
+Enemy::Enemy(std::string name, std::string nickname, size_t health,
+             size_t strength, size_t critical_chance)
+    : archetype_(nullptr), health_(health) {
   size_t max_size = 5;
 
   if (name.empty() || nickname.empty()) {
@@ -17,20 +50,34 @@ Enemy::Enemy(const std::string& name, const std::string& nickname,
   } else if (health == 0 || strength == 0) {
     throw std::invalid_argument("HEALTH AND/OR STRENGTH EQUAL ZERO");
   }
+
+  archetype_ = GetArchetypeTable().Intern(EnemyArchetype{
+      std::move(name), std::move(nickname), health, strength,
+      critical_chance});
 }
 
-const std::string &Enemy::GetName() const { return name_; }
+const std::string &Enemy::GetName() const { return archetype_->name; }
 
-const std::string &Enemy::GetNickname() const { return nickname_; }
+const std::string &Enemy::GetNickname() const { return archetype_->nickname; }
+
+const EnemyArchetype &Enemy::GetArchetype() const { return *archetype_; }
 
 size_t Enemy::GetHealth() const { return health_; }
 
-size_t Enemy::GetStrength() const { return strength_; }
+void Enemy::SetHealth(size_t health) { health_ = health; }
 
-size_t Enemy::GetCriticalChance() const { return critical_chance_; }
+size_t Enemy::GetStrength() const { return archetype_->strength; }
+
+size_t Enemy::GetCriticalChance() const {
+  return archetype_->critical_chance;
+}
 
 size_t Enemy::DealDamage() const {
-  return CalculateDamage();
+  return CalculateDamage((size_t)(rand() % 100));
+}
+
+size_t Enemy::DealDamage(size_t roll) const {
+  return CalculateDamage(roll);
 }
 
 void Enemy::TakeDamage(size_t amount) {
@@ -43,11 +90,13 @@ void Enemy::TakeDamage(size_t amount) {
 
 bool Enemy::IsAlive() { return health_ > 0; }
 
-size_t Enemy::CalculateDamage() const {
-  if ((size_t)(rand() % 100) <= critical_chance_ && critical_chance_ > 0) {
-    return (2 * strength_);
+size_t Enemy::CalculateDamage(size_t roll) const {
+  size_t critical_chance = archetype_->critical_chance;
+
+  if (roll <= critical_chance && critical_chance > 0) {
+    return (2 * archetype_->strength);
   } else {
-    return strength_;
+    return archetype_->strength;
   }
 }
 
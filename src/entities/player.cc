@@ -4,16 +4,19 @@
 
 namespace adventure {
 
+const size_t Player::kDefaultMaxWeapons;
+
 Player::Player() : current_location_("ENTRN"), max_health_(1000),
-      health_(1000), number_of_keys_(0) {
-  std::vector<Weapon> start_weapons{Weapon("SWORD", "SWORD", 15, 15)};
-  weapons_ = start_weapons;
+      health_(1000), number_of_keys_(0), max_weapons_(kDefaultMaxWeapons) {
+  weapons_.Insert(0, Weapon("SWORD", "SWORD", 15, 15));
 }
 
 Player::Player(const std::string& current_location, size_t health,
                size_t number_of_keys, const std::vector<Weapon>& weapons)
     : current_location_(current_location), max_health_(health),
-      health_(health), number_of_keys_(number_of_keys), weapons_(weapons) {
+      health_(health), number_of_keys_(number_of_keys),
+      max_weapons_(kDefaultMaxWeapons),
+      weapons_(weapons.begin(), weapons.end()) {
   size_t max_size = 5;
 
   if (current_location.empty()) {
@@ -35,12 +38,26 @@ size_t Player::GetMaxHealth() const { return max_health_; }
 
 size_t Player::GetNumberOfKeys() const { return number_of_keys_; }
 
-const std::vector<Weapon> &Player::GetWeapons() const { return weapons_; }
+const Inventory::Weapons &Player::GetWeapons() const {
+  return weapons_.GetWeapons();
+}
 
 void Player::SetCurrentLocation(const std::string& new_location) {
   current_location_ = new_location;
 }
 
+size_t Player::GetMaxWeapons() const { return max_weapons_; }
+
+void Player::SetHealth(size_t health) { health_ = health; }
+
+void Player::SetMaxWeapons(size_t max_weapons) {
+  if (max_weapons == 0) {
+    throw std::invalid_argument("MAX WEAPONS EQUALS ZERO");
+  }
+
+  max_weapons_ = max_weapons;
+}
+
 void Player::RegenerateHealth() {
   health_ += max_health_ / 20;
 
@@ -53,6 +70,10 @@ size_t Player::DealDamage() const {
   return RetrieveStrongestWeapon().CalculateDamage();
 }
 
+size_t Player::DealDamage(size_t roll) const {
+  return RetrieveStrongestWeapon().CalculateDamage(roll);
+}
+
 void Player::TakeDamage(size_t amount) {
   if (amount > health_) {
     health_ = 0;
@@ -74,59 +95,50 @@ void Player::DecrementNumberOfKeys() {
 }
 
 void Player::AddWeapon(const Weapon& weapon) {
-  for (Weapon& player_weapon : weapons_) {
-    if (player_weapon.GetName() == weapon.GetName()) {
-      throw std::invalid_argument("WEAPON ALREADY ON PERSON");
-    }
+  if (weapons_.FindName(weapon.GetName()) != Inventory::kNotFound) {
+    throw std::invalid_argument("WEAPON ALREADY ON PERSON");
   }
 
-  weapons_.push_back(weapon);
+  weapons_.Insert(weapons_.GetWeapons().size(), weapon);
 }
 
 void Player::RemoveWeapon(const Weapon& weapon) {
-  if (weapons_.empty()) {
+  if (weapons_.GetWeapons().empty()) {
     throw std::invalid_argument("WEAPONS EMPTY");
   }
 
-  for (size_t index = 0; index < weapons_.size(); ++index) {
-    if (weapons_[index].GetName() == weapon.GetName()) {
-      weapons_.erase(weapons_.begin() + (int)index);
-      return;
-    }
+  size_t index = weapons_.FindName(weapon.GetName());
+  if (index == Inventory::kNotFound) {
+    throw std::invalid_argument("WEAPON NOT FOUND");
   }
 
-  throw std::invalid_argument("WEAPON NOT FOUND");
+  weapons_.Erase(index);
+}
+
+void Player::InsertWeapon(size_t index, const Weapon& weapon) {
+  weapons_.Insert(index, weapon);
 }
 
-Weapon &Player::RetrieveWeapon(const std::string& name) {
+const Weapon &Player::RetrieveWeapon(const std::string& name) const {
   if (name.empty()) {
     throw std::invalid_argument("WEAPON NAME NOT SPECIFIED");
   }
 
-  for (Weapon& weapon : weapons_) {
-    if (weapon.GetNickname() == name) {
-      return weapon;
-    }
+  size_t index = weapons_.FindNickname(name);
+  if (index == Inventory::kNotFound) {
+    throw std::invalid_argument("WEAPON NOT FOUND");
   }
 
-  throw std::invalid_argument("WEAPON NOT FOUND");
+  return weapons_.GetWeapons()[index];
 }
 
 const Weapon &Player::RetrieveStrongestWeapon() const {
-  size_t max_strength = 0;
-  size_t index = 0;
-
-  for (size_t weapon = 0; weapon < weapons_.size(); ++weapon) {
-    size_t strength = weapons_[weapon].GetStrength();
-
-    if (strength > max_strength) {
-      max_strength = strength;
-      index = weapon;
-    }
+  size_t index = weapons_.GetStrongest();
+  if (index == Inventory::kNotFound) {
+    throw std::out_of_range("WEAPONS EMPTY");
   }
 
-  return weapons_.at(index);
+  return weapons_.GetWeapons()[index];
 }
 
-
 }   // namespace adventure
\ No newline at end of file
@@ -0,0 +1,217 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "items/inventory.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace adventure {
+
+const size_t Inventory::kInlineWeapons;
+const size_t Inventory::kNotFound;
+
+Inventory::Inventory() : strongest_(kNotFound) {}
+
+const Inventory::Weapons &Inventory::GetWeapons() const { return weapons_; }
+
+size_t Inventory::FindName(const std::string& name) const {
+  if (IsIndexed()) {
+    std::pair<NameIndex::const_iterator, NameIndex::const_iterator> found =
+        names_.equal_range(&name);
+    return FindFirst(found.first, found.second);
+  }
+
+  for (size_t index = 0; index < weapons_.size(); ++index) {
+    if (weapons_[index].GetName() == name) {
+      return index;
+    }
+  }
+
+  return kNotFound;
+}
+
+size_t Inventory::FindNickname(const std::string& nickname) const {
+  if (IsIndexed()) {
+    std::pair<NameIndex::const_iterator, NameIndex::const_iterator> found =
+        nicknames_.equal_range(&nickname);
+    return FindFirst(found.first, found.second);
+  }
+
+  for (size_t index = 0; index < weapons_.size(); ++index) {
+    if (weapons_[index].GetNickname() == nickname) {
+      return index;
+    }
+  }
+
+  return kNotFound;
+}
+
+size_t Inventory::GetStrongest() const { return strongest_; }
+
+void Inventory::Insert(size_t index, const Weapon& weapon) {
+  if (index > weapons_.size()) {
+    throw std::invalid_argument("WEAPON INDEX OUT OF RANGE");
+  }
+
+  weapons_.insert(index, weapon);
+
+  // The Weapon that outgrows the inline storage builds the whole index
+  if (weapons_.size() == kInlineWeapons + 1) {
+    Rebuild();
+    return;
+  }
+
+  if (IsIndexed()) {
+    AddHandle(index);
+  }
+
+  if (strongest_ != kNotFound && strongest_ >= index) {
+    ++strongest_;
+  }
+  Record(index);
+}
+
+void Inventory::Erase(size_t index) {
+  if (index >= weapons_.size()) {
+    throw std::invalid_argument("WEAPON INDEX OUT OF RANGE");
+  }
+
+  if (IsIndexed()) {
+    const Weapon& weapon = weapons_[index];
+    size_t handle = handles_[index];
+
+    Forget(names_, &weapon.GetName(), handle);
+    Forget(nicknames_, &weapon.GetNickname(), handle);
+    Forget(strengths_, weapon.GetStrength(), handle);
+
+    handles_.erase(handles_.begin() + index);
+    free_handles_.push_back(handle);
+    for (size_t moved = index; moved < handles_.size(); ++moved) {
+      positions_[handles_[moved]] = moved;
+    }
+  }
+
+  weapons_.erase(index);
+
+  if (!IsIndexed()) {
+    Clear();
+  }
+
+  if (strongest_ == index) {
+    // The first of the Weapons left with the highest strength takes over
+    if (IsIndexed()) {
+      std::pair<StrengthIndex::const_iterator,
+                StrengthIndex::const_iterator> strongest =
+          strengths_.equal_range(strengths_.begin()->first);
+      strongest_ = FindFirst(strongest.first, strongest.second);
+    } else {
+      strongest_ = kNotFound;
+      for (size_t weapon = 0; weapon < weapons_.size(); ++weapon) {
+        RecordStrongest(weapon);
+      }
+    }
+  } else if (strongest_ > index) {
+    --strongest_;
+  }
+}
+
+bool Inventory::IsIndexed() const {
+  return weapons_.size() > kInlineWeapons;
+}
+
+void Inventory::AddHandle(size_t index) {
+  size_t handle = positions_.size();
+  if (free_handles_.empty()) {
+    positions_.push_back(index);
+  } else {
+    handle = free_handles_.back();
+    free_handles_.pop_back();
+    positions_[handle] = index;
+  }
+
+  handles_.insert(handles_.begin() + index, handle);
+  for (size_t moved = index + 1; moved < handles_.size(); ++moved) {
+    positions_[handles_[moved]] = moved;
+  }
+}
+
+void Inventory::Record(size_t index) {
+  const Weapon& weapon = weapons_[index];
+
+  if (IsIndexed()) {
+    size_t handle = handles_[index];
+
+    names_.emplace(&weapon.GetName(), handle);
+    nicknames_.emplace(&weapon.GetNickname(), handle);
+    strengths_.emplace(weapon.GetStrength(), handle);
+  }
+
+  RecordStrongest(index);
+}
+
+void Inventory::RecordStrongest(size_t index) {
+  const Weapon& weapon = weapons_[index];
+
+  if (strongest_ == kNotFound ||
+      weapon.GetStrength() > weapons_[strongest_].GetStrength() ||
+      (weapon.GetStrength() == weapons_[strongest_].GetStrength() &&
+       index < strongest_)) {
+    strongest_ = index;
+  }
+}
+
+template <typename Iterator>
+size_t Inventory::FindFirst(Iterator first, Iterator last) const {
+  size_t found = kNotFound;
+
+  for (; first != last; ++first) {
+    found = std::min(found, positions_[first->second]);
+  }
+
+  return found;
+}
+
+template <typename Index, typename Key>
+void Inventory::Forget(Index& index, const Key& key, size_t handle) {
+  std::pair<typename Index::iterator, typename Index::iterator> found =
+      index.equal_range(key);
+
+  for (; found.first != found.second; ++found.first) {
+    if (found.first->second == handle) {
+      index.erase(found.first);
+      return;
+    }
+  }
+}
+
+void Inventory::Rebuild() {
+  Clear();
+  strongest_ = kNotFound;
+
+  for (size_t index = 0; index < weapons_.size(); ++index) {
+    AddHandle(index);
+    Record(index);
+  }
+}
+
+void Inventory::Clear() {
+  handles_.clear();
+  positions_.clear();
+  free_handles_.clear();
+  names_.clear();
+  nicknames_.clear();
+  strengths_.clear();
+}
+
+size_t Inventory::NameHash::operator()(const std::string* name) const {
+  return std::hash<std::string>()(*name);
+}
+
+bool Inventory::NameEqual::operator()(const std::string* lhs,
+                                      const std::string* rhs) const {
+  return *lhs == *rhs;
+}
+
+}   // namespace adventure
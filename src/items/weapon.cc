@@ -2,12 +2,44 @@
 
 #include "items/weapon.h"
 
+#include "memory/archetype_table.h"
+
+#include <functional>
+#include <utility>
+
 namespace adventure {
 
-Weapon::Weapon(const std::string& name, const std::string& nickname,
-               size_t strength, size_t critical_chance)
-    : name_(name), nickname_(nickname), strength_(strength),
-      critical_chance_(critical_chance) {
+namespace {
+
+ArchetypeTable<WeaponArchetype, WeaponArchetype::Hash> &GetArchetypeTable() {
+  static ArchetypeTable<WeaponArchetype, WeaponArchetype::Hash> table;
+  return table;
+}
+
+}   // namespace
+
+size_t WeaponArchetype::Hash::operator()(
+    const WeaponArchetype& archetype) const {
+  std::hash<std::string> hash_string;
+  std::hash<size_t> hash_size;
+
+  size_t hash = hash_string(archetype.name);
+  hash = CombineHash(hash, hash_string(archetype.nickname));
+  hash = CombineHash(hash, hash_size(archetype.strength));
+  return CombineHash(hash, hash_size(archetype.critical_chance));
+}
+
+bool operator==(const WeaponArchetype& lhs, const WeaponArchetype& rhs) {
+  return lhs.name == rhs.name && lhs.nickname == rhs.nickname &&
+         lhs.strength == rhs.strength &&
+         lhs.critical_chance == rhs.critical_chance;
+}
+
+size_t GetNumberOfWeaponArchetypes() { return GetArchetypeTable().size(); }
+
+Weapon::Weapon(std::string name, std::string nickname, size_t strength,
+               size_t critical_chance)
+    : archetype_(nullptr) {
   size_t max_size = 5;
 
   if (name.empty() || nickname.empty()) {
@@ -17,21 +49,34 @@ Weapon::Weapon(const std::string& name, const std::string& nickname,
   } else if (strength == 0) {
     throw std::invalid_argument("STRENGTH EQUALS ZERO");
   }
+
+  archetype_ = GetArchetypeTable().Intern(WeaponArchetype{
+      std::move(name), std::move(nickname), strength, critical_chance});
 }
 
-const std::string &Weapon::GetName() const { return name_; }
+const std::string &Weapon::GetName() const { return archetype_->name; }
 
-const std::string &Weapon::GetNickname() const { return nickname_; }
+const std::string &Weapon::GetNickname() const {
+  return archetype_->nickname;
+}
 
-size_t Weapon::GetStrength() const { return strength_; }
+const WeaponArchetype &Weapon::GetArchetype() const { return *archetype_; }
 
-size_t Weapon::GetCriticalChance() const { return critical_chance_; }
+size_t Weapon::GetStrength() const { return archetype_->strength; }
+
+size_t Weapon::GetCriticalChance() const {
+  return archetype_->critical_chance;
+}
 
 size_t Weapon::CalculateDamage() const {
-  if ((size_t)(rand() % 100) <= critical_chance_) {
-    return (2 * strength_);
+  return CalculateDamage((size_t)(rand() % 100));
+}
+
+size_t Weapon::CalculateDamage(size_t roll) const {
+  if (roll <= archetype_->critical_chance) {
+    return (2 * archetype_->strength);
   } else {
-    return strength_;
+    return archetype_->strength;
   }
 }
 
@@ -0,0 +1,325 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "jobs/job_system.h"
+
+#include <chrono>
+#include <utility>
+
+namespace adventure {
+
+namespace {
+
+// Which JobSystem and worker the current thread belongs to, so that jobs
+// spawned from inside a job go onto the spawning worker's own deques
+thread_local const JobSystem* current_system = nullptr;
+thread_local size_t current_worker = 0;
+
+// How long a waiting thread blocks before looking for work to help with
+const std::chrono::milliseconds kWaitInterval(1);
+
+}   // namespace
+
+CancellationToken::CancellationToken()
+    : is_canceled_(std::make_shared<std::atomic<bool>>(false)) {}
+
+void CancellationToken::Cancel() { *is_canceled_ = true; }
+
+bool CancellationToken::IsCanceled() const { return *is_canceled_; }
+
+JobHandle::JobHandle() : job_() {}
+
+JobHandle::JobHandle(std::shared_ptr<Job> job) : job_(std::move(job)) {}
+
+bool JobHandle::IsValid() const { return job_ != nullptr; }
+
+bool JobHandle::IsFinished() const {
+  if (!job_) {
+    return true;
+  }
+
+  std::lock_guard<std::mutex> lock(job_->mutex);
+  return job_->is_finished;
+}
+
+bool JobHandle::WasCanceled() const {
+  if (!job_) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(job_->mutex);
+  return job_->was_canceled;
+}
+
+JobSystem::JobSystem(size_t number_of_workers)
+    : workers_(), number_of_queued_(0), number_of_sleeping_(0),
+      is_stopping_(false) {
+  for (size_t worker = 0; worker < number_of_workers; ++worker) {
+    workers_.emplace_back(new Worker());
+    workers_.back()->steals = 0;
+  }
+
+  // Workers only start once every deque exists, since they steal from all
+  for (size_t worker = 0; worker < number_of_workers; ++worker) {
+    workers_[worker]->thread = std::thread(&JobSystem::RunWorker, this,
+                                           worker);
+  }
+}
+
+JobSystem::~JobSystem() {
+  is_stopping_ = true;
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    wake_up_.notify_all();
+  }
+
+  for (const std::unique_ptr<Worker>& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+size_t JobSystem::GetDefaultNumberOfWorkers() {
+  size_t hardware_threads = std::thread::hardware_concurrency();
+
+  if (hardware_threads <= 1) {
+    return 1;
+  }
+  return hardware_threads - 1;
+}
+
+size_t JobSystem::GetNumberOfWorkers() const { return workers_.size(); }
+
+size_t JobSystem::GetNumberOfSteals() const {
+  size_t steals = 0;
+
+  for (const std::unique_ptr<Worker>& worker : workers_) {
+    steals += worker->steals;
+  }
+  return steals;
+}
+
+JobHandle JobSystem::Submit(const std::function<void()>& work,
+                            JobPriority priority) {
+  std::shared_ptr<Job> job = CreateJob(work, priority, nullptr);
+
+  Schedule(job);
+  return JobHandle(job);
+}
+
+JobHandle JobSystem::Submit(const std::function<void()>& work,
+                            JobPriority priority,
+                            const CancellationToken& token) {
+  std::shared_ptr<Job> job = CreateJob(work, priority, token.is_canceled_);
+
+  Schedule(job);
+  return JobHandle(job);
+}
+
+JobHandle JobSystem::Then(const JobHandle& predecessor,
+                          const std::function<void()>& work,
+                          JobPriority priority) {
+  std::shared_ptr<Job> job = CreateJob(work, priority, nullptr);
+
+  // Holds the job back until the predecessor has been checked
+  job->dependencies = 1;
+
+  if (predecessor.job_) {
+    std::lock_guard<std::mutex> lock(predecessor.job_->mutex);
+
+    if (!predecessor.job_->is_finished) {
+      ++job->dependencies;
+      predecessor.job_->continuations.push_back(job);
+    }
+  }
+
+  if (--job->dependencies == 0) {
+    Schedule(job);
+  }
+  return JobHandle(job);
+}
+
+JobHandle JobSystem::Then(const std::vector<JobHandle>& predecessors,
+                          const std::function<void()>& work,
+                          JobPriority priority,
+                          const CancellationToken& token) {
+  std::shared_ptr<Job> job = CreateJob(work, priority, token.is_canceled_);
+
+  // Holds the job back until every predecessor has been checked
+  job->dependencies = 1;
+
+  for (const JobHandle& predecessor : predecessors) {
+    if (!predecessor.job_) {
+      continue;
+    }
+
+    std::lock_guard<std::mutex> lock(predecessor.job_->mutex);
+
+    if (!predecessor.job_->is_finished) {
+      ++job->dependencies;
+      predecessor.job_->continuations.push_back(job);
+    }
+  }
+
+  if (--job->dependencies == 0) {
+    Schedule(job);
+  }
+  return JobHandle(job);
+}
+
+void JobSystem::Wait(const JobHandle& handle) {
+  if (!handle.job_) {
+    return;
+  }
+
+  size_t worker = workers_.size();
+  if (current_system == this) {
+    worker = current_worker;
+  }
+
+  const std::shared_ptr<Job>& awaited = handle.job_;
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(awaited->mutex);
+
+      if (awaited->is_finished) {
+        if (awaited->error) {
+          std::rethrow_exception(awaited->error);
+        }
+        return;
+      }
+    }
+
+    std::shared_ptr<Job> job;
+    if (FindJob(worker, job)) {
+      Execute(job);
+      continue;
+    }
+
+    // Blocks briefly rather than indefinitely, since the awaited job may
+    // still be waiting on continuations that only this thread can pick up
+    std::unique_lock<std::mutex> lock(awaited->mutex);
+    awaited->finished.wait_for(lock, kWaitInterval, [&awaited] {
+      return awaited->is_finished;
+    });
+  }
+}
+
+std::shared_ptr<Job> JobSystem::CreateJob(
+    const std::function<void()>& work, JobPriority priority,
+    const std::shared_ptr<std::atomic<bool>>& is_canceled) const {
+  std::shared_ptr<Job> job = std::make_shared<Job>();
+
+  job->work = work;
+  job->priority = priority;
+  job->is_canceled = is_canceled;
+  job->dependencies = 0;
+  job->is_finished = false;
+  job->was_canceled = false;
+  return job;
+}
+
+void JobSystem::Schedule(const std::shared_ptr<Job>& job) {
+  size_t priority = (size_t)job->priority;
+
+  // Counted before the push so that a worker never sleeps while the job is
+  // in a deque
+  ++number_of_queued_;
+
+  if (current_system == this) {
+    workers_[current_worker]->queues[priority].Push(job);
+  } else {
+    injected_[priority].Push(job);
+  }
+
+  if (number_of_sleeping_ > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    wake_up_.notify_one();
+  }
+}
+
+bool JobSystem::FindJob(size_t worker, std::shared_ptr<Job>& job) {
+  size_t number_of_workers = workers_.size();
+
+  for (size_t priority = 0; priority < kNumberOfPriorities; ++priority) {
+    bool is_found = false;
+
+    if (worker < number_of_workers) {
+      is_found = workers_[worker]->queues[priority].Pop(job);
+    }
+
+    if (!is_found) {
+      is_found = injected_[priority].Steal(job);
+    }
+
+    for (size_t offset = 1; !is_found && offset <= number_of_workers;
+         ++offset) {
+      size_t victim = (worker + offset) % number_of_workers;
+
+      if (victim != worker && workers_[victim]->queues[priority].Steal(job)) {
+        is_found = true;
+
+        if (worker < number_of_workers) {
+          ++workers_[worker]->steals;
+        }
+      }
+    }
+
+    if (is_found) {
+      --number_of_queued_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void JobSystem::Execute(const std::shared_ptr<Job>& job) {
+  bool was_canceled = job->is_canceled && *job->is_canceled;
+  std::exception_ptr error;
+
+  if (!was_canceled) {
+    try {
+      job->work();
+    } catch (...) {
+      error = std::current_exception();
+    }
+  }
+
+  std::vector<std::shared_ptr<Job>> continuations;
+  {
+    std::lock_guard<std::mutex> lock(job->mutex);
+
+    job->is_finished = true;
+    job->was_canceled = was_canceled;
+    job->error = error;
+    job->work = nullptr;
+    continuations.swap(job->continuations);
+  }
+  job->finished.notify_all();
+
+  for (const std::shared_ptr<Job>& continuation : continuations) {
+    if (--continuation->dependencies == 0) {
+      Schedule(continuation);
+    }
+  }
+}
+
+void JobSystem::RunWorker(size_t worker) {
+  current_system = this;
+  current_worker = worker;
+
+  while (!is_stopping_) {
+    std::shared_ptr<Job> job;
+    if (FindJob(worker, job)) {
+      Execute(job);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    ++number_of_sleeping_;
+    wake_up_.wait(lock, [this] {
+      return is_stopping_ || number_of_queued_ > 0;
+    });
+    --number_of_sleeping_;
+  }
+}
+
+}   // namespace adventure
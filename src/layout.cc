@@ -0,0 +1,219 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "layout.h"
+
+#include <stdexcept>
+
+namespace adventure {
+
+namespace {
+
+// Every ratio below is a fraction of the window's width (for x and widths)
+// or height (for y, heights, and font sizes)
+
+struct RectangleRatios {
+  float center_x;
+  float center_y;
+  float width;
+  float height;
+};
+
+struct TextRatios {
+  float x;
+  float y;
+  float size;
+  TextAlignment alignment;
+};
+
+/**
+ * A row of equal buttons. Buttons past the first row's worth carry on along
+ * a second row that starts back at the first column.
+ */
+struct ButtonRowRatios {
+  RectangleRatios first;
+  float column_step;
+  float row_step;
+  size_t first_row_length;
+};
+
+// In the order of LayoutPanel: center x, center y, width, height
+const RectangleRatios kPanelRatios[] = {
+    // kActionPanel
+    {1.0f / 2.0f, 33.0f / 40.0f, 1.0f, 7.0f / 20.0f},
+    // kTopBorderBar
+    {1.0f / 2.0f, 1.0f / 40.0f, 1.0f, 1.0f / 20.0f},
+    // kBottomBorderBar
+    {1.0f / 2.0f, 5.0f / 8.0f, 1.0f, 1.0f / 20.0f},
+    // kLeftSubPanel
+    {1.0f / 4.0f, 13.0f / 40.0f, 7.0f / 15.0f, 1.0f / 2.0f},
+    // kRightSubPanel
+    {3.0f / 4.0f, 13.0f / 40.0f, 7.0f / 15.0f, 1.0f / 2.0f},
+    // kMap
+    {1.0f / 2.0f, 47.0f / 160.0f, 19.0f / 30.0f, 37.0f / 80.0f},
+    // kLocationBar
+    {1.0f / 2.0f, 5.0f / 40.0f, 1.0f / 8.0f, 1.0f / 20.0f},
+    // kStatusBar
+    {1.0f / 2.0f, 9.0f / 16.0f, 1.0f / 2.0f, 1.0f / 20.0f}
+};
+
+// In the order of LayoutText: x, y, font size, alignment
+const TextRatios kTextRatios[] = {
+    // kGameOver
+    {1.0f / 2.0f, 29.0f / 80.0f, 3.0f / 10.0f, TextAlignment::kCenter},
+    // kMessage
+    {1.0f / 2.0f, 21.0f / 80.0f, 1.0f / 15.0f, TextAlignment::kCenter},
+    // kLocation
+    {1.0f / 2.0f, 9.0f / 80.0f, 49.0f / 1890.0f, TextAlignment::kCenter},
+    // kHealth
+    {22.0f / 80.0f, 44.0f / 80.0f, 49.0f / 1890.0f, TextAlignment::kLeft},
+    // kKeys
+    {1.0f / 2.0f, 44.0f / 80.0f, 49.0f / 1890.0f, TextAlignment::kCenter},
+    // kWeapons
+    {58.0f / 80.0f, 44.0f / 80.0f, 49.0f / 1890.0f, TextAlignment::kRight},
+    // kSubInformation
+    {3.0f / 4.0f, 7.0f / 20.0f, 1.0f / 18.0f, TextAlignment::kCenter},
+    // kSubPage
+    {1.0f / 4.0f, 21.0f / 40.0f, 49.0f / 1890.0f, TextAlignment::kCenter}
+};
+
+const ButtonRowRatios kActionButtonRatios = {
+    {3.0f / 20.0f, 33.0f / 40.0f, 7.0f / 40.0f, 3.0f / 20.0f}, 7.0f / 30.0f,
+    0.0f, Layout::kNumberOfActionButtons};
+
+const ButtonRowRatios kSubActionButtonRatios = {
+    {17.0f / 120.0f, 9.0f / 40.0f, 11.0f / 60.0f, 3.0f / 20.0f},
+    13.0f / 60.0f, 1.0f / 5.0f, 2};
+
+// Button labels are raised from the button's center by a fraction of the
+// window's width
+const float kButtonLabelRaise = 1.0f / 30.0f;
+const float kButtonLabelSize = 1.0f / 10.0f;
+
+const float kSubInformationLineHeight = 1.0f / 10.0f;
+
+static_assert(sizeof(kPanelRatios) / sizeof(kPanelRatios[0]) ==
+                  (size_t)LayoutPanel::kNumberOfPanels,
+              "Every panel needs ratios");
+static_assert(sizeof(kTextRatios) / sizeof(kTextRatios[0]) ==
+                  (size_t)LayoutText::kNumberOfTexts,
+              "Every text needs ratios");
+
+ci::Rectf ScaleRectangle(const RectangleRatios& ratios,
+                         const glm::vec2& bounds) {
+  float center_x = ratios.center_x * bounds.x;
+  float center_y = ratios.center_y * bounds.y;
+  float half_width = (ratios.width * bounds.x) / 2.0f;
+  float half_height = (ratios.height * bounds.y) / 2.0f;
+
+  return ci::Rectf(center_x - half_width, center_y - half_height,
+                   center_x + half_width, center_y + half_height);
+}
+
+/**
+ * Lays out a row of buttons and the labels raised from their centers.
+ */
+void ScaleButtonRow(const ButtonRowRatios& ratios, size_t number_of_buttons,
+                    const glm::vec2& bounds, std::vector<ci::Rectf>& buttons,
+                    std::vector<TextAnchor>& labels) {
+  for (size_t button = 0; button < number_of_buttons; ++button) {
+    RectangleRatios button_ratios = ratios.first;
+    button_ratios.center_x += (float)button * ratios.column_step;
+
+    if (button >= ratios.first_row_length) {
+      button_ratios.center_x -= (float)ratios.first_row_length *
+                                ratios.column_step;
+      button_ratios.center_y += ratios.row_step;
+    }
+
+    buttons.push_back(ScaleRectangle(button_ratios, bounds));
+
+    glm::vec2 center = buttons.back().getCenter();
+    glm::vec2 label(center.x, center.y - (kButtonLabelRaise * bounds.x));
+    labels.push_back(TextAnchor{label, kButtonLabelSize * bounds.y,
+                                TextAlignment::kCenter});
+  }
+}
+
+}   // namespace
+
+const size_t Layout::kNumberOfActionButtons;
+const size_t Layout::kNumberOfSubActionButtons;
+
+Layout::Layout() : Layout(0.0f, 0.0f) {}
+
+Layout::Layout(float window_width, float window_height)
+    : bounds_(window_width, window_height), panels_(), texts_(),
+      action_buttons_(), action_button_labels_(), sub_action_buttons_(),
+      sub_action_button_labels_(),
+      sub_information_line_height_(kSubInformationLineHeight *
+                                   window_height) {
+  for (const RectangleRatios& ratios : kPanelRatios) {
+    panels_.push_back(ScaleRectangle(ratios, bounds_));
+  }
+
+  for (const TextRatios& ratios : kTextRatios) {
+    glm::vec2 position(ratios.x * bounds_.x, ratios.y * bounds_.y);
+    texts_.push_back(TextAnchor{position, ratios.size * bounds_.y,
+                                ratios.alignment});
+  }
+
+  ScaleButtonRow(kActionButtonRatios, kNumberOfActionButtons, bounds_,
+                 action_buttons_, action_button_labels_);
+  ScaleButtonRow(kSubActionButtonRatios, kNumberOfSubActionButtons, bounds_,
+                 sub_action_buttons_, sub_action_button_labels_);
+}
+
+const glm::vec2 &Layout::GetBounds() const { return bounds_; }
+
+const ci::Rectf &Layout::GetPanel(LayoutPanel panel) const {
+  return panels_.at((size_t)panel);
+}
+
+const TextAnchor &Layout::GetText(LayoutText text) const {
+  return texts_.at((size_t)text);
+}
+
+const ci::Rectf &Layout::GetActionButton(size_t button) const {
+  if (button >= action_buttons_.size()) {
+    throw std::invalid_argument("BUTTON INDEX OUT OF RANGE");
+  }
+
+  return action_buttons_[button];
+}
+
+const TextAnchor &Layout::GetActionButtonLabel(size_t button) const {
+  if (button >= action_button_labels_.size()) {
+    throw std::invalid_argument("BUTTON INDEX OUT OF RANGE");
+  }
+
+  return action_button_labels_[button];
+}
+
+const ci::Rectf &Layout::GetSubActionButton(size_t button) const {
+  if (button >= sub_action_buttons_.size()) {
+    throw std::invalid_argument("BUTTON INDEX OUT OF RANGE");
+  }
+
+  return sub_action_buttons_[button];
+}
+
+const TextAnchor &Layout::GetSubActionButtonLabel(size_t button) const {
+  if (button >= sub_action_button_labels_.size()) {
+    throw std::invalid_argument("BUTTON INDEX OUT OF RANGE");
+  }
+
+  return sub_action_button_labels_[button];
+}
+
+TextAnchor Layout::GetSubInformationLine(size_t line,
+                                         size_t number_of_lines) const {
+  TextAnchor anchor = GetText(LayoutText::kSubInformation);
+
+  // The block of lines is raised by half its height
+  anchor.position.y += ((float)line - ((float)number_of_lines / 2.0f)) *
+                       sub_information_line_height_;
+
+  return anchor;
+}
+
+}   // namespace adventure
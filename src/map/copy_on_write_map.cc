@@ -0,0 +1,120 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "map/copy_on_write_map.h"
+
+#include <algorithm>
+
+namespace adventure {
+
+CopyOnWriteMap::const_iterator::const_iterator(const CopyOnWriteMap* map,
+                                               size_t index)
+    : map_(map), index_(index) {}
+
+const Room &CopyOnWriteMap::const_iterator::operator*() const {
+  return (*map_)[index_];
+}
+
+const Room *CopyOnWriteMap::const_iterator::operator->() const {
+  return &(*map_)[index_];
+}
+
+CopyOnWriteMap::const_iterator &CopyOnWriteMap::const_iterator::operator++() {
+  ++index_;
+  return *this;
+}
+
+bool CopyOnWriteMap::const_iterator::operator==(
+    const const_iterator& other) const {
+  return map_ == other.map_ && index_ == other.index_;
+}
+
+bool CopyOnWriteMap::const_iterator::operator!=(
+    const const_iterator& other) const {
+  return !(*this == other);
+}
+
+CopyOnWriteMap::CopyOnWriteMap(std::shared_ptr<const Dungeon> dungeon)
+    : dungeon_(std::move(dungeon)), modified_rooms_() {
+  if (!dungeon_) {
+    throw std::invalid_argument("DUNGEON NOT SPECIFIED");
+  }
+}
+
+const Dungeon &CopyOnWriteMap::GetDungeon() const { return *dungeon_; }
+
+const std::shared_ptr<const Dungeon> &CopyOnWriteMap::GetSharedDungeon()
+    const {
+  return dungeon_;
+}
+
+size_t CopyOnWriteMap::GetNumberOfModifiedRooms() const {
+  return modified_rooms_.size();
+}
+
+bool CopyOnWriteMap::IsModified(size_t index) const {
+  return modified_rooms_.find(index) != modified_rooms_.end();
+}
+
+std::vector<size_t> CopyOnWriteMap::GetModifiedRoomIndices() const {
+  std::vector<size_t> indices;
+  indices.reserve(modified_rooms_.size());
+
+  for (const std::pair<const size_t, Room>& modified : modified_rooms_) {
+    indices.push_back(modified.first);
+  }
+
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+
+size_t CopyOnWriteMap::size() const { return dungeon_->GetMap().size(); }
+
+bool CopyOnWriteMap::empty() const { return dungeon_->GetMap().empty(); }
+
+const Room &CopyOnWriteMap::at(size_t index) const {
+  if (index >= size()) {
+    throw std::out_of_range("ROOM INDEX OUT OF RANGE");
+  }
+
+  return (*this)[index];
+}
+
+const Room &CopyOnWriteMap::operator[](size_t index) const {
+  if (!modified_rooms_.empty()) {
+    std::unordered_map<size_t, Room>::const_iterator modified =
+        modified_rooms_.find(index);
+
+    if (modified != modified_rooms_.end()) {
+      return modified->second;
+    }
+  }
+
+  return dungeon_->GetMap()[index];
+}
+
+const Room &CopyOnWriteMap::front() const { return (*this)[0]; }
+
+const Room &CopyOnWriteMap::back() const { return (*this)[size() - 1]; }
+
+CopyOnWriteMap::const_iterator CopyOnWriteMap::begin() const {
+  return const_iterator(this, 0);
+}
+
+CopyOnWriteMap::const_iterator CopyOnWriteMap::end() const {
+  return const_iterator(this, size());
+}
+
+Room &CopyOnWriteMap::Modify(size_t index) {
+  std::unordered_map<size_t, Room>::iterator modified =
+      modified_rooms_.find(index);
+
+  if (modified == modified_rooms_.end()) {
+    modified = modified_rooms_.emplace(index, at(index)).first;
+  }
+
+  return modified->second;
+}
+
+void CopyOnWriteMap::Reset() { modified_rooms_.clear(); }
+
+}   // namespace adventure
@@ -2,17 +2,19 @@
 
 #include "map/door.h"
 
+#include <stdexcept>
+#include <utility>
+
 namespace adventure {
 
-Door::Door(const std::string& direction, const std::string& adjacent_room,
-           bool is_locked)
-    : direction_(direction), adjacent_room_(adjacent_room),
-      is_locked_(is_locked) {
+Door::Door(std::string direction, std::string adjacent_room, bool is_locked)
+    : direction_(std::move(direction)),
+      adjacent_room_(std::move(adjacent_room)), is_locked_(is_locked) {
   size_t max_size = 5;
 
-  if (direction.empty() || adjacent_room.empty()) {
+  if (direction_.empty() || adjacent_room_.empty()) {
     throw std::invalid_argument("DIRECTION AND/OR ADJACENT ROOM NOT SPECIFIED");
-  } else if (adjacent_room.size() > max_size) {
+  } else if (adjacent_room_.size() > max_size) {
     throw std::invalid_argument("ADJACENT ROOM TOO LONG");
   }
 }
@@ -4,23 +4,57 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
 
 namespace adventure {
 
-Dungeon::Dungeon() : map_() {}
+Dungeon::Dungeon()
+    : arena_(new Arena()), map_(),
+      room_indices_(RoomIndices::allocator_type(arena_.get())) {}
+
+Dungeon::Dungeon(const Dungeon& other)
+    : arena_(new Arena()), map_(other.map_),
+      room_indices_(other.room_indices_.begin(), other.room_indices_.end()) {}
 
 const std::vector<Room> &Dungeon::GetMap() const { return map_; }
 
+const Arena &Dungeon::GetArena() const { return *arena_; }
+
+size_t Dungeon::FindRoomIndex(const std::string& name) const {
+  if (name.empty()) {
+    throw std::invalid_argument("ROOM NAME NOT SPECIFIED");
+  }
+
+  RoomIndices::const_iterator index =
+      room_indices_.find(name);
+
+  if (index == room_indices_.end()) {
+    throw std::invalid_argument("ROOM NOT FOUND");
+  }
+
+  return index->second;
+}
+
+bool Dungeon::HasRoom(const std::string& name) const {
+  return room_indices_.find(name) != room_indices_.end();
+}
+
 std::istream &operator>>(std::istream &is, Dungeon &dungeon) {
   std::string line;
   std::getline(is , line);
 
   if (line == "DUNGEON_LOAD_FINAL_PROJECT") {
+    std::vector<Door> doors;
+    std::vector<Enemy> enemies;
+    std::vector<Weapon> weapons;
+
     while (is.good()) {
       std::getline(is , line);
 
       if (line == "    {") {
-        dungeon.map_.push_back(dungeon.GenerateRoom(is, line));
+        dungeon.GenerateRoom(is, line, doors, enemies, weapons);
+        dungeon.room_indices_.emplace(dungeon.map_.back().GetNickname(),
+                                      dungeon.map_.size() - 1);
       }
     }
   } else {
@@ -30,7 +64,10 @@ std::istream &operator>>(std::istream &is, Dungeon &dungeon) {
   return is;
 }
 
-Room Dungeon::GenerateRoom(std::istream &is, std::string &line) {
+void Dungeon::GenerateRoom(std::istream &is, std::string &line,
+                           std::vector<Door>& doors,
+                           std::vector<Enemy>& enemies,
+                           std::vector<Weapon>& weapons) {
   std::getline(is , line);
   line.erase(std::remove_if(line.begin(), line.end(), isspace), line.end());
   std::string name = line;
@@ -39,7 +76,7 @@ Room Dungeon::GenerateRoom(std::istream &is, std::string &line) {
   line.erase(std::remove_if(line.begin(), line.end(), isspace), line.end());
   std::string nickname = line;
 
-  std::vector<Door> doors;
+  doors.clear();
   std::getline(is , line);
   if (line == "      [") {
     while (line != "      ]") {
@@ -51,7 +88,7 @@ Room Dungeon::GenerateRoom(std::istream &is, std::string &line) {
     }
   }
 
-  std::vector<Enemy> enemies;
+  enemies.clear();
   std::getline(is , line);
   if (line == "      [") {
     while (line != "      ]") {
@@ -63,7 +100,7 @@ Room Dungeon::GenerateRoom(std::istream &is, std::string &line) {
     }
   }
 
-  std::vector<Weapon> weapons;
+  weapons.clear();
   std::getline(is , line);
   if (line == "      [") {
     while (line != "      ]") {
@@ -79,7 +116,8 @@ Room Dungeon::GenerateRoom(std::istream &is, std::string &line) {
   line.erase(std::remove_if(line.begin(), line.end(), isspace), line.end());
   size_t number_of_keys = (size_t)std::stoi(line);
 
-  return Room(name, nickname, doors, enemies, weapons, number_of_keys);
+  map_.emplace_back(std::move(name), std::move(nickname), doors, enemies,
+                    weapons, number_of_keys, arena_.get());
 }
 
 Door Dungeon::GenerateDoor(std::istream &is, std::string &line) {
@@ -103,7 +141,7 @@ Door Dungeon::GenerateDoor(std::istream &is, std::string &line) {
 
   std::getline(is, line);
 
-  return Door(direction, adjacent_room, is_locked);
+  return Door(std::move(direction), std::move(adjacent_room), is_locked);
 }
 
 Enemy Dungeon::GenerateEnemy(std::istream &is, std::string &line) {
@@ -129,7 +167,8 @@ Enemy Dungeon::GenerateEnemy(std::istream &is, std::string &line) {
 
   std::getline(is, line);
 
-  return Enemy(name, nickname, health, strength, critical_chance);
+  return Enemy(std::move(name), std::move(nickname), health, strength,
+               critical_chance);
 }
 
 Weapon Dungeon::GenerateWeapon(std::istream &is, std::string &line) {
@@ -151,7 +190,8 @@ Weapon Dungeon::GenerateWeapon(std::istream &is, std::string &line) {
 
   std::getline(is, line);
 
-  return Weapon(name, nickname, strength, critical_chance);
+  return Weapon(std::move(name), std::move(nickname), strength,
+                critical_chance);
 }
 
 }
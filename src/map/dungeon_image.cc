@@ -0,0 +1,487 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "map/dungeon_image.h"
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace adventure {
+
+namespace {
+
+// Records are stored in this machine's byte order, which the magic number
+// catches if it ever differs
+const uint32_t kMagic = 0x44565441;
+const uint32_t kVersion = 1;
+const uint32_t kNoAdjacentRoom = 0xFFFFFFFF;
+
+struct ImageSpan {
+  uint32_t offset;
+  uint32_t size;
+};
+
+struct ImageHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t size;
+  uint32_t number_of_rooms;
+  uint32_t rooms;
+  uint32_t buckets;
+  uint32_t number_of_buckets;
+  uint32_t reserved;
+};
+
+struct ImageRoom {
+  ImageSpan name;
+  ImageSpan nickname;
+  uint32_t number_of_keys;
+  uint32_t reserved;
+  ImageSpan doors;
+  ImageSpan enemies;
+  ImageSpan weapons;
+};
+
+struct ImageDoor {
+  ImageSpan direction;
+  uint32_t adjacent_room;
+  uint32_t is_locked;
+};
+
+struct ImageEnemy {
+  ImageSpan name;
+  ImageSpan nickname;
+  uint32_t health;
+  uint32_t strength;
+  uint32_t critical_chance;
+  uint32_t reserved;
+};
+
+struct ImageWeapon {
+  ImageSpan name;
+  ImageSpan nickname;
+  uint32_t strength;
+  uint32_t critical_chance;
+};
+
+// Records are copied out rather than pointed to, so the image needs no
+// particular alignment
+template <typename Record>
+Record Load(const char* data, size_t offset) {
+  Record record;
+  std::memcpy(&record, data + offset, sizeof(Record));
+
+  return record;
+}
+
+template <typename Record>
+void Store(std::string& image, size_t offset, const Record& record) {
+  std::memcpy(&image[offset], &record, sizeof(Record));
+}
+
+size_t Allocate(std::string& image, size_t size) {
+  size_t offset = image.size();
+  image.resize(offset + size, '\0');
+
+  return offset;
+}
+
+ImageSpan AppendString(std::string& image, const std::string& text) {
+  ImageSpan span{(uint32_t)image.size(), (uint32_t)text.size()};
+  image.append(text);
+
+  return span;
+}
+
+uint32_t Hash(const char* text, size_t size) {
+  uint32_t hash = 2166136261u;
+
+  for (size_t index = 0; index < size; ++index) {
+    hash = (hash ^ (uint8_t)text[index]) * 16777619u;
+  }
+  return hash;
+}
+
+bool IsInside(uint64_t offset, uint64_t size, uint64_t image_size) {
+  return offset <= image_size && size <= image_size - offset;
+}
+
+std::string ToString(const char* data, const ImageSpan& span) {
+  return std::string(data + span.offset, span.size);
+}
+
+bool Equals(const char* data, const ImageSpan& span,
+            const std::string& text) {
+  return span.size == text.size() &&
+         std::memcmp(data + span.offset, text.data(), text.size()) == 0;
+}
+
+}   // namespace
+
+const size_t DungeonImage::kNoRoom;
+
+void DungeonImage::Write(const Dungeon& dungeon, const std::string& path) {
+  const std::vector<Room>& rooms = dungeon.GetMap();
+  if (rooms.empty()) {
+    throw std::invalid_argument("DUNGEON MAP HAS NO ROOMS");
+  }
+
+  // A table at most half full keeps lookups short
+  size_t number_of_buckets = 1;
+  while (number_of_buckets < rooms.size() * 2) {
+    number_of_buckets *= 2;
+  }
+
+  std::string image;
+  Allocate(image, sizeof(ImageHeader));
+  size_t rooms_offset = Allocate(image, rooms.size() * sizeof(ImageRoom));
+  size_t buckets_offset = Allocate(image, number_of_buckets * sizeof(uint32_t));
+
+  std::vector<uint32_t> buckets(number_of_buckets, 0);
+  for (size_t room = 0; room < rooms.size(); ++room) {
+    const std::string& nickname = rooms[room].GetNickname();
+    size_t bucket = Hash(nickname.data(), nickname.size()) &
+                    (number_of_buckets - 1);
+
+    while (buckets[bucket] != 0) {
+      bucket = (bucket + 1) & (number_of_buckets - 1);
+    }
+    buckets[bucket] = (uint32_t)room + 1;
+  }
+  for (size_t bucket = 0; bucket < number_of_buckets; ++bucket) {
+    Store(image, buckets_offset + bucket * sizeof(uint32_t), buckets[bucket]);
+  }
+
+  // Every fixed-size record is laid out before any string, so the strings
+  // can simply be appended while the records are filled in
+  for (size_t room = 0; room < rooms.size(); ++room) {
+    const Room& source = rooms[room];
+    ImageRoom record;
+
+    record.number_of_keys = (uint32_t)source.GetNumberOfKeys();
+    record.reserved = 0;
+    record.doors = ImageSpan{
+        (uint32_t)Allocate(image, source.GetDoors().size() * sizeof(ImageDoor)),
+        (uint32_t)source.GetDoors().size()};
+    record.enemies = ImageSpan{
+        (uint32_t)Allocate(image,
+                           source.GetEnemies().size() * sizeof(ImageEnemy)),
+        (uint32_t)source.GetEnemies().size()};
+    record.weapons = ImageSpan{
+        (uint32_t)Allocate(image,
+                           source.GetWeapons().size() * sizeof(ImageWeapon)),
+        (uint32_t)source.GetWeapons().size()};
+    record.name = ImageSpan{0, 0};
+    record.nickname = ImageSpan{0, 0};
+
+    Store(image, rooms_offset + room * sizeof(ImageRoom), record);
+  }
+
+  for (size_t room = 0; room < rooms.size(); ++room) {
+    const Room& source = rooms[room];
+    size_t room_offset = rooms_offset + room * sizeof(ImageRoom);
+    ImageRoom record = Load<ImageRoom>(image.data(), room_offset);
+
+    record.name = AppendString(image, source.GetName());
+    record.nickname = AppendString(image, source.GetNickname());
+    Store(image, room_offset, record);
+
+    for (size_t index = 0; index < source.GetDoors().size(); ++index) {
+      const Door& door = source.GetDoors()[index];
+      ImageDoor door_record;
+
+      door_record.direction = AppendString(image, door.GetDirection());
+      door_record.is_locked = door.IsLocked() ? 1 : 0;
+      try {
+        door_record.adjacent_room =
+            (uint32_t)dungeon.FindRoomIndex(door.GetAdjacentRoom());
+      } catch (const std::invalid_argument&) {
+        door_record.adjacent_room = kNoAdjacentRoom;
+      }
+
+      Store(image, record.doors.offset + index * sizeof(ImageDoor),
+            door_record);
+    }
+
+    for (size_t index = 0; index < source.GetEnemies().size(); ++index) {
+      const Enemy& enemy = source.GetEnemies()[index];
+      ImageEnemy enemy_record;
+
+      enemy_record.name = AppendString(image, enemy.GetName());
+      enemy_record.nickname = AppendString(image, enemy.GetNickname());
+      enemy_record.health = (uint32_t)enemy.GetHealth();
+      enemy_record.strength = (uint32_t)enemy.GetStrength();
+      enemy_record.critical_chance = (uint32_t)enemy.GetCriticalChance();
+      enemy_record.reserved = 0;
+
+      Store(image, record.enemies.offset + index * sizeof(ImageEnemy),
+            enemy_record);
+    }
+
+    for (size_t index = 0; index < source.GetWeapons().size(); ++index) {
+      const Weapon& weapon = source.GetWeapons()[index];
+      ImageWeapon weapon_record;
+
+      weapon_record.name = AppendString(image, weapon.GetName());
+      weapon_record.nickname = AppendString(image, weapon.GetNickname());
+      weapon_record.strength = (uint32_t)weapon.GetStrength();
+      weapon_record.critical_chance = (uint32_t)weapon.GetCriticalChance();
+
+      Store(image, record.weapons.offset + index * sizeof(ImageWeapon),
+            weapon_record);
+    }
+  }
+
+  ImageHeader header{kMagic, kVersion, (uint32_t)image.size(),
+                     (uint32_t)rooms.size(), (uint32_t)rooms_offset,
+                     (uint32_t)buckets_offset, (uint32_t)number_of_buckets, 0};
+  Store(image, 0, header);
+
+  // Processes that already mapped the old image keep its pages, since the
+  // new one replaces the file rather than overwriting it
+  std::string temporary_path = path + ".tmp";
+  std::FILE* file = std::fopen(temporary_path.c_str(), "wb");
+  if (file == nullptr) {
+    throw std::invalid_argument("FILE COULD NOT BE WRITTEN");
+  }
+
+  bool is_written =
+      std::fwrite(image.data(), 1, image.size(), file) == image.size();
+  is_written = std::fclose(file) == 0 && is_written;
+
+#ifdef _WIN32
+  // Windows will not rename over an existing file
+  if (is_written) {
+    std::remove(path.c_str());
+  }
+#endif
+  if (!is_written || std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+    std::remove(temporary_path.c_str());
+    throw std::invalid_argument("FILE COULD NOT BE WRITTEN");
+  }
+}
+
+DungeonImage::DungeonImage(const std::string& path)
+    : file_(path), data_((const char*)file_.GetData()),
+      size_(file_.GetSize()) {
+  if (size_ < sizeof(ImageHeader)) {
+    throw std::invalid_argument("DUNGEON IMAGE IS CORRUPTED");
+  }
+
+  Validate();
+}
+
+size_t DungeonImage::GetSize() const { return size_; }
+
+size_t DungeonImage::GetNumberOfRooms() const {
+  return Load<ImageHeader>(data_, 0).number_of_rooms;
+}
+
+size_t DungeonImage::FindRoomIndex(const std::string& name) const {
+  if (name.empty()) {
+    throw std::invalid_argument("ROOM NAME NOT SPECIFIED");
+  }
+
+  ImageHeader header = Load<ImageHeader>(data_, 0);
+  size_t mask = header.number_of_buckets - 1;
+  size_t bucket = Hash(name.data(), name.size()) & mask;
+
+  // Validation guarantees an empty bucket, so every probe ends
+  for (uint32_t room = Load<uint32_t>(data_, header.buckets +
+                                                 bucket * sizeof(uint32_t));
+       room != 0;
+       room = Load<uint32_t>(data_, header.buckets +
+                                        bucket * sizeof(uint32_t))) {
+    ImageRoom record = Load<ImageRoom>(data_, RetrieveRoomOffset(room - 1));
+
+    if (Equals(data_, record.nickname, name)) {
+      return room - 1;
+    }
+    bucket = (bucket + 1) & mask;
+  }
+
+  throw std::invalid_argument("ROOM NOT FOUND");
+}
+
+std::string DungeonImage::GetRoomName(size_t room) const {
+  return ToString(data_, Load<ImageRoom>(data_, RetrieveRoomOffset(room)).name);
+}
+
+std::string DungeonImage::GetRoomNickname(size_t room) const {
+  return ToString(data_,
+                  Load<ImageRoom>(data_, RetrieveRoomOffset(room)).nickname);
+}
+
+size_t DungeonImage::GetNumberOfKeys(size_t room) const {
+  return Load<ImageRoom>(data_, RetrieveRoomOffset(room)).number_of_keys;
+}
+
+size_t DungeonImage::GetNumberOfDoors(size_t room) const {
+  return Load<ImageRoom>(data_, RetrieveRoomOffset(room)).doors.size;
+}
+
+size_t DungeonImage::FindDoorIndex(size_t room,
+                                   const std::string& direction) const {
+  if (direction.empty()) {
+    throw std::invalid_argument("DOOR DIRECTION NOT SPECIFIED");
+  }
+
+  ImageSpan doors = Load<ImageRoom>(data_, RetrieveRoomOffset(room)).doors;
+  for (size_t door = 0; door < doors.size; ++door) {
+    ImageDoor record =
+        Load<ImageDoor>(data_, doors.offset + door * sizeof(ImageDoor));
+
+    if (Equals(data_, record.direction, direction)) {
+      return door;
+    }
+  }
+
+  throw std::invalid_argument("DOOR NOT FOUND");
+}
+
+std::string DungeonImage::GetDoorDirection(size_t room, size_t door) const {
+  ImageSpan doors = Load<ImageRoom>(data_, RetrieveRoomOffset(room)).doors;
+  if (door >= doors.size) {
+    throw std::invalid_argument("DOOR INDEX OUT OF RANGE");
+  }
+
+  return ToString(data_, Load<ImageDoor>(data_, doors.offset +
+                                                    door * sizeof(ImageDoor))
+                             .direction);
+}
+
+size_t DungeonImage::GetAdjacentRoomIndex(size_t room, size_t door) const {
+  ImageSpan doors = Load<ImageRoom>(data_, RetrieveRoomOffset(room)).doors;
+  if (door >= doors.size) {
+    throw std::invalid_argument("DOOR INDEX OUT OF RANGE");
+  }
+
+  uint32_t adjacent_room =
+      Load<ImageDoor>(data_, doors.offset + door * sizeof(ImageDoor))
+          .adjacent_room;
+  return adjacent_room == kNoAdjacentRoom ? kNoRoom : adjacent_room;
+}
+
+bool DungeonImage::IsDoorLocked(size_t room, size_t door) const {
+  ImageSpan doors = Load<ImageRoom>(data_, RetrieveRoomOffset(room)).doors;
+  if (door >= doors.size) {
+    throw std::invalid_argument("DOOR INDEX OUT OF RANGE");
+  }
+
+  return Load<ImageDoor>(data_, doors.offset + door * sizeof(ImageDoor))
+             .is_locked != 0;
+}
+
+size_t DungeonImage::GetNumberOfEnemies(size_t room) const {
+  return Load<ImageRoom>(data_, RetrieveRoomOffset(room)).enemies.size;
+}
+
+Enemy DungeonImage::GetEnemy(size_t room, size_t enemy) const {
+  ImageSpan enemies = Load<ImageRoom>(data_, RetrieveRoomOffset(room)).enemies;
+  if (enemy >= enemies.size) {
+    throw std::invalid_argument("ENEMY INDEX OUT OF RANGE");
+  }
+
+  ImageEnemy record =
+      Load<ImageEnemy>(data_, enemies.offset + enemy * sizeof(ImageEnemy));
+  return Enemy(ToString(data_, record.name), ToString(data_, record.nickname),
+               record.health, record.strength, record.critical_chance);
+}
+
+size_t DungeonImage::GetNumberOfWeapons(size_t room) const {
+  return Load<ImageRoom>(data_, RetrieveRoomOffset(room)).weapons.size;
+}
+
+Weapon DungeonImage::GetWeapon(size_t room, size_t weapon) const {
+  ImageSpan weapons = Load<ImageRoom>(data_, RetrieveRoomOffset(room)).weapons;
+  if (weapon >= weapons.size) {
+    throw std::invalid_argument("WEAPON INDEX OUT OF RANGE");
+  }
+
+  ImageWeapon record =
+      Load<ImageWeapon>(data_, weapons.offset + weapon * sizeof(ImageWeapon));
+  return Weapon(ToString(data_, record.name), ToString(data_, record.nickname),
+                record.strength, record.critical_chance);
+}
+
+void DungeonImage::Validate() const {
+  ImageHeader header = Load<ImageHeader>(data_, 0);
+
+  if (header.magic != kMagic || header.version != kVersion ||
+      header.size != size_ || header.number_of_rooms == 0 ||
+      header.number_of_buckets <= header.number_of_rooms ||
+      (header.number_of_buckets & (header.number_of_buckets - 1)) != 0 ||
+      !IsInside(header.rooms,
+                (uint64_t)header.number_of_rooms * sizeof(ImageRoom), size_) ||
+      !IsInside(header.buckets,
+                (uint64_t)header.number_of_buckets * sizeof(uint32_t),
+                size_)) {
+    throw std::invalid_argument("DUNGEON IMAGE IS CORRUPTED");
+  }
+
+  for (size_t bucket = 0; bucket < header.number_of_buckets; ++bucket) {
+    if (Load<uint32_t>(data_, header.buckets + bucket * sizeof(uint32_t)) >
+        header.number_of_rooms) {
+      throw std::invalid_argument("DUNGEON IMAGE IS CORRUPTED");
+    }
+  }
+
+  for (size_t room = 0; room < header.number_of_rooms; ++room) {
+    ImageRoom record =
+        Load<ImageRoom>(data_, header.rooms + room * sizeof(ImageRoom));
+    bool is_valid =
+        IsInside(record.name.offset, record.name.size, size_) &&
+        IsInside(record.nickname.offset, record.nickname.size, size_) &&
+        IsInside(record.doors.offset,
+                 (uint64_t)record.doors.size * sizeof(ImageDoor), size_) &&
+        IsInside(record.enemies.offset,
+                 (uint64_t)record.enemies.size * sizeof(ImageEnemy), size_) &&
+        IsInside(record.weapons.offset,
+                 (uint64_t)record.weapons.size * sizeof(ImageWeapon), size_);
+
+    for (size_t door = 0; is_valid && door < record.doors.size; ++door) {
+      ImageDoor door_record = Load<ImageDoor>(
+          data_, record.doors.offset + door * sizeof(ImageDoor));
+
+      is_valid = IsInside(door_record.direction.offset,
+                          door_record.direction.size, size_) &&
+                 (door_record.adjacent_room < header.number_of_rooms ||
+                  door_record.adjacent_room == kNoAdjacentRoom);
+    }
+    for (size_t enemy = 0; is_valid && enemy < record.enemies.size; ++enemy) {
+      ImageEnemy enemy_record = Load<ImageEnemy>(
+          data_, record.enemies.offset + enemy * sizeof(ImageEnemy));
+
+      is_valid = IsInside(enemy_record.name.offset, enemy_record.name.size,
+                          size_) &&
+                 IsInside(enemy_record.nickname.offset,
+                          enemy_record.nickname.size, size_);
+    }
+    for (size_t weapon = 0; is_valid && weapon < record.weapons.size;
+         ++weapon) {
+      ImageWeapon weapon_record = Load<ImageWeapon>(
+          data_, record.weapons.offset + weapon * sizeof(ImageWeapon));
+
+      is_valid = IsInside(weapon_record.name.offset, weapon_record.name.size,
+                          size_) &&
+                 IsInside(weapon_record.nickname.offset,
+                          weapon_record.nickname.size, size_);
+    }
+
+    if (!is_valid) {
+      throw std::invalid_argument("DUNGEON IMAGE IS CORRUPTED");
+    }
+  }
+}
+
+size_t DungeonImage::RetrieveRoomOffset(size_t room) const {
+  ImageHeader header = Load<ImageHeader>(data_, 0);
+
+  if (room >= header.number_of_rooms) {
+    throw std::invalid_argument("ROOM INDEX OUT OF RANGE");
+  }
+  return header.rooms + room * sizeof(ImageRoom);
+}
+
+}   // namespace adventure
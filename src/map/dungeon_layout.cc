@@ -0,0 +1,178 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "map/dungeon_layout.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace adventure {
+
+const int32_t DungeonLayout::kBucketSize;
+
+DungeonLayout::DungeonLayout()
+    : positions_(), minimum_{0, 0}, maximum_{0, 0}, bucket_rooms_(),
+      buckets_() {}
+
+DungeonLayout::DungeonLayout(const Dungeon& dungeon) : DungeonLayout() {
+  const std::vector<Room>& map = dungeon.GetMap();
+  if (map.empty()) {
+    return;
+  }
+
+  positions_.resize(map.size());
+  std::vector<bool> is_placed(map.size(), false);
+
+  PlaceGroup(dungeon, 0, GridPosition{0, 0}, is_placed);
+
+  // Rooms the first Room cannot reach are placed group by group, each one
+  // starting a column past everything placed so far
+  for (size_t room = 1; room < map.size(); ++room) {
+    if (!is_placed[room]) {
+      PlaceGroup(dungeon, room, GridPosition{maximum_.x + 2, minimum_.y},
+                 is_placed);
+    }
+  }
+
+  IndexBuckets();
+}
+
+size_t DungeonLayout::size() const { return positions_.size(); }
+
+const GridPosition &DungeonLayout::GetPosition(size_t room) const {
+  if (room >= positions_.size()) {
+    throw std::invalid_argument("ROOM INDEX OUT OF RANGE");
+  }
+
+  return positions_[room];
+}
+
+const GridPosition &DungeonLayout::GetMinimum() const { return minimum_; }
+
+const GridPosition &DungeonLayout::GetMaximum() const { return maximum_; }
+
+void DungeonLayout::FindRooms(const GridPosition& minimum,
+                              const GridPosition& maximum,
+                              std::vector<size_t>& rooms) const {
+  rooms.clear();
+
+  for (int32_t bucket_y = FindBucket(minimum.y);
+       bucket_y <= FindBucket(maximum.y); ++bucket_y) {
+    for (int32_t bucket_x = FindBucket(minimum.x);
+         bucket_x <= FindBucket(maximum.x); ++bucket_x) {
+      auto bucket = buckets_.find(FindBucketKey(bucket_x, bucket_y));
+      if (bucket == buckets_.end()) {
+        continue;
+      }
+
+      for (uint32_t index = bucket->second.first;
+           index < bucket->second.second; ++index) {
+        const GridPosition& position = positions_[bucket_rooms_[index]];
+
+        if (position.x >= minimum.x && position.x <= maximum.x &&
+            position.y >= minimum.y && position.y <= maximum.y) {
+          rooms.push_back(bucket_rooms_[index]);
+        }
+      }
+    }
+  }
+}
+
+bool DungeonLayout::FindOffset(const std::string& direction,
+                               GridPosition& offset) {
+  if (direction == "LEFT") {
+    offset = GridPosition{-1, 0};
+  } else if (direction == "RIGHT") {
+    offset = GridPosition{1, 0};
+  } else if (direction == "UP") {
+    offset = GridPosition{0, -1};
+  } else if (direction == "DOWN") {
+    offset = GridPosition{0, 1};
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+void DungeonLayout::PlaceGroup(const Dungeon& dungeon, size_t start,
+                               const GridPosition& position,
+                               std::vector<bool>& is_placed) {
+  const std::vector<Room>& map = dungeon.GetMap();
+  bool is_first_group = start == 0;
+
+  std::vector<uint32_t> queue{(uint32_t)start};
+  positions_[start] = position;
+  is_placed[start] = true;
+
+  if (is_first_group) {
+    minimum_ = position;
+    maximum_ = position;
+  }
+
+  for (size_t next = 0; next < queue.size(); ++next) {
+    uint32_t room = queue[next];
+    const GridPosition& room_position = positions_[room];
+
+    minimum_.x = std::min(minimum_.x, room_position.x);
+    minimum_.y = std::min(minimum_.y, room_position.y);
+    maximum_.x = std::max(maximum_.x, room_position.x);
+    maximum_.y = std::max(maximum_.y, room_position.y);
+
+    for (const Door& door : map[room].GetDoors()) {
+      GridPosition offset;
+      if (!FindOffset(door.GetDirection(), offset) ||
+          !dungeon.HasRoom(door.GetAdjacentRoom())) {
+        continue;
+      }
+
+      size_t adjacent_room = dungeon.FindRoomIndex(door.GetAdjacentRoom());
+      if (is_placed[adjacent_room]) {
+        continue;
+      }
+
+      positions_[adjacent_room] = GridPosition{room_position.x + offset.x,
+                                               room_position.y + offset.y};
+      is_placed[adjacent_room] = true;
+      queue.push_back((uint32_t)adjacent_room);
+    }
+  }
+}
+
+void DungeonLayout::IndexBuckets() {
+  std::vector<std::pair<uint64_t, uint32_t>> keyed_rooms;
+  keyed_rooms.reserve(positions_.size());
+
+  for (size_t room = 0; room < positions_.size(); ++room) {
+    const GridPosition& position = positions_[room];
+    keyed_rooms.emplace_back(FindBucketKey(FindBucket(position.x),
+                                           FindBucket(position.y)),
+                             (uint32_t)room);
+  }
+
+  std::sort(keyed_rooms.begin(), keyed_rooms.end());
+
+  bucket_rooms_.reserve(keyed_rooms.size());
+  for (size_t index = 0; index < keyed_rooms.size(); ++index) {
+    bucket_rooms_.push_back(keyed_rooms[index].second);
+
+    uint64_t key = keyed_rooms[index].first;
+    if (index == 0 || keyed_rooms[index - 1].first != key) {
+      buckets_[key] = std::make_pair((uint32_t)index, (uint32_t)index);
+    }
+    ++buckets_[key].second;
+  }
+}
+
+int32_t DungeonLayout::FindBucket(int32_t coordinate) {
+  if (coordinate >= 0) {
+    return coordinate / kBucketSize;
+  }
+
+  return -((-coordinate + kBucketSize - 1) / kBucketSize);
+}
+
+uint64_t DungeonLayout::FindBucketKey(int32_t bucket_x, int32_t bucket_y) {
+  return ((uint64_t)(uint32_t)bucket_x << 32) | (uint64_t)(uint32_t)bucket_y;
+}
+
+}   // namespace adventure
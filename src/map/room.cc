@@ -4,29 +4,56 @@
 
 namespace adventure {
 
-Room::Room(const std::string& name, const std::string& nickname,
+Room::Room(std::string name, std::string nickname,
            const std::vector<Door>& doors, const std::vector<Enemy>& enemies,
            const std::vector<Weapon>& weapons, size_t number_of_keys)
-    : name_(name), nickname_(nickname), doors_(doors), enemies_(enemies),
-      weapons_(weapons), number_of_keys_(number_of_keys) {
+    : Room(std::move(name), std::move(nickname), doors, enemies, weapons,
+           number_of_keys, nullptr) {}
+
+Room::Room(std::string name, std::string nickname,
+           const std::vector<Door>& doors, const std::vector<Enemy>& enemies,
+           const std::vector<Weapon>& weapons, size_t number_of_keys,
+           Arena* arena)
+    : name_(std::move(name)), nickname_(std::move(nickname)),
+      doors_(doors.begin(), doors.end(), ArenaAllocator<Door>(arena)),
+      enemies_(ArenaAllocator<Enemy>(arena)),
+      weapons_(ArenaAllocator<Weapon>(arena)),
+      number_of_keys_(number_of_keys),
+      enemy_counts_(0, EnemyCounts::hasher(), EnemyCounts::key_equal(),
+                    EnemyCounts::allocator_type(arena)) {
   size_t max_size = 5;
 
-  if (name.empty() || nickname.empty()) {
+  if (name_.empty() || nickname_.empty()) {
     throw std::invalid_argument("NAME AND/OR NICKNAME NOT SPECIFIED");
-  } else if (nickname.size() > max_size) {
+  } else if (nickname_.size() > max_size) {
     throw std::invalid_argument("NICKNAME TOO LONG");
   }
+
+  enemies_.reserve(enemies.size());
+  for (const Enemy& enemy : enemies) {
+    enemies_.Insert(enemy);
+    ++enemy_counts_[&enemy.GetArchetype()];
+  }
+
+  weapons_.reserve(weapons.size());
+  for (const Weapon& weapon : weapons) {
+    weapons_.Insert(weapon);
+  }
 }
 
 const std::string &Room::GetName() const { return name_; }
 
 const std::string &Room::GetNickname() const { return nickname_; }
 
-const std::vector<Door> &Room::GetDoors() const { return doors_; }
+const ArenaVector<Door> &Room::GetDoors() const { return doors_; }
 
-const std::vector<Enemy> &Room::GetEnemies() const { return enemies_; }
+const ArenaVector<Enemy> &Room::GetEnemies() const {
+  return enemies_.GetValues();
+}
 
-const std::vector<Weapon> &Room::GetWeapons() const { return weapons_; }
+const ArenaVector<Weapon> &Room::GetWeapons() const {
+  return weapons_.GetValues();
+}
 
 size_t Room::GetNumberOfKeys() const { return number_of_keys_; }
 
@@ -40,66 +67,115 @@ void Room::DecrementNumberOfKeys() {
   }
 }
 
-void Room::AddWeapon(const Weapon& weapon) {
-  for (Weapon& room_weapon : weapons_) {
+SlotHandle Room::AddWeapon(const Weapon& weapon) {
+  for (const Weapon& room_weapon : weapons_.GetValues()) {
     if (room_weapon.GetName() == weapon.GetName()) {
       throw std::invalid_argument("WEAPON ALREADY IN ROOM");
     }
   }
 
-  weapons_.push_back(weapon);
+  return weapons_.Insert(weapon);
 }
 
-void Room::RemoveWeapon(const Weapon& weapon) {
-  if (weapons_.empty()) {
-    throw std::invalid_argument("WEAPONS EMPTY");
+void Room::RemoveWeapon(SlotHandle handle) {
+  if (!weapons_.Contains(handle)) {
+    throw std::invalid_argument("WEAPON NOT FOUND");
   }
 
-  for (size_t index = 0; index < weapons_.size(); ++index) {
-    if (weapons_[index].GetName() == weapon.GetName()) {
-      weapons_.erase(weapons_.begin() + (int)index);
-      return;
-    }
+  weapons_.Remove(handle);
+}
+
+void Room::RemoveWeaponAt(size_t index) {
+  if (index >= weapons_.size()) {
+    throw std::invalid_argument("WEAPON NOT FOUND");
   }
 
-  throw std::invalid_argument("WEAPON NOT FOUND");
+  weapons_.RemoveAt(index);
 }
 
-void Room::RemoveEnemy(const Enemy& enemy) {
-  if (enemies_.empty()) {
-    throw std::invalid_argument("ENEMIES EMPTY");
+void Room::RemoveEnemy(SlotHandle handle) {
+  if (!enemies_.Contains(handle)) {
+    throw std::invalid_argument("ENEMY NOT FOUND");
   }
 
-  for (size_t index = 0; index < enemies_.size(); ++index) {
-    if (enemies_[index].GetName() == enemy.GetName()) {
-      enemies_.erase(enemies_.begin() + (int)index);
-      return;
-    }
+  --enemy_counts_[&enemies_.Get(handle).GetArchetype()];
+  enemies_.Remove(handle);
+}
+
+void Room::ReserveWeapons(size_t capacity) { weapons_.reserve(capacity); }
+
+void Room::InsertWeapon(size_t index, const Weapon& weapon) {
+  if (index > weapons_.size()) {
+    throw std::invalid_argument("WEAPON INDEX OUT OF RANGE");
   }
 
-  throw std::invalid_argument("ENEMY NOT FOUND");
+  weapons_.InsertAt(index, weapon);
 }
 
-Weapon &Room::RetrieveWeapon(const std::string& name) {
+void Room::InsertEnemy(size_t index, const Enemy& enemy) {
+  if (index > enemies_.size()) {
+    throw std::invalid_argument("ENEMY INDEX OUT OF RANGE");
+  }
+
+  enemies_.InsertAt(index, enemy);
+  ++enemy_counts_[&enemy.GetArchetype()];
+}
+
+void Room::RemoveEnemyAt(size_t index) {
+  if (index >= enemies_.size()) {
+    throw std::invalid_argument("ENEMY NOT FOUND");
+  }
+
+  --enemy_counts_[&enemies_.GetAt(index).GetArchetype()];
+  enemies_.RemoveAt(index);
+}
+
+SlotHandle Room::FindWeapon(const std::string& name) const {
   if (name.empty()) {
     throw std::invalid_argument("WEAPON NAME NOT SPECIFIED");
   }
 
-  for (Weapon& weapon : weapons_) {
-    if (weapon.GetNickname() == name) {
-      return weapon;
+  const ArenaVector<Weapon>& weapons = weapons_.GetValues();
+  for (size_t index = 0; index < weapons.size(); ++index) {
+    if (weapons[index].GetNickname() == name) {
+      return weapons_.GetHandle(index);
     }
   }
 
   throw std::invalid_argument("WEAPON NOT FOUND");
 }
 
+size_t Room::GetWeaponIndex(SlotHandle handle) const {
+  if (!weapons_.Contains(handle)) {
+    throw std::invalid_argument("WEAPON NOT FOUND");
+  }
+
+  return weapons_.GetIndex(handle);
+}
+
+Weapon &Room::RetrieveWeapon(const std::string& name) {
+  return weapons_.Get(FindWeapon(name));
+}
+
+Weapon &Room::RetrieveWeapon(SlotHandle handle) {
+  if (!weapons_.Contains(handle)) {
+    throw std::invalid_argument("WEAPON NOT FOUND");
+  }
+
+  return weapons_.Get(handle);
+}
+
 Door &Room::RetrieveDoor(const std::string &direction) {
+  return const_cast<Door&>(
+      static_cast<const Room&>(*this).RetrieveDoor(direction));
+}
+
+const Door &Room::RetrieveDoor(const std::string &direction) const {
   if (direction.empty()) {
     throw std::invalid_argument("DOOR DIRECTION NOT SPECIFIED");
   }
 
-  for (Door& door : doors_) {
+  for (const Door& door : doors_) {
     if (door.GetDirection() == direction) {
       return door;
     }
@@ -108,18 +184,60 @@ Door &Room::RetrieveDoor(const std::string &direction) {
   throw std::invalid_argument("DOOR NOT FOUND");
 }
 
-Enemy &Room::RetrieveEnemy(const std::string &name) {
+SlotHandle Room::FindEnemy(const std::string& name) const {
   if (name.empty()) {
     throw std::invalid_argument("ENEMY NAME NOT SPECIFIED");
   }
 
-  for (Enemy& enemy : enemies_) {
-    if (enemy.GetNickname() == name) {
-      return enemy;
+  const ArenaVector<Enemy>& enemies = enemies_.GetValues();
+  for (size_t index = 0; index < enemies.size(); ++index) {
+    if (enemies[index].GetNickname() == name) {
+      return enemies_.GetHandle(index);
     }
   }
 
   throw std::invalid_argument("ENEMY NOT FOUND");
 }
 
+size_t Room::CountEnemies(const EnemyArchetype& archetype) const {
+  EnemyCounts::const_iterator found = enemy_counts_.find(&archetype);
+  return found == enemy_counts_.end() ? 0 : found->second;
+}
+
+size_t Room::GetEnemyIndex(SlotHandle handle) const {
+  if (!enemies_.Contains(handle)) {
+    throw std::invalid_argument("ENEMY NOT FOUND");
+  }
+
+  return enemies_.GetIndex(handle);
+}
+
+Enemy &Room::RetrieveEnemy(const std::string &name) {
+  return enemies_.Get(FindEnemy(name));
+}
+
+Enemy &Room::RetrieveEnemy(SlotHandle handle) {
+  if (!enemies_.Contains(handle)) {
+    throw std::invalid_argument("ENEMY NOT FOUND");
+  }
+
+  return enemies_.Get(handle);
+}
+
+Enemy &Room::RetrieveEnemyAt(size_t index) {
+  if (index >= enemies_.size()) {
+    throw std::invalid_argument("ENEMY NOT FOUND");
+  }
+
+  return enemies_.GetAt(index);
+}
+
+Door &Room::RetrieveDoorAt(size_t index) {
+  if (index >= doors_.size()) {
+    throw std::invalid_argument("DOOR NOT FOUND");
+  }
+
+  return doors_[index];
+}
+
 }   // namespace adventure
\ No newline at end of file
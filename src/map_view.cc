@@ -0,0 +1,293 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "map_view.h"
+
+#include <algorithm>
+
+namespace adventure {
+
+namespace {
+
+// The part of a cell on each side of a Room's box that is left for Doors
+const float kCellMargin = 0.2f;
+const float kDoorThickness = 1.0f / 8.0f;
+
+const ci::ColorA kUnvisitedColor = ci::Color::gray(0.1875f);
+const ci::ColorA kVisitedColor = ci::Color::gray(0.3125f);
+const ci::ColorA kCurrentColor = ci::Color::gray(0.5f);
+const ci::ColorA kOpenDoorColor = ci::Color::gray(0.3125f);
+const ci::ColorA kLockedDoorColor = ci::Color(0.75f, 0.125f, 0.125f);
+
+const ci::ColorA kMinimapMarker = ci::Color(1.0f, 0.75f, 0.0f);
+
+// Doors past the last bit of a lock mask keep the Dungeon's own lock
+const size_t kMaxMaskedDoors = 64;
+
+}   // namespace
+
+const int32_t MapView::kVisibleColumns;
+const int32_t MapView::kVisibleRows;
+const int32_t MapView::kMaxMinimapSize;
+
+MapView::MapView()
+    : dungeon_(), layout_(), is_visited_(), locked_doors_(), current_room_(0),
+      has_current_room_(false), visible_rooms_(), quads_(), bounds_(),
+      cell_size_(0.0f), origin_(), is_dirty_(true), minimap_width_(0),
+      minimap_height_(0), minimap_scale_(1), minimap_pixels_(),
+      changed_pixels_(), minimap_texture_() {}
+
+void MapView::SetDungeon(const std::shared_ptr<const Dungeon>& dungeon) {
+  dungeon_ = dungeon;
+  layout_ = DungeonLayout(*dungeon_);
+
+  const std::vector<Room>& map = dungeon_->GetMap();
+  is_visited_.assign(map.size(), false);
+  locked_doors_.assign(map.size(), 0);
+
+  for (size_t room = 0; room < map.size(); ++room) {
+    const ArenaVector<Door>& doors = map[room].GetDoors();
+
+    for (size_t door = 0; door < doors.size() && door < kMaxMaskedDoors;
+         ++door) {
+      if (doors[door].IsLocked()) {
+        locked_doors_[room] |= (uint64_t)1 << door;
+      }
+    }
+  }
+
+  has_current_room_ = false;
+  is_dirty_ = true;
+
+  // Dungeons wider than the texture share each pixel between several cells
+  int32_t width = 0;
+  int32_t height = 0;
+  if (!map.empty()) {
+    width = layout_.GetMaximum().x - layout_.GetMinimum().x + 1;
+    height = layout_.GetMaximum().y - layout_.GetMinimum().y + 1;
+  }
+
+  minimap_scale_ = std::max(1, (std::max(width, height) + kMaxMinimapSize -
+                                1) / kMaxMinimapSize);
+  minimap_width_ = (width + minimap_scale_ - 1) / minimap_scale_;
+  minimap_height_ = (height + minimap_scale_ - 1) / minimap_scale_;
+
+  // An opaque black background, with every Room not yet visited over it
+  minimap_pixels_.assign(4 * (size_t)minimap_width_ * minimap_height_, 0);
+  for (size_t alpha = 3; alpha < minimap_pixels_.size(); alpha += 4) {
+    minimap_pixels_[alpha] = 255;
+  }
+  for (size_t room = 0; room < map.size(); ++room) {
+    SetMinimapPixel(FindMinimapPixel(room), kUnvisitedColor);
+  }
+
+  // The whole minimap is uploaded with the texture
+  changed_pixels_.clear();
+  minimap_texture_.reset();
+}
+
+void MapView::Update(const std::string& location, uint64_t locked_doors) {
+  if (dungeon_ == nullptr || !dungeon_->HasRoom(location)) {
+    return;
+  }
+
+  size_t room = dungeon_->FindRoomIndex(location);
+  if (has_current_room_ && room == current_room_ &&
+      locked_doors == locked_doors_[room]) {
+    return;
+  }
+
+  if (has_current_room_ && room != current_room_) {
+    SetMinimapPixel(FindMinimapPixel(current_room_), kVisitedColor);
+  }
+
+  current_room_ = room;
+  has_current_room_ = true;
+  is_visited_[room] = true;
+  locked_doors_[room] = locked_doors;
+
+  SetMinimapPixel(FindMinimapPixel(room), kMinimapMarker);
+  is_dirty_ = true;
+}
+
+void MapView::Draw(const ci::Rectf& bounds, TextRenderer& text_renderer) {
+  if (!has_current_room_) {
+    return;
+  }
+
+  if (bounds.getUpperLeft() != bounds_.getUpperLeft() ||
+      bounds.getLowerRight() != bounds_.getLowerRight()) {
+    bounds_ = bounds;
+    is_dirty_ = true;
+  }
+
+  if (is_dirty_) {
+    LoadQuads();
+  }
+
+  quads_.Draw();
+
+  const std::vector<Room>& map = dungeon_->GetMap();
+  float size = cell_size_ / 5.0f;
+
+  for (size_t room : visible_rooms_) {
+    if (!is_visited_[room]) {
+      continue;
+    }
+
+    glm::vec2 center = FindCell(room).getCenter();
+    text_renderer.Draw(map[room].GetNickname(),
+                       glm::vec2(center.x, center.y - (size / 2.0f)), size,
+                       TextAlignment::kCenter, ci::Color("white"));
+  }
+
+  DrawMinimap();
+}
+
+size_t MapView::GetNumberOfVisibleRooms() const {
+  return visible_rooms_.size();
+}
+
+void MapView::LoadQuads() {
+  cell_size_ = std::min(bounds_.getWidth() / (float)kVisibleColumns,
+                        bounds_.getHeight() / (float)kVisibleRows);
+
+  // The current Room's cell sits in the middle of the map
+  glm::vec2 center = bounds_.getCenter();
+  origin_ = glm::vec2(center.x - (cell_size_ / 2.0f),
+                      center.y - (cell_size_ / 2.0f));
+
+  const GridPosition& position = layout_.GetPosition(current_room_);
+  layout_.FindRooms(GridPosition{position.x - (kVisibleColumns / 2),
+                                 position.y - (kVisibleRows / 2)},
+                    GridPosition{position.x + (kVisibleColumns / 2),
+                                 position.y + (kVisibleRows / 2)},
+                    visible_rooms_);
+
+  quads_.Clear();
+
+  float margin = kCellMargin * cell_size_;
+  for (size_t room : visible_rooms_) {
+    ci::Rectf cell = FindCell(room);
+    ci::Rectf box(cell.getUpperLeft() + glm::vec2(margin, margin),
+                  cell.getLowerRight() - glm::vec2(margin, margin));
+
+    AddDoors(room, box);
+
+    if (room == current_room_) {
+      quads_.AddRectangle(box, kCurrentColor);
+    } else if (is_visited_[room]) {
+      quads_.AddRectangle(box, kVisitedColor);
+    } else {
+      quads_.AddRectangle(box, kUnvisitedColor);
+    }
+  }
+
+  is_dirty_ = false;
+}
+
+void MapView::AddDoors(size_t room, const ci::Rectf& box) {
+  const ArenaVector<Door>& doors = dungeon_->GetMap()[room].GetDoors();
+
+  glm::vec2 center = box.getCenter();
+  float half_box = box.getWidth() / 2.0f;
+  float half_thickness = (kDoorThickness * cell_size_) / 2.0f;
+
+  for (size_t door = 0; door < doors.size(); ++door) {
+    GridPosition offset;
+    if (!DungeonLayout::FindOffset(doors[door].GetDirection(), offset)) {
+      continue;
+    }
+
+    // A bar from the box's edge to the cell's, meeting the neighbour's bar
+    glm::vec2 direction((float)offset.x, (float)offset.y);
+    glm::vec2 start = center + (direction * half_box);
+    glm::vec2 end = center + (direction * (cell_size_ / 2.0f));
+    glm::vec2 across(direction.y * half_thickness,
+                     direction.x * half_thickness);
+
+    glm::vec2 first = start - across;
+    glm::vec2 second = end + across;
+    ci::Rectf bar(std::min(first.x, second.x), std::min(first.y, second.y),
+                  std::max(first.x, second.x), std::max(first.y, second.y));
+
+    quads_.AddRectangle(bar, IsDoorLocked(room, door) ? kLockedDoorColor
+                                                      : kOpenDoorColor);
+  }
+}
+
+void MapView::DrawMinimap() {
+  if (minimap_pixels_.empty()) {
+    return;
+  }
+
+  if (minimap_texture_ == nullptr) {
+    minimap_texture_ = ci::gl::Texture2d::create(
+        minimap_pixels_.data(), GL_RGBA, minimap_width_, minimap_height_,
+        ci::gl::Texture2d::Format().magFilter(GL_NEAREST)
+            .minFilter(GL_NEAREST));
+    changed_pixels_.clear();
+  } else if (!changed_pixels_.empty()) {
+    ci::gl::ScopedTextureBind bind(minimap_texture_);
+
+    for (size_t pixel : changed_pixels_) {
+      glTexSubImage2D(GL_TEXTURE_2D, 0, (GLint)(pixel % minimap_width_),
+                      (GLint)(pixel / minimap_width_), 1, 1, GL_RGBA,
+                      GL_UNSIGNED_BYTE, &minimap_pixels_[4 * pixel]);
+    }
+    changed_pixels_.clear();
+  }
+
+  // The minimap keeps the Dungeon's shape inside a quarter of the map
+  float side = std::min(bounds_.getWidth(), bounds_.getHeight()) / 4.0f;
+  float scale = side / (float)std::max(minimap_width_, minimap_height_);
+  float margin = side / 16.0f;
+
+  glm::vec2 top_right(bounds_.getLowerRight().x - margin,
+                      bounds_.getUpperLeft().y + margin);
+  ci::Rectf minimap(top_right.x - ((float)minimap_width_ * scale),
+                    top_right.y, top_right.x,
+                    top_right.y + ((float)minimap_height_ * scale));
+
+  ci::gl::color(ci::Color("white"));
+  ci::gl::draw(minimap_texture_, minimap);
+}
+
+ci::Rectf MapView::FindCell(size_t room) const {
+  const GridPosition& position = layout_.GetPosition(room);
+  const GridPosition& current = layout_.GetPosition(current_room_);
+
+  float left = origin_.x + ((float)(position.x - current.x) * cell_size_);
+  float top = origin_.y + ((float)(position.y - current.y) * cell_size_);
+
+  return ci::Rectf(left, top, left + cell_size_, top + cell_size_);
+}
+
+size_t MapView::FindMinimapPixel(size_t room) const {
+  const GridPosition& position = layout_.GetPosition(room);
+
+  size_t x = (size_t)((position.x - layout_.GetMinimum().x) / minimap_scale_);
+  size_t y = (size_t)((position.y - layout_.GetMinimum().y) / minimap_scale_);
+
+  return x + (y * (size_t)minimap_width_);
+}
+
+void MapView::SetMinimapPixel(size_t pixel, const ci::ColorA& color) {
+  uint8_t* rgba = &minimap_pixels_[4 * pixel];
+
+  rgba[0] = (uint8_t)(color.r * 255.0f);
+  rgba[1] = (uint8_t)(color.g * 255.0f);
+  rgba[2] = (uint8_t)(color.b * 255.0f);
+  rgba[3] = (uint8_t)(color.a * 255.0f);
+
+  changed_pixels_.push_back(pixel);
+}
+
+bool MapView::IsDoorLocked(size_t room, size_t door) const {
+  if (door >= kMaxMaskedDoors) {
+    return dungeon_->GetMap()[room].GetDoors()[door].IsLocked();
+  }
+
+  return (locked_doors_[room] >> door) & 1;
+}
+
+}   // namespace adventure
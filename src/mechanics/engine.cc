@@ -2,151 +2,428 @@
 
 #include "mechanics/engine.h"
 
+#include "serialization/checksum.h"
+#include "serialization/varint.h"
+
+#include <utility>
+
 namespace adventure {
 
-Engine::Engine() {
-  std::string kFilepath = "C:\\Users\\cesco\\OneDrive\\Documents\\"
-                                 "School\\UIUC\\2020-2021\\Spring 2021\\"
-                                 "CS 126\\Cinder\\my-projects\\"
-                                 "final-project-fvial2\\resources\\"
-                                 "dungeon.txt";
-  Dungeon dungeon;
+namespace {
 
-  std::ifstream input_file(kFilepath);
-  if (input_file.is_open()) {
-    input_file >> dungeon;
+const char kSnapshotMagic[] = "ADVE";
+const size_t kSnapshotMagicSize = 4;
+const uint64_t kSnapshotVersion = 2;
 
-    input_file.close();
-  } else {
-    std::invalid_argument("FILE NOT FOUND");
+// Written from both the Player's Weapons and a Room's, which are held in
+// different kinds of vectors
+template <typename Weapons>
+void WriteWeapons(std::ostream& os, const Weapons& weapons) {
+  WriteVarint(os, weapons.size());
+
+  for (const Weapon& weapon : weapons) {
+    WriteVarintString(os, weapon.GetName());
+    WriteVarintString(os, weapon.GetNickname());
+    WriteVarint(os, weapon.GetStrength());
+    WriteVarint(os, weapon.GetCriticalChance());
+  }
+}
+
+std::vector<Weapon> ReadWeapons(std::istream& is) {
+  std::vector<Weapon> weapons;
+
+  for (uint64_t count = ReadVarint(is); count > 0; --count) {
+    std::string name = ReadVarintString(is);
+    std::string nickname = ReadVarintString(is);
+    size_t strength = (size_t)ReadVarint(is);
+    weapons.emplace_back(name, nickname, strength, (size_t)ReadVarint(is));
+  }
+
+  return weapons;
+}
+
+void WriteEnemy(std::ostream& os, const Enemy& enemy) {
+  WriteVarintString(os, enemy.GetName());
+  WriteVarintString(os, enemy.GetNickname());
+  WriteVarint(os, enemy.GetHealth());
+  WriteVarint(os, enemy.GetStrength());
+  WriteVarint(os, enemy.GetCriticalChance());
+}
+
+Enemy ReadEnemy(std::istream& is) {
+  std::string name = ReadVarintString(is);
+  std::string nickname = ReadVarintString(is);
+  size_t health = (size_t)ReadVarint(is);
+  size_t strength = (size_t)ReadVarint(is);
+
+  // Fallen Enemies are saved with no health left, which the constructor
+  // does not accept
+  Enemy enemy(name, nickname, 1, strength, (size_t)ReadVarint(is));
+  enemy.SetHealth(health);
+
+  return enemy;
+}
+
+void WriteRoom(std::ostream& os, const Room& room) {
+  WriteVarintString(os, room.GetName());
+  WriteVarintString(os, room.GetNickname());
+
+  WriteVarint(os, room.GetDoors().size());
+  for (const Door& door : room.GetDoors()) {
+    WriteVarintString(os, door.GetDirection());
+    WriteVarintString(os, door.GetAdjacentRoom());
+    WriteVarint(os, door.IsLocked());
+  }
+
+  WriteVarint(os, room.GetEnemies().size());
+  for (const Enemy& enemy : room.GetEnemies()) {
+    WriteEnemy(os, enemy);
   }
 
-  map_ = dungeon.GetMap();
+  WriteWeapons(os, room.GetWeapons());
+  WriteVarint(os, room.GetNumberOfKeys());
 }
 
+Room ReadRoom(std::istream& is) {
+  std::string name = ReadVarintString(is);
+  std::string nickname = ReadVarintString(is);
+
+  std::vector<Door> doors;
+  for (uint64_t count = ReadVarint(is); count > 0; --count) {
+    std::string direction = ReadVarintString(is);
+    std::string adjacent_room = ReadVarintString(is);
+    doors.emplace_back(direction, adjacent_room, ReadVarint(is) != 0);
+  }
+
+  std::vector<Enemy> enemies;
+  for (uint64_t count = ReadVarint(is); count > 0; --count) {
+    enemies.push_back(ReadEnemy(is));
+  }
+
+  std::vector<Weapon> weapons = ReadWeapons(is);
+  size_t number_of_keys = (size_t)ReadVarint(is);
+
+  return Room(name, nickname, doors, enemies, weapons, number_of_keys);
+}
+
+}   // namespace
+
+Engine::Engine() : player_(), map_(LoadDefaultDungeon()), qualifier_(),
+                   message_(), random_(kDefaultSeed),
+                   journal_(kJournalCapacity), last_deltas_(),
+                   statistics_(), statistics_id_(0), number_of_commands_(0),
+                   fallen_enemies_(), next_fallen_enemy_(0), revision_(0) {}
+
 Engine::Engine(const Player& player, const Dungeon& dungeon)
-    : player_(player), map_(dungeon.GetMap()), qualifier_(), message_()  {
-  if (dungeon.GetMap().empty()) {
+    : Engine(player, std::make_shared<const Dungeon>(dungeon)) {}
+
+Engine::Engine(const Player& player, Dungeon&& dungeon)
+    : Engine(player, std::make_shared<const Dungeon>(std::move(dungeon))) {}
+
+Engine::Engine(const Player& player, std::shared_ptr<const Dungeon> dungeon)
+    : player_(player), map_(std::move(dungeon)), qualifier_(), message_(),
+      random_(kDefaultSeed), journal_(kJournalCapacity), last_deltas_(),
+      statistics_(), statistics_id_(0), number_of_commands_(0),
+      fallen_enemies_(), next_fallen_enemy_(0), revision_(0) {
+  if (map_.empty()) {
     throw std::invalid_argument("DUNGEON MAP HAS NO ROOMS");
   }
 }
 
 const Player &Engine::GetPlayer() const { return player_; }
 
-const std::vector<Room> &Engine::GetMap() const { return map_; }
+const CopyOnWriteMap &Engine::GetMap() const { return map_; }
 
 const std::string &Engine::GetMessage() const { return message_; }
 
+const Journal &Engine::GetJournal() const { return journal_; }
+
+const std::vector<Delta> &Engine::GetLastDeltas() const {
+  return last_deltas_;
+}
+
+uint64_t Engine::GetRandomState() const { return random_.GetState(); }
+
+void Engine::SetRandomState(uint64_t state) { random_.SetState(state); }
+
 void Engine::SetQualifier(const std::string& qualifier) {
   qualifier_ = qualifier;
 }
 
-void Engine::SetMessage(const std::string& message) { message_ = message; }
+void Engine::SetMessage(const std::string& message) {
+  if (message_ == message) {
+    return;
+  }
+
+  message_ = message;
+  ++revision_;
+}
+
+void Engine::SetMessage(const char* message) {
+  if (message_.compare(message) == 0) {
+    return;
+  }
+
+  message_.assign(message);
+  ++revision_;
+}
+
+uint64_t Engine::GetRevision() const { return revision_; }
+
+void Engine::ReportTo(std::shared_ptr<GameStatistics> statistics,
+                      uint64_t id) {
+  statistics_ = std::move(statistics);
+  statistics_id_ = id;
+}
+
+void Engine::Execute(Command command, const std::string& qualifier) {
+  // Reserved here rather than once, since copying an Engine does not copy
+  // the spare capacity, so composing messages and listing Deltas never
+  // allocates
+  message_.reserve(kMessageCapacity);
+  last_deltas_.reserve(kDeltaCapacity);
+
+  qualifier_ = qualifier;
+  last_deltas_.clear();
+  ++number_of_commands_;
+
+  switch (command) {
+    case Command::kFight:
+      Fight();
+      break;
+
+    case Command::kTake:
+      Take();
+      break;
+
+    case Command::kDrop:
+      Drop();
+      break;
+
+    case Command::kGo:
+      Go();
+      break;
+
+    case Command::kUndo:
+      Undo();
+      break;
+
+    case Command::kRedo:
+      Redo();
+      break;
+  }
+}
+
+uint64_t Engine::ComputeChecksum() const {
+  Checksum checksum;
+
+  checksum.Add(player_);
+  checksum.Add(map_);
+  checksum.Add(message_);
+  checksum.Add(random_.GetState());
+
+  return checksum.GetValue();
+}
 
 void Engine::Go() {
-  Room& player_room = RetrieveRoom(player_.GetCurrentLocation());
+  journal_.BeginCommand();
+  ++revision_;
+
+  size_t room_index = RetrieveRoomIndex(player_.GetCurrentLocation());
+  const Room& player_room = map_[room_index];
+  size_t health = player_.GetHealth();
 
   if (player_room.GetDoors().empty()) {
     message_ = "THERE ARE NO DOORS IN THIS ROOM";
   } else {
-    Door& target_door = player_room.RetrieveDoor(qualifier_);
+    const Door& target_door = player_room.RetrieveDoor(qualifier_);
+    uint32_t door_index = (uint32_t)(&target_door - &player_room.GetDoors()[0]);
 
     if (target_door.IsLocked()) {
       if (player_.GetNumberOfKeys() > 0) {
-        Room& adjacent_room = RetrieveRoom(target_door.GetAdjacentRoom());
-
-        target_door.SwitchLock();
+        // Only unlocking changes the Room, so only then is it copied
+        ModifyRoom(room_index).RetrieveDoorAt(door_index).SwitchLock();
+        Record(Delta{DeltaType::kLockSwitched, (uint32_t)room_index,
+                     door_index, 1, 0});
 
         player_.DecrementNumberOfKeys();
+        Record(Delta{DeltaType::kPlayerKeys, 0, 0,
+                     (uint32_t)player_.GetNumberOfKeys() + 1,
+                     (uint32_t)player_.GetNumberOfKeys()});
         message_ = "YOU UNLOCKED THE DOOR";
 
         player_.RegenerateHealth();
+        RecordPlayerHealth(health);
       } else {
         message_ = "YOU DO NOT HAVE A KEY";
       }
     } else {
+      size_t adjacent_index = RetrieveRoomIndex(target_door.GetAdjacentRoom());
+
       player_.SetCurrentLocation(target_door.GetAdjacentRoom());
+      Record(Delta{DeltaType::kLocation, 0, 0, (uint32_t)room_index,
+                   (uint32_t)adjacent_index});
 
       message_ = "YOU WENT ";
       message_.append(qualifier_);
 
       player_.RegenerateHealth();
+      RecordPlayerHealth(health);
     }
   }
 }
 
 void Engine::Take() {
-  Room& player_room = RetrieveRoom(player_.GetCurrentLocation());
+  journal_.BeginCommand();
+  ++revision_;
+
+  size_t room_index = RetrieveRoomIndex(player_.GetCurrentLocation());
+  const Room& current_room = map_[room_index];
+  size_t health = player_.GetHealth();
 
-  if (player_room.GetNumberOfKeys() == 0 && player_room.GetWeapons().empty()) {
+  if (current_room.GetNumberOfKeys() == 0 &&
+      current_room.GetWeapons().empty()) {
     message_ = "THERE ARE NO ITEMS IN THIS ROOM";
-  } else if (player_.GetWeapons().size() == kMaxPlayerWeapons) {
+  } else if (player_.GetWeapons().size() >= player_.GetMaxWeapons()) {
     message_ = "YOU ARE CARRYING TOO MANY WEAPONS";
   } else {
+    Room& player_room = ModifyRoom(room_index);
+
     if (qualifier_ == "KEY") {
+      size_t room_keys = player_room.GetNumberOfKeys();
+
       player_.IncrementNumberOfKeys();
       player_room.DecrementNumberOfKeys();
 
+      Record(Delta{DeltaType::kPlayerKeys, 0, 0,
+                   (uint32_t)player_.GetNumberOfKeys() - 1,
+                   (uint32_t)player_.GetNumberOfKeys()});
+      if (room_keys != player_room.GetNumberOfKeys()) {
+        Record(Delta{DeltaType::kRoomKeys, (uint32_t)room_index, 0,
+                     (uint32_t)room_keys,
+                     (uint32_t)player_room.GetNumberOfKeys()});
+      }
+
       message_ = "YOU TOOK A KEY";
     } else {
-      Weapon& weapon = player_room.RetrieveWeapon(qualifier_);
+      SlotHandle weapon = player_room.FindWeapon(qualifier_);
+      uint32_t weapon_index = (uint32_t)player_room.GetWeaponIndex(weapon);
 
-      player_.AddWeapon(weapon);
+      player_.AddWeapon(player_room.RetrieveWeapon(weapon));
       player_room.RemoveWeapon(weapon);
+      Record(Delta{DeltaType::kWeaponTaken, (uint32_t)room_index,
+                   weapon_index, 0, 0});
 
       message_ = "YOU TOOK THE ";
       message_.append(qualifier_);
     }
 
     player_.RegenerateHealth();
+    RecordPlayerHealth(health);
   }
 }
 
 void Engine::Drop() {
-  Room& player_room = RetrieveRoom(player_.GetCurrentLocation());
+  journal_.BeginCommand();
+  ++revision_;
+
+  size_t room_index = RetrieveRoomIndex(player_.GetCurrentLocation());
+  size_t health = player_.GetHealth();
 
   if (player_.GetNumberOfKeys() == 0 && player_.GetWeapons().empty()) {
     message_ = "THERE ARE NO ITEMS ON YOUR PERSON";
   } else {
+    Room& player_room = ModifyRoom(room_index);
+
     if (qualifier_ == "KEY") {
+      size_t player_keys = player_.GetNumberOfKeys();
+
       player_.DecrementNumberOfKeys();
       player_room.IncrementNumberOfKeys();
 
+      if (player_keys != player_.GetNumberOfKeys()) {
+        Record(Delta{DeltaType::kPlayerKeys, 0, 0,
+                     (uint32_t)player_keys,
+                     (uint32_t)player_.GetNumberOfKeys()});
+      }
+      Record(Delta{DeltaType::kRoomKeys, (uint32_t)room_index, 0,
+                   (uint32_t)player_room.GetNumberOfKeys() - 1,
+                   (uint32_t)player_room.GetNumberOfKeys()});
+
       message_ = "YOU DROPPED A KEY";
     } else {
-      Weapon& weapon = player_.RetrieveWeapon(qualifier_);
+      const Weapon& weapon = player_.RetrieveWeapon(qualifier_);
+      uint32_t weapon_index = (uint32_t)(&weapon - &player_.GetWeapons()[0]);
 
       player_room.AddWeapon(weapon);
       player_.RemoveWeapon(weapon);
+      Record(Delta{DeltaType::kWeaponDropped, (uint32_t)room_index,
+                   weapon_index, 0, 0});
 
       message_ = "YOU DROPPED THE ";
       message_.append(qualifier_);
     }
 
     player_.RegenerateHealth();
+    RecordPlayerHealth(health);
   }
 }
 
 void Engine::Fight() {
-  Room& player_room = RetrieveRoom(player_.GetCurrentLocation());
+  journal_.BeginCommand();
+  ++revision_;
 
-  if (player_room.GetEnemies().empty()) {
+  size_t room_index = RetrieveRoomIndex(player_.GetCurrentLocation());
+  size_t health = player_.GetHealth();
+
+  if (map_[room_index].GetEnemies().empty()) {
     message_ = "THERE ARE NO ENEMIES IN THIS ROOM";
+  } else if (player_.GetWeapons().empty()) {
+    message_ = "YOU HAVE NO WEAPONS";
   } else {
-    Enemy& room_enemy = player_room.RetrieveEnemy(qualifier_);
+    Room& player_room = ModifyRoom(room_index);
+
+    // The handle names exactly this Enemy, even if others share its name
+    SlotHandle enemy = player_room.FindEnemy(qualifier_);
+    Enemy& room_enemy = player_room.RetrieveEnemy(enemy);
+    uint32_t enemy_index = (uint32_t)player_room.GetEnemyIndex(enemy);
+    size_t enemy_health = room_enemy.GetHealth();
 
     while (room_enemy.IsAlive() && player_.IsAlive()) {
-      room_enemy.TakeDamage(player_.DealDamage());
-      player_.TakeDamage(room_enemy.DealDamage());
+      room_enemy.TakeDamage(player_.DealDamage(random_.Roll(100)));
+      player_.TakeDamage(room_enemy.DealDamage(random_.Roll(100)));
     }
 
+    // The whole fight is recorded as one change per fighter rather than one
+    // change per round
+    Record(Delta{DeltaType::kEnemyHealth, (uint32_t)room_index,
+                 enemy_index, (uint32_t)enemy_health,
+                 (uint32_t)room_enemy.GetHealth()});
+    RecordPlayerHealth(health);
+
     if (!player_.IsAlive()) {
       message_ = "YOU LOSE";
+
+      if (statistics_ != nullptr) {
+        statistics_->RecordDeath(room_index);
+      }
     } else {
+      if (statistics_ != nullptr) {
+        statistics_->RecordKill(room_enemy.GetArchetype());
+      }
+
       if (player_.GetCurrentLocation() == map_.back().GetNickname()) {
         message_ = "YOU WIN";
+
+        if (statistics_ != nullptr) {
+          statistics_->RecordWin(statistics_id_, number_of_commands_);
+        }
       } else {
-        player_room.RemoveEnemy(room_enemy);
+        size_t slot = StoreFallenEnemy(room_enemy);
+
+        player_room.RemoveEnemy(enemy);
+        Record(Delta{DeltaType::kEnemyRemoved, (uint32_t)room_index,
+                     enemy_index, (uint32_t)slot, 0});
 
         message_ = "YOU FOUGHT THE ";
         message_.append(qualifier_);
@@ -155,18 +432,341 @@ void Engine::Fight() {
   }
 }
 
+void Engine::Undo() {
+  ++revision_;
+
+  if (!journal_.CanUndo()) {
+    message_ = "THERE IS NOTHING TO UNDO";
+    return;
+  }
+
+  journal_.Undo([this](const Delta& delta) {
+    Revert(delta);
+    last_deltas_.push_back(delta);
+  });
+
+  message_ = "YOU UNDID YOUR LAST ACTION";
+}
+
+void Engine::Redo() {
+  ++revision_;
+
+  if (!journal_.CanRedo()) {
+    message_ = "THERE IS NOTHING TO REDO";
+    return;
+  }
+
+  journal_.Redo([this](const Delta& delta) {
+    Reapply(delta);
+    last_deltas_.push_back(delta);
+  });
+
+  message_ = "YOU REDID YOUR LAST ACTION";
+}
+
 Room &Engine::RetrieveRoom(const std::string& name) {
-  if (name.empty()) {
-    throw std::invalid_argument("ROOM NAME NOT SPECIFIED");
+  // The Room may be changed through the reference at any time after this
+  ++revision_;
+  return ModifyRoom(RetrieveRoomIndex(name));
+}
+
+const Room &Engine::FindRoom(const std::string& name) const {
+  return map_[RetrieveRoomIndex(name)];
+}
+
+Room &Engine::ModifyRoom(size_t index) {
+  bool is_copied = !map_.IsModified(index);
+  Room& room = map_.Modify(index);
+
+  if (is_copied) {
+    // Enough for the Player to drop every Weapon they can carry here
+    // without the copy's list growing
+    room.ReserveWeapons(room.GetWeapons().size() + player_.GetMaxWeapons());
+  }
+
+  return room;
+}
+
+size_t Engine::RetrieveRoomIndex(const std::string& name) const {
+  return map_.GetDungeon().FindRoomIndex(name);
+}
+
+std::shared_ptr<const Dungeon> Engine::LoadDefaultDungeon() {
+  std::string kFilepath = "C:\\Users\\cesco\\OneDrive\\Documents\\"
+                                 "School\\UIUC\\2020-2021\\Spring 2021\\"
+                                 "CS 126\\Cinder\\my-projects\\"
+                                 "final-project-fvial2\\resources\\"
+                                 "dungeon.txt";
+  std::shared_ptr<Dungeon> dungeon = std::make_shared<Dungeon>();
+
+  std::ifstream input_file(kFilepath);
+  if (input_file.is_open()) {
+    input_file >> *dungeon;
+
+    input_file.close();
+  } else {
+    throw std::invalid_argument("FILE NOT FOUND");
+  }
+
+  return dungeon;
+}
+
+void Engine::Record(const Delta& delta) {
+  journal_.Record(delta);
+  last_deltas_.push_back(delta);
+}
+
+void Engine::RecordPlayerHealth(size_t before) {
+  if (before != player_.GetHealth()) {
+    Record(Delta{DeltaType::kPlayerHealth, 0, 0, (uint32_t)before,
+                 (uint32_t)player_.GetHealth()});
+  }
+}
+
+size_t Engine::StoreFallenEnemy(const Enemy& enemy) {
+  if (fallen_enemies_.capacity() < kJournalCapacity) {
+    fallen_enemies_.reserve(kJournalCapacity);
+  }
+
+  // Reuses slots like a ring buffer, so a slot is only overwritten once the
+  // Delta referring to it has been evicted from the Journal
+  size_t slot = next_fallen_enemy_;
+  next_fallen_enemy_ = (next_fallen_enemy_ + 1) % kJournalCapacity;
+
+  if (slot < fallen_enemies_.size()) {
+    fallen_enemies_[slot] = enemy;
+  } else {
+    fallen_enemies_.push_back(enemy);
+  }
+
+  return slot;
+}
+
+void Engine::Revert(const Delta& delta) {
+  switch (delta.type) {
+    case DeltaType::kLocation:
+      player_.SetCurrentLocation(map_[delta.before].GetNickname());
+      break;
+
+    case DeltaType::kPlayerHealth:
+      player_.SetHealth(delta.before);
+      break;
+
+    case DeltaType::kPlayerKeys:
+      if (delta.after > delta.before) {
+        player_.DecrementNumberOfKeys();
+      } else {
+        player_.IncrementNumberOfKeys();
+      }
+      break;
+
+    case DeltaType::kRoomKeys:
+      if (delta.after > delta.before) {
+        ModifyRoom(delta.room).DecrementNumberOfKeys();
+      } else {
+        ModifyRoom(delta.room).IncrementNumberOfKeys();
+      }
+      break;
+
+    case DeltaType::kWeaponTaken: {
+      // The taken Weapon is always the Player's last one when reverted
+      Weapon weapon = player_.GetWeapons().back();
+
+      player_.RemoveWeapon(weapon);
+      ModifyRoom(delta.room).InsertWeapon(delta.index, weapon);
+      break;
+    }
+
+    case DeltaType::kWeaponDropped: {
+      // The dropped Weapon is always the Room's last one when reverted
+      Room& room = ModifyRoom(delta.room);
+      Weapon weapon = room.GetWeapons().back();
+
+      room.RemoveWeaponAt(room.GetWeapons().size() - 1);
+      player_.InsertWeapon(delta.index, weapon);
+      break;
+    }
+
+    case DeltaType::kEnemyHealth:
+      ModifyRoom(delta.room).RetrieveEnemyAt(delta.index).SetHealth(delta.before);
+      break;
+
+    case DeltaType::kEnemyRemoved:
+      ModifyRoom(delta.room).InsertEnemy(delta.index, fallen_enemies_[delta.before]);
+      break;
+
+    case DeltaType::kLockSwitched:
+      ModifyRoom(delta.room).RetrieveDoorAt(delta.index).SwitchLock();
+      break;
+
+    case DeltaType::kCommand:
+      break;
+  }
+}
+
+void Engine::Reapply(const Delta& delta) {
+  switch (delta.type) {
+    case DeltaType::kLocation:
+      player_.SetCurrentLocation(map_[delta.after].GetNickname());
+      break;
+
+    case DeltaType::kPlayerHealth:
+      player_.SetHealth(delta.after);
+      break;
+
+    case DeltaType::kPlayerKeys:
+      if (delta.after > delta.before) {
+        player_.IncrementNumberOfKeys();
+      } else {
+        player_.DecrementNumberOfKeys();
+      }
+      break;
+
+    case DeltaType::kRoomKeys:
+      if (delta.after > delta.before) {
+        ModifyRoom(delta.room).IncrementNumberOfKeys();
+      } else {
+        ModifyRoom(delta.room).DecrementNumberOfKeys();
+      }
+      break;
+
+    case DeltaType::kWeaponTaken: {
+      Weapon weapon = ModifyRoom(delta.room).GetWeapons()[delta.index];
+
+      player_.AddWeapon(weapon);
+      ModifyRoom(delta.room).RemoveWeaponAt(delta.index);
+      break;
+    }
+
+    case DeltaType::kWeaponDropped: {
+      Weapon weapon = player_.GetWeapons()[delta.index];
+
+      ModifyRoom(delta.room).AddWeapon(weapon);
+      player_.RemoveWeapon(weapon);
+      break;
+    }
+
+    case DeltaType::kEnemyHealth:
+      ModifyRoom(delta.room).RetrieveEnemyAt(delta.index).SetHealth(delta.after);
+      break;
+
+    case DeltaType::kEnemyRemoved:
+      fallen_enemies_[delta.before] = ModifyRoom(delta.room).GetEnemies()[delta.index];
+      ModifyRoom(delta.room).RemoveEnemyAt(delta.index);
+      break;
+
+    case DeltaType::kLockSwitched:
+      ModifyRoom(delta.room).RetrieveDoorAt(delta.index).SwitchLock();
+      break;
+
+    case DeltaType::kCommand:
+      break;
+  }
+}
+
+std::ostream &operator<<(std::ostream& os, const Engine& engine) {
+  Checksum dungeon_checksum;
+  dungeon_checksum.Add(engine.map_.GetDungeon().GetMap());
+
+  os.write(kSnapshotMagic, kSnapshotMagicSize);
+  WriteVarint(os, kSnapshotVersion);
+  WriteVarint(os, dungeon_checksum.GetValue());
+
+  const Player& player = engine.player_;
+  WriteVarintString(os, player.GetCurrentLocation());
+  WriteVarint(os, player.GetMaxHealth());
+  WriteVarint(os, player.GetHealth());
+  WriteVarint(os, player.GetNumberOfKeys());
+  WriteVarint(os, player.GetMaxWeapons());
+  WriteWeapons(os, player.GetWeapons());
+
+  // Unmodified Rooms are already in the Dungeon, which keeps snapshots small
+  std::vector<size_t> indices = engine.map_.GetModifiedRoomIndices();
+  WriteVarint(os, indices.size());
+  for (size_t index : indices) {
+    WriteVarint(os, index);
+    WriteRoom(os, engine.map_[index]);
+  }
+
+  WriteVarintString(os, engine.message_);
+  WriteVarint(os, engine.random_.GetState());
+
+  // The Journal is saved so that undo and redo behave the same after a
+  // restore, along with the fallen Enemies its Deltas refer to
+  os << engine.journal_;
+  WriteVarint(os, engine.fallen_enemies_.size());
+  for (const Enemy& enemy : engine.fallen_enemies_) {
+    WriteEnemy(os, enemy);
+  }
+  WriteVarint(os, engine.next_fallen_enemy_);
+
+  return os;
+}
+
+std::istream &operator>>(std::istream& is, Engine& engine) {
+  char magic[kSnapshotMagicSize];
+
+  if (!is.read(magic, kSnapshotMagicSize) ||
+      std::string(magic, kSnapshotMagicSize) != kSnapshotMagic ||
+      ReadVarint(is) != kSnapshotVersion) {
+    throw std::invalid_argument("INVALID SNAPSHOT");
   }
 
-  for (Room& room : map_) {
-    if (room.GetNickname() == name) {
-      return room;
+  Checksum dungeon_checksum;
+  dungeon_checksum.Add(engine.map_.GetDungeon().GetMap());
+
+  if (ReadVarint(is) != dungeon_checksum.GetValue()) {
+    throw std::invalid_argument("DUNGEON DOES NOT MATCH SNAPSHOT");
+  }
+
+  // Everything is read before anything is changed, so a bad snapshot leaves
+  // the Engine as it was
+  std::string location = ReadVarintString(is);
+  size_t max_health = (size_t)ReadVarint(is);
+  size_t health = (size_t)ReadVarint(is);
+  size_t number_of_keys = (size_t)ReadVarint(is);
+  size_t max_weapons = (size_t)ReadVarint(is);
+  Player player(location, max_health, number_of_keys, ReadWeapons(is));
+  player.SetHealth(health);
+  player.SetMaxWeapons(max_weapons);
+
+  std::vector<std::pair<size_t, Room>> rooms;
+  for (uint64_t count = ReadVarint(is); count > 0; --count) {
+    size_t index = (size_t)ReadVarint(is);
+
+    if (index >= engine.map_.size()) {
+      throw std::invalid_argument("ROOM INDEX OUT OF RANGE");
     }
+    rooms.emplace_back(index, ReadRoom(is));
   }
 
-  throw std::invalid_argument("ROOM NOT FOUND");
+  std::string message = ReadVarintString(is);
+  uint64_t random_state = ReadVarint(is);
+
+  Journal journal(engine.journal_.GetCapacity());
+  is >> journal;
+
+  std::vector<Enemy> fallen_enemies;
+  for (uint64_t count = ReadVarint(is); count > 0; --count) {
+    fallen_enemies.push_back(ReadEnemy(is));
+  }
+  size_t next_fallen_enemy = (size_t)ReadVarint(is);
+
+  engine.player_ = player;
+  engine.map_.Reset();
+  for (const std::pair<size_t, Room>& room : rooms) {
+    engine.map_.Modify(room.first) = room.second;
+  }
+  engine.message_ = message;
+  engine.random_.SetState(random_state);
+
+  engine.journal_ = journal;
+  engine.last_deltas_.clear();
+  engine.fallen_enemies_ = fallen_enemies;
+  engine.next_fallen_enemy_ = next_fallen_enemy;
+  ++engine.revision_;
+
+  return is;
 }
 
-}   // namespace adventure
\ No newline at end of file
+}   // namespace adventure
@@ -0,0 +1,372 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "mechanics/game_controller.h"
+
+#include "serialization/checksum.h"
+
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+namespace adventure {
+
+namespace {
+
+/**
+ * Copies the page of a list starting at the given index, reusing the
+ * page's storage.
+ */
+template <typename List, typename T>
+void CopyPage(const List& list, size_t first, std::vector<T>& page) {
+  if (first >= list.size()) {
+    return;
+  }
+
+  size_t last = std::min(list.size(),
+                         first + GameSnapshot::kSubPanelPageSize);
+  page.assign(list.begin() + first, list.begin() + last);
+}
+
+}   // namespace
+
+GameController::GameController() : GameController(Engine()) {}
+
+GameController::GameController(const Engine& engine)
+    : engine_(engine), main_selection_(0), sub_selection_(0),
+      last_button_index_(3), has_toggled_panels_(false),
+      is_quit_requested_(false), sub_panel_(SubPanel::kNone),
+      is_recording_(false), replay_path_(), replay_log_(),
+      last_command_time_(std::chrono::steady_clock::now()), spectators_() {
+  engine_.SetMessage("WHAT WILL YOU DO?");
+}
+
+const Engine &GameController::GetEngine() const { return engine_; }
+
+void GameController::Seed(uint64_t seed) { engine_.SetRandomState(seed); }
+
+void GameController::StartRecording(const std::string& replay_path) {
+  Checksum checksum;
+  checksum.Add(engine_.GetMap());
+
+  is_recording_ = true;
+  replay_path_ = replay_path;
+  replay_log_ = ReplayLog(engine_.GetRandomState(), checksum.GetValue());
+  last_command_time_ = std::chrono::steady_clock::now();
+}
+
+void GameController::SaveRecording() {
+  if (is_recording_) {
+    // Checksumming the whole game is only worth it once, when saving
+    replay_log_.SetFinalChecksum(engine_.ComputeChecksum());
+
+    std::ofstream log_file(replay_path_, std::ios::binary);
+    log_file << replay_log_;
+  }
+}
+
+void GameController::BroadcastTo(
+    std::shared_ptr<SpectatorChannel> spectators) {
+  spectators_ = std::move(spectators);
+
+  if (spectators_ != nullptr) {
+    spectators_->PublishKeyframe(engine_);
+  }
+}
+
+void GameController::HandleKey(Key key) {
+  // Once the game is over, every key behaves like escape
+  if (key == Key::kEscape || IsGameOver()) {
+    if (has_toggled_panels_) {
+      CloseSubPanels();
+    } else {
+      is_quit_requested_ = true;
+    }
+    return;
+  }
+
+  switch (key) {
+    case Key::kRight:
+      MoveSelectionRight();
+      break;
+
+    case Key::kLeft:
+      MoveSelectionLeft();
+      break;
+
+    case Key::kUp:
+      MoveSelectionUp();
+      break;
+
+    case Key::kDown:
+      MoveSelectionDown();
+      break;
+
+    case Key::kReturn:
+      if (has_toggled_panels_) {
+        ExecuteCommand();
+        CloseSubPanels();
+      } else {
+        has_toggled_panels_ = true;
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  if (has_toggled_panels_) {
+    LoadOptions();
+  }
+}
+
+bool GameController::IsQuitRequested() const { return is_quit_requested_; }
+
+void GameController::FillSnapshot(GameSnapshot& snapshot) const {
+  snapshot.engine_revision = engine_.GetRevision();
+  snapshot.player = engine_.GetPlayer();
+  snapshot.message = engine_.GetMessage();
+  snapshot.is_game_over = IsGameOver();
+  snapshot.is_quit_requested = is_quit_requested_;
+
+  const Player& player = engine_.GetPlayer();
+  const Room& current_room = engine_.FindRoom(player.GetCurrentLocation());
+
+  snapshot.locked_doors = 0;
+  const ArenaVector<Door>& doors = current_room.GetDoors();
+  for (size_t door = 0; door < doors.size() && door < 64; ++door) {
+    if (doors[door].IsLocked()) {
+      snapshot.locked_doors |= (uint64_t)1 << door;
+    }
+  }
+
+  snapshot.main_selection = main_selection_;
+  snapshot.sub_selection = sub_selection_;
+  snapshot.has_toggled_panels = has_toggled_panels_;
+  snapshot.sub_panel = sub_panel_;
+
+  // Clearing keeps the storage of the snapshot's lists for the next fill
+  snapshot.enemies.clear();
+  snapshot.weapons.clear();
+  snapshot.doors.clear();
+  snapshot.number_of_keys = 0;
+  snapshot.first_sub_action = 0;
+  snapshot.number_of_sub_actions = 0;
+
+  if (sub_panel_ == SubPanel::kNone) {
+    return;
+  }
+
+  // Only the page holding the sub-selection is copied, however long the
+  // list is
+  size_t first = (sub_selection_ / GameSnapshot::kSubPanelPageSize) *
+                 GameSnapshot::kSubPanelPageSize;
+  snapshot.first_sub_action = first;
+  snapshot.number_of_sub_actions = last_button_index_ + 1;
+
+  if (sub_panel_ == SubPanel::kEnemies) {
+    CopyPage(current_room.GetEnemies(), first, snapshot.enemies);
+  } else if (sub_panel_ == SubPanel::kDoors) {
+    CopyPage(current_room.GetDoors(), first, snapshot.doors);
+  } else if (main_selection_ == kSecondButton) {
+    CopyPage(current_room.GetWeapons(), first, snapshot.weapons);
+    snapshot.number_of_keys = current_room.GetNumberOfKeys();
+  } else {
+    CopyPage(player.GetWeapons(), first, snapshot.weapons);
+    snapshot.number_of_keys = player.GetNumberOfKeys();
+  }
+}
+
+bool GameController::IsGameOver() const {
+  return engine_.GetMessage() == "YOU WIN" ||
+         engine_.GetMessage() == "YOU LOSE";
+}
+
+void GameController::CloseSubPanels() {
+  sub_selection_ = kFirstButton;
+  has_toggled_panels_ = false;
+  sub_panel_ = SubPanel::kNone;
+
+  last_button_index_ = 3;
+}
+
+void GameController::ExecuteCommand() {
+  // The action buttons are laid out in the same order as the Command values
+  RunCommand((Command)main_selection_, FindSubAction(sub_selection_));
+}
+
+void GameController::RunCommand(Command command,
+                                const std::string& qualifier) {
+  engine_.Execute(command, qualifier);
+
+  if (is_recording_) {
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    uint32_t elapsed_ms = (uint32_t)std::chrono::duration_cast<
+        std::chrono::milliseconds>(now - last_command_time_).count();
+    last_command_time_ = now;
+
+    replay_log_.Record(command, qualifier, elapsed_ms);
+  }
+
+  if (spectators_ != nullptr) {
+    spectators_->Publish(engine_);
+  }
+}
+
+std::string GameController::FindSubAction(size_t index) const {
+  const Player& player = engine_.GetPlayer();
+  const Room& current_room = engine_.FindRoom(player.GetCurrentLocation());
+
+  if (main_selection_ == kFirstButton) {
+    return current_room.GetEnemies().at(index).GetNickname();
+  } else if (main_selection_ == kSecondButton) {
+    if (index < current_room.GetWeapons().size()) {
+      return current_room.GetWeapons()[index].GetNickname();
+    }
+    return "KEY";
+  } else if (main_selection_ == kThirdButton) {
+    if (index < player.GetWeapons().size()) {
+      return player.GetWeapons()[index].GetNickname();
+    }
+    return "KEY";
+  } else {
+    return current_room.GetDoors().at(index).GetDirection();
+  }
+}
+
+void GameController::MoveSelectionLeft() {
+  if (has_toggled_panels_) {
+    if (sub_selection_ == kFirstButton) {
+      sub_selection_ = last_button_index_;
+    } else {
+      --sub_selection_;
+    }
+  } else {
+    if (main_selection_ == kFirstButton) {
+      main_selection_ = last_button_index_;
+    } else {
+      --main_selection_;
+    }
+  }
+}
+
+void GameController::MoveSelectionRight() {
+  if (has_toggled_panels_) {
+    if (sub_selection_ == last_button_index_) {
+      sub_selection_ = kFirstButton;
+    } else {
+      ++sub_selection_;
+    }
+  } else {
+    if (main_selection_ == last_button_index_) {
+      main_selection_ = kFirstButton;
+    } else {
+      ++main_selection_;
+    }
+  }
+}
+
+void GameController::MoveSelectionUp() {
+  if (!has_toggled_panels_) {
+    return;
+  }
+
+  if (sub_selection_ < GameSnapshot::kSubPanelPageSize) {
+    sub_selection_ = kFirstButton;
+  } else {
+    sub_selection_ -= GameSnapshot::kSubPanelPageSize;
+  }
+}
+
+void GameController::MoveSelectionDown() {
+  if (!has_toggled_panels_) {
+    return;
+  }
+
+  sub_selection_ = std::min(sub_selection_ + GameSnapshot::kSubPanelPageSize,
+                            last_button_index_);
+}
+
+void GameController::LoadOptions() {
+  if (main_selection_ == kFirstButton) {
+    LoadFightOptions();
+  } else if (main_selection_ == kSecondButton) {
+    LoadTakeOptions();
+  } else if (main_selection_ == kThirdButton) {
+    LoadDropOptions();
+  } else if (main_selection_ == kFourthButton) {
+    LoadGoOptions();
+  }
+}
+
+void GameController::LoadFightOptions() {
+  const Room& current_room = engine_.FindRoom(engine_.GetPlayer()
+                                                  .GetCurrentLocation());
+
+  if (current_room.GetEnemies().empty()) {
+    CloseSubPanels();
+
+    // Attempts to execute a command because the failure will produce the
+    // desired visual output message
+    RunCommand(Command::kFight, "");
+  } else {
+    engine_.SetMessage("WHAT WILL YOU DO?");
+    last_button_index_ = current_room.GetEnemies().size() - 1;
+    sub_panel_ = SubPanel::kEnemies;
+  }
+}
+
+void GameController::LoadTakeOptions() {
+  const Room& current_room = engine_.FindRoom(engine_.GetPlayer()
+                                                  .GetCurrentLocation());
+
+  if (current_room.GetWeapons().empty() &&
+      current_room.GetNumberOfKeys() == 0) {
+    CloseSubPanels();
+
+    // Attempts to execute a command because the failure will produce the
+    // desired visual output message
+    RunCommand(Command::kTake, "");
+  } else {
+    engine_.SetMessage("WHAT WILL YOU DO?");
+    last_button_index_ = (current_room.GetWeapons().size() +
+                          current_room.GetNumberOfKeys()) - 1;
+    sub_panel_ = SubPanel::kWeapons;
+  }
+}
+
+void GameController::LoadDropOptions() {
+  const Player& player = engine_.GetPlayer();
+
+  if (player.GetWeapons().empty() && player.GetNumberOfKeys() == 0) {
+    CloseSubPanels();
+
+    // Attempts to execute a command because the failure will produce the
+    // desired visual output message
+    RunCommand(Command::kDrop, "");
+  } else {
+    engine_.SetMessage("WHAT WILL YOU DO?");
+    last_button_index_ = (player.GetWeapons().size() +
+                          player.GetNumberOfKeys()) - 1;
+    sub_panel_ = SubPanel::kWeapons;
+  }
+}
+
+void GameController::LoadGoOptions() {
+  const Room& current_room = engine_.FindRoom(engine_.GetPlayer()
+                                                  .GetCurrentLocation());
+
+  if (current_room.GetDoors().empty()) {
+    CloseSubPanels();
+
+    // Attempts to execute a command because the failure will produce the
+    // desired visual output message
+    RunCommand(Command::kGo, "");
+  } else {
+    engine_.SetMessage("WHAT WILL YOU DO?");
+    last_button_index_ = current_room.GetDoors().size() - 1;
+    sub_panel_ = SubPanel::kDoors;
+  }
+}
+
+}   // namespace adventure
@@ -0,0 +1,16 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "mechanics/game_snapshot.h"
+
+namespace adventure {
+
+const size_t GameSnapshot::kSubPanelPageSize;
+
+GameSnapshot::GameSnapshot()
+    : version(0), engine_revision(0), player(), message(), is_game_over(false),
+      is_quit_requested(false), locked_doors(0), main_selection(0),
+      sub_selection(0), has_toggled_panels(false), sub_panel(SubPanel::kNone),
+      enemies(), weapons(), doors(), number_of_keys(0), first_sub_action(0),
+      number_of_sub_actions(0) {}
+
+}   // namespace adventure
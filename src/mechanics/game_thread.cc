@@ -0,0 +1,95 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "mechanics/game_thread.h"
+
+#include <utility>
+
+namespace adventure {
+
+GameThread::GameThread(std::unique_ptr<GameController> controller)
+    : controller_(std::move(controller)), keys_(kKeyCapacity), snapshots_(),
+      version_(0), is_stopping_(false) {
+  if (!controller_) {
+    throw std::invalid_argument("CONTROLLER NOT SPECIFIED");
+  }
+
+  // The render thread has something to draw from its very first frame
+  Publish();
+  snapshots_.Update();
+
+  thread_ = std::thread(&GameThread::Run, this);
+}
+
+GameThread::~GameThread() { Stop(); }
+
+bool GameThread::PushKey(Key key) {
+  if (!keys_.TryPush(key)) {
+    return false;
+  }
+
+  // Taking the mutex orders the push before the game thread's check, so the
+  // wake up cannot land between that check and it going to sleep
+  {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+  }
+  key_pushed_.notify_one();
+  return true;
+}
+
+bool GameThread::UpdateSnapshot() { return snapshots_.Update(); }
+
+const GameSnapshot &GameThread::GetSnapshot() const {
+  return snapshots_.GetFront();
+}
+
+void GameThread::Stop() {
+  if (!thread_.joinable()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    is_stopping_ = true;
+  }
+  key_pushed_.notify_one();
+
+  thread_.join();
+}
+
+GameController &GameThread::GetController() { return *controller_; }
+
+void GameThread::Publish() {
+  GameSnapshot& snapshot = snapshots_.GetBack();
+
+  controller_->FillSnapshot(snapshot);
+  snapshot.version = ++version_;
+  snapshots_.Publish();
+}
+
+void GameThread::Run() {
+  while (true) {
+    bool has_handled = false;
+
+    Key key;
+    while (keys_.TryPop(key)) {
+      controller_->HandleKey(key);
+      has_handled = true;
+    }
+
+    if (has_handled) {
+      Publish();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    if (is_stopping_) {
+      return;
+    }
+
+    key_pushed_.wait(lock, [this] {
+      return is_stopping_ || !keys_.empty();
+    });
+  }
+}
+
+}   // namespace adventure
@@ -0,0 +1,156 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "mechanics/journal.h"
+
+#include "serialization/varint.h"
+
+#include <stdexcept>
+
+namespace adventure {
+
+Journal::Journal(size_t capacity)
+    : capacity_(capacity), records_(), begin_(0), cursor_(0), end_(0),
+      command_start_(0), is_command_pending_(false), is_recording_(true) {}
+
+size_t Journal::GetCapacity() const { return capacity_; }
+
+size_t Journal::GetSize() const { return end_; }
+
+bool Journal::CanUndo() const { return cursor_ > 0; }
+
+bool Journal::CanRedo() const { return cursor_ < end_; }
+
+void Journal::BeginCommand() {
+  is_command_pending_ = true;
+  is_recording_ = true;
+}
+
+void Journal::Record(const Delta& delta) {
+  if (capacity_ == 0) {
+    return;
+  }
+
+  if (is_command_pending_) {
+    is_command_pending_ = false;
+
+    // A new command makes the undone commands unreachable
+    end_ = cursor_;
+    command_start_ = end_;
+
+    Push(Delta{DeltaType::kCommand, 0, 0, 0, 0});
+  }
+
+  if (is_recording_) {
+    Push(delta);
+  }
+}
+
+void Journal::Clear() {
+  begin_ = 0;
+  cursor_ = 0;
+  end_ = 0;
+  command_start_ = 0;
+  is_command_pending_ = false;
+}
+
+Delta &Journal::At(size_t position) {
+  return records_[(begin_ + position) % capacity_];
+}
+
+void Journal::Push(const Delta& delta) {
+  if (records_.empty()) {
+    records_.resize(capacity_);
+  }
+
+  if (end_ == capacity_) {
+    Evict();
+
+    if (!is_recording_) {
+      return;
+    }
+  }
+
+  At(end_) = delta;
+  ++end_;
+  cursor_ = end_;
+}
+
+void Journal::Evict() {
+  // Every older command is already gone, so only the command being recorded
+  // is dropped. The history before it could not be undone anyway, since its
+  // changes are not recorded
+  if (command_start_ == 0) {
+    end_ = 0;
+    cursor_ = 0;
+    is_recording_ = false;
+    return;
+  }
+
+  size_t drop = 1;
+  while (drop < command_start_ && At(drop).type != DeltaType::kCommand) {
+    ++drop;
+  }
+
+  begin_ = (begin_ + drop) % capacity_;
+  end_ -= drop;
+  cursor_ -= drop;
+  command_start_ -= drop;
+}
+
+std::ostream &operator<<(std::ostream& os, const Journal& journal) {
+  WriteVarint(os, journal.end_);
+  WriteVarint(os, journal.cursor_);
+  WriteVarint(os, journal.command_start_);
+
+  for (size_t position = 0; position < journal.end_; ++position) {
+    const Delta& delta =
+        journal.records_[(journal.begin_ + position) % journal.capacity_];
+
+    WriteVarint(os, (uint64_t)delta.type);
+    WriteVarint(os, delta.room);
+    WriteVarint(os, delta.index);
+    WriteVarint(os, delta.before);
+    WriteVarint(os, delta.after);
+  }
+
+  return os;
+}
+
+std::istream &operator>>(std::istream& is, Journal& journal) {
+  size_t end = (size_t)ReadVarint(is);
+  size_t cursor = (size_t)ReadVarint(is);
+  size_t command_start = (size_t)ReadVarint(is);
+
+  if (end > journal.capacity_ || cursor > end || command_start > end) {
+    throw std::invalid_argument("INVALID JOURNAL");
+  }
+
+  std::vector<Delta> records(end == 0 ? 0 : journal.capacity_);
+  for (size_t position = 0; position < end; ++position) {
+    uint64_t type = ReadVarint(is);
+
+    if (type > (uint64_t)DeltaType::kLockSwitched) {
+      throw std::invalid_argument("INVALID JOURNAL");
+    }
+
+    Delta& delta = records[position];
+    delta.type = (DeltaType)type;
+    delta.room = (uint32_t)ReadVarint(is);
+    delta.index = (uint32_t)ReadVarint(is);
+    delta.before = (uint32_t)ReadVarint(is);
+    delta.after = (uint32_t)ReadVarint(is);
+  }
+
+  // The restored Deltas start at the front of the ring buffer
+  journal.records_.swap(records);
+  journal.begin_ = 0;
+  journal.cursor_ = cursor;
+  journal.end_ = end;
+  journal.command_start_ = command_start;
+  journal.is_command_pending_ = false;
+  journal.is_recording_ = true;
+
+  return is;
+}
+
+}   // namespace adventure
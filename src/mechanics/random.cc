@@ -0,0 +1,31 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "mechanics/random.h"
+
+namespace adventure {
+
+Random::Random(uint64_t seed) : state_(seed) {
+  if (state_ == 0) {
+    state_ = kZeroReplacement;
+  }
+}
+
+uint64_t Random::GetState() const { return state_; }
+
+void Random::SetState(uint64_t state) {
+  state_ = state;
+
+  if (state_ == 0) {
+    state_ = kZeroReplacement;
+  }
+}
+
+size_t Random::Roll(size_t bound) {
+  state_ ^= state_ >> 12;
+  state_ ^= state_ << 25;
+  state_ ^= state_ >> 27;
+
+  return (size_t)((state_ * 0x2545F4914F6CDD1DULL) >> 32) % bound;
+}
+
+}   // namespace adventure
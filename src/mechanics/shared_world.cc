@@ -0,0 +1,285 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "mechanics/shared_world.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace adventure {
+
+SharedWorld::SharedWorld(std::shared_ptr<const Dungeon> dungeon,
+                         size_t max_players)
+    : dungeon_(std::move(dungeon)), rooms_(), players_(max_players),
+      number_of_players_(0), number_of_contended_locks_(0) {
+  if (dungeon_ == nullptr || dungeon_->GetMap().empty()) {
+    throw std::invalid_argument("DUNGEON MAP HAS NO ROOMS");
+  } else if (max_players == 0) {
+    throw std::invalid_argument("MAX PLAYERS EQUALS ZERO");
+  }
+
+  for (const Room& room : dungeon_->GetMap()) {
+    rooms_.emplace_back(new RoomSlot{{}, room, {0}});
+  }
+}
+
+size_t SharedWorld::AddPlayer(const Player& player) {
+  dungeon_->FindRoomIndex(player.GetCurrentLocation());
+
+  std::lock_guard<std::mutex> lock(adding_mutex_);
+
+  size_t id = number_of_players_;
+  if (id == players_.size()) {
+    throw std::invalid_argument("TOO MANY PLAYERS");
+  }
+
+  players_[id].reset(new PlayerSlot{player, std::string(),
+                                    Random(kDefaultSeed + id)});
+  number_of_players_ = id + 1;
+
+  return id;
+}
+
+size_t SharedWorld::GetNumberOfPlayers() const { return number_of_players_; }
+
+size_t SharedWorld::GetNumberOfRooms() const { return rooms_.size(); }
+
+const Player &SharedWorld::GetPlayer(size_t player) const {
+  return RetrievePlayer(player).player;
+}
+
+const std::string &SharedWorld::GetMessage(size_t player) const {
+  return RetrievePlayer(player).message;
+}
+
+void SharedWorld::Execute(size_t player, Command command,
+                          const std::string& qualifier) {
+  PlayerSlot& slot = RetrievePlayer(player);
+
+  switch (command) {
+    case Command::kFight:
+      Fight(slot, qualifier);
+      break;
+
+    case Command::kTake:
+      Take(slot, qualifier);
+      break;
+
+    case Command::kDrop:
+      Drop(slot, qualifier);
+      break;
+
+    case Command::kGo:
+      Go(slot, qualifier);
+      break;
+
+    case Command::kUndo:
+    case Command::kRedo:
+      throw std::invalid_argument("COMMAND NOT AVAILABLE IN A SHARED WORLD");
+  }
+}
+
+Room SharedWorld::CopyRoom(size_t index) const {
+  if (index >= rooms_.size()) {
+    throw std::invalid_argument("ROOM INDEX OUT OF RANGE");
+  }
+
+  std::unique_lock<std::mutex> lock = LockRoom(index);
+  return rooms_[index]->room;
+}
+
+uint64_t SharedWorld::GetRoomVersion(size_t index) const {
+  if (index >= rooms_.size()) {
+    throw std::invalid_argument("ROOM INDEX OUT OF RANGE");
+  }
+
+  return rooms_[index]->version;
+}
+
+uint64_t SharedWorld::GetNumberOfContendedLocks() const {
+  return number_of_contended_locks_;
+}
+
+SharedWorld::PlayerSlot &SharedWorld::RetrievePlayer(size_t player) const {
+  if (player >= number_of_players_) {
+    throw std::invalid_argument("PLAYER NOT FOUND");
+  }
+
+  return *players_[player];
+}
+
+std::unique_lock<std::mutex> SharedWorld::LockRoom(size_t index) const {
+  std::unique_lock<std::mutex> lock(rooms_[index]->mutex, std::try_to_lock);
+
+  if (!lock.owns_lock()) {
+    number_of_contended_locks_.fetch_add(1, std::memory_order_relaxed);
+    lock.lock();
+  }
+
+  return lock;
+}
+
+void SharedWorld::Go(PlayerSlot& slot, const std::string& qualifier) {
+  Player& player = slot.player;
+  size_t room_index = dungeon_->FindRoomIndex(player.GetCurrentLocation());
+
+  // Doors are never added, removed, or redirected, only locked and
+  // unlocked, so the Dungeon tells which Room a door leads to without
+  // locking anything
+  const Room& template_room = dungeon_->GetMap()[room_index];
+  if (template_room.GetDoors().empty()) {
+    slot.message = "THERE ARE NO DOORS IN THIS ROOM";
+    return;
+  }
+
+  const Door& template_door = template_room.RetrieveDoor(qualifier);
+  size_t door_index = (size_t)(&template_door - &template_room.GetDoors()[0]);
+  size_t adjacent_index =
+      dungeon_->FindRoomIndex(template_door.GetAdjacentRoom());
+
+  // Both Rooms are locked in index order, so two Players walking through
+  // the same door in opposite directions cannot deadlock
+  std::unique_lock<std::mutex> first_lock =
+      LockRoom(std::min(room_index, adjacent_index));
+  std::unique_lock<std::mutex> second_lock;
+  if (adjacent_index != room_index) {
+    second_lock = LockRoom(std::max(room_index, adjacent_index));
+  }
+
+  RoomSlot& player_room = *rooms_[room_index];
+  Door& door = player_room.room.RetrieveDoorAt(door_index);
+
+  if (door.IsLocked()) {
+    if (player.GetNumberOfKeys() > 0) {
+      door.SwitchLock();
+      ++player_room.version;
+
+      player.DecrementNumberOfKeys();
+      slot.message = "YOU UNLOCKED THE DOOR";
+
+      player.RegenerateHealth();
+    } else {
+      slot.message = "YOU DO NOT HAVE A KEY";
+    }
+  } else {
+    player.SetCurrentLocation(door.GetAdjacentRoom());
+
+    slot.message = "YOU WENT ";
+    slot.message.append(qualifier);
+
+    player.RegenerateHealth();
+  }
+}
+
+void SharedWorld::Take(PlayerSlot& slot, const std::string& qualifier) {
+  Player& player = slot.player;
+  size_t room_index = dungeon_->FindRoomIndex(player.GetCurrentLocation());
+
+  std::unique_lock<std::mutex> lock = LockRoom(room_index);
+  RoomSlot& player_room = *rooms_[room_index];
+  Room& room = player_room.room;
+
+  if (room.GetNumberOfKeys() == 0 && room.GetWeapons().empty()) {
+    slot.message = "THERE ARE NO ITEMS IN THIS ROOM";
+  } else if (player.GetWeapons().size() >= player.GetMaxWeapons()) {
+    slot.message = "YOU ARE CARRYING TOO MANY WEAPONS";
+  } else if (qualifier == "KEY") {
+    // Unlike in a single-player Engine, a key can only be taken if the Room
+    // has one, since every key taken is one another Player cannot take
+    if (room.GetNumberOfKeys() == 0) {
+      slot.message = "THERE ARE NO KEYS IN THIS ROOM";
+    } else {
+      room.DecrementNumberOfKeys();
+      ++player_room.version;
+      player.IncrementNumberOfKeys();
+
+      slot.message = "YOU TOOK A KEY";
+      player.RegenerateHealth();
+    }
+  } else {
+    SlotHandle weapon = room.FindWeapon(qualifier);
+
+    player.AddWeapon(room.RetrieveWeapon(weapon));
+    room.RemoveWeapon(weapon);
+    ++player_room.version;
+
+    slot.message = "YOU TOOK THE ";
+    slot.message.append(qualifier);
+    player.RegenerateHealth();
+  }
+}
+
+void SharedWorld::Drop(PlayerSlot& slot, const std::string& qualifier) {
+  Player& player = slot.player;
+  size_t room_index = dungeon_->FindRoomIndex(player.GetCurrentLocation());
+
+  if (player.GetNumberOfKeys() == 0 && player.GetWeapons().empty()) {
+    slot.message = "THERE ARE NO ITEMS ON YOUR PERSON";
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock = LockRoom(room_index);
+  RoomSlot& player_room = *rooms_[room_index];
+
+  if (qualifier == "KEY") {
+    if (player.GetNumberOfKeys() == 0) {
+      slot.message = "YOU DO NOT HAVE A KEY";
+    } else {
+      player.DecrementNumberOfKeys();
+      player_room.room.IncrementNumberOfKeys();
+      ++player_room.version;
+
+      slot.message = "YOU DROPPED A KEY";
+      player.RegenerateHealth();
+    }
+  } else {
+    const Weapon& weapon = player.RetrieveWeapon(qualifier);
+
+    player_room.room.AddWeapon(weapon);
+    player.RemoveWeapon(weapon);
+    ++player_room.version;
+
+    slot.message = "YOU DROPPED THE ";
+    slot.message.append(qualifier);
+    player.RegenerateHealth();
+  }
+}
+
+void SharedWorld::Fight(PlayerSlot& slot, const std::string& qualifier) {
+  Player& player = slot.player;
+  size_t room_index = dungeon_->FindRoomIndex(player.GetCurrentLocation());
+
+  std::unique_lock<std::mutex> lock = LockRoom(room_index);
+  RoomSlot& player_room = *rooms_[room_index];
+  Room& room = player_room.room;
+
+  if (room.GetEnemies().empty()) {
+    slot.message = "THERE ARE NO ENEMIES IN THIS ROOM";
+    return;
+  } else if (player.GetWeapons().empty()) {
+    slot.message = "YOU HAVE NO WEAPONS";
+    return;
+  }
+
+  SlotHandle enemy = room.FindEnemy(qualifier);
+  Enemy& room_enemy = room.RetrieveEnemy(enemy);
+
+  while (room_enemy.IsAlive() && player.IsAlive()) {
+    room_enemy.TakeDamage(player.DealDamage(slot.random.Roll(100)));
+    player.TakeDamage(room_enemy.DealDamage(slot.random.Roll(100)));
+  }
+  ++player_room.version;
+
+  if (!player.IsAlive()) {
+    slot.message = "YOU LOSE";
+  } else if (room_index + 1 == rooms_.size()) {
+    slot.message = "YOU WIN";
+  } else {
+    room.RemoveEnemy(enemy);
+
+    slot.message = "YOU FOUGHT THE ";
+    slot.message.append(qualifier);
+  }
+}
+
+}   // namespace adventure
@@ -0,0 +1,523 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "mechanics/spectator_channel.h"
+
+#include "serialization/varint.h"
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace adventure {
+
+namespace {
+
+/**
+ * The kinds of frames on a spectator channel.
+ */
+enum class FrameType : uint8_t {
+  kKeyframe,
+  kDelta
+};
+
+/**
+ * The changes a delta frame can carry. Each carries the new value rather
+ * than the difference, so applying one twice does no harm.
+ */
+enum class SpectatorEvent : uint8_t {
+  kLocation,
+  kPlayerHealth,
+  kPlayerKeys,
+  kPlayerWeapons,
+  kRoomKeys,
+  kRoomWeapons,
+  kRoomEnemies,
+  kDoorLock
+};
+
+void AppendVarint(uint64_t value, std::string& buffer) {
+  uint8_t bytes[kMaxVarintSize];
+  size_t size = EncodeVarint(value, bytes);
+
+  buffer.append((const char*)bytes, size);
+}
+
+void AppendString(const std::string& text, std::string& buffer) {
+  AppendVarint(text.size(), buffer);
+  buffer.append(text);
+}
+
+// Appended from both the Player's Weapons and a Room's, which are held in
+// different kinds of vectors
+template <typename Weapons>
+void AppendWeapons(const Weapons& weapons, std::string& buffer) {
+  AppendVarint(weapons.size(), buffer);
+
+  for (const Weapon& weapon : weapons) {
+    AppendString(weapon.GetName(), buffer);
+    AppendString(weapon.GetNickname(), buffer);
+    AppendVarint(weapon.GetStrength(), buffer);
+    AppendVarint(weapon.GetCriticalChance(), buffer);
+  }
+}
+
+void AppendEnemies(const ArenaVector<Enemy>& enemies, std::string& buffer) {
+  AppendVarint(enemies.size(), buffer);
+
+  for (const Enemy& enemy : enemies) {
+    AppendString(enemy.GetName(), buffer);
+    AppendString(enemy.GetNickname(), buffer);
+    AppendVarint(enemy.GetHealth(), buffer);
+    AppendVarint(enemy.GetStrength(), buffer);
+    AppendVarint(enemy.GetCriticalChance(), buffer);
+  }
+}
+
+void AppendRoom(const Room& room, std::string& buffer) {
+  AppendString(room.GetName(), buffer);
+  AppendString(room.GetNickname(), buffer);
+
+  AppendVarint(room.GetDoors().size(), buffer);
+  for (const Door& door : room.GetDoors()) {
+    AppendString(door.GetDirection(), buffer);
+    AppendString(door.GetAdjacentRoom(), buffer);
+    AppendVarint(door.IsLocked(), buffer);
+  }
+
+  AppendEnemies(room.GetEnemies(), buffer);
+  AppendWeapons(room.GetWeapons(), buffer);
+  AppendVarint(room.GetNumberOfKeys(), buffer);
+}
+
+/**
+ * Reads fields out of a single frame, throwing if the frame ends before a
+ * field does.
+ */
+class FrameReader {
+ public:
+  explicit FrameReader(const std::string& frame)
+      : data_((const uint8_t*)frame.data()), size_(frame.size()),
+        position_(0) {}
+
+  bool IsAtEnd() const { return position_ == size_; }
+
+  uint64_t ReadVarint() {
+    uint64_t value = 0;
+    size_t read = DecodeVarint(data_ + position_, size_ - position_, value);
+
+    if (read == 0) {
+      throw std::invalid_argument("MALFORMED FRAME");
+    }
+
+    position_ += read;
+    return value;
+  }
+
+  std::string ReadString() {
+    uint64_t length = ReadVarint();
+
+    if (length > size_ - position_) {
+      throw std::invalid_argument("MALFORMED FRAME");
+    }
+
+    std::string text((const char*)data_ + position_, (size_t)length);
+    position_ += (size_t)length;
+    return text;
+  }
+
+  std::vector<Weapon> ReadWeapons() {
+    std::vector<Weapon> weapons;
+
+    for (uint64_t count = ReadVarint(); count > 0; --count) {
+      std::string name = ReadString();
+      std::string nickname = ReadString();
+      size_t strength = (size_t)ReadVarint();
+      weapons.emplace_back(name, nickname, strength, (size_t)ReadVarint());
+    }
+
+    return weapons;
+  }
+
+  std::vector<Enemy> ReadEnemies() {
+    std::vector<Enemy> enemies;
+
+    for (uint64_t count = ReadVarint(); count > 0; --count) {
+      std::string name = ReadString();
+      std::string nickname = ReadString();
+      size_t health = (size_t)ReadVarint();
+      size_t strength = (size_t)ReadVarint();
+
+      // Enemies beaten in the final Room stay with no health left, which
+      // the constructor does not accept
+      Enemy enemy(name, nickname, 1, strength, (size_t)ReadVarint());
+      enemy.SetHealth(health);
+      enemies.push_back(enemy);
+    }
+
+    return enemies;
+  }
+
+  Room ReadRoom() {
+    std::string name = ReadString();
+    std::string nickname = ReadString();
+
+    std::vector<Door> doors;
+    for (uint64_t count = ReadVarint(); count > 0; --count) {
+      std::string direction = ReadString();
+      std::string adjacent_room = ReadString();
+      doors.emplace_back(direction, adjacent_room, ReadVarint() != 0);
+    }
+
+    std::vector<Enemy> enemies = ReadEnemies();
+    std::vector<Weapon> weapons = ReadWeapons();
+
+    return Room(name, nickname, doors, enemies, weapons,
+                (size_t)ReadVarint());
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t position_;
+};
+
+/**
+ * Returns a copy of a Player with different Weapons.
+ */
+// Rooms are rebuilt from plain vectors, whatever their lists are held in
+template <typename T>
+std::vector<T> CopyList(const ArenaVector<T>& list) {
+  return std::vector<T>(list.begin(), list.end());
+}
+
+Player WithWeapons(const Player& player, const std::vector<Weapon>& weapons) {
+  Player changed(player.GetCurrentLocation(), player.GetMaxHealth(),
+                 player.GetNumberOfKeys(), weapons);
+  changed.SetHealth(player.GetHealth());
+  changed.SetMaxWeapons(player.GetMaxWeapons());
+
+  return changed;
+}
+
+void SetNumberOfKeys(Player& player, size_t number_of_keys) {
+  while (player.GetNumberOfKeys() < number_of_keys) {
+    player.IncrementNumberOfKeys();
+  }
+  while (player.GetNumberOfKeys() > number_of_keys) {
+    player.DecrementNumberOfKeys();
+  }
+}
+
+void SetNumberOfKeys(Room& room, size_t number_of_keys) {
+  while (room.GetNumberOfKeys() < number_of_keys) {
+    room.IncrementNumberOfKeys();
+  }
+  while (room.GetNumberOfKeys() > number_of_keys) {
+    room.DecrementNumberOfKeys();
+  }
+}
+
+}   // namespace
+
+SpectatorChannel::SpectatorChannel(size_t capacity, size_t keyframe_interval)
+    : keyframe_interval_(keyframe_interval), ring_(capacity),
+      commands_since_keyframe_(0), frame_(), keyframe_position_(0),
+      has_keyframe_(false), number_of_frames_(0) {
+  if (keyframe_interval_ == 0) {
+    throw std::invalid_argument("KEYFRAME INTERVAL EQUALS ZERO");
+  }
+}
+
+void SpectatorChannel::Publish(const Engine& engine) {
+  // A keyframe is also due once the newest one is half way to being
+  // overwritten, so there is always one left for spectators to start from
+  uint64_t words_since_keyframe = ring_.GetEnd() - keyframe_position_;
+  if (!has_keyframe_ || commands_since_keyframe_ >= keyframe_interval_ ||
+      words_since_keyframe * sizeof(uint64_t) > ring_.GetCapacity() / 2) {
+    PublishKeyframe(engine);
+    return;
+  }
+
+  const Player& player = engine.GetPlayer();
+  const CopyOnWriteMap& map = engine.GetMap();
+
+  frame_.clear();
+  AppendVarint((uint64_t)FrameType::kDelta, frame_);
+  AppendString(engine.GetMessage(), frame_);
+
+  // The same change is often recorded twice in a row, such as an Enemy's
+  // health followed by its removal, and is only sent once
+  SpectatorEvent previous_event = SpectatorEvent::kLocation;
+  uint32_t previous_room = 0;
+  bool has_previous = false;
+
+  for (const Delta& delta : engine.GetLastDeltas()) {
+    SpectatorEvent event;
+
+    switch (delta.type) {
+      case DeltaType::kLocation:
+        event = SpectatorEvent::kLocation;
+        break;
+      case DeltaType::kPlayerHealth:
+        event = SpectatorEvent::kPlayerHealth;
+        break;
+      case DeltaType::kPlayerKeys:
+        event = SpectatorEvent::kPlayerKeys;
+        break;
+      case DeltaType::kRoomKeys:
+        event = SpectatorEvent::kRoomKeys;
+        break;
+      case DeltaType::kWeaponTaken:
+      case DeltaType::kWeaponDropped:
+        event = SpectatorEvent::kRoomWeapons;
+        break;
+      case DeltaType::kEnemyHealth:
+      case DeltaType::kEnemyRemoved:
+        event = SpectatorEvent::kRoomEnemies;
+        break;
+      case DeltaType::kLockSwitched:
+        event = SpectatorEvent::kDoorLock;
+        break;
+      default:
+        continue;
+    }
+
+    if (has_previous && event == previous_event &&
+        delta.room == previous_room && event != SpectatorEvent::kDoorLock) {
+      continue;
+    }
+    previous_event = event;
+    previous_room = delta.room;
+    has_previous = true;
+
+    AppendVarint((uint64_t)event, frame_);
+
+    switch (event) {
+      case SpectatorEvent::kLocation:
+        AppendVarint(map.GetDungeon().FindRoomIndex(
+                         player.GetCurrentLocation()), frame_);
+        break;
+      case SpectatorEvent::kPlayerHealth:
+        AppendVarint(player.GetHealth(), frame_);
+        break;
+      case SpectatorEvent::kPlayerKeys:
+        AppendVarint(player.GetNumberOfKeys(), frame_);
+        break;
+      case SpectatorEvent::kRoomKeys:
+        AppendVarint(delta.room, frame_);
+        AppendVarint(map[delta.room].GetNumberOfKeys(), frame_);
+        break;
+      case SpectatorEvent::kRoomWeapons:
+        // An item moved between the Room and the Player
+        AppendVarint(delta.room, frame_);
+        AppendWeapons(map[delta.room].GetWeapons(), frame_);
+        AppendVarint((uint64_t)SpectatorEvent::kPlayerWeapons, frame_);
+        AppendWeapons(player.GetWeapons(), frame_);
+        break;
+      case SpectatorEvent::kRoomEnemies:
+        AppendVarint(delta.room, frame_);
+        AppendEnemies(map[delta.room].GetEnemies(), frame_);
+        break;
+      case SpectatorEvent::kDoorLock:
+        AppendVarint(delta.room, frame_);
+        AppendVarint(delta.index, frame_);
+        AppendVarint(map[delta.room].GetDoors()[delta.index].IsLocked(),
+                     frame_);
+        break;
+      default:
+        break;
+    }
+  }
+
+  ring_.Publish(frame_.data(), frame_.size());
+  ++commands_since_keyframe_;
+  ++number_of_frames_;
+}
+
+void SpectatorChannel::PublishKeyframe(const Engine& engine) {
+  const Player& player = engine.GetPlayer();
+  const CopyOnWriteMap& map = engine.GetMap();
+
+  frame_.clear();
+  AppendVarint((uint64_t)FrameType::kKeyframe, frame_);
+  AppendString(engine.GetMessage(), frame_);
+
+  AppendString(player.GetCurrentLocation(), frame_);
+  AppendVarint(player.GetMaxHealth(), frame_);
+  AppendVarint(player.GetHealth(), frame_);
+  AppendVarint(player.GetNumberOfKeys(), frame_);
+  AppendWeapons(player.GetWeapons(), frame_);
+
+  // Spectators have the Dungeon, so only the Rooms that differ are sent
+  std::vector<size_t> indices = map.GetModifiedRoomIndices();
+  AppendVarint(indices.size(), frame_);
+  for (size_t index : indices) {
+    AppendVarint(index, frame_);
+    AppendRoom(map[index], frame_);
+  }
+
+  uint64_t position = ring_.Publish(frame_.data(), frame_.size());
+  keyframe_position_.store(position, std::memory_order_release);
+  has_keyframe_.store(true, std::memory_order_release);
+
+  commands_since_keyframe_ = 0;
+  ++number_of_frames_;
+}
+
+const BroadcastRing &SpectatorChannel::GetRing() const { return ring_; }
+
+uint64_t SpectatorChannel::GetKeyframePosition() const {
+  return keyframe_position_.load(std::memory_order_acquire);
+}
+
+bool SpectatorChannel::HasKeyframe() const {
+  return has_keyframe_.load(std::memory_order_acquire);
+}
+
+uint64_t SpectatorChannel::GetNumberOfFrames() const {
+  return number_of_frames_;
+}
+
+Spectator::Spectator(const SpectatorChannel& channel,
+                     std::shared_ptr<const Dungeon> dungeon)
+    : channel_(channel),
+      position_(channel.HasKeyframe() ? channel.GetKeyframePosition() : 0),
+      frame_(), player_(), map_(std::move(dungeon)), message_(),
+      is_synced_(false), number_of_overruns_(0) {}
+
+bool Spectator::Update() {
+  bool has_changed = false;
+
+  while (true) {
+    BroadcastRead result = channel_.GetRing().Read(position_, frame_);
+
+    if (result == BroadcastRead::kEmpty) {
+      break;
+    } else if (result == BroadcastRead::kOverrun) {
+      ++number_of_overruns_;
+      is_synced_ = false;
+
+      // Starts over from the newest keyframe, unless that has just been
+      // overwritten too, in which case the next update tries again
+      uint64_t keyframe = channel_.GetKeyframePosition();
+      if (keyframe == position_) {
+        break;
+      }
+      position_ = keyframe;
+      continue;
+    }
+
+    // Frames read before the first keyframe are skipped
+    Apply(frame_);
+    has_changed = has_changed || is_synced_;
+  }
+
+  return has_changed;
+}
+
+bool Spectator::IsSynced() const { return is_synced_; }
+
+const Player &Spectator::GetPlayer() const { return player_; }
+
+const CopyOnWriteMap &Spectator::GetMap() const { return map_; }
+
+const std::string &Spectator::GetMessage() const { return message_; }
+
+uint64_t Spectator::GetNumberOfOverruns() const {
+  return number_of_overruns_;
+}
+
+void Spectator::Apply(const std::string& frame) {
+  FrameReader reader(frame);
+  FrameType type = (FrameType)reader.ReadVarint();
+
+  if (type == FrameType::kKeyframe) {
+    std::string message = reader.ReadString();
+
+    std::string location = reader.ReadString();
+    size_t max_health = (size_t)reader.ReadVarint();
+    size_t health = (size_t)reader.ReadVarint();
+    size_t number_of_keys = (size_t)reader.ReadVarint();
+    Player player(location, max_health, number_of_keys,
+                  reader.ReadWeapons());
+    player.SetHealth(health);
+
+    std::vector<std::pair<size_t, Room>> rooms;
+    for (uint64_t count = reader.ReadVarint(); count > 0; --count) {
+      size_t index = (size_t)reader.ReadVarint();
+
+      if (index >= map_.size()) {
+        throw std::invalid_argument("ROOM INDEX OUT OF RANGE");
+      }
+      rooms.emplace_back(index, reader.ReadRoom());
+    }
+
+    message_ = message;
+    player_ = player;
+    map_.Reset();
+    for (const std::pair<size_t, Room>& room : rooms) {
+      map_.Modify(room.first) = room.second;
+    }
+
+    is_synced_ = true;
+    return;
+  } else if (type != FrameType::kDelta) {
+    throw std::invalid_argument("INVALID FRAME TYPE");
+  }
+
+  // Deltas only make sense on top of the keyframe before them
+  if (!is_synced_) {
+    return;
+  }
+
+  message_ = reader.ReadString();
+
+  while (!reader.IsAtEnd()) {
+    SpectatorEvent event = (SpectatorEvent)reader.ReadVarint();
+
+    if (event == SpectatorEvent::kLocation) {
+      player_.SetCurrentLocation(
+          map_.at((size_t)reader.ReadVarint()).GetNickname());
+    } else if (event == SpectatorEvent::kPlayerHealth) {
+      player_.SetHealth((size_t)reader.ReadVarint());
+    } else if (event == SpectatorEvent::kPlayerKeys) {
+      SetNumberOfKeys(player_, (size_t)reader.ReadVarint());
+    } else if (event == SpectatorEvent::kPlayerWeapons) {
+      player_ = WithWeapons(player_, reader.ReadWeapons());
+    } else if (event == SpectatorEvent::kRoomKeys) {
+      size_t index = (size_t)reader.ReadVarint();
+      SetNumberOfKeys(map_.Modify(index), (size_t)reader.ReadVarint());
+    } else if (event == SpectatorEvent::kRoomWeapons) {
+      size_t index = (size_t)reader.ReadVarint();
+      const Room& room = map_.at(index);
+
+      map_.Modify(index) = Room(room.GetName(), room.GetNickname(),
+                                CopyList(room.GetDoors()),
+                                CopyList(room.GetEnemies()),
+                                reader.ReadWeapons(),
+                                room.GetNumberOfKeys());
+    } else if (event == SpectatorEvent::kRoomEnemies) {
+      size_t index = (size_t)reader.ReadVarint();
+      const Room& room = map_.at(index);
+
+      map_.Modify(index) = Room(room.GetName(), room.GetNickname(),
+                                CopyList(room.GetDoors()),
+                                reader.ReadEnemies(),
+                                CopyList(room.GetWeapons()),
+                                room.GetNumberOfKeys());
+    } else if (event == SpectatorEvent::kDoorLock) {
+      size_t index = (size_t)reader.ReadVarint();
+      uint32_t door = (uint32_t)reader.ReadVarint();
+      bool is_locked = reader.ReadVarint() != 0;
+
+      Door& room_door = map_.Modify(index).RetrieveDoorAt(door);
+      if (room_door.IsLocked() != is_locked) {
+        room_door.SwitchLock();
+      }
+    } else {
+      throw std::invalid_argument("INVALID EVENT TYPE");
+    }
+  }
+}
+
+}   // namespace adventure
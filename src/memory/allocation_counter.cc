@@ -0,0 +1,54 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "memory/allocation_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Counted per thread, so that a measurement is not thrown off by whatever
+// other threads happen to allocate at the same time
+thread_local size_t number_of_allocations = 0;
+thread_local size_t number_of_frees = 0;
+
+}   // namespace
+
+#ifdef ADVENTURE_COUNT_ALLOCATIONS
+
+void* operator new(size_t size) {
+  ++number_of_allocations;
+
+  void* memory = std::malloc(size == 0 ? 1 : size);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return memory;
+}
+
+void operator delete(void* memory) noexcept {
+  if (memory != nullptr) {
+    ++number_of_frees;
+  }
+
+  std::free(memory);
+}
+
+#endif
+
+namespace adventure {
+
+bool IsCountingAllocations() {
+#ifdef ADVENTURE_COUNT_ALLOCATIONS
+  return true;
+#else
+  return false;
+#endif
+}
+
+size_t GetNumberOfAllocations() { return number_of_allocations; }
+
+size_t GetNumberOfFrees() { return number_of_frees; }
+
+}   // namespace adventure
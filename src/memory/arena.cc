@@ -0,0 +1,70 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "memory/arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+
+namespace adventure {
+
+const size_t Arena::kDefaultFirstBlockSize;
+const size_t Arena::kMaxBlockSize;
+
+Arena::Arena() : Arena(kDefaultFirstBlockSize) {}
+
+Arena::Arena(size_t first_block_size)
+    : current_block_(nullptr), cursor_(nullptr), end_(nullptr),
+      next_block_size_(first_block_size), number_of_blocks_(0),
+      number_of_bytes_(0), capacity_(0) {
+  if (first_block_size == 0) {
+    throw std::invalid_argument("BLOCK SIZE EQUALS ZERO");
+  }
+}
+
+Arena::~Arena() {
+  while (current_block_ != nullptr) {
+    Block* previous = current_block_->previous;
+    ::operator delete(current_block_);
+    current_block_ = previous;
+  }
+}
+
+void* Arena::Allocate(size_t size, size_t alignment) {
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+    throw std::invalid_argument("INVALID ALIGNMENT");
+  }
+
+  uintptr_t start = ((uintptr_t)cursor_ + alignment - 1) & ~(alignment - 1);
+  if (cursor_ == nullptr || start + size > (uintptr_t)end_) {
+    AddBlock(size + alignment);
+    start = ((uintptr_t)cursor_ + alignment - 1) & ~(alignment - 1);
+  }
+
+  cursor_ = (char*)(start + size);
+  number_of_bytes_ += size;
+  return (void*)start;
+}
+
+size_t Arena::GetNumberOfBlocks() const { return number_of_blocks_; }
+
+size_t Arena::GetNumberOfBytes() const { return number_of_bytes_; }
+
+size_t Arena::GetCapacity() const { return capacity_; }
+
+void Arena::AddBlock(size_t minimum_size) {
+  size_t size = std::max(next_block_size_, minimum_size);
+  Block* block = (Block*)::operator new(sizeof(Block) + size);
+  block->previous = current_block_;
+  block->size = size;
+  current_block_ = block;
+  cursor_ = (char*)(block + 1);
+  end_ = cursor_ + size;
+
+  next_block_size_ = std::min(next_block_size_ * 2, kMaxBlockSize);
+  ++number_of_blocks_;
+  capacity_ += size;
+}
+
+}   // namespace adventure
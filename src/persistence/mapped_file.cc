@@ -0,0 +1,138 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "persistence/mapped_file.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace adventure {
+
+MappedFile::MappedFile(const std::string& path)
+    : data_(nullptr), size_(0), mapping_(nullptr) {
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::invalid_argument("FILE NOT FOUND");
+  }
+
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size)) {
+    CloseHandle(file);
+    throw std::invalid_argument("FILE COULD NOT BE MAPPED");
+  } else if (file_size.QuadPart == 0) {
+    CloseHandle(file);
+    return;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0,
+                                      nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr) {
+    throw std::invalid_argument("FILE COULD NOT BE MAPPED");
+  }
+
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (data == nullptr) {
+    CloseHandle(mapping);
+    throw std::invalid_argument("FILE COULD NOT BE MAPPED");
+  }
+
+  mapping_ = mapping;
+  size_ = (size_t)file_size.QuadPart;
+#else
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::invalid_argument("FILE NOT FOUND");
+  }
+
+  struct stat file_status;
+  if (fstat(fd, &file_status) != 0) {
+    close(fd);
+    throw std::invalid_argument("FILE COULD NOT BE MAPPED");
+  } else if (file_status.st_size == 0) {
+    close(fd);
+    return;
+  }
+
+  // The mapping keeps the file alive on its own
+  void* data = mmap(nullptr, (size_t)file_status.st_size, PROT_READ,
+                    MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw std::invalid_argument("FILE COULD NOT BE MAPPED");
+  }
+
+  size_ = (size_t)file_status.st_size;
+#endif
+  data_ = (const uint8_t*)data;
+}
+
+MappedFile::~MappedFile() {
+  if (data_ == nullptr) {
+    return;
+  }
+
+#ifdef _WIN32
+  UnmapViewOfFile(data_);
+  CloseHandle((HANDLE)mapping_);
+#else
+  munmap((void*)data_, size_);
+#endif
+}
+
+const uint8_t* MappedFile::GetData() const { return data_; }
+
+size_t MappedFile::GetSize() const { return size_; }
+
+std::vector<std::string> ListFiles(const std::string& directory) {
+  std::vector<std::string> paths;
+
+#ifdef _WIN32
+  WIN32_FIND_DATAA entry;
+  HANDLE search = FindFirstFileA((directory + "\\*").c_str(), &entry);
+  if (search == INVALID_HANDLE_VALUE) {
+    throw std::invalid_argument("DIRECTORY NOT FOUND");
+  }
+
+  do {
+    if ((entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0) {
+      paths.push_back(directory + "\\" + entry.cFileName);
+    }
+  } while (FindNextFileA(search, &entry));
+  FindClose(search);
+#else
+  DIR* stream = opendir(directory.c_str());
+  if (stream == nullptr) {
+    throw std::invalid_argument("DIRECTORY NOT FOUND");
+  }
+
+  for (dirent* entry = readdir(stream); entry != nullptr;
+       entry = readdir(stream)) {
+    std::string path = directory + "/" + entry->d_name;
+    struct stat file_status;
+
+    if (stat(path.c_str(), &file_status) == 0 &&
+        S_ISREG(file_status.st_mode)) {
+      paths.push_back(path);
+    }
+  }
+  closedir(stream);
+#endif
+
+  std::sort(paths.begin(), paths.end());
+  return paths;
+}
+
+}   // namespace adventure
@@ -0,0 +1,378 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "persistence/session_store.h"
+
+#include "serialization/checksum.h"
+#include "serialization/varint.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace adventure {
+
+namespace {
+
+const char kMagic[] = "ADVS";
+const size_t kMagicSize = 4;
+const uint64_t kVersion = 1;
+
+}   // namespace
+
+SessionStore::SessionStore(const std::string& directory,
+                           std::chrono::milliseconds snapshot_interval)
+    : directory_(directory), snapshot_interval_(snapshot_interval),
+      log_(directory), sessions_(), pending_snapshots_(),
+      number_of_writing_(0), round_(0), has_failed_(false),
+      is_stopping_(false),
+      number_of_snapshots_(0) {
+  if (snapshot_interval.count() <= 0) {
+    throw std::invalid_argument("SNAPSHOT INTERVAL NOT POSITIVE");
+  }
+
+  snapshot_thread_ = std::thread(&SessionStore::Run, this);
+}
+
+SessionStore::~SessionStore() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopping_ = true;
+  }
+  snapshot_queued_.notify_one();
+
+  snapshot_thread_.join();
+}
+
+std::map<uint64_t, Engine> SessionStore::Recover(const Engine& initial) {
+  std::map<uint64_t, Engine> engines;
+  std::map<uint64_t, uint64_t> snapshot_sequences;
+
+  std::ifstream index(GetIndexPath());
+  uint64_t session;
+  while (index >> session) {
+    Engine engine = initial;
+    snapshot_sequences[session] = ReadSnapshot(session, engine);
+    engines.emplace(session, engine);
+  }
+
+  std::map<uint64_t, uint64_t> last_sequences = snapshot_sequences;
+  log_.Replay([&](const WalRecord& record) {
+    // Sessions are indexed once their first snapshot is durable, so a
+    // session missing from the index crashed before it was fully opened
+    std::map<uint64_t, Engine>::iterator engine =
+        engines.find(record.session);
+    if (engine == engines.end()) {
+      return;
+    }
+
+    uint64_t& last_sequence = last_sequences[record.session];
+    if (record.sequence <= last_sequence) {
+      return;
+    }
+
+    engine->second.Execute(record.command, record.qualifier);
+    last_sequence = record.sequence;
+  });
+
+  uint64_t first_segment = log_.GetFirstSegment();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const std::pair<const uint64_t, Engine>& engine : engines) {
+    uint64_t snapshot_sequence = snapshot_sequences[engine.first];
+    uint64_t last_sequence = last_sequences[engine.first];
+
+    SessionState& state = sessions_[engine.first];
+    state.last_sequence = last_sequence;
+    state.snapshot_sequence = snapshot_sequence;
+    state.snapshot_round = round_;
+
+    // The replayed tail is snapshotted right away, so the old segments it
+    // came from can be removed without waiting for the session to come back
+    if (last_sequence > snapshot_sequence) {
+      state.segment_starts.emplace_back(snapshot_sequence + 1, first_segment);
+
+      std::ostringstream bytes;
+      bytes << engine.second;
+      pending_snapshots_.push_back(
+          PendingSnapshot{engine.first, last_sequence, bytes.str()});
+    }
+  }
+  snapshot_queued_.notify_one();
+
+  return engines;
+}
+
+void SessionStore::Open(uint64_t session, const Engine& engine) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (sessions_.count(session) > 0) {
+      throw std::invalid_argument("SESSION ALREADY OPEN");
+    }
+  }
+
+  std::ostringstream bytes;
+  bytes << engine;
+  WriteSnapshot(PendingSnapshot{session, 0, bytes.str()});
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  SessionState& state = sessions_[session];
+  state.last_sequence = 0;
+  state.snapshot_sequence = 0;
+  state.snapshot_round = round_;
+
+  std::string index;
+  for (const std::pair<const uint64_t, SessionState>& open : sessions_) {
+    index += std::to_string(open.first) + "\n";
+  }
+  WriteFileAtomically(GetIndexPath(), index);
+}
+
+uint64_t SessionStore::Record(uint64_t session, Command command,
+                              const std::string& qualifier,
+                              const Engine& engine) {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  std::map<uint64_t, SessionState>::iterator state = sessions_.find(session);
+  if (state == sessions_.end()) {
+    throw std::invalid_argument("SESSION NOT OPEN");
+  }
+
+  uint64_t sequence = ++state->second.last_sequence;
+
+  uint64_t segment;
+  uint64_t ticket = log_.Append(WalRecord{session, sequence, command,
+                                          qualifier}, segment);
+
+  std::deque<std::pair<uint64_t, uint64_t>>& starts =
+      state->second.segment_starts;
+  if (starts.empty() || starts.back().second != segment) {
+    starts.emplace_back(sequence, segment);
+  }
+
+  if (state->second.snapshot_round == round_) {
+    return ticket;
+  }
+  state->second.snapshot_round = round_;
+  lock.unlock();
+
+  // Saving the Engine is the only snapshot work done on the session's own
+  // thread; the file is written in the background
+  QueueSnapshot(session, sequence, engine);
+
+  return ticket;
+}
+
+void SessionStore::WaitUntilDurable(uint64_t ticket) {
+  log_.WaitUntilDurable(ticket);
+}
+
+void SessionStore::Snapshot(uint64_t session, const Engine& engine) {
+  uint64_t sequence;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (has_failed_) {
+      throw std::invalid_argument("SNAPSHOT COULD NOT BE WRITTEN");
+    }
+
+    std::map<uint64_t, SessionState>::iterator state =
+        sessions_.find(session);
+    if (state == sessions_.end()) {
+      throw std::invalid_argument("SESSION NOT OPEN");
+    }
+
+    sequence = state->second.last_sequence;
+    state->second.snapshot_round = round_;
+  }
+
+  QueueSnapshot(session, sequence, engine);
+}
+
+void SessionStore::WaitForSnapshots() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  snapshots_written_.wait(lock, [this] {
+    return pending_snapshots_.empty() && number_of_writing_ == 0;
+  });
+
+  if (has_failed_) {
+    throw std::invalid_argument("SNAPSHOT COULD NOT BE WRITTEN");
+  }
+}
+
+const WriteAheadLog &SessionStore::GetLog() const { return log_; }
+
+size_t SessionStore::GetNumberOfSnapshots() const {
+  return number_of_snapshots_;
+}
+
+std::string SessionStore::GetSnapshotPath(uint64_t session) const {
+  return directory_ + "/session-" + std::to_string(session) + ".snapshot";
+}
+
+std::string SessionStore::GetIndexPath() const {
+  return directory_ + "/sessions.index";
+}
+
+void SessionStore::QueueSnapshot(uint64_t session, uint64_t sequence,
+                                 const Engine& engine) {
+  std::ostringstream bytes;
+  bytes << engine;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_snapshots_.push_back(PendingSnapshot{session, sequence,
+                                                 bytes.str()});
+  }
+  snapshot_queued_.notify_one();
+}
+
+void SessionStore::WriteSnapshot(const PendingSnapshot& snapshot) const {
+  std::ostringstream bytes;
+  bytes.write(kMagic, kMagicSize);
+  WriteVarint(bytes, kVersion);
+  WriteVarint(bytes, snapshot.session);
+  WriteVarint(bytes, snapshot.sequence);
+  WriteVarintString(bytes, snapshot.engine);
+
+  Checksum checksum;
+  checksum.Add(bytes.str());
+  WriteVarint(bytes, checksum.GetValue());
+
+  WriteFileAtomically(GetSnapshotPath(snapshot.session), bytes.str());
+}
+
+uint64_t SessionStore::ReadSnapshot(uint64_t session, Engine& engine) const {
+  std::ifstream snapshot_file(GetSnapshotPath(session), std::ios::binary);
+  if (!snapshot_file.is_open()) {
+    throw std::invalid_argument("SNAPSHOT NOT FOUND");
+  }
+
+  std::string bytes((std::istreambuf_iterator<char>(snapshot_file)),
+                    std::istreambuf_iterator<char>());
+  std::istringstream is(bytes);
+
+  char magic[kMagicSize];
+  if (!is.read(magic, kMagicSize) ||
+      std::string(magic, kMagicSize) != kMagic ||
+      ReadVarint(is) != kVersion || ReadVarint(is) != session) {
+    throw std::invalid_argument("SNAPSHOT IS CORRUPTED");
+  }
+
+  uint64_t sequence = ReadVarint(is);
+  std::string engine_bytes = ReadVarintString(is);
+
+  Checksum checksum;
+  checksum.Add(bytes.substr(0, (size_t)is.tellg()));
+  if (ReadVarint(is) != checksum.GetValue()) {
+    throw std::invalid_argument("SNAPSHOT IS CORRUPTED");
+  }
+
+  std::istringstream engine_stream(engine_bytes);
+  engine_stream >> engine;
+
+  return sequence;
+}
+
+void SessionStore::CompleteSnapshot(const PendingSnapshot& snapshot) {
+  SessionState& state = sessions_[snapshot.session];
+
+  if (snapshot.sequence <= state.snapshot_sequence) {
+    return;
+  }
+  state.snapshot_sequence = snapshot.sequence;
+
+  std::deque<std::pair<uint64_t, uint64_t>>& starts = state.segment_starts;
+  if (snapshot.sequence >= state.last_sequence) {
+    starts.clear();
+  } else {
+    while (starts.size() > 1 && starts[1].first <= snapshot.sequence + 1) {
+      starts.pop_front();
+    }
+  }
+}
+
+uint64_t SessionStore::FindOldestSegment() const {
+  uint64_t oldest_segment = log_.GetCurrentSegment();
+
+  for (const std::pair<const uint64_t, SessionState>& session : sessions_) {
+    if (!session.second.segment_starts.empty()) {
+      oldest_segment = std::min(oldest_segment,
+                                session.second.segment_starts.front().second);
+    }
+  }
+
+  return oldest_segment;
+}
+
+void SessionStore::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  std::chrono::steady_clock::time_point next_round =
+      std::chrono::steady_clock::now() + snapshot_interval_;
+
+  while (true) {
+    snapshot_queued_.wait_until(lock, next_round, [this] {
+      return is_stopping_ || !pending_snapshots_.empty();
+    });
+
+    if (std::chrono::steady_clock::now() >= next_round) {
+      // Every session becomes due at its next command, and their records
+      // from now on go to a new segment that the snapshots will leave behind
+      ++round_;
+      next_round = std::chrono::steady_clock::now() + snapshot_interval_;
+
+      lock.unlock();
+      log_.Rotate();
+      lock.lock();
+    }
+
+    if (pending_snapshots_.empty() && is_stopping_) {
+      return;
+    }
+
+    std::vector<PendingSnapshot> snapshots;
+    snapshots.swap(pending_snapshots_);
+    number_of_writing_ = snapshots.size();
+    lock.unlock();
+
+    // A snapshot that cannot be written (e.g. on a full disk) releases no
+    // segments, and the failure is kept for the caller to see
+    std::vector<size_t> written;
+    bool is_failed = false;
+    for (size_t snapshot = 0; snapshot < snapshots.size(); ++snapshot) {
+      try {
+        WriteSnapshot(snapshots[snapshot]);
+        written.push_back(snapshot);
+      } catch (const std::invalid_argument&) {
+        is_failed = true;
+      }
+    }
+    number_of_snapshots_ += written.size();
+
+    lock.lock();
+    for (size_t snapshot : written) {
+      CompleteSnapshot(snapshots[snapshot]);
+    }
+    uint64_t oldest_segment = FindOldestSegment();
+    lock.unlock();
+
+    // Does nothing unless a snapshot or a rotation freed up old segments
+    try {
+      log_.RemoveSegmentsBefore(oldest_segment);
+    } catch (const std::invalid_argument&) {
+      is_failed = true;
+    }
+
+    lock.lock();
+    if (is_failed) {
+      has_failed_ = true;
+    }
+    number_of_writing_ = 0;
+    snapshots_written_.notify_all();
+  }
+}
+
+}   // namespace adventure
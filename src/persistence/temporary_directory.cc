@@ -0,0 +1,106 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "persistence/temporary_directory.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+namespace adventure {
+
+TemporaryDirectory::TemporaryDirectory(const std::string& prefix)
+    : path_() {
+#ifdef _WIN32
+  char base[MAX_PATH + 1];
+  DWORD length = GetTempPathA(sizeof(base), base);
+  if (length == 0 || length > MAX_PATH) {
+    throw std::invalid_argument("DIRECTORY COULD NOT BE CREATED");
+  }
+
+  // Names are tried in turn until one is not taken
+  std::string stem = std::string(base) + prefix + "-" +
+                     std::to_string(GetCurrentProcessId()) + "-";
+  for (size_t attempt = 0; attempt < 1000; ++attempt) {
+    std::string path = stem + std::to_string(attempt);
+
+    if (_mkdir(path.c_str()) == 0) {
+      path_ = path;
+      return;
+    } else if (errno != EEXIST) {
+      break;
+    }
+  }
+
+  throw std::invalid_argument("DIRECTORY COULD NOT BE CREATED");
+#else
+  const char* base = std::getenv("TMPDIR");
+  std::string pattern = std::string(base != nullptr && *base != '\0' ? base
+                                                                     : "/tmp")
+                        + "/" + prefix + "-XXXXXX";
+
+  std::vector<char> name(pattern.begin(), pattern.end());
+  name.push_back('\0');
+
+  if (mkdtemp(name.data()) == nullptr) {
+    throw std::invalid_argument("DIRECTORY COULD NOT BE CREATED");
+  }
+
+  path_ = name.data();
+#endif
+}
+
+TemporaryDirectory::~TemporaryDirectory() {
+#ifdef _WIN32
+  WIN32_FIND_DATAA entry;
+  HANDLE search = FindFirstFileA((path_ + "\\*").c_str(), &entry);
+  if (search != INVALID_HANDLE_VALUE) {
+    do {
+      std::string name = entry.cFileName;
+      if (name == "." || name == "..") {
+        continue;
+      }
+
+      std::string path = path_ + "\\" + name;
+      if ((entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0) {
+        _rmdir(path.c_str());
+      } else {
+        std::remove(path.c_str());
+      }
+    } while (FindNextFileA(search, &entry));
+    FindClose(search);
+  }
+
+  _rmdir(path_.c_str());
+#else
+  DIR* stream = opendir(path_.c_str());
+  if (stream != nullptr) {
+    for (dirent* entry = readdir(stream); entry != nullptr;
+         entry = readdir(stream)) {
+      std::string name = entry->d_name;
+      if (name == "." || name == "..") {
+        continue;
+      }
+
+      // Removes a file, a link, or an empty directory alike
+      std::remove((path_ + "/" + name).c_str());
+    }
+    closedir(stream);
+  }
+
+  rmdir(path_.c_str());
+#endif
+}
+
+const std::string &TemporaryDirectory::GetPath() const { return path_; }
+
+}   // namespace adventure
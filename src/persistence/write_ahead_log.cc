@@ -0,0 +1,392 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "persistence/write_ahead_log.h"
+
+#include "serialization/checksum.h"
+#include "serialization/varint.h"
+
+#include <cerrno>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace adventure {
+
+namespace {
+
+const size_t kChecksumSize = 8;
+const uint64_t kMaxCommand = (uint64_t)Command::kRedo;
+
+void AppendVarint(std::string& buffer, uint64_t value) {
+  uint8_t bytes[kMaxVarintSize];
+  size_t size = EncodeVarint(value, bytes);
+
+  buffer.append((const char*)bytes, size);
+}
+
+uint64_t ComputePayloadChecksum(const uint8_t* payload, size_t size) {
+  Checksum checksum;
+  checksum.Add(std::string((const char*)payload, size));
+
+  return checksum.GetValue();
+}
+
+bool FileExists(const std::string& path) {
+  std::FILE* file = std::fopen(path.c_str(), "rb");
+
+  if (file == nullptr) {
+    return false;
+  }
+
+  std::fclose(file);
+  return true;
+}
+
+}   // namespace
+
+bool SyncFile(std::FILE* file) {
+  if (std::fflush(file) != 0) {
+    return false;
+  }
+
+#ifdef _WIN32
+  return _commit(_fileno(file)) == 0;
+#else
+  return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool MakeDirectory(const std::string& path) {
+#ifdef _WIN32
+  return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+  return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+}
+
+void WriteFileAtomically(const std::string& path, const std::string& bytes) {
+  std::string temporary_path = path + ".tmp";
+  std::FILE* file = std::fopen(temporary_path.c_str(), "wb");
+
+  if (file == nullptr) {
+    throw std::invalid_argument("FILE COULD NOT BE WRITTEN");
+  }
+
+  bool is_written =
+      std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() &&
+      SyncFile(file);
+  std::fclose(file);
+
+#ifdef _WIN32
+  // Windows will not rename over an existing file
+  if (is_written) {
+    std::remove(path.c_str());
+  }
+#endif
+  if (!is_written || std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+    std::remove(temporary_path.c_str());
+    throw std::invalid_argument("FILE COULD NOT BE WRITTEN");
+  }
+}
+
+WriteAheadLog::WriteAheadLog(const std::string& directory)
+    : directory_(directory), first_segment_(0), first_new_segment_(0),
+      pending_(), current_segment_(0), next_ticket_(0), rotation_ticket_(0),
+      durable_ticket_(0), has_failed_(false), is_stopping_(false),
+      number_of_syncs_(0), file_(nullptr), file_segment_(0) {
+  if (!MakeDirectory(directory)) {
+    throw std::invalid_argument("DIRECTORY COULD NOT BE CREATED");
+  }
+
+  std::ifstream manifest(GetManifestPath());
+  if (manifest.is_open()) {
+    manifest >> first_segment_;
+  }
+
+  first_new_segment_ = first_segment_;
+  while (FileExists(GetSegmentPath(first_new_segment_))) {
+    ++first_new_segment_;
+  }
+
+  current_segment_ = first_new_segment_;
+  OpenSegment(current_segment_);
+
+  flusher_ = std::thread(&WriteAheadLog::Flush, this);
+}
+
+WriteAheadLog::~WriteAheadLog() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopping_ = true;
+  }
+  appended_.notify_one();
+
+  flusher_.join();
+  if (file_ != nullptr) {
+    std::fclose(file_);
+  }
+}
+
+uint64_t WriteAheadLog::Append(const WalRecord& record, uint64_t& segment) {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  if (has_failed_) {
+    throw std::invalid_argument("LOG COULD NOT BE WRITTEN");
+  }
+
+  if (pending_.empty() || pending_.back().segment != current_segment_) {
+    pending_.push_back(Batch{current_segment_, std::string()});
+  }
+
+  Encode(record, pending_.back().bytes);
+  segment = current_segment_;
+  uint64_t ticket = ++next_ticket_;
+
+  lock.unlock();
+  appended_.notify_one();
+
+  return ticket;
+}
+
+void WriteAheadLog::WaitUntilDurable(uint64_t ticket) {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  synced_.wait(lock, [this, ticket] {
+    return durable_ticket_ >= ticket || has_failed_;
+  });
+
+  if (durable_ticket_ < ticket) {
+    throw std::invalid_argument("LOG COULD NOT BE WRITTEN");
+  }
+}
+
+uint64_t WriteAheadLog::Rotate() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  if (next_ticket_ == rotation_ticket_) {
+    return current_segment_;
+  }
+  rotation_ticket_ = next_ticket_;
+
+  // The empty batch makes the flusher create the new segment's file even if
+  // nothing is appended to it, so segment files never skip a number
+  pending_.push_back(Batch{++current_segment_, std::string()});
+  uint64_t segment = current_segment_;
+
+  lock.unlock();
+  appended_.notify_one();
+
+  return segment;
+}
+
+void WriteAheadLog::RemoveSegmentsBefore(uint64_t segment) {
+  uint64_t first_segment;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (segment > current_segment_) {
+      segment = current_segment_;
+    }
+    if (segment <= first_segment_) {
+      return;
+    }
+
+    first_segment = first_segment_;
+    first_segment_ = segment;
+  }
+
+  // The manifest is replaced before any segment is removed, so a crash in
+  // between only leaves files behind that the next run skips
+  WriteFileAtomically(GetManifestPath(), std::to_string(segment) + "\n");
+
+  for (uint64_t removed = first_segment; removed < segment; ++removed) {
+    std::remove(GetSegmentPath(removed).c_str());
+  }
+}
+
+void WriteAheadLog::Replay(
+    const std::function<void(const WalRecord&)>& apply) const {
+  for (uint64_t segment = first_segment_; segment < first_new_segment_;
+       ++segment) {
+    std::ifstream segment_file(GetSegmentPath(segment), std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(segment_file)),
+                      std::istreambuf_iterator<char>());
+
+    const uint8_t* buffer = (const uint8_t*)bytes.data();
+    size_t offset = 0;
+    WalRecord record;
+
+    // A record that does not decode can only have been torn by a crash, and
+    // nothing after it in the segment was ever synced
+    size_t size = Decode(buffer, bytes.size(), record);
+    while (size > 0) {
+      apply(record);
+
+      offset += size;
+      size = Decode(buffer + offset, bytes.size() - offset, record);
+    }
+  }
+}
+
+uint64_t WriteAheadLog::GetCurrentSegment() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return current_segment_;
+}
+
+uint64_t WriteAheadLog::GetFirstSegment() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return first_segment_;
+}
+
+uint64_t WriteAheadLog::GetNumberOfSyncs() const { return number_of_syncs_; }
+
+void WriteAheadLog::Encode(const WalRecord& record, std::string& buffer) {
+  std::string payload;
+  AppendVarint(payload, record.session);
+  AppendVarint(payload, record.sequence);
+  AppendVarint(payload, (uint64_t)record.command);
+  AppendVarint(payload, record.qualifier.size());
+  payload += record.qualifier;
+
+  uint64_t checksum = ComputePayloadChecksum((const uint8_t*)payload.data(),
+                                             payload.size());
+
+  AppendVarint(buffer, payload.size());
+  buffer += payload;
+  for (size_t byte = 0; byte < kChecksumSize; ++byte) {
+    buffer += (char)((checksum >> (8 * byte)) & 0xFF);
+  }
+}
+
+size_t WriteAheadLog::Decode(const uint8_t* buffer, size_t size,
+                             WalRecord& record) {
+  uint64_t payload_size;
+  size_t offset = DecodeVarint(buffer, size, payload_size);
+
+  if (offset == 0 || payload_size > size - offset ||
+      kChecksumSize > size - offset - payload_size) {
+    return 0;
+  }
+
+  const uint8_t* payload = buffer + offset;
+  size_t end = offset + (size_t)payload_size;
+
+  uint64_t checksum = 0;
+  for (size_t byte = 0; byte < kChecksumSize; ++byte) {
+    checksum |= (uint64_t)buffer[end + byte] << (8 * byte);
+  }
+
+  if (checksum != ComputePayloadChecksum(payload, (size_t)payload_size)) {
+    return 0;
+  }
+
+  uint64_t fields[4];
+  size_t position = 0;
+  for (uint64_t& field : fields) {
+    size_t field_size = DecodeVarint(payload + position,
+                                     (size_t)payload_size - position, field);
+    if (field_size == 0) {
+      return 0;
+    }
+    position += field_size;
+  }
+
+  if (fields[2] > kMaxCommand || fields[3] != payload_size - position) {
+    return 0;
+  }
+
+  record.session = fields[0];
+  record.sequence = fields[1];
+  record.command = (Command)fields[2];
+  record.qualifier.assign((const char*)payload + position,
+                          (size_t)fields[3]);
+
+  return end + kChecksumSize;
+}
+
+std::string WriteAheadLog::GetSegmentPath(uint64_t segment) const {
+  return directory_ + "/wal-" + std::to_string(segment) + ".log";
+}
+
+std::string WriteAheadLog::GetManifestPath() const {
+  return directory_ + "/wal.manifest";
+}
+
+void WriteAheadLog::OpenSegment(uint64_t segment) {
+  file_ = std::fopen(GetSegmentPath(segment).c_str(), "wb");
+
+  if (file_ == nullptr) {
+    throw std::invalid_argument("LOG SEGMENT COULD NOT BE CREATED");
+  }
+  file_segment_ = segment;
+}
+
+bool WriteAheadLog::Write(const Batch& batch) {
+  if (batch.segment != file_segment_) {
+    // Everything in the old segment is synced before moving on, so segments
+    // are durable in order
+    bool is_synced = SyncFile(file_);
+    std::fclose(file_);
+    file_ = nullptr;
+
+    if (!is_synced) {
+      return false;
+    }
+
+    try {
+      OpenSegment(batch.segment);
+    } catch (const std::invalid_argument&) {
+      return false;
+    }
+  }
+
+  return std::fwrite(batch.bytes.data(), 1, batch.bytes.size(), file_) ==
+         batch.bytes.size();
+}
+
+void WriteAheadLog::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    appended_.wait(lock, [this] { return is_stopping_ || !pending_.empty(); });
+
+    if (pending_.empty()) {
+      return;
+    }
+
+    // Everything appended while the last group was syncing goes out as the
+    // next group, with one sync for all of it
+    std::vector<Batch> batches;
+    batches.swap(pending_);
+    uint64_t ticket = next_ticket_;
+    bool is_written = !has_failed_;
+    lock.unlock();
+
+    // After a failure the batches are dropped, since the records before
+    // them may be missing from the segment
+    for (size_t batch = 0; is_written && batch < batches.size(); ++batch) {
+      is_written = Write(batches[batch]);
+    }
+    if (is_written) {
+      is_written = SyncFile(file_);
+      ++number_of_syncs_;
+    }
+
+    lock.lock();
+    if (is_written) {
+      durable_ticket_ = ticket;
+    } else {
+      has_failed_ = true;
+    }
+    synced_.notify_all();
+  }
+}
+
+}   // namespace adventure
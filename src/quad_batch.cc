@@ -0,0 +1,63 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "quad_batch.h"
+
+namespace adventure {
+
+QuadBatch::QuadBatch()
+    : mesh_(ci::TriMesh::Format().positions(2).colors(4)),
+      number_of_rectangles_(0), is_dirty_(true), shader_(), batch_() {}
+
+void QuadBatch::Clear() {
+  mesh_.clear();
+  number_of_rectangles_ = 0;
+  is_dirty_ = true;
+}
+
+void QuadBatch::AddRectangle(const ci::Rectf& rectangle,
+                             const ci::ColorA& color) {
+  uint32_t first = (uint32_t)(4 * number_of_rectangles_);
+
+  glm::vec2 top_left = rectangle.getUpperLeft();
+  glm::vec2 bottom_right = rectangle.getLowerRight();
+
+  mesh_.appendPosition(top_left);
+  mesh_.appendPosition(glm::vec2(bottom_right.x, top_left.y));
+  mesh_.appendPosition(bottom_right);
+  mesh_.appendPosition(glm::vec2(top_left.x, bottom_right.y));
+
+  for (size_t corner = 0; corner < 4; ++corner) {
+    mesh_.appendColorRgba(color);
+  }
+
+  mesh_.appendTriangle(first, first + 1, first + 2);
+  mesh_.appendTriangle(first, first + 2, first + 3);
+
+  ++number_of_rectangles_;
+  is_dirty_ = true;
+}
+
+void QuadBatch::Draw() {
+  if (number_of_rectangles_ == 0) {
+    return;
+  }
+
+  if (is_dirty_) {
+    if (shader_ == nullptr) {
+      shader_ = ci::gl::getStockShader(ci::gl::ShaderDef().color());
+    }
+
+    batch_ = ci::gl::Batch::create(mesh_, shader_);
+    is_dirty_ = false;
+  }
+
+  batch_->draw();
+}
+
+size_t QuadBatch::GetNumberOfRectangles() const {
+  return number_of_rectangles_;
+}
+
+bool QuadBatch::IsDirty() const { return is_dirty_; }
+
+}   // namespace adventure
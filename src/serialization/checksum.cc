@@ -0,0 +1,107 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "serialization/checksum.h"
+
+namespace adventure {
+
+namespace {
+
+const uint64_t kOffsetBasis = 0xCBF29CE484222325ULL;
+const uint64_t kPrime = 0x100000001B3ULL;
+
+}   // namespace
+
+Checksum::Checksum() : value_(kOffsetBasis) {}
+
+uint64_t Checksum::GetValue() const { return value_; }
+
+void Checksum::Add(uint64_t value) {
+  for (size_t byte = 0; byte < sizeof(value); ++byte) {
+    value_ ^= (value >> (8 * byte)) & 0xFF;
+    value_ *= kPrime;
+  }
+}
+
+void Checksum::Add(const std::string& text) {
+  // The length keeps adjacent strings from hashing the same when split
+  // differently (e.g. "AB" + "C" and "A" + "BC")
+  Add((uint64_t)text.size());
+
+  for (char character : text) {
+    value_ ^= (uint8_t)character;
+    value_ *= kPrime;
+  }
+}
+
+void Checksum::Add(const Weapon& weapon) {
+  Add(weapon.GetName());
+  Add(weapon.GetNickname());
+  Add((uint64_t)weapon.GetStrength());
+  Add((uint64_t)weapon.GetCriticalChance());
+}
+
+void Checksum::Add(const Enemy& enemy) {
+  Add(enemy.GetName());
+  Add(enemy.GetNickname());
+  Add((uint64_t)enemy.GetHealth());
+  Add((uint64_t)enemy.GetStrength());
+  Add((uint64_t)enemy.GetCriticalChance());
+}
+
+void Checksum::Add(const Door& door) {
+  Add(door.GetDirection());
+  Add(door.GetAdjacentRoom());
+  Add((uint64_t)door.IsLocked());
+}
+
+void Checksum::Add(const Room& room) {
+  Add(room.GetName());
+  Add(room.GetNickname());
+
+  Add((uint64_t)room.GetDoors().size());
+  for (const Door& door : room.GetDoors()) {
+    Add(door);
+  }
+
+  Add((uint64_t)room.GetEnemies().size());
+  for (const Enemy& enemy : room.GetEnemies()) {
+    Add(enemy);
+  }
+
+  Add((uint64_t)room.GetWeapons().size());
+  for (const Weapon& weapon : room.GetWeapons()) {
+    Add(weapon);
+  }
+
+  Add((uint64_t)room.GetNumberOfKeys());
+}
+
+void Checksum::Add(const Player& player) {
+  Add(player.GetCurrentLocation());
+  Add((uint64_t)player.GetHealth());
+  Add((uint64_t)player.GetMaxHealth());
+  Add((uint64_t)player.GetNumberOfKeys());
+
+  Add((uint64_t)player.GetWeapons().size());
+  for (const Weapon& weapon : player.GetWeapons()) {
+    Add(weapon);
+  }
+}
+
+void Checksum::Add(const std::vector<Room>& map) {
+  Add((uint64_t)map.size());
+
+  for (const Room& room : map) {
+    Add(room);
+  }
+}
+
+void Checksum::Add(const CopyOnWriteMap& map) {
+  Add((uint64_t)map.size());
+
+  for (const Room& room : map) {
+    Add(room);
+  }
+}
+
+}   // namespace adventure
@@ -0,0 +1,176 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "serialization/replay_log.h"
+
+#include "serialization/checksum.h"
+#include "serialization/varint.h"
+
+namespace adventure {
+
+namespace {
+
+const char kMagic[] = "ADVR";
+const size_t kMagicSize = 4;
+const uint64_t kVersion = 1;
+
+// Commands are written shifted up by one so that zero can mark the end
+const uint64_t kEndMarker = 0;
+const uint64_t kMaxCommand = (uint64_t)Command::kRedo;
+
+}   // namespace
+
+ReplayLog::ReplayLog()
+    : seed_(0), dungeon_checksum_(0), final_checksum_(0), entries_() {}
+
+ReplayLog::ReplayLog(uint64_t seed, uint64_t dungeon_checksum)
+    : seed_(seed), dungeon_checksum_(dungeon_checksum), final_checksum_(0),
+      entries_() {}
+
+uint64_t ReplayLog::GetSeed() const { return seed_; }
+
+uint64_t ReplayLog::GetDungeonChecksum() const { return dungeon_checksum_; }
+
+uint64_t ReplayLog::GetFinalChecksum() const { return final_checksum_; }
+
+const std::vector<ReplayEntry> &ReplayLog::GetEntries() const {
+  return entries_;
+}
+
+void ReplayLog::SetFinalChecksum(uint64_t final_checksum) {
+  final_checksum_ = final_checksum;
+}
+
+void ReplayLog::Record(Command command, const std::string& qualifier,
+                       uint32_t elapsed_ms) {
+  entries_.push_back(ReplayEntry{command, elapsed_ms, qualifier});
+}
+
+bool ReplayLog::Replay(Engine& engine) const {
+  Checksum checksum;
+  checksum.Add(engine.GetMap());
+
+  if (checksum.GetValue() != dungeon_checksum_) {
+    throw std::invalid_argument("DUNGEON DOES NOT MATCH LOG");
+  }
+
+  engine.SetRandomState(seed_);
+
+  for (const ReplayEntry& entry : entries_) {
+    engine.Execute(entry.command, entry.qualifier);
+  }
+
+  return engine.ComputeChecksum() == final_checksum_;
+}
+
+std::ostream &operator<<(std::ostream& os, const ReplayLog& log) {
+  os.write(kMagic, kMagicSize);
+  WriteVarint(os, kVersion);
+  WriteVarint(os, log.seed_);
+  WriteVarint(os, log.dungeon_checksum_);
+
+  for (const ReplayEntry& entry : log.entries_) {
+    WriteVarint(os, (uint64_t)entry.command + 1);
+    WriteVarint(os, entry.elapsed_ms);
+    WriteVarintString(os, entry.qualifier);
+  }
+
+  WriteVarint(os, kEndMarker);
+  WriteVarint(os, log.final_checksum_);
+
+  return os;
+}
+
+std::istream &operator>>(std::istream& is, ReplayLog& log) {
+  char magic[kMagicSize];
+
+  if (!is.read(magic, kMagicSize) ||
+      std::string(magic, kMagicSize) != kMagic ||
+      ReadVarint(is) != kVersion) {
+    throw std::invalid_argument("INVALID FILE");
+  }
+
+  log.seed_ = ReadVarint(is);
+  log.dungeon_checksum_ = ReadVarint(is);
+  log.entries_.clear();
+
+  uint64_t command = ReadVarint(is);
+  while (command != kEndMarker) {
+    if (command - 1 > kMaxCommand) {
+      throw std::invalid_argument("INVALID COMMAND");
+    }
+
+    ReplayEntry entry;
+    entry.command = (Command)(command - 1);
+    entry.elapsed_ms = (uint32_t)ReadVarint(is);
+    entry.qualifier = ReadVarintString(is);
+    log.entries_.push_back(entry);
+
+    command = ReadVarint(is);
+  }
+
+  log.final_checksum_ = ReadVarint(is);
+
+  return is;
+}
+
+ReplayReader::ReplayReader(const uint8_t* data, size_t size)
+    : data_(data), size_(size), position_(0), final_checksum_(0) {}
+
+bool ReplayReader::HasNext() const { return position_ < size_; }
+
+void ReplayReader::Begin(uint64_t& seed, uint64_t& dungeon_checksum) {
+  if (size_ - position_ < kMagicSize ||
+      std::string((const char*)data_ + position_, kMagicSize) != kMagic) {
+    throw std::invalid_argument("INVALID FILE");
+  }
+  position_ += kMagicSize;
+
+  if (ReadVarint() != kVersion) {
+    throw std::invalid_argument("INVALID FILE");
+  }
+
+  seed = ReadVarint();
+  dungeon_checksum = ReadVarint();
+}
+
+bool ReplayReader::Next(ReplayEntry& entry) {
+  uint64_t command = ReadVarint();
+
+  if (command == kEndMarker) {
+    final_checksum_ = ReadVarint();
+    return false;
+  } else if (command - 1 > kMaxCommand) {
+    throw std::invalid_argument("INVALID COMMAND");
+  }
+
+  entry.command = (Command)(command - 1);
+  entry.elapsed_ms = (uint32_t)ReadVarint();
+
+  uint64_t qualifier_size = ReadVarint();
+  if (qualifier_size > size_ - position_) {
+    throw std::invalid_argument("STRING CUT SHORT");
+  }
+  entry.qualifier.assign((const char*)data_ + position_,
+                         (size_t)qualifier_size);
+  position_ += (size_t)qualifier_size;
+
+  return true;
+}
+
+uint64_t ReplayReader::GetFinalChecksum() const { return final_checksum_; }
+
+size_t ReplayReader::GetPosition() const { return position_; }
+
+uint64_t ReplayReader::ReadVarint() {
+  uint64_t value = 0;
+  size_t size = DecodeVarint(data_ + position_, size_ - position_, value);
+
+  if (size == 0) {
+    throw std::invalid_argument("VARINT CUT SHORT");
+  }
+
+  position_ += size;
+  return value;
+}
+
+}   // namespace adventure
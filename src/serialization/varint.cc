@@ -0,0 +1,78 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "serialization/varint.h"
+
+#include <stdexcept>
+
+namespace adventure {
+
+size_t EncodeVarint(uint64_t value, uint8_t* buffer) {
+  size_t size = 0;
+
+  while (value >= 0x80) {
+    buffer[size++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  buffer[size++] = (uint8_t)value;
+
+  return size;
+}
+
+size_t DecodeVarint(const uint8_t* buffer, size_t size, uint64_t& value) {
+  value = 0;
+
+  for (size_t index = 0; index < size && index < kMaxVarintSize; ++index) {
+    value |= (uint64_t)(buffer[index] & 0x7F) << (7 * index);
+
+    if ((buffer[index] & 0x80) == 0) {
+      return index + 1;
+    }
+  }
+
+  return 0;
+}
+
+void WriteVarint(std::ostream& os, uint64_t value) {
+  uint8_t buffer[kMaxVarintSize];
+  size_t size = EncodeVarint(value, buffer);
+
+  os.write((const char*)buffer, (std::streamsize)size);
+}
+
+uint64_t ReadVarint(std::istream& is) {
+  uint64_t value = 0;
+
+  for (size_t index = 0; index < kMaxVarintSize; ++index) {
+    int byte = is.get();
+
+    if (byte == std::char_traits<char>::eof()) {
+      throw std::invalid_argument("VARINT CUT SHORT");
+    }
+
+    value |= (uint64_t)(byte & 0x7F) << (7 * index);
+
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+
+  throw std::invalid_argument("VARINT TOO LONG");
+}
+
+void WriteVarintString(std::ostream& os, const std::string& text) {
+  WriteVarint(os, text.size());
+  os.write(text.data(), (std::streamsize)text.size());
+}
+
+std::string ReadVarintString(std::istream& is) {
+  size_t size = (size_t)ReadVarint(is);
+  std::string text(size, '\0');
+
+  if (size > 0 && !is.read(&text[0], (std::streamsize)size)) {
+    throw std::invalid_argument("STRING CUT SHORT");
+  }
+
+  return text;
+}
+
+}   // namespace adventure
@@ -0,0 +1,302 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "server/game_server.h"
+
+#include "server/protocol.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace adventure {
+
+GameServer::GameServer(const std::string& socket_path,
+                       std::shared_ptr<const Dungeon> dungeon,
+                       const Player& player, size_t number_of_threads)
+    : socket_path_(socket_path), dungeon_(std::move(dungeon)), player_(player),
+      number_of_threads_(number_of_threads), listen_fd_(-1), wake_fd_(-1),
+      is_running_(false), next_session_(0), replication_(), statistics_() {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+
+  if (number_of_threads_ == 0) {
+    throw std::invalid_argument("NUMBER OF THREADS EQUALS ZERO");
+  } else if (socket_path_.size() >= sizeof(address.sun_path)) {
+    throw std::invalid_argument("SOCKET PATH TOO LONG");
+  }
+  std::memcpy(address.sun_path, socket_path_.c_str(), socket_path_.size());
+
+  listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+  unlink(socket_path_.c_str());
+  if (listen_fd_ < 0 || wake_fd_ < 0 ||
+      bind(listen_fd_, (sockaddr*)&address, sizeof(address)) < 0 ||
+      listen(listen_fd_, SOMAXCONN) < 0) {
+    if (listen_fd_ >= 0) {
+      close(listen_fd_);
+    }
+    if (wake_fd_ >= 0) {
+      close(wake_fd_);
+    }
+    throw std::invalid_argument("SOCKET COULD NOT BE BOUND");
+  }
+}
+
+GameServer::~GameServer() {
+  Stop();
+
+  close(listen_fd_);
+  close(wake_fd_);
+  unlink(socket_path_.c_str());
+}
+
+void GameServer::Run() {
+  is_running_ = true;
+
+  std::vector<std::thread> threads;
+  for (size_t thread = 1; thread < number_of_threads_; ++thread) {
+    threads.emplace_back(&GameServer::RunEventLoop, this);
+  }
+
+  RunEventLoop();
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+void GameServer::Stop() {
+  is_running_ = false;
+
+  // The eventfd is never read, so one write wakes every loop for good
+  uint64_t one = 1;
+  ssize_t written = write(wake_fd_, &one, sizeof(one));
+  (void)written;
+}
+
+void GameServer::ReplicateTo(
+    std::shared_ptr<ReplicationPrimary> replication) {
+  replication_ = std::move(replication);
+}
+
+void GameServer::ReportTo(std::shared_ptr<GameStatistics> statistics) {
+  statistics_ = std::move(statistics);
+}
+
+void GameServer::RunEventLoop() {
+  int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd < 0) {
+    return;
+  }
+
+  // Every loop waits on the same listening socket, and EPOLLEXCLUSIVE wakes
+  // only one of them per incoming connection
+  epoll_event event;
+  std::memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN | EPOLLEXCLUSIVE;
+  event.data.fd = listen_fd_;
+  epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd_, &event);
+
+  event.events = EPOLLIN;
+  event.data.fd = wake_fd_;
+  epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd_, &event);
+
+  std::unordered_map<int, std::unique_ptr<Connection>> connections;
+  std::vector<epoll_event> events((size_t)kMaxEvents);
+
+  while (is_running_) {
+    int ready = epoll_wait(epoll_fd, events.data(), kMaxEvents, -1);
+
+    for (int index = 0; index < ready; ++index) {
+      int fd = events[(size_t)index].data.fd;
+      uint32_t flags = events[(size_t)index].events;
+
+      if (fd == wake_fd_) {
+        continue;
+      } else if (fd == listen_fd_) {
+        AcceptConnections(epoll_fd, connections);
+        continue;
+      }
+
+      std::unordered_map<int, std::unique_ptr<Connection>>::iterator found =
+          connections.find(fd);
+      if (found == connections.end()) {
+        continue;
+      }
+
+      Connection& connection = *found->second;
+      bool is_open = (flags & (EPOLLERR | EPOLLHUP)) == 0 ||
+                     (flags & EPOLLIN) != 0;
+
+      if (is_open && (flags & EPOLLIN) != 0) {
+        is_open = ReadRequests(connection);
+      }
+      if (is_open && !connection.output.empty()) {
+        is_open = WriteUpdates(connection);
+      }
+
+      if (is_open) {
+        UpdateInterest(epoll_fd, connection);
+      } else {
+        if (replication_ != nullptr) {
+          replication_->EndSession(connection.session);
+        }
+
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(found);
+      }
+    }
+  }
+
+  for (std::pair<const int, std::unique_ptr<Connection>>& connection :
+       connections) {
+    close(connection.first);
+  }
+  close(epoll_fd);
+}
+
+void GameServer::AcceptConnections(
+    int epoll_fd,
+    std::unordered_map<int, std::unique_ptr<Connection>>& connections) {
+  while (true) {
+    int fd = accept4(listen_fd_, nullptr, nullptr,
+                     SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      return;
+    }
+
+    std::unique_ptr<Connection> connection(new Connection{
+        fd, next_session_++, Engine(player_, dungeon_), std::string(),
+        std::string(), 0, true, false});
+    if (statistics_ != nullptr) {
+      connection->engine.ReportTo(statistics_, connection->session);
+    }
+    if (replication_ != nullptr) {
+      replication_->StartSession(connection->session, connection->engine);
+    }
+
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+
+    connections[fd] = std::move(connection);
+  }
+}
+
+bool GameServer::ReadRequests(Connection& connection) {
+  char chunk[16 * 1024];
+
+  while (connection.output.size() - connection.output_offset <
+         kHighWaterMark) {
+    ssize_t received = read(connection.fd, chunk, sizeof(chunk));
+
+    if (received == 0) {
+      return false;
+    } else if (received < 0) {
+      return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    }
+
+    connection.input.append(chunk, (size_t)received);
+
+    // Executes every complete Request that has arrived, in order, so that
+    // clients can pipeline many Requests without waiting for each reply
+    size_t consumed = 0;
+    Request request;
+    StateUpdate update;
+
+    try {
+      size_t frame_size = 0;
+      while ((frame_size = DecodeRequest(connection.input.data() + consumed,
+                                         connection.input.size() - consumed,
+                                         request)) > 0) {
+        consumed += frame_size;
+
+        try {
+          connection.engine.Execute(request.command, request.qualifier);
+        } catch (const std::exception& error) {
+          connection.engine.SetMessage(error.what());
+        }
+        if (replication_ != nullptr) {
+          replication_->Replicate(connection.session, request.command,
+                                  request.qualifier, connection.engine);
+        }
+
+        FillStateUpdate(request.id, connection.engine, update);
+        EncodeStateUpdate(update, connection.output);
+      }
+    } catch (const std::invalid_argument&) {
+      // A malformed frame leaves the stream unusable
+      return false;
+    }
+
+    connection.input.erase(0, consumed);
+  }
+
+  return true;
+}
+
+bool GameServer::WriteUpdates(Connection& connection) {
+  while (connection.output_offset < connection.output.size()) {
+    ssize_t sent = send(connection.fd,
+                        connection.output.data() + connection.output_offset,
+                        connection.output.size() - connection.output_offset,
+                        MSG_NOSIGNAL);
+
+    if (sent < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        return false;
+      }
+
+      // Drops the sent prefix so a slow reader does not pin it in memory
+      if (connection.output_offset >= kLowWaterMark) {
+        connection.output.erase(0, connection.output_offset);
+        connection.output_offset = 0;
+      }
+      return true;
+    }
+
+    connection.output_offset += (size_t)sent;
+  }
+
+  connection.output.clear();
+  connection.output_offset = 0;
+
+  return true;
+}
+
+void GameServer::UpdateInterest(int epoll_fd, Connection& connection) {
+  size_t pending = connection.output.size() - connection.output_offset;
+
+  bool should_read = connection.is_reading ? pending < kHighWaterMark
+                                           : pending < kLowWaterMark;
+  bool should_write = pending > 0;
+
+  if (should_read == connection.is_reading &&
+      should_write == connection.is_writing) {
+    return;
+  }
+
+  connection.is_reading = should_read;
+  connection.is_writing = should_write;
+
+  epoll_event event;
+  std::memset(&event, 0, sizeof(event));
+  event.events = (should_read ? (uint32_t)EPOLLIN : 0u) |
+                 (should_write ? (uint32_t)EPOLLOUT : 0u);
+  event.data.fd = connection.fd;
+  epoll_ctl(epoll_fd, EPOLL_CTL_MOD, connection.fd, &event);
+}
+
+}   // namespace adventure
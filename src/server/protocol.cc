@@ -0,0 +1,231 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "server/protocol.h"
+
+#include "serialization/varint.h"
+
+#include <stdexcept>
+
+namespace adventure {
+
+namespace {
+
+const uint64_t kMaxCommand = (uint64_t)Command::kRedo;
+const uint64_t kMaxReplicationType =
+    (uint64_t)ReplicationType::kResyncRequested;
+
+void AppendVarint(uint64_t value, std::string& buffer) {
+  uint8_t bytes[kMaxVarintSize];
+  size_t size = EncodeVarint(value, bytes);
+
+  buffer.append((const char*)bytes, size);
+}
+
+void AppendString(const std::string& text, std::string& buffer) {
+  AppendVarint(text.size(), buffer);
+  buffer.append(text);
+}
+
+/**
+ * Reads fields out of a single frame payload, throwing if the payload ends
+ * before a field does.
+ */
+class PayloadReader {
+ public:
+  PayloadReader(const char* data, size_t size)
+      : data_((const uint8_t*)data), size_(size), position_(0) {}
+
+  uint64_t ReadVarint() {
+    uint64_t value = 0;
+    size_t read = DecodeVarint(data_ + position_, size_ - position_, value);
+
+    if (read == 0) {
+      throw std::invalid_argument("MALFORMED FRAME");
+    }
+
+    position_ += read;
+    return value;
+  }
+
+  void ReadString(std::string& text) {
+    uint64_t length = ReadVarint();
+
+    if (length > size_ - position_) {
+      throw std::invalid_argument("MALFORMED FRAME");
+    }
+
+    text.assign((const char*)data_ + position_, (size_t)length);
+    position_ += (size_t)length;
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t position_;
+};
+
+/**
+ * Finds the payload of the frame at the front of a buffer.
+ * @return The number of bytes in the whole frame, or 0 if it is incomplete
+ */
+size_t FindPayload(const char* data, size_t size, size_t max_size,
+                   size_t& payload_offset, size_t& payload_size) {
+  uint64_t length = 0;
+  size_t header = DecodeVarint((const uint8_t*)data, size, length);
+
+  if (header == 0) {
+    if (size >= kMaxVarintSize) {
+      throw std::invalid_argument("MALFORMED FRAME");
+    }
+    return 0;
+  }
+
+  if (length > max_size) {
+    throw std::invalid_argument("FRAME TOO LARGE");
+  }
+
+  if (size - header < length) {
+    return 0;
+  }
+
+  payload_offset = header;
+  payload_size = (size_t)length;
+
+  return header + (size_t)length;
+}
+
+void AppendFrame(const std::string& payload, std::string& buffer) {
+  AppendVarint(payload.size(), buffer);
+  buffer.append(payload);
+}
+
+}   // namespace
+
+void EncodeRequest(const Request& request, std::string& buffer) {
+  std::string payload;
+
+  AppendVarint(request.id, payload);
+  AppendVarint((uint64_t)request.command, payload);
+  AppendString(request.qualifier, payload);
+
+  AppendFrame(payload, buffer);
+}
+
+size_t DecodeRequest(const char* data, size_t size, Request& request) {
+  size_t payload_offset = 0;
+  size_t payload_size = 0;
+  size_t frame_size = FindPayload(data, size, kMaxFrameSize, payload_offset,
+                                  payload_size);
+
+  if (frame_size == 0) {
+    return 0;
+  }
+
+  PayloadReader reader(data + payload_offset, payload_size);
+  request.id = reader.ReadVarint();
+
+  uint64_t command = reader.ReadVarint();
+  if (command > kMaxCommand) {
+    throw std::invalid_argument("INVALID COMMAND");
+  }
+  request.command = (Command)command;
+
+  reader.ReadString(request.qualifier);
+
+  return frame_size;
+}
+
+void EncodeStateUpdate(const StateUpdate& update, std::string& buffer) {
+  std::string payload;
+
+  AppendVarint(update.id, payload);
+  AppendString(update.message, payload);
+  AppendString(update.location, payload);
+  AppendVarint(update.health, payload);
+  AppendVarint(update.number_of_keys, payload);
+  AppendVarint(update.number_of_weapons, payload);
+
+  AppendFrame(payload, buffer);
+}
+
+size_t DecodeStateUpdate(const char* data, size_t size, StateUpdate& update) {
+  size_t payload_offset = 0;
+  size_t payload_size = 0;
+  size_t frame_size = FindPayload(data, size, kMaxFrameSize, payload_offset,
+                                  payload_size);
+
+  if (frame_size == 0) {
+    return 0;
+  }
+
+  PayloadReader reader(data + payload_offset, payload_size);
+  update.id = reader.ReadVarint();
+  reader.ReadString(update.message);
+  reader.ReadString(update.location);
+  update.health = reader.ReadVarint();
+  update.number_of_keys = reader.ReadVarint();
+  update.number_of_weapons = reader.ReadVarint();
+
+  return frame_size;
+}
+
+void EncodeReplicationFrame(const ReplicationFrame& frame,
+                            std::string& buffer) {
+  std::string payload;
+
+  AppendVarint((uint64_t)frame.type, payload);
+  AppendVarint(frame.session, payload);
+  AppendVarint(frame.sequence, payload);
+  AppendVarint(frame.value, payload);
+  AppendVarint((uint64_t)frame.command, payload);
+  AppendString(frame.data, payload);
+
+  AppendFrame(payload, buffer);
+}
+
+size_t DecodeReplicationFrame(const char* data, size_t size,
+                              ReplicationFrame& frame) {
+  size_t payload_offset = 0;
+  size_t payload_size = 0;
+  size_t frame_size = FindPayload(data, size, kMaxReplicationFrameSize,
+                                  payload_offset, payload_size);
+
+  if (frame_size == 0) {
+    return 0;
+  }
+
+  PayloadReader reader(data + payload_offset, payload_size);
+
+  uint64_t type = reader.ReadVarint();
+  if (type > kMaxReplicationType) {
+    throw std::invalid_argument("INVALID FRAME TYPE");
+  }
+  frame.type = (ReplicationType)type;
+
+  frame.session = reader.ReadVarint();
+  frame.sequence = reader.ReadVarint();
+  frame.value = reader.ReadVarint();
+
+  uint64_t command = reader.ReadVarint();
+  if (command > kMaxCommand) {
+    throw std::invalid_argument("INVALID COMMAND");
+  }
+  frame.command = (Command)command;
+
+  reader.ReadString(frame.data);
+
+  return frame_size;
+}
+
+void FillStateUpdate(uint64_t id, const Engine& engine, StateUpdate& update) {
+  const Player& player = engine.GetPlayer();
+
+  update.id = id;
+  update.message = engine.GetMessage();
+  update.location = player.GetCurrentLocation();
+  update.health = player.GetHealth();
+  update.number_of_keys = player.GetNumberOfKeys();
+  update.number_of_weapons = player.GetWeapons().size();
+}
+
+}   // namespace adventure
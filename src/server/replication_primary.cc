@@ -0,0 +1,250 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "server/replication_primary.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace adventure {
+
+uint64_t GetSteadyMicroseconds() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ReplicationPrimary::ReplicationPrimary(const std::string& socket_path,
+                                       size_t hash_interval)
+    : hash_interval_(hash_interval), fd_(-1), pending_(), sequences_(),
+      resync_requests_(), is_stopping_(false), is_connected_(false),
+      number_of_queued_(0), number_of_sent_(0), number_of_acknowledged_(0) {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+
+  if (hash_interval_ == 0) {
+    throw std::invalid_argument("HASH INTERVAL EQUALS ZERO");
+  } else if (socket_path.size() >= sizeof(address.sun_path)) {
+    throw std::invalid_argument("SOCKET PATH TOO LONG");
+  }
+  std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size());
+
+  fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd_ < 0 || connect(fd_, (sockaddr*)&address, sizeof(address)) < 0) {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+    throw std::invalid_argument("SOCKET COULD NOT BE CONNECTED");
+  }
+
+  is_connected_ = true;
+  sender_ = std::thread(&ReplicationPrimary::Run, this);
+}
+
+ReplicationPrimary::~ReplicationPrimary() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopping_ = true;
+  }
+  queued_.notify_one();
+
+  sender_.join();
+  close(fd_);
+}
+
+void ReplicationPrimary::StartSession(uint64_t session,
+                                      const Engine& engine) {
+  if (!is_connected_) {
+    return;
+  }
+
+  std::ostringstream snapshot;
+  snapshot << engine;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    sequences_[session] = 0;
+    Queue(ReplicationFrame{ReplicationType::kSessionStarted, session, 0, 0,
+                           Command::kFight, snapshot.str()});
+  }
+  queued_.notify_one();
+}
+
+void ReplicationPrimary::Replicate(uint64_t session, Command command,
+                                   const std::string& qualifier,
+                                   const Engine& engine) {
+  if (!is_connected_) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  uint64_t sequence = ++sequences_[session];
+  Queue(ReplicationFrame{ReplicationType::kCommand, session, sequence,
+                         GetSteadyMicroseconds(), command, qualifier});
+
+  bool is_resync_requested = resync_requests_.erase(session) > 0;
+  bool is_hash_due = sequence % hash_interval_ == 0;
+  lock.unlock();
+
+  // The checksum and snapshot are computed on the session's own thread,
+  // outside the lock, so sessions only contend on the queue itself
+  ReplicationFrame frame{ReplicationType::kStateHash, session, sequence, 0,
+                         command, std::string()};
+
+  if (is_resync_requested) {
+    std::ostringstream snapshot;
+    snapshot << engine;
+
+    frame.type = ReplicationType::kSessionStarted;
+    frame.data = snapshot.str();
+  } else if (is_hash_due) {
+    frame.value = engine.ComputeChecksum();
+  } else {
+    queued_.notify_one();
+    return;
+  }
+
+  lock.lock();
+  Queue(frame);
+  lock.unlock();
+
+  queued_.notify_one();
+}
+
+void ReplicationPrimary::EndSession(uint64_t session) {
+  if (!is_connected_) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    sequences_.erase(session);
+    resync_requests_.erase(session);
+    Queue(ReplicationFrame{ReplicationType::kSessionEnded, session, 0, 0,
+                           Command::kFight, std::string()});
+  }
+  queued_.notify_one();
+}
+
+bool ReplicationPrimary::IsConnected() const { return is_connected_; }
+
+uint64_t ReplicationPrimary::GetNumberOfSentFrames() const {
+  return number_of_sent_;
+}
+
+uint64_t ReplicationPrimary::GetNumberOfAcknowledgedFrames() const {
+  return number_of_acknowledged_;
+}
+
+uint64_t ReplicationPrimary::GetLag() const {
+  return number_of_queued_ - number_of_acknowledged_;
+}
+
+void ReplicationPrimary::Queue(const ReplicationFrame& frame) {
+  EncodeReplicationFrame(frame, pending_);
+  ++number_of_queued_;
+}
+
+bool ReplicationPrimary::ReadReplies(std::string& input) {
+  char chunk[4096];
+
+  while (true) {
+    ssize_t received = recv(fd_, chunk, sizeof(chunk), MSG_DONTWAIT);
+
+    if (received == 0) {
+      return false;
+    } else if (received < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        return false;
+      }
+      break;
+    }
+
+    input.append(chunk, (size_t)received);
+  }
+
+  size_t consumed = 0;
+  ReplicationFrame frame;
+
+  try {
+    size_t frame_size = 0;
+    while ((frame_size = DecodeReplicationFrame(input.data() + consumed,
+                                                input.size() - consumed,
+                                                frame)) > 0) {
+      consumed += frame_size;
+
+      if (frame.type == ReplicationType::kAcknowledgement) {
+        number_of_acknowledged_ = frame.sequence;
+      } else if (frame.type == ReplicationType::kResyncRequested) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (sequences_.count(frame.session) > 0) {
+          resync_requests_.insert(frame.session);
+        }
+      }
+    }
+  } catch (const std::invalid_argument&) {
+    return false;
+  }
+
+  input.erase(0, consumed);
+  return true;
+}
+
+void ReplicationPrimary::Run() {
+  std::string input;
+  std::string output;
+
+  while (true) {
+    uint64_t number_of_frames;
+    bool is_stopping;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+
+      // Wakes up now and then even when idle, to pick up acknowledgements
+      queued_.wait_for(lock, kIdleInterval, [this] {
+        return is_stopping_ || !pending_.empty();
+      });
+
+      output.swap(pending_);
+      number_of_frames = number_of_queued_;
+      is_stopping = is_stopping_;
+    }
+
+    size_t offset = 0;
+    while (offset < output.size()) {
+      ssize_t sent = send(fd_, output.data() + offset, output.size() - offset,
+                          MSG_NOSIGNAL);
+
+      if (sent < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        is_connected_ = false;
+        return;
+      }
+      offset += (size_t)sent;
+    }
+    output.clear();
+    number_of_sent_ = number_of_frames;
+
+    if (!ReadReplies(input)) {
+      is_connected_ = false;
+      return;
+    }
+
+    if (is_stopping) {
+      return;
+    }
+  }
+}
+
+}   // namespace adventure
@@ -0,0 +1,269 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "server/replication_standby.h"
+
+#include "server/replication_primary.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace adventure {
+
+ReplicationStandby::ReplicationStandby(const std::string& socket_path,
+                                       std::shared_ptr<const Dungeon> dungeon)
+    : socket_path_(socket_path), dungeon_(std::move(dungeon)), listen_fd_(-1),
+      wake_fd_(-1), is_running_(true), engines_(), diverged_sessions_(),
+      number_of_sessions_(0), number_of_applied_(0), number_of_hash_checks_(0),
+      number_of_divergences_(0), last_lag_(0), max_lag_(0) {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+
+  if (socket_path_.size() >= sizeof(address.sun_path)) {
+    throw std::invalid_argument("SOCKET PATH TOO LONG");
+  }
+  std::memcpy(address.sun_path, socket_path_.c_str(), socket_path_.size());
+
+  listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+  unlink(socket_path_.c_str());
+  if (listen_fd_ < 0 || wake_fd_ < 0 ||
+      bind(listen_fd_, (sockaddr*)&address, sizeof(address)) < 0 ||
+      listen(listen_fd_, 1) < 0) {
+    if (listen_fd_ >= 0) {
+      close(listen_fd_);
+    }
+    if (wake_fd_ >= 0) {
+      close(wake_fd_);
+    }
+    throw std::invalid_argument("SOCKET COULD NOT BE BOUND");
+  }
+}
+
+ReplicationStandby::~ReplicationStandby() {
+  close(listen_fd_);
+  close(wake_fd_);
+  unlink(socket_path_.c_str());
+}
+
+bool ReplicationStandby::Run() {
+  pollfd fds[2];
+  fds[0].fd = listen_fd_;
+  fds[0].events = POLLIN;
+  fds[1].fd = wake_fd_;
+  fds[1].events = POLLIN;
+
+  while (is_running_) {
+    fds[0].revents = 0;
+    fds[1].revents = 0;
+
+    if (poll(fds, 2, -1) < 0 && errno != EINTR) {
+      return false;
+    }
+    if (!is_running_ || (fds[0].revents & POLLIN) == 0) {
+      continue;
+    }
+
+    int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0) {
+      continue;
+    }
+
+    bool is_disconnected = Serve(fd);
+    close(fd);
+
+    return is_disconnected;
+  }
+
+  return false;
+}
+
+void ReplicationStandby::Stop() {
+  is_running_ = false;
+
+  // The eventfd is never read, so one write wakes Run for good
+  uint64_t one = 1;
+  ssize_t written = write(wake_fd_, &one, sizeof(one));
+  (void)written;
+}
+
+std::map<uint64_t, Engine> ReplicationStandby::TakeOver() {
+  std::map<uint64_t, Engine> engines;
+  engines.swap(engines_);
+  diverged_sessions_.clear();
+  number_of_sessions_ = 0;
+
+  return engines;
+}
+
+size_t ReplicationStandby::GetNumberOfSessions() const {
+  return number_of_sessions_;
+}
+
+uint64_t ReplicationStandby::GetNumberOfAppliedFrames() const {
+  return number_of_applied_;
+}
+
+uint64_t ReplicationStandby::GetNumberOfHashChecks() const {
+  return number_of_hash_checks_;
+}
+
+uint64_t ReplicationStandby::GetNumberOfDivergences() const {
+  return number_of_divergences_;
+}
+
+uint64_t ReplicationStandby::GetLastLag() const { return last_lag_; }
+
+uint64_t ReplicationStandby::GetMaxLag() const { return max_lag_; }
+
+void ReplicationStandby::Apply(const ReplicationFrame& frame,
+                               std::string& output) {
+  std::map<uint64_t, Engine>::iterator found = engines_.find(frame.session);
+
+  switch (frame.type) {
+    case ReplicationType::kSessionStarted: {
+      Engine engine(Player(), dungeon_);
+      std::istringstream snapshot(frame.data);
+      snapshot >> engine;
+
+      if (found != engines_.end()) {
+        engines_.erase(found);
+      }
+      engines_.emplace(frame.session, std::move(engine));
+      diverged_sessions_.erase(frame.session);
+      break;
+    }
+    case ReplicationType::kCommand: {
+      if (found == engines_.end()) {
+        break;
+      }
+
+      // Errors are reported through the message exactly as the primary's
+      // server does, so the two Engines stay identical
+      try {
+        found->second.Execute(frame.command, frame.data);
+      } catch (const std::exception& error) {
+        found->second.SetMessage(error.what());
+      }
+
+      uint64_t now = GetSteadyMicroseconds();
+      uint64_t lag = now > frame.value ? now - frame.value : 0;
+      last_lag_ = lag;
+      if (lag > max_lag_) {
+        max_lag_ = lag;
+      }
+      break;
+    }
+    case ReplicationType::kStateHash: {
+      // A session waiting for its new snapshot has already been reported
+      if (found == engines_.end() ||
+          diverged_sessions_.count(frame.session) > 0) {
+        break;
+      }
+
+      ++number_of_hash_checks_;
+      if (found->second.ComputeChecksum() != frame.value) {
+        ++number_of_divergences_;
+        diverged_sessions_.insert(frame.session);
+        EncodeReplicationFrame(
+            ReplicationFrame{ReplicationType::kResyncRequested, frame.session,
+                             frame.sequence, 0, Command::kFight,
+                             std::string()},
+            output);
+      }
+      break;
+    }
+    case ReplicationType::kSessionEnded:
+      engines_.erase(frame.session);
+      diverged_sessions_.erase(frame.session);
+      break;
+    default:
+      throw std::invalid_argument("INVALID FRAME TYPE");
+  }
+
+  number_of_sessions_ = engines_.size();
+  ++number_of_applied_;
+}
+
+bool ReplicationStandby::Serve(int fd) {
+  pollfd fds[2];
+  fds[0].fd = fd;
+  fds[0].events = POLLIN;
+  fds[1].fd = wake_fd_;
+  fds[1].events = POLLIN;
+
+  char chunk[64 * 1024];
+  std::string input;
+  std::string output;
+
+  while (is_running_) {
+    fds[0].revents = 0;
+    fds[1].revents = 0;
+
+    if (poll(fds, 2, -1) < 0 && errno != EINTR) {
+      return true;
+    }
+    if (!is_running_) {
+      break;
+    } else if (fds[0].revents == 0) {
+      continue;
+    }
+
+    ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+    if (received == 0) {
+      return true;
+    } else if (received < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return true;
+    }
+
+    input.append(chunk, (size_t)received);
+
+    size_t consumed = 0;
+    ReplicationFrame frame;
+
+    try {
+      size_t frame_size = 0;
+      while ((frame_size = DecodeReplicationFrame(input.data() + consumed,
+                                                  input.size() - consumed,
+                                                  frame)) > 0) {
+        consumed += frame_size;
+        Apply(frame, output);
+      }
+    } catch (const std::invalid_argument&) {
+      // A malformed frame leaves the stream unusable
+      return true;
+    }
+
+    input.erase(0, consumed);
+
+    // Replies are sent without blocking, so a primary that is busy sending
+    // never stalls the standby, and whatever does not fit waits for the next
+    // batch
+    EncodeReplicationFrame(
+        ReplicationFrame{ReplicationType::kAcknowledgement, 0,
+                         number_of_applied_, 0, Command::kFight,
+                         std::string()},
+        output);
+    ssize_t sent = send(fd, output.data(), output.size(),
+                        MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (sent > 0) {
+      output.erase(0, (size_t)sent);
+    }
+  }
+
+  return false;
+}
+
+}   // namespace adventure
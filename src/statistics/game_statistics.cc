@@ -0,0 +1,140 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "statistics/game_statistics.h"
+
+#include "persistence/write_ahead_log.h"
+
+#include <sstream>
+#include <stdexcept>
+
+namespace adventure {
+
+const size_t GameStatistics::kWinsCounter;
+
+GameStatistics::GameStatistics(const Dungeon& dungeon,
+                               size_t number_of_shards,
+                               size_t leaderboard_size)
+    : enemies_(ListEnemies(dungeon)), enemy_indices_(), archetype_indices_(),
+      rooms_(),
+      counters_(1 + enemies_.size() + dungeon.GetMap().size(),
+                number_of_shards),
+      win_commands_(number_of_shards),
+      fastest_wins_(leaderboard_size, number_of_shards) {
+  if (dungeon.GetMap().empty()) {
+    throw std::invalid_argument("DUNGEON MAP HAS NO ROOMS");
+  }
+
+  for (size_t enemy = 0; enemy < enemies_.size(); ++enemy) {
+    enemy_indices_.emplace(enemies_[enemy], enemy);
+  }
+  for (const Room& room : dungeon.GetMap()) {
+    rooms_.push_back(room.GetNickname());
+
+    for (const Enemy& enemy : room.GetEnemies()) {
+      archetype_indices_.emplace(&enemy.GetArchetype(),
+                                 enemy_indices_[enemy.GetNickname()]);
+    }
+  }
+}
+
+void GameStatistics::RecordKill(const EnemyArchetype& enemy) {
+  std::unordered_map<const EnemyArchetype*, size_t>::const_iterator index =
+      archetype_indices_.find(&enemy);
+
+  if (index != archetype_indices_.end()) {
+    counters_.Add(1 + index->second);
+  }
+}
+
+void GameStatistics::RecordDeath(size_t room) {
+  if (room >= rooms_.size()) {
+    throw std::invalid_argument("ROOM INDEX OUT OF RANGE");
+  }
+
+  counters_.Add(1 + enemies_.size() + room);
+}
+
+void GameStatistics::RecordWin(uint64_t id, uint64_t number_of_commands) {
+  counters_.Add(kWinsCounter);
+  win_commands_.Record(number_of_commands);
+  fastest_wins_.Submit(id, number_of_commands);
+}
+
+uint64_t GameStatistics::GetKills(const std::string& enemy) const {
+  std::unordered_map<std::string, size_t>::const_iterator index =
+      enemy_indices_.find(enemy);
+
+  if (index == enemy_indices_.end()) {
+    throw std::invalid_argument("ENEMY NOT FOUND");
+  }
+
+  return counters_.Get(1 + index->second);
+}
+
+uint64_t GameStatistics::GetDeaths(size_t room) const {
+  if (room >= rooms_.size()) {
+    throw std::invalid_argument("ROOM INDEX OUT OF RANGE");
+  }
+
+  return counters_.Get(1 + enemies_.size() + room);
+}
+
+uint64_t GameStatistics::GetWins() const {
+  return counters_.Get(kWinsCounter);
+}
+
+std::vector<uint64_t> GameStatistics::GetWinHistogram() const {
+  return win_commands_.GetCounts();
+}
+
+std::vector<LeaderboardEntry> GameStatistics::GetFastestWins() const {
+  return fastest_wins_.GetTop();
+}
+
+void GameStatistics::Export(const std::string& path) const {
+  std::ostringstream snapshot;
+
+  snapshot << "WINS " << GetWins() << "\n";
+  for (const std::string& enemy : enemies_) {
+    snapshot << "KILLS " << enemy << " " << GetKills(enemy) << "\n";
+  }
+  for (size_t room = 0; room < rooms_.size(); ++room) {
+    snapshot << "DEATHS " << rooms_[room] << " " << GetDeaths(room) << "\n";
+  }
+
+  // Each bucket is listed by the fewest commands a win in it took
+  std::vector<uint64_t> histogram = GetWinHistogram();
+  for (size_t bucket = 0; bucket < histogram.size(); ++bucket) {
+    if (histogram[bucket] > 0) {
+      snapshot << "WIN COMMANDS "
+               << (bucket == 0 ? 0 : (uint64_t)1 << (bucket - 1)) << " "
+               << histogram[bucket] << "\n";
+    }
+  }
+
+  for (const LeaderboardEntry& entry : GetFastestWins()) {
+    snapshot << "FASTEST WIN " << entry.id << " " << entry.score << "\n";
+  }
+
+  WriteFileAtomically(path, snapshot.str());
+}
+
+std::vector<std::string> GameStatistics::ListEnemies(const Dungeon& dungeon) {
+  std::vector<std::string> enemies;
+
+  for (const Room& room : dungeon.GetMap()) {
+    for (const Enemy& enemy : room.GetEnemies()) {
+      bool is_listed = false;
+      for (const std::string& listed : enemies) {
+        is_listed = is_listed || listed == enemy.GetNickname();
+      }
+
+      if (!is_listed) {
+        enemies.push_back(enemy.GetNickname());
+      }
+    }
+  }
+  return enemies;
+}
+
+}   // namespace adventure
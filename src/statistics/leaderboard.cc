@@ -0,0 +1,82 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "statistics/leaderboard.h"
+
+#include "statistics/sharded_counters.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace adventure {
+
+namespace {
+
+bool Ranks(const LeaderboardEntry& left, const LeaderboardEntry& right) {
+  return left.score < right.score ||
+         (left.score == right.score && left.id < right.id);
+}
+
+}   // namespace
+
+Leaderboard::Leaderboard(size_t capacity, size_t number_of_shards)
+    : capacity_(capacity), number_of_shards_(number_of_shards), shards_() {
+  if (capacity == 0) {
+    throw std::invalid_argument("CAPACITY NOT SPECIFIED");
+  } else if (number_of_shards == 0) {
+    throw std::invalid_argument("NUMBER OF SHARDS EQUALS ZERO");
+  }
+
+  shards_.reset(new Shard[number_of_shards]);
+  for (size_t shard = 0; shard < number_of_shards; ++shard) {
+    shards_[shard].entries.reserve(capacity + 1);
+    shards_[shard].cutoff.store(std::numeric_limits<uint64_t>::max(),
+                                std::memory_order_relaxed);
+  }
+}
+
+size_t Leaderboard::GetCapacity() const { return capacity_; }
+
+void Leaderboard::Submit(uint64_t id, uint64_t score) {
+  Shard& shard = shards_[GetThreadShard() % number_of_shards_];
+
+  // An entry tying the cutoff may still rank higher by its id, which is
+  // only settled under the lock
+  if (score > shard.cutoff.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  LeaderboardEntry entry{id, score};
+
+  shard.entries.insert(std::upper_bound(shard.entries.begin(),
+                                        shard.entries.end(), entry, Ranks),
+                       entry);
+  if (shard.entries.size() > capacity_) {
+    shard.entries.pop_back();
+  }
+
+  // Until the shard is full every score is kept
+  if (shard.entries.size() == capacity_) {
+    shard.cutoff.store(shard.entries.back().score,
+                       std::memory_order_relaxed);
+  }
+}
+
+std::vector<LeaderboardEntry> Leaderboard::GetTop() const {
+  std::vector<LeaderboardEntry> top;
+
+  for (size_t shard = 0; shard < number_of_shards_; ++shard) {
+    std::lock_guard<std::mutex> lock(shards_[shard].mutex);
+    top.insert(top.end(), shards_[shard].entries.begin(),
+               shards_[shard].entries.end());
+  }
+
+  std::sort(top.begin(), top.end(), Ranks);
+  if (top.size() > capacity_) {
+    top.resize(capacity_);
+  }
+  return top;
+}
+
+}   // namespace adventure
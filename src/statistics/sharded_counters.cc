@@ -0,0 +1,102 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "statistics/sharded_counters.h"
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace adventure {
+
+const size_t ShardedCounters::kCacheLineWords;
+const size_t ShardedHistogram::kNumberOfBuckets;
+
+size_t GetThreadShard() {
+  static std::atomic<size_t> next_shard(0);
+  thread_local size_t shard = next_shard.fetch_add(1);
+
+  return shard;
+}
+
+ShardedCounters::ShardedCounters(size_t number_of_counters,
+                                 size_t number_of_shards)
+    : number_of_counters_(number_of_counters),
+      number_of_shards_(number_of_shards), words_(), first_word_(0),
+      shard_stride_(0) {
+  if (number_of_counters == 0) {
+    throw std::invalid_argument("NUMBER OF COUNTERS EQUALS ZERO");
+  } else if (number_of_shards == 0) {
+    throw std::invalid_argument("NUMBER OF SHARDS EQUALS ZERO");
+  }
+
+  shard_stride_ = (number_of_counters + kCacheLineWords - 1) /
+                  kCacheLineWords * kCacheLineWords;
+
+  // One extra line lets the first shard start on a line boundary
+  size_t number_of_words = shard_stride_ * number_of_shards + kCacheLineWords;
+  words_.reset(new std::atomic<uint64_t>[number_of_words]);
+  for (size_t word = 0; word < number_of_words; ++word) {
+    words_[word].store(0, std::memory_order_relaxed);
+  }
+
+  size_t line_size = kCacheLineWords * sizeof(uint64_t);
+  while ((uintptr_t)&words_[first_word_] % line_size != 0) {
+    ++first_word_;
+  }
+}
+
+size_t ShardedCounters::GetNumberOfCounters() const {
+  return number_of_counters_;
+}
+
+size_t ShardedCounters::GetNumberOfShards() const { return number_of_shards_; }
+
+void ShardedCounters::Add(size_t counter, uint64_t amount) {
+  if (counter >= number_of_counters_) {
+    throw std::invalid_argument("COUNTER INDEX OUT OF RANGE");
+  }
+
+  size_t shard = GetThreadShard() % number_of_shards_;
+  words_[first_word_ + shard * shard_stride_ + counter].fetch_add(
+      amount, std::memory_order_relaxed);
+}
+
+uint64_t ShardedCounters::Get(size_t counter) const {
+  if (counter >= number_of_counters_) {
+    throw std::invalid_argument("COUNTER INDEX OUT OF RANGE");
+  }
+
+  uint64_t total = 0;
+  for (size_t shard = 0; shard < number_of_shards_; ++shard) {
+    total += words_[first_word_ + shard * shard_stride_ + counter].load(
+        std::memory_order_relaxed);
+  }
+  return total;
+}
+
+ShardedHistogram::ShardedHistogram(size_t number_of_shards)
+    : counters_(kNumberOfBuckets, number_of_shards) {}
+
+size_t ShardedHistogram::GetBucket(uint64_t value) {
+  size_t bucket = 0;
+
+  while (value != 0) {
+    value >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+void ShardedHistogram::Record(uint64_t value) {
+  counters_.Add(GetBucket(value));
+}
+
+std::vector<uint64_t> ShardedHistogram::GetCounts() const {
+  std::vector<uint64_t> counts(kNumberOfBuckets);
+
+  for (size_t bucket = 0; bucket < kNumberOfBuckets; ++bucket) {
+    counts[bucket] = counters_.Get(bucket);
+  }
+  return counts;
+}
+
+}   // namespace adventure
@@ -0,0 +1,74 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include "text_renderer.h"
+
+#include <cmath>
+
+namespace adventure {
+
+TextRenderer::TextRenderer(const std::string& font_name)
+    : font_name_(font_name), atlases_() {}
+
+void TextRenderer::Draw(const std::string& text, const glm::vec2& position,
+                        float size, TextAlignment alignment,
+                        const ci::ColorA& color) {
+  if (text.empty()) {
+    return;
+  }
+
+  Atlas& atlas = FindAtlas(size);
+  const Layout& layout = FindLayout(atlas, text);
+
+  glm::vec2 baseline(position.x, position.y + atlas.font->getAscent());
+  if (alignment == TextAlignment::kCenter) {
+    baseline.x -= layout.width / 2.0f;
+  } else if (alignment == TextAlignment::kRight) {
+    baseline.x -= layout.width;
+  }
+
+  ci::gl::color(color);
+  atlas.font->drawGlyphs(layout.placements, baseline);
+}
+
+size_t TextRenderer::GetNumberOfLayouts() const {
+  size_t number_of_layouts = 0;
+  for (const std::pair<const int, Atlas>& atlas : atlases_) {
+    number_of_layouts += atlas.second.layouts.size();
+  }
+
+  return number_of_layouts;
+}
+
+TextRenderer::Atlas &TextRenderer::FindAtlas(float size) {
+  // Sizes that round to the same pixel share an atlas
+  int pixels = (int)std::lround(size);
+
+  Atlas& atlas = atlases_[pixels];
+  if (atlas.font == nullptr) {
+    atlas.font = ci::gl::TextureFont::create(ci::Font(font_name_,
+                                                      (float)pixels));
+  }
+
+  return atlas;
+}
+
+const TextRenderer::Layout &TextRenderer::FindLayout(Atlas& atlas,
+                                                     const std::string& text) {
+  std::unordered_map<std::string, Layout>::const_iterator found =
+      atlas.layouts.find(text);
+  if (found != atlas.layouts.end()) {
+    return found->second;
+  }
+
+  if (atlas.layouts.size() >= kMaxLayoutsPerSize) {
+    atlas.layouts.clear();
+  }
+
+  Layout& layout = atlas.layouts[text];
+  layout.placements = atlas.font->getGlyphPlacements(text);
+  layout.width = atlas.font->measureString(text).x;
+
+  return layout;
+}
+
+}   // namespace adventure
@@ -2,13 +2,26 @@
 
 #include "visualizer.h"
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
 namespace adventure {
 
+static_assert(Layout::kNumberOfSubActionButtons ==
+                  GameSnapshot::kSubPanelPageSize,
+              "Every sub-action on a page needs a button");
+
 Visualizer::Visualizer(int window_width, int window_height) 
-    : bounds_(glm::vec2(window_width, window_height)),
+    : layout_((float)window_width, (float)window_height),
       player_information_(std::vector<std::string>(4, "")),
-      sub_actions_(), action_information_(), message_(), main_selection_(0),
-      sub_selection_(0), has_toggled_panels_(false), is_game_over_(false) {}
+      sub_actions_(), action_information_(), message_(), sub_page_(),
+      main_selection_(0), sub_selection_(0), first_sub_action_(0),
+      number_of_sub_actions_(0), has_toggled_panels_(false),
+      sub_panel_(SubPanel::kNone), is_game_over_(false),
+      engine_revision_(0), heatmap_(), heatmap_cells_(), heatmap_labels_(),
+      map_view_(), text_renderer_("Impact"), quads_(), overlay_quads_(),
+      has_layout_changed_(true) {}
 
 const std::vector<std::string> &Visualizer::GetSubActions() const {
   return sub_actions_;
@@ -18,12 +31,14 @@ size_t Visualizer::GetMainSelection() const { return main_selection_; }
 
 void Visualizer::SetMainSelection(size_t main_selection) {
   main_selection_ = main_selection;
+  has_layout_changed_ = true;
 }
 
 size_t Visualizer::GetSubSelection() const { return sub_selection_; }
 
 void Visualizer::SetSubSelection(size_t sub_selection) {
   sub_selection_ = sub_selection;
+  has_layout_changed_ = true;
 }
 
 bool Visualizer::HasToggledPanels() const { return has_toggled_panels_; }
@@ -32,40 +47,166 @@ bool Visualizer::IsGameOver() const { return is_game_over_; }
 
 void Visualizer::SetHasToggledPanels(bool has_toggled_panels) {
   has_toggled_panels_ = has_toggled_panels;
+  has_layout_changed_ = true;
 }
 
-void Visualizer::IncrementMainSelection() { ++main_selection_; }
+void Visualizer::IncrementMainSelection() {
+  ++main_selection_;
+  has_layout_changed_ = true;
+}
 
-void Visualizer::DecrementMainSelection() { --main_selection_; }
+void Visualizer::DecrementMainSelection() {
+  --main_selection_;
+  has_layout_changed_ = true;
+}
 
-void Visualizer::IncrementSubSelection() { ++sub_selection_; }
+void Visualizer::IncrementSubSelection() {
+  ++sub_selection_;
+  has_layout_changed_ = true;
+}
 
-void Visualizer::DecrementSubSelection() { --sub_selection_; }
+void Visualizer::DecrementSubSelection() {
+  --sub_selection_;
+  has_layout_changed_ = true;
+}
 
 void Visualizer::Display() {
+  if (has_layout_changed_) {
+    LoadQuads();
+  }
+
+  // Every rectangle is drawn at once, and the text goes over them
+  quads_.Draw();
+
   if (is_game_over_) {
     DrawGameOver();
   } else {
-    DrawActionPanel();
-    DrawBorderBars();
+    DrawActionButtonText();
 
     if (has_toggled_panels_) {
-      DrawSubPanels();
+      DrawSubActionButtonText();
       DrawSubInformationText();
+      DrawSubPageText();
     } else {
-      DrawMap();
-      DrawInformationBars();
+      if (heatmap_cells_.empty()) {
+        map_view_.Draw(layout_.GetPanel(LayoutPanel::kMap), text_renderer_);
+      }
+      overlay_quads_.Draw();
+
+      DrawHeatmapText();
       DrawPlayerInformationText();
       DrawMessage();
     }
   }
 }
 
+void Visualizer::Resize(int window_width, int window_height) {
+  layout_ = Layout((float)window_width, (float)window_height);
+  LoadHeatmapCells();
+  has_layout_changed_ = true;
+}
+
+void Visualizer::Update(const GameSnapshot& snapshot) {
+  bool has_game_changed = snapshot.engine_revision != engine_revision_;
+  bool has_selection_changed = snapshot.main_selection != main_selection_ ||
+                               snapshot.sub_selection != sub_selection_ ||
+                               snapshot.has_toggled_panels !=
+                                   has_toggled_panels_ ||
+                               snapshot.sub_panel != sub_panel_;
+
+  // Snapshots that only change text leave the rectangles as they are
+  if (has_selection_changed) {
+    has_layout_changed_ = true;
+  }
+
+  engine_revision_ = snapshot.engine_revision;
+  main_selection_ = snapshot.main_selection;
+  sub_selection_ = snapshot.sub_selection;
+  has_toggled_panels_ = snapshot.has_toggled_panels;
+  sub_panel_ = snapshot.sub_panel;
+
+  // Each region is rebuilt only when what it shows has changed. The player
+  // information only changes with the game itself, and the map view skips
+  // a room and locks it already shows
+  if (has_game_changed) {
+    UpdatePlayerInformationText(snapshot.player);
+    map_view_.Update(snapshot.player.GetCurrentLocation(),
+                     snapshot.locked_doors);
+  }
+
+  if (snapshot.message != message_ || snapshot.is_game_over != is_game_over_) {
+    UpdateMessage(snapshot.message, snapshot.is_game_over);
+  }
+
+  // The sub-panel changes with either the game or the selection
+  if (!has_game_changed && !has_selection_changed) {
+    return;
+  }
+
+  size_t number_of_sub_actions = sub_actions_.size();
+
+  // Only the page of sub-actions in the snapshot is labelled, however long
+  // the whole list is
+  first_sub_action_ = snapshot.first_sub_action;
+  number_of_sub_actions_ = snapshot.number_of_sub_actions;
+  size_t page_size = std::min(GameSnapshot::kSubPanelPageSize,
+                              number_of_sub_actions_ - first_sub_action_);
+
+  sub_page_.clear();
+  if (number_of_sub_actions_ > GameSnapshot::kSubPanelPageSize) {
+    size_t number_of_pages = (number_of_sub_actions_ +
+                              GameSnapshot::kSubPanelPageSize - 1) /
+                             GameSnapshot::kSubPanelPageSize;
+
+    sub_page_ = "PAGE ";
+    sub_page_.append(std::to_string((first_sub_action_ /
+                                     GameSnapshot::kSubPanelPageSize) + 1));
+    sub_page_.append("/");
+    sub_page_.append(std::to_string(number_of_pages));
+  }
+
+  if (snapshot.sub_panel == SubPanel::kEnemies) {
+    UpdateSubActionText(snapshot.enemies);
+    UpdateSubInformationText(snapshot.enemies);
+  } else if (snapshot.sub_panel == SubPanel::kWeapons) {
+    UpdateSubActionText(snapshot.weapons,
+                        page_size - snapshot.weapons.size());
+
+    // The key buttons after the Weapons have no information to show
+    if (GetSelectedSubActionButton() < snapshot.weapons.size()) {
+      UpdateSubInformationText(snapshot.weapons);
+    } else {
+      action_information_.clear();
+    }
+  } else if (snapshot.sub_panel == SubPanel::kDoors) {
+    UpdateSubActionText(snapshot.doors);
+    UpdateSubInformationText(snapshot.doors);
+  }
+
+  if (sub_actions_.size() != number_of_sub_actions) {
+    has_layout_changed_ = true;
+  }
+}
+
 void Visualizer::UpdateMessage(const std::string& message, bool is_game_over) {
+  if (is_game_over != is_game_over_) {
+    has_layout_changed_ = true;
+  }
+
   message_ = message;
   is_game_over_ = is_game_over;
 }
 
+void Visualizer::SetHeatmap(const Heatmap& heatmap) {
+  heatmap_ = heatmap;
+  LoadHeatmapCells();
+  has_layout_changed_ = true;
+}
+
+void Visualizer::SetDungeon(const std::shared_ptr<const Dungeon>& dungeon) {
+  map_view_.SetDungeon(dungeon);
+}
+
 void Visualizer::UpdatePlayerInformationText(const Player& player) {
   size_t index = 0;
   player_information_.at(index) = "ROOM: ";
@@ -88,41 +229,46 @@ void Visualizer::UpdatePlayerInformationText(const Player& player) {
   player_information_.at(index).append(std::to_string(player.GetWeapons()
                                                           .size()));
   player_information_.at(index).append("/");
-  player_information_.at(index).append(std::to_string(kMaxBoxes));
+  player_information_.at(index).append(std::to_string(player
+                                                          .GetMaxWeapons()));
 }
 
+// The labels are assigned over the last page's, so turning a page reuses
+// their storage
+
 void Visualizer::UpdateSubActionText(const std::vector<Enemy>& enemies) {
-  sub_actions_.clear();
+  sub_actions_.resize(enemies.size());
 
-  for (const Enemy& enemy : enemies) {
-    sub_actions_.push_back(enemy.GetNickname());
+  for (size_t button = 0; button < enemies.size(); ++button) {
+    sub_actions_[button] = enemies[button].GetNickname();
   }
 }
 
 void Visualizer::UpdateSubActionText(const std::vector<Weapon>& weapons,
                          size_t number_of_keys) {
-  sub_actions_.clear();
+  sub_actions_.resize(weapons.size() + number_of_keys);
 
-  for (const Weapon& weapon : weapons) {
-    sub_actions_.push_back(weapon.GetNickname());
+  for (size_t button = 0; button < weapons.size(); ++button) {
+    sub_actions_[button] = weapons[button].GetNickname();
   }
 
-  if (number_of_keys == 1) {
-    sub_actions_.emplace_back("KEY");
+  for (size_t button = weapons.size(); button < sub_actions_.size();
+       ++button) {
+    sub_actions_[button] = "KEY";
   }
 }
 
 void Visualizer::UpdateSubActionText(const std::vector<Door>& doors) {
-  sub_actions_.clear();
+  sub_actions_.resize(doors.size());
 
-  for (const Door& door : doors) {
-    sub_actions_.push_back(door.GetDirection());
+  for (size_t button = 0; button < doors.size(); ++button) {
+    sub_actions_[button] = doors[button].GetDirection();
   }
 }
 
 void Visualizer::UpdateSubInformationText(const std::vector<Enemy>& enemies) {
   action_information_.clear();
-  Enemy enemy = enemies.at(sub_selection_);
+  Enemy enemy = enemies.at(GetSelectedSubActionButton());
 
   std::string text = "NAME: ";
   text.append(enemy.GetName());
@@ -143,7 +289,7 @@ void Visualizer::UpdateSubInformationText(const std::vector<Enemy>& enemies) {
 
 void Visualizer::UpdateSubInformationText(const std::vector<Weapon>& weapons) {
   action_information_.clear();
-  Weapon weapon = weapons.at(sub_selection_);
+  Weapon weapon = weapons.at(GetSelectedSubActionButton());
 
   std::string text = "NAME: ";
   text.append(weapon.GetName());
@@ -160,7 +306,7 @@ void Visualizer::UpdateSubInformationText(const std::vector<Weapon>& weapons) {
 
 void Visualizer::UpdateSubInformationText(const std::vector<Door>& doors) {
   action_information_.clear();
-  Door door = doors.at(sub_selection_);
+  Door door = doors.at(GetSelectedSubActionButton());
 
   std::string text = "ROOM: ";
   text.append(door.GetAdjacentRoom());
@@ -175,210 +321,211 @@ void Visualizer::UpdateSubInformationText(const std::vector<Door>& doors) {
   action_information_.push_back(text);
 }
 
-void Visualizer::DrawGameOver() {
-  float size = (3.0f * (float)bounds_.y) / 10.0f;
-  float center_x = (1.0f * (float)bounds_.x) / 2.0f;
-  float center_y = (29.0f * (float)bounds_.y) / 80.0f;
-
-  glm::vec2 center(center_x, center_y);
-  const ci::Font font("Impact", size);
-
-  ci::gl::drawStringCentered(message_, center, ci::Color("white"), font);
-}
-
-void Visualizer::DrawActionPanel() {
-  float width = (float)bounds_.x;
-  float height = (7.0f * (float)bounds_.y) / 20.0f;
-  float center_x = (1.0f * (float)bounds_.x) / 2.0f;
-  float center_y = (33.0f * (float)bounds_.y) / 40.0f;
-
-  ci::gl::color(ci::Color::gray(0.0625));
-  DrawSolidRectangle(width, height, glm::vec2(center_x, center_y));
-
-  DrawActionButtons(glm::vec2(center_x, center_y));
-}
-
-void Visualizer::DrawSubPanels() {
-  float width = (7.0f * (float)bounds_.x) / 15.0f;
-  float height = (1.0f * (float)bounds_.y) / 2.0f;
-  float center_x = (1.0f * (float)bounds_.x) / 4.0f;
-  float center_y = (13.0f * (float)bounds_.y) / 40.0f;
-
-  ci::gl::color(ci::Color::gray(0.0625));
-  DrawSolidRectangle(width, height, glm::vec2(center_x, center_y));
-
-  DrawSubActionButtons(glm::vec2(center_x, center_y));
-
-  center_x = (3.0f * (float)bounds_.x) / 4.0f;
-
-  ci::gl::color(ci::Color::gray(0.0625));
-  DrawSolidRectangle(width, height, glm::vec2(center_x, center_y));
-}
-
-void Visualizer::DrawActionButtons(const glm::vec2& panel_center) {
-  std::vector<std::string> command_actions{"FIGHT", "TAKE", "DROP", "GO"};
+void Visualizer::LoadQuads() {
+  quads_.Clear();
+  overlay_quads_.Clear();
 
-  float width = (7.0f * (float)bounds_.x) / 40.0f;
-  float height = (3.0f * (float)bounds_.y) / 20.0f;
-  float center_x = panel_center.x - ((7.0f * (float)bounds_.x) / 20.0f);
-  float center_y = panel_center.y;
+  if (!is_game_over_) {
+    AddActionPanel();
+    AddBorderBars();
 
-  for (size_t button = 0; button < kMaxBoxes; ++button) {
-    if (button == main_selection_) {
-      ci::gl::color(ci::Color::gray(0.25));
+    if (has_toggled_panels_) {
+      AddSubPanels();
     } else {
-      ci::gl::color(ci::Color::gray(0.125));
+      AddMap();
+      AddHeatmap();
+      AddInformationBars();
     }
+  }
 
-    DrawSolidRectangle(width, height, glm::vec2(center_x, center_y));
-    DrawButtonText(glm::vec2(center_x, center_y), command_actions[button]);
+  has_layout_changed_ = false;
+}
+
+void Visualizer::LoadHeatmapCells() {
+  heatmap_cells_.clear();
+  heatmap_labels_.clear();
 
-    center_x += (7.0f * (float)bounds_.x) / 30.0f;
+  size_t number_of_cells = heatmap_.GetNumberOfRooms();
+  if (number_of_cells == 0) {
+    return;
   }
-}
 
-void Visualizer::DrawSubActionButtons(const glm::vec2& panel_center) {
-  float width = (11.0f * (float)bounds_.x) / 60.0f;
-  float height = (3.0f * (float)bounds_.y) / 20.0f;
-  float center_x = (17.0f * (float)bounds_.x) / 120.0f;
-  float center_y = (9.0f * (float)bounds_.y) / 40.0f;
+  const ci::Rectf& map = layout_.GetPanel(LayoutPanel::kMap);
 
-  for (size_t button = 0; button < sub_actions_.size(); ++button) {
-    if (button == kMaxBoxes / 2) {
-      center_x -= (13.0f * (float)bounds_.x) / 30.0f;
-      center_y += (1.0f * (float)bounds_.y) / 5.0f;
-    }
+  size_t columns = (size_t)std::ceil(std::sqrt((double)number_of_cells));
+  size_t rows = (number_of_cells + columns - 1) / columns;
+  float cell_width = map.getWidth() / (float)columns;
+  float cell_height = map.getHeight() / (float)rows;
 
-    if (button == sub_selection_) {
-      ci::gl::color(ci::Color::gray(0.25));
-    } else {
-      ci::gl::color(ci::Color::gray(0.125));
-    }
+  for (size_t cell = 0; cell < number_of_cells; ++cell) {
+    float left = map.getUpperLeft().x +
+                 ((float)(cell % columns) * cell_width);
+    float top = map.getUpperLeft().y + ((float)(cell / columns) * cell_height);
 
-    DrawSolidRectangle(width, height, glm::vec2(center_x, center_y));
-    DrawButtonText(glm::vec2(center_x, center_y), sub_actions_[button]);
+    heatmap_cells_.emplace_back(left, top, left + cell_width,
+                                top + cell_height);
 
-    center_x += (13.0f * (float)bounds_.x) / 60.0f;
+    // The visits only change with the Heatmap, so the labels are made here
+    // rather than on every frame
+    std::string label = heatmap_.GetRoom(cell);
+    label.append(" ");
+    label.append(std::to_string(heatmap_.GetVisits(cell)));
+    heatmap_labels_.push_back(std::move(label));
   }
 }
 
-void Visualizer::DrawButtonText(const glm::vec2& button_center,
-                                const std::string& text) const {
-  float size = (1.0f * (float)bounds_.y) / 10.0f;
-  float text_adjust_y = button_center.y - ((1.0f * (float)bounds_.x) / 30.0f);
+void Visualizer::DrawGameOver() {
+  DrawText(message_, layout_.GetText(LayoutText::kGameOver),
+           ci::Color("white"));
+}
 
-  glm::vec2 new_center(button_center.x, text_adjust_y);
-  const ci::Font font("Impact", size);
+void Visualizer::AddActionPanel() {
+  quads_.AddRectangle(layout_.GetPanel(LayoutPanel::kActionPanel),
+                      ci::Color::gray(0.0625));
 
-  ci::gl::drawStringCentered(text, new_center, ci::Color("white"), font);
+  AddActionButtons();
 }
 
-void Visualizer::DrawBorderBars() const {
-  float width = (float)bounds_.x;
-  float height = (float)bounds_.y / 20.0f;
-  float center_x = (1.0f * (float)bounds_.x) / 2.0f;
-  float center_y = (1.0f * (float)bounds_.y) / 40.0f;
-
-  ci::gl::color(ci::Color::gray(0.125));
-  DrawSolidRectangle(width, height, glm::vec2(center_x, center_y));
+void Visualizer::AddSubPanels() {
+  quads_.AddRectangle(layout_.GetPanel(LayoutPanel::kLeftSubPanel),
+                      ci::Color::gray(0.0625));
 
-  center_y = (5.0f * (float)bounds_.y) / 8.0f;
+  AddSubActionButtons();
 
-  DrawSolidRectangle(width, height, glm::vec2(center_x, center_y));
+  quads_.AddRectangle(layout_.GetPanel(LayoutPanel::kRightSubPanel),
+                      ci::Color::gray(0.0625));
 }
 
-void Visualizer::DrawMap() const {
-  float width = (19.0f * (float)bounds_.x) / 30.0f;
-  float height = (37.0f * (float)bounds_.y) / 80.0f;
-  float center_x = (1.0f * (float)bounds_.x) / 2.0f;
-  float center_y = (47.0f * (float)bounds_.y) / 160.0f;
-
-  ci::gl::color(ci::Color::gray(0.0625));
-  DrawSolidRectangle(width, height, glm::vec2(center_x, center_y));
+void Visualizer::AddActionButtons() {
+  for (size_t button = 0; button < Layout::kNumberOfActionButtons; ++button) {
+    quads_.AddRectangle(layout_.GetActionButton(button),
+                        GetButtonColor(button == main_selection_));
+  }
 }
 
-void Visualizer::DrawInformationBars() const {
-  float width = (1.0f * (float)bounds_.x) / 8.0f;
-  float height = (1.0f * (float)bounds_.y) / 20.0f;
-  float center_x = (1.0f * (float)bounds_.x) / 2.0f;
-  float center_y = (5.0f * (float)bounds_.y) / 40.0f;
+void Visualizer::AddSubActionButtons() {
+  for (size_t button = 0; button < GetNumberOfSubActionButtons(); ++button) {
+    quads_.AddRectangle(layout_.GetSubActionButton(button),
+                        GetButtonColor(button ==
+                                       GetSelectedSubActionButton()));
+  }
+}
 
-  ci::gl::color(ci::Color::gray(0.125));
-  DrawSolidRectangle(width, height, glm::vec2(center_x, center_y));
+void Visualizer::DrawActionButtonText() {
+  const std::string command_actions[] = {"FIGHT", "TAKE", "DROP", "GO"};
 
-  width = (1.0f * (float)bounds_.x) / 2.0f;
-  height = (1.0f * (float)bounds_.y) / 20.0f;
-  center_x = (1.0f * (float)bounds_.x) / 2.0f;
-  center_y = (9.0f * (float)bounds_.y) / 16.0f;
+  for (size_t button = 0; button < Layout::kNumberOfActionButtons; ++button) {
+    DrawText(command_actions[button], layout_.GetActionButtonLabel(button),
+             ci::Color("white"));
+  }
+}
 
-  DrawSolidRectangle(width, height, glm::vec2(center_x, center_y));
+void Visualizer::DrawSubActionButtonText() {
+  for (size_t button = 0; button < GetNumberOfSubActionButtons(); ++button) {
+    DrawText(sub_actions_[button], layout_.GetSubActionButtonLabel(button),
+             ci::Color("white"));
+  }
 }
 
-void Visualizer::DrawPlayerInformationText() {
-  float size = (49.0f * (float)bounds_.y) / 1890.0f;
-  float top_x = (1.0f * (float)bounds_.x) / 2.0f;
-  float top_y = (9.0f * (float)bounds_.y) / 80.0f;
+void Visualizer::AddBorderBars() {
+  quads_.AddRectangle(layout_.GetPanel(LayoutPanel::kTopBorderBar),
+                      ci::Color::gray(0.125));
+  quads_.AddRectangle(layout_.GetPanel(LayoutPanel::kBottomBorderBar),
+                      ci::Color::gray(0.125));
+}
 
-  const ci::Font font("Impact", size);
-  glm::vec2 top(top_x, top_y);
+void Visualizer::AddMap() {
+  quads_.AddRectangle(layout_.GetPanel(LayoutPanel::kMap),
+                      ci::Color::gray(0.0625));
+}
 
-  size_t index = 0;
+void Visualizer::AddHeatmap() {
+  for (size_t cell = 0; cell < heatmap_cells_.size(); ++cell) {
+    const ci::Rectf& bounds = heatmap_cells_[cell];
+    glm::vec2 center = bounds.getCenter();
+    glm::vec2 half_size(bounds.getWidth() * 0.45f,
+                        bounds.getHeight() * 0.45f);
+
+    // Cells go from the map's own gray to red as visits near the most
+    float intensity = heatmap_.GetIntensity(cell);
+    quads_.AddRectangle(ci::Rectf(center - half_size, center + half_size),
+                        ci::Color(0.0625f + (0.6875f * intensity), 0.0625f,
+                                  0.0625f));
+  }
+}
 
-  ci::gl::drawStringCentered(player_information_.at(index), top,
-                             ci::Color("white"), font);
+void Visualizer::DrawHeatmapText() {
+  const ci::Rectf& map = layout_.GetPanel(LayoutPanel::kMap);
 
-  top.x = (22.0f * (float)bounds_.x) / 80.0f;
-  top.y = (44.0f * (float)bounds_.y) / 80.0f;
+  for (size_t cell = 0; cell < heatmap_cells_.size(); ++cell) {
+    const ci::Rectf& bounds = heatmap_cells_[cell];
 
-  ++index;
-  ci::gl::drawString(player_information_.at(index), top,
-                     ci::Color("white"), font);
+    // Cells that the map does not show are not drawn at all
+    if (!map.intersects(bounds)) {
+      continue;
+    }
 
-  top.x = (1.0f * (float)bounds_.x) / 2.0f;
+    float size = bounds.getHeight() / 5.0f;
+    glm::vec2 text_center(bounds.getCenter().x,
+                          bounds.getCenter().y - (size / 2.0f));
+    text_renderer_.Draw(heatmap_labels_[cell], text_center, size,
+                        TextAlignment::kCenter, ci::Color::gray(0.5));
+  }
+}
 
-  ++index;
-  ci::gl::drawStringCentered(player_information_.at(index), top,
-                     ci::Color("white"), font);
+void Visualizer::AddInformationBars() {
+  overlay_quads_.AddRectangle(layout_.GetPanel(LayoutPanel::kLocationBar),
+                              ci::Color::gray(0.125));
+  overlay_quads_.AddRectangle(layout_.GetPanel(LayoutPanel::kStatusBar),
+                              ci::Color::gray(0.125));
+}
 
-  top.x = (58.0f * (float)bounds_.x) / 80.0f;
+void Visualizer::DrawPlayerInformationText() {
+  const LayoutText kTexts[] = {LayoutText::kLocation, LayoutText::kHealth,
+                               LayoutText::kKeys, LayoutText::kWeapons};
 
-  ++index;
-  ci::gl::drawStringRight(player_information_.at(index), top,
-                             ci::Color("white"), font);
+  for (size_t index = 0; index < player_information_.size(); ++index) {
+    DrawText(player_information_[index], layout_.GetText(kTexts[index]),
+             ci::Color("white"));
+  }
 }
 
 void Visualizer::DrawSubInformationText() {
-  float size = (1.0f * (float)bounds_.y) / 18.0f;
-  float center_x = (3.0f * (float)bounds_.x) / 4.0f;
-  float center_y = (7.0f * (float)bounds_.y) / 20.0f;
-
-  center_y -= ((float)action_information_.size() * (float)bounds_.y) / 20.0f;
-  glm::vec2 center(center_x, center_y);
-  const ci::Font font("Impact", size);
+  size_t number_of_lines = action_information_.size();
 
-  for (const std::string& line : action_information_) {
-    ci::gl::drawStringCentered(line, center, ci::Color("white"), font);
-    center.y += (1.0f * (float)bounds_.y) / 10.0f;
+  for (size_t line = 0; line < number_of_lines; ++line) {
+    DrawText(action_information_[line],
+             layout_.GetSubInformationLine(line, number_of_lines),
+             ci::Color("white"));
   }
 }
 
+void Visualizer::DrawSubPageText() {
+  DrawText(sub_page_, layout_.GetText(LayoutText::kSubPage),
+           ci::Color::gray(0.5));
+}
+
 void Visualizer::DrawMessage() {
-  float size = (1.0f * (float)bounds_.y) / 15.0f;
-  float center_x = (1.0f * (float)bounds_.x) / 2.0f;
-  float center_y = (21.0f * (float)bounds_.y) / 80.0f;
+  DrawText(message_, layout_.GetText(LayoutText::kMessage),
+           ci::Color("white"));
+}
 
-  glm::vec2 center(center_x, center_y);
-  const ci::Font font("Impact", size);
+void Visualizer::DrawText(const std::string& text, const TextAnchor& anchor,
+                          const ci::ColorA& color) {
+  text_renderer_.Draw(text, anchor.position, anchor.size, anchor.alignment,
+                      color);
+}
 
-  ci::gl::drawStringCentered(message_, center, ci::Color("white"), font);
+size_t Visualizer::GetNumberOfSubActionButtons() const {
+  return std::min(sub_actions_.size(), Layout::kNumberOfSubActionButtons);
 }
 
-void Visualizer::DrawSolidRectangle(float width, float height,
-                                    const glm::vec2& center) {
-  glm::vec2 top(center.x - (width / 2.0f), center.y - (height / 2.0f));
-  glm::vec2 bottom(center.x + (width / 2.0f), center.y + (height / 2.0f));
+size_t Visualizer::GetSelectedSubActionButton() const {
+  return sub_selection_ - first_sub_action_;
+}
 
-  ci::gl::drawSolidRect(ci::Rectf(top, bottom));
+ci::ColorA Visualizer::GetButtonColor(bool is_selected) {
+  return is_selected ? ci::Color::gray(0.25) : ci::Color::gray(0.125);
 }
 
 }   // namespace adventure
\ No newline at end of file
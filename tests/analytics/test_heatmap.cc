@@ -0,0 +1,77 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <analytics/heatmap.h>
+
+#include <sstream>
+
+using adventure::Heatmap;
+
+TEST_CASE("Heatmap cells") {
+  Heatmap heatmap;
+  heatmap.Add("ENTRN", 8);
+  heatmap.Add("SWORD", 2);
+  heatmap.Add("BOW", 0);
+
+  SECTION("Rooms keep their order") {
+    REQUIRE(heatmap.GetNumberOfRooms() == 3);
+    REQUIRE(heatmap.GetRoom(0) == "ENTRN");
+    REQUIRE(heatmap.GetRoom(2) == "BOW");
+    REQUIRE(heatmap.GetVisits(1) == 2);
+  }
+
+  SECTION("Intensity is relative to the most visits") {
+    REQUIRE(heatmap.GetIntensity(0) == Approx(1.0f));
+    REQUIRE(heatmap.GetIntensity(1) == Approx(0.25f));
+    REQUIRE(heatmap.GetIntensity(2) == Approx(0.0f));
+  }
+
+  SECTION("No visits have no intensity") {
+    Heatmap unvisited;
+    unvisited.Add("ENTRN", 0);
+
+    REQUIRE(unvisited.GetIntensity(0) == Approx(0.0f));
+  }
+
+  SECTION("Room name not specified") {
+    REQUIRE_THROWS_AS(heatmap.Add("", 1), std::invalid_argument);
+  }
+
+  SECTION("Invalid room name") {
+    REQUIRE_THROWS_AS(heatmap.Add("BAT CAVE", 1), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Heatmap file") {
+  Heatmap heatmap;
+  heatmap.Add("ENTRN", 8);
+  heatmap.Add("SWORD", 2);
+
+  SECTION("Round trip") {
+    std::stringstream stream;
+    stream << heatmap;
+
+    Heatmap loaded;
+    stream >> loaded;
+
+    REQUIRE(loaded.GetNumberOfRooms() == 2);
+    REQUIRE(loaded.GetRoom(1) == "SWORD");
+    REQUIRE(loaded.GetVisits(0) == 8);
+    REQUIRE(loaded.GetIntensity(1) == Approx(0.25f));
+  }
+
+  SECTION("Invalid header") {
+    std::stringstream stream("DUNGEON_LOAD_FINAL_PROJECT\nENTRN 8\n");
+    Heatmap loaded;
+
+    REQUIRE_THROWS_AS(stream >> loaded, std::invalid_argument);
+  }
+
+  SECTION("Invalid cell") {
+    std::stringstream stream("HEATMAP_ROOM_VISITS\nENTRN EIGHT\n");
+    Heatmap loaded;
+
+    REQUIRE_THROWS_AS(stream >> loaded, std::invalid_argument);
+  }
+}
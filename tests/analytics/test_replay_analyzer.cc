@@ -0,0 +1,190 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <analytics/replay_analyzer.h>
+#include <persistence/mapped_file.h>
+#include <persistence/temporary_directory.h>
+#include <serialization/checksum.h>
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using adventure::Player;
+
+using adventure::Weapon;
+
+using adventure::Dungeon;
+
+using adventure::ReplayAnalyzer;
+using adventure::ReplayReport;
+
+using adventure::JobSystem;
+
+using adventure::Checksum;
+using adventure::Command;
+using adventure::Engine;
+using adventure::ReplayLog;
+using adventure::TemporaryDirectory;
+
+namespace {
+
+const std::string kDirectoryPrefix = "replay-analyzer-test";
+const size_t kNumberOfSessions = 3;
+
+void Run(Engine& engine, ReplayLog& log, Command command,
+         const std::string& qualifier, uint32_t elapsed_ms) {
+  engine.Execute(command, qualifier);
+  log.Record(command, qualifier, elapsed_ms);
+}
+
+std::string SessionPath(const std::string& directory, size_t session) {
+  return directory + "/session-" + std::to_string(session) + ".replay";
+}
+
+}   // namespace
+
+TEST_CASE("ReplayAnalyzer") {
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player player("ENTRN", 1, 0, valid_weapons);
+  std::shared_ptr<Dungeon> dungeon = std::make_shared<Dungeon>();
+
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> *dungeon;
+
+    input_file.close();
+  }
+
+  Checksum checksum;
+  checksum.Add(Engine(player, dungeon).GetMap());
+
+  // One session takes the SWORD and walks back, the other two die to the
+  // BLOB, one of them after taking the BOW
+  std::vector<ReplayLog> logs;
+  for (size_t session = 0; session < kNumberOfSessions; ++session) {
+    Engine engine(player, dungeon);
+    ReplayLog log(session + 1, checksum.GetValue());
+    engine.SetRandomState(log.GetSeed());
+
+    if (session == 0) {
+      Run(engine, log, Command::kGo, "UP", 100);
+      Run(engine, log, Command::kTake, "SWORD", 50);
+      Run(engine, log, Command::kGo, "DOWN", 70);
+    } else {
+      Run(engine, log, Command::kGo, "DOWN", 200 * (uint32_t)session);
+      if (session == 2) {
+        Run(engine, log, Command::kTake, "BOW", 10);
+      }
+      Run(engine, log, Command::kFight, "BLOB", 10);
+    }
+
+    log.SetFinalChecksum(engine.ComputeChecksum());
+    logs.push_back(log);
+  }
+
+  ReplayAnalyzer analyzer(dungeon, player);
+  size_t sword = analyzer.GetWeapons()[0] == "SWORD" ? 0 : 1;
+  size_t bow = 1 - sword;
+
+  SECTION("Sessions in one buffer") {
+    std::stringstream stream;
+    for (const ReplayLog& log : logs) {
+      stream << log;
+    }
+    std::string bytes = stream.str();
+
+    ReplayReport report = analyzer.CreateReport();
+    analyzer.Analyze((const uint8_t*)bytes.data(), bytes.size(), report);
+
+    REQUIRE(report.number_of_logs == kNumberOfSessions);
+    REQUIRE(report.number_of_skipped_logs == 0);
+    REQUIRE(report.number_of_commands == 8);
+    REQUIRE(report.number_of_bytes == bytes.size());
+
+    size_t entrance = dungeon->FindRoomIndex("ENTRN");
+    REQUIRE(report.room_visits[entrance] == 4);
+    REQUIRE(report.room_exits[entrance] == 3);
+    REQUIRE(report.room_milliseconds[entrance] == 100 + 200 + 400);
+    REQUIRE(report.room_visits[dungeon->FindRoomIndex("SWORD")] == 1);
+    REQUIRE(report.room_milliseconds[dungeon->FindRoomIndex("SWORD")] ==
+            120);
+    REQUIRE(report.room_visits[dungeon->FindRoomIndex("BOW")] == 2);
+
+    REQUIRE(report.death_paths.size() == 1);
+    REQUIRE(report.death_paths["ENTRN > BOW"] == 2);
+
+    REQUIRE(report.weapon_sightings[sword] == 1);
+    REQUIRE(report.weapon_pickups[sword] == 1);
+    REQUIRE(report.weapon_sightings[bow] == 2);
+    REQUIRE(report.weapon_pickups[bow] == 1);
+  }
+
+  SECTION("A log cut short is skipped") {
+    std::stringstream stream;
+    stream << logs[1];
+    std::string bytes = stream.str();
+
+    ReplayReport report = analyzer.CreateReport();
+    analyzer.Analyze((const uint8_t*)bytes.data(), bytes.size() - 1, report);
+
+    REQUIRE(report.number_of_logs == 0);
+    REQUIRE(report.number_of_skipped_logs == 1);
+  }
+
+  SECTION("A log of another dungeon is skipped") {
+    std::stringstream stream;
+    stream << ReplayLog(1, checksum.GetValue() + 1) << logs[0];
+    std::string bytes = stream.str();
+
+    ReplayReport report = analyzer.CreateReport();
+    analyzer.Analyze((const uint8_t*)bytes.data(), bytes.size(), report);
+
+    REQUIRE(report.number_of_logs == 1);
+    REQUIRE(report.number_of_skipped_logs == 1);
+  }
+
+  SECTION("Files are analyzed in parallel and merged") {
+    TemporaryDirectory directory(kDirectoryPrefix);
+
+    for (size_t session = 0; session < kNumberOfSessions; ++session) {
+      std::ofstream log_file(SessionPath(directory.GetPath(), session),
+                             std::ios::binary);
+      log_file << logs[session];
+    }
+    std::ofstream corrupt_file(directory.GetPath() + "/corrupt.replay");
+    corrupt_file << "NOT A REPLAY LOG";
+    corrupt_file.close();
+
+    std::vector<std::string> paths = adventure::ListFiles(directory.GetPath());
+    paths.push_back(directory.GetPath() + "/missing.replay");
+
+    ReplayReport report;
+    {
+      JobSystem jobs(2);
+      report = analyzer.AnalyzeFiles(paths, jobs);
+    }
+
+    REQUIRE(report.number_of_logs == kNumberOfSessions);
+    REQUIRE(report.number_of_skipped_logs == 2);
+    REQUIRE(report.death_paths["ENTRN > BOW"] == 2);
+    REQUIRE(report.weapon_pickups[sword] == 1);
+
+    adventure::Heatmap heatmap = analyzer.CreateHeatmap(report);
+    REQUIRE(heatmap.GetNumberOfRooms() == dungeon->GetMap().size());
+    REQUIRE(heatmap.GetRoom(0) == "ENTRN");
+    REQUIRE(heatmap.GetIntensity(0) == Approx(1.0f));
+  }
+
+  SECTION("Dungeon not specified") {
+    REQUIRE_THROWS_AS(ReplayAnalyzer(nullptr, player),
+                      std::invalid_argument);
+  }
+}
@@ -0,0 +1,141 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <concurrency/broadcast_ring.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+using adventure::BroadcastRead;
+using adventure::BroadcastRing;
+
+namespace {
+
+void Publish(BroadcastRing& ring, const std::string& message) {
+  ring.Publish(message.data(), message.size());
+}
+
+}   // namespace
+
+TEST_CASE("Broadcast ring constructor") {
+  SECTION("Rounds up to a power of two") {
+    BroadcastRing ring(100);
+
+    REQUIRE(ring.GetCapacity() == 128);
+    REQUIRE(ring.GetEnd() == 0);
+  }
+
+  SECTION("Capacity not specified") {
+    REQUIRE_THROWS_AS(BroadcastRing(0), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Broadcast ring publish and read") {
+  BroadcastRing ring(256);
+  std::string message;
+  uint64_t first_reader = 0;
+  uint64_t second_reader = 0;
+
+  SECTION("Every reader sees every message") {
+    Publish(ring, "YOU WENT UP");
+    Publish(ring, "");
+    Publish(ring, "YOU TOOK THE SWORD");
+
+    REQUIRE(ring.Read(first_reader, message) == BroadcastRead::kMessage);
+    REQUIRE(message == "YOU WENT UP");
+    REQUIRE(ring.Read(first_reader, message) == BroadcastRead::kMessage);
+    REQUIRE(message.empty());
+    REQUIRE(ring.Read(first_reader, message) == BroadcastRead::kMessage);
+    REQUIRE(message == "YOU TOOK THE SWORD");
+    REQUIRE(ring.Read(first_reader, message) == BroadcastRead::kEmpty);
+
+    REQUIRE(ring.Read(second_reader, message) == BroadcastRead::kMessage);
+    REQUIRE(message == "YOU WENT UP");
+  }
+
+  SECTION("Empty edge case") {
+    REQUIRE(ring.Read(first_reader, message) == BroadcastRead::kEmpty);
+  }
+
+  SECTION("Readers that fall behind are overrun") {
+    for (size_t index = 0; index < 32; ++index) {
+      Publish(ring, "MESSAGE " + std::to_string(index));
+    }
+
+    REQUIRE(ring.Read(first_reader, message) == BroadcastRead::kOverrun);
+
+    uint64_t newest = ring.Publish("NEWEST", 6);
+    REQUIRE(ring.Read(newest, message) == BroadcastRead::kMessage);
+    REQUIRE(message == "NEWEST");
+  }
+
+  SECTION("Message too large") {
+    std::string large(200, 'X');
+
+    REQUIRE_THROWS_AS(Publish(ring, large), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Broadcast ring across threads") {
+  const size_t kMessages = 20000;
+  BroadcastRing ring(1024);
+  std::atomic<bool> is_started(false);
+  std::atomic<bool> is_done(false);
+
+  // The reader either sees the messages in order or learns it was overrun,
+  // never a torn message
+  bool is_consistent = true;
+  size_t number_read = 0;
+
+  std::thread reader([&] {
+    uint64_t position = 0;
+    std::string message;
+    size_t last = 0;
+    bool has_last = false;
+    is_started = true;
+
+    while (true) {
+      BroadcastRead result = ring.Read(position, message);
+
+      if (result == BroadcastRead::kEmpty) {
+        if (is_done) {
+          return;
+        }
+        std::this_thread::yield();
+      } else if (result == BroadcastRead::kOverrun) {
+        position = ring.GetEnd();
+        has_last = false;
+      } else {
+        size_t value = (size_t)std::stoul(message);
+        if (message != std::to_string(value) + " " +
+                           std::string(value % 17, '#') ||
+            (has_last && value != last + 1)) {
+          is_consistent = false;
+        }
+
+        last = value;
+        has_last = true;
+        ++number_read;
+      }
+    }
+  });
+
+  while (!is_started) {
+    std::this_thread::yield();
+  }
+  for (size_t index = 0; index < kMessages; ++index) {
+    Publish(ring, std::to_string(index) + " " + std::string(index % 17, '#'));
+
+    // Gives the reader a chance to keep up even on a single core
+    if (index % 8 == 0) {
+      std::this_thread::yield();
+    }
+  }
+  is_done = true;
+  reader.join();
+
+  REQUIRE(is_consistent);
+  REQUIRE(number_read > 0);
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <concurrency/spsc_queue.h>
+
+#include <thread>
+
+using adventure::SpscQueue;
+
+TEST_CASE("Spsc queue constructor") {
+  SECTION("Rounds up to a power of two") {
+    SpscQueue<int> queue(5);
+
+    REQUIRE(queue.GetCapacity() == 8);
+    REQUIRE(queue.empty());
+  }
+
+  SECTION("Capacity not specified") {
+    REQUIRE_THROWS_AS(SpscQueue<int>(0), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Spsc queue push and pop") {
+  SpscQueue<int> queue(4);
+  int item = 0;
+
+  SECTION("First in, first out") {
+    REQUIRE(queue.TryPush(1));
+    REQUIRE(queue.TryPush(2));
+
+    REQUIRE(queue.TryPop(item));
+    REQUIRE(item == 1);
+    REQUIRE(queue.TryPop(item));
+    REQUIRE(item == 2);
+  }
+
+  SECTION("Empty edge case") {
+    REQUIRE_FALSE(queue.TryPop(item));
+  }
+
+  SECTION("Full edge case") {
+    for (int number = 0; number < 4; ++number) {
+      REQUIRE(queue.TryPush(number));
+    }
+
+    REQUIRE_FALSE(queue.TryPush(4));
+    REQUIRE(queue.TryPop(item));
+    REQUIRE(queue.TryPush(4));
+  }
+
+  SECTION("Across threads") {
+    int number_of_items = 100000;
+    bool is_in_order = true;
+
+    std::thread consumer([&queue, &is_in_order, number_of_items] {
+      int expected = 0;
+      int popped = 0;
+
+      while (expected < number_of_items) {
+        if (queue.TryPop(popped)) {
+          is_in_order = is_in_order && popped == expected;
+          ++expected;
+        } else {
+          // Lets the producer run when both share a single core
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    for (int number = 0; number < number_of_items;) {
+      if (queue.TryPush(number)) {
+        ++number;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    consumer.join();
+
+    REQUIRE(is_in_order);
+    REQUIRE(queue.empty());
+  }
+}
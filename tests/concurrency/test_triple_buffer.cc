@@ -0,0 +1,85 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <concurrency/triple_buffer.h>
+
+#include <thread>
+
+using adventure::TripleBuffer;
+
+TEST_CASE("Triple buffer update") {
+  TripleBuffer<int> buffer;
+
+  SECTION("Nothing published edge case") {
+    REQUIRE_FALSE(buffer.Update());
+  }
+
+  SECTION("Picks up the published value") {
+    buffer.GetBack() = 5;
+    buffer.Publish();
+
+    REQUIRE(buffer.Update());
+    REQUIRE(buffer.GetFront() == 5);
+    REQUIRE_FALSE(buffer.Update());
+    REQUIRE(buffer.GetFront() == 5);
+  }
+
+  SECTION("Picks up only the latest value") {
+    buffer.GetBack() = 1;
+    buffer.Publish();
+    buffer.GetBack() = 2;
+    buffer.Publish();
+
+    REQUIRE(buffer.Update());
+    REQUIRE(buffer.GetFront() == 2);
+  }
+
+  SECTION("Front is untouched while writing") {
+    buffer.GetBack() = 1;
+    buffer.Publish();
+    buffer.Update();
+
+    for (int value = 2; value < 10; ++value) {
+      buffer.GetBack() = value;
+      buffer.Publish();
+
+      REQUIRE(buffer.GetFront() == 1);
+    }
+  }
+}
+
+TEST_CASE("Triple buffer across threads") {
+  SECTION("Values never go backwards or tear") {
+    struct Pair {
+      int first;
+      int second;
+    };
+
+    int number_of_values = 100000;
+    TripleBuffer<Pair> buffer;
+    bool is_consistent = true;
+
+    std::thread writer([&buffer, number_of_values] {
+      for (int value = 1; value <= number_of_values; ++value) {
+        buffer.GetBack().first = value;
+        buffer.GetBack().second = -value;
+        buffer.Publish();
+      }
+    });
+
+    int last = 0;
+    while (last < number_of_values) {
+      if (buffer.Update()) {
+        const Pair& pair = buffer.GetFront();
+
+        is_consistent = is_consistent && pair.first > last &&
+                        pair.second == -pair.first;
+        last = pair.first;
+      }
+    }
+    writer.join();
+
+    REQUIRE(is_consistent);
+  }
+}
@@ -65,4 +65,35 @@ TEST_CASE("Enemy deal damage") {
 
     REQUIRE(enemy.DealDamage() == (2 * enemy.GetStrength()));
   }
-}
\ No newline at end of file
+}
+TEST_CASE("Enemy archetype") {
+  Enemy first("BAT", "BAT", 20, 5, 5);
+
+  SECTION("Enemies of the same kind share an archetype") {
+    Enemy second("BAT", "BAT", 20, 5, 5);
+    second.TakeDamage(15);
+
+    REQUIRE(&first.GetArchetype() == &second.GetArchetype());
+    REQUIRE(&first.GetName() == &second.GetName());
+    REQUIRE(first.GetHealth() == 20);
+    REQUIRE(second.GetHealth() == 5);
+  }
+
+  SECTION("Enemies with different stats do not") {
+    Enemy second("BAT", "BAT", 20, 6, 5);
+
+    REQUIRE(&first.GetArchetype() != &second.GetArchetype());
+    REQUIRE(second.GetStrength() == 6);
+  }
+
+  SECTION("Kinds are interned once") {
+    size_t number_of_archetypes = adventure::GetNumberOfEnemyArchetypes();
+    Enemy second("BAT", "BAT", 20, 5, 5);
+
+    REQUIRE(adventure::GetNumberOfEnemyArchetypes() == number_of_archetypes);
+  }
+
+  SECTION("An Enemy is its archetype and its health") {
+    REQUIRE(sizeof(Enemy) == sizeof(void*) + sizeof(size_t));
+  }
+}
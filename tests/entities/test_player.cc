@@ -138,4 +138,47 @@ TEST_CASE("Player remove from weapons") {
                       std::invalid_argument);
     REQUIRE(player.GetWeapons().size() == 1);
   }
-}
\ No newline at end of file
+}
+TEST_CASE("Player with many weapons") {
+  std::vector<Weapon> weapons;
+  for (size_t weapon = 0; weapon < 100; ++weapon) {
+    std::string name = "W" + std::to_string(weapon);
+    weapons.push_back(Weapon(name, name, 1 + weapon, 0));
+  }
+  Player player("ENTRN", 100, 0, weapons);
+
+  SECTION("Deals damage with the strongest weapon") {
+    REQUIRE(player.DealDamage(50) == 100);
+  }
+
+  SECTION("Strongest weapon removed") {
+    player.RemoveWeapon(player.RetrieveWeapon("W99"));
+
+    REQUIRE(player.DealDamage(50) == 99);
+    REQUIRE_THROWS_AS(player.RetrieveWeapon("W99"), std::invalid_argument);
+  }
+
+  SECTION("Duplicate weapon rejected") {
+    REQUIRE_THROWS_AS(player.AddWeapon(Weapon("W50", "W50", 1, 0)),
+                      std::invalid_argument);
+    REQUIRE(player.GetWeapons().size() == 100);
+  }
+}
+
+TEST_CASE("Player weapon limit") {
+  Player player;
+
+  SECTION("Default limit") {
+    REQUIRE(player.GetMaxWeapons() == Player::kDefaultMaxWeapons);
+  }
+
+  SECTION("Limit raised") {
+    player.SetMaxWeapons(1000);
+
+    REQUIRE(player.GetMaxWeapons() == 1000);
+  }
+
+  SECTION("Limit equals zero") {
+    REQUIRE_THROWS_AS(player.SetMaxWeapons(0), std::invalid_argument);
+  }
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <items/inventory.h>
+
+#include <string>
+#include <vector>
+
+using adventure::Inventory;
+using adventure::Weapon;
+
+TEST_CASE("Inventory strongest weapon") {
+  std::vector<Weapon> weapons{Weapon("DAGGER", "DAGGR", 5, 5),
+                              Weapon("SWORD", "SWORD", 15, 5),
+                              Weapon("CLUB", "CLUB", 15, 5)};
+  Inventory inventory(weapons.begin(), weapons.end());
+
+  SECTION("First of the strongest") {
+    REQUIRE(inventory.GetStrongest() == 1);
+  }
+
+  SECTION("Stronger weapon added") {
+    inventory.Insert(3, Weapon("AXE", "AXE", 20, 5));
+
+    REQUIRE(inventory.GetStrongest() == 3);
+  }
+
+  SECTION("Equally strong weapon inserted in front") {
+    inventory.Insert(0, Weapon("AXE", "AXE", 15, 5));
+
+    REQUIRE(inventory.GetStrongest() == 0);
+  }
+
+  SECTION("Strongest weapon removed") {
+    inventory.Erase(1);
+
+    REQUIRE(inventory.GetStrongest() == 1);
+    REQUIRE(inventory.GetWeapons()[1].GetName() == "CLUB");
+  }
+
+  SECTION("Every weapon removed") {
+    inventory.Erase(0);
+    inventory.Erase(0);
+    inventory.Erase(0);
+
+    REQUIRE(inventory.GetStrongest() == Inventory::kNotFound);
+  }
+
+  SECTION("Index out of range") {
+    REQUIRE_THROWS_AS(inventory.Insert(4, Weapon("AXE", "AXE", 20, 5)),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(inventory.Erase(3), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Inventory beyond the inline weapons") {
+  Inventory inventory;
+  for (size_t weapon = 0; weapon < 64; ++weapon) {
+    std::string name = "W" + std::to_string(weapon);
+    inventory.Insert(weapon, Weapon(name, name, 1 + weapon % 40, 5));
+  }
+
+  SECTION("Weapons move to the heap") {
+    REQUIRE(inventory.GetWeapons().size() == 64);
+    REQUIRE_FALSE(inventory.GetWeapons().IsInline());
+  }
+
+  SECTION("Found by name and nickname") {
+    REQUIRE(inventory.FindName("W0") == 0);
+    REQUIRE(inventory.FindNickname("W63") == 63);
+    REQUIRE(inventory.FindName("W64") == Inventory::kNotFound);
+    REQUIRE(inventory.GetStrongest() == 39);
+  }
+
+  SECTION("Index follows removals") {
+    inventory.Erase(0);
+    inventory.Erase(38);
+
+    REQUIRE(inventory.FindName("W0") == Inventory::kNotFound);
+    REQUIRE(inventory.FindName("W1") == 0);
+    REQUIRE(inventory.FindNickname("W63") == 61);
+    REQUIRE(inventory.GetStrongest() == 37);
+    REQUIRE(inventory.GetWeapons()[37].GetName() == "W38");
+  }
+
+  SECTION("Index follows insertions in front") {
+    inventory.Insert(0, Weapon("AXE", "AXE", 40, 5));
+    inventory.Insert(10, Weapon("W5", "W5", 1, 5));
+
+    REQUIRE(inventory.FindName("AXE") == 0);
+    REQUIRE(inventory.FindName("W0") == 1);
+    REQUIRE(inventory.FindName("W5") == 6);
+    REQUIRE(inventory.FindNickname("W63") == 65);
+    REQUIRE(inventory.GetStrongest() == 0);
+  }
+
+  SECTION("Index matches a scan with repeated names") {
+    // Every other weapon shares one of three names
+    for (size_t round = 0; round < 40; ++round) {
+      std::string name = "R" + std::to_string(round % 3);
+      size_t size = inventory.GetWeapons().size();
+
+      if (round % 4 == 3) {
+        inventory.Erase((round * 7) % size);
+      } else {
+        inventory.Insert((round * 5) % (size + 1),
+                         Weapon(name, name, 1 + round % 45, 5));
+      }
+
+      const Inventory::Weapons& weapons = inventory.GetWeapons();
+      for (size_t weapon = 0; weapon < weapons.size(); ++weapon) {
+        size_t first = 0;
+        while (weapons[first].GetName() != weapons[weapon].GetName()) {
+          ++first;
+        }
+        REQUIRE(inventory.FindName(weapons[weapon].GetName()) == first);
+        REQUIRE(inventory.FindNickname(weapons[weapon].GetNickname()) ==
+                first);
+
+        size_t strongest = inventory.GetStrongest();
+        REQUIRE((weapons[weapon].GetStrength() <
+                     weapons[strongest].GetStrength() ||
+                 (weapons[weapon].GetStrength() ==
+                      weapons[strongest].GetStrength() &&
+                  weapon >= strongest)));
+      }
+    }
+  }
+
+  SECTION("Index dropped once the weapons fit inline") {
+    while (inventory.GetWeapons().size() > Inventory::kInlineWeapons) {
+      inventory.Erase(0);
+    }
+
+    REQUIRE(inventory.FindName("W60") == 0);
+    REQUIRE(inventory.FindNickname("W63") == 3);
+    REQUIRE(inventory.GetStrongest() == 3);
+  }
+
+  SECTION("Copies keep the index") {
+    Inventory copy = inventory;
+    inventory.Erase(0);
+
+    REQUIRE(copy.FindName("W0") == 0);
+    REQUIRE(copy.GetStrongest() == 39);
+  }
+}
+
+TEST_CASE("Inventory within the inline weapons") {
+  Inventory inventory;
+  inventory.Insert(0, Weapon("SWORD", "SWORD", 15, 5));
+  inventory.Insert(1, Weapon("BOW", "BOW", 10, 25));
+
+  REQUIRE(inventory.GetWeapons().IsInline());
+  REQUIRE(inventory.FindNickname("BOW") == 1);
+  REQUIRE(inventory.FindName("AXE") == Inventory::kNotFound);
+}
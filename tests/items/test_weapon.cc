@@ -40,4 +40,25 @@ TEST_CASE("Weapon calculate damage") {
 
     REQUIRE(weapon.CalculateDamage() == (2 * weapon.GetStrength()));
   }
-}
\ No newline at end of file
+}
+TEST_CASE("Weapon archetype") {
+  Weapon first("SWORD", "SWORD", 5, 5);
+
+  SECTION("Weapons of the same kind share an archetype") {
+    Weapon second("SWORD", "SWORD", 5, 5);
+
+    REQUIRE(&first.GetArchetype() == &second.GetArchetype());
+    REQUIRE(&first.GetNickname() == &second.GetNickname());
+  }
+
+  SECTION("Weapons with different stats do not") {
+    Weapon second("SWORD", "SWORD", 5, 6);
+
+    REQUIRE(&first.GetArchetype() != &second.GetArchetype());
+    REQUIRE(second.GetCriticalChance() == 6);
+  }
+
+  SECTION("A Weapon is only its archetype") {
+    REQUIRE(sizeof(Weapon) == sizeof(void*));
+  }
+}
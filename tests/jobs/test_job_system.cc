@@ -0,0 +1,180 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <jobs/job_system.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using adventure::CancellationToken;
+using adventure::JobHandle;
+using adventure::JobPriority;
+using adventure::JobSystem;
+
+TEST_CASE("Job system submit") {
+  SECTION("Runs on workers") {
+    JobSystem jobs(4);
+    std::atomic<size_t> count(0);
+
+    std::vector<JobHandle> handles;
+    for (size_t job = 0; job < 1000; ++job) {
+      handles.push_back(jobs.Submit([&count] { ++count; }));
+    }
+    for (const JobHandle& handle : handles) {
+      jobs.Wait(handle);
+    }
+
+    REQUIRE(count == 1000);
+    REQUIRE(handles.front().IsFinished());
+    REQUIRE_FALSE(handles.front().WasCanceled());
+  }
+
+  SECTION("No workers edge case") {
+    JobSystem jobs(0);
+    size_t count = 0;
+
+    JobHandle handle = jobs.Submit([&count] { ++count; });
+    REQUIRE_FALSE(handle.IsFinished());
+
+    jobs.Wait(handle);
+    REQUIRE(count == 1);
+  }
+
+  SECTION("Invalid handle edge case") {
+    JobSystem jobs(1);
+    JobHandle handle;
+
+    REQUIRE_FALSE(handle.IsValid());
+    REQUIRE(handle.IsFinished());
+    REQUIRE_NOTHROW(jobs.Wait(handle));
+  }
+
+  SECTION("Error is rethrown on wait") {
+    JobSystem jobs(2);
+
+    JobHandle handle = jobs.Submit([] {
+      throw std::invalid_argument("FAILED");
+    });
+
+    REQUIRE_THROWS_AS(jobs.Wait(handle), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Job system nested jobs") {
+  SECTION("Jobs spawned from jobs are stolen") {
+    JobSystem jobs(4);
+    std::atomic<size_t> count(0);
+
+    JobHandle root = jobs.Submit([&jobs, &count] {
+      std::vector<JobHandle> children;
+      for (size_t job = 0; job < 10000; ++job) {
+        children.push_back(jobs.Submit([&count] { ++count; }));
+      }
+      for (const JobHandle& child : children) {
+        jobs.Wait(child);
+      }
+    });
+    jobs.Wait(root);
+
+    REQUIRE(count == 10000);
+  }
+}
+
+TEST_CASE("Job system priorities") {
+  SECTION("Higher priority runs first") {
+    JobSystem jobs(0);
+    std::vector<int> order;
+
+    JobHandle low = jobs.Submit([&order] { order.push_back(3); },
+                                JobPriority::kLow);
+    jobs.Submit([&order] { order.push_back(2); }, JobPriority::kNormal);
+    jobs.Submit([&order] { order.push_back(1); }, JobPriority::kHigh);
+
+    jobs.Wait(low);
+    REQUIRE(order == std::vector<int>({1, 2, 3}));
+  }
+}
+
+TEST_CASE("Job system cancellation") {
+  SECTION("Canceled before starting") {
+    JobSystem jobs(0);
+    CancellationToken token;
+    bool has_run = false;
+
+    JobHandle handle = jobs.Submit([&has_run] { has_run = true; },
+                                   JobPriority::kNormal, token);
+    token.Cancel();
+    jobs.Wait(handle);
+
+    REQUIRE(token.IsCanceled());
+    REQUIRE(handle.IsFinished());
+    REQUIRE(handle.WasCanceled());
+    REQUIRE_FALSE(has_run);
+  }
+
+  SECTION("Copies share the flag") {
+    CancellationToken token;
+    CancellationToken copy = token;
+
+    copy.Cancel();
+    REQUIRE(token.IsCanceled());
+  }
+}
+
+TEST_CASE("Job system continuations") {
+  SECTION("Runs after the predecessor") {
+    JobSystem jobs(2);
+    std::vector<int> order;
+
+    JobHandle first = jobs.Submit([&order] { order.push_back(1); });
+    JobHandle second = jobs.Then(first, [&order] { order.push_back(2); });
+    jobs.Wait(second);
+
+    REQUIRE(order == std::vector<int>({1, 2}));
+  }
+
+  SECTION("Runs after every predecessor") {
+    JobSystem jobs(4);
+    std::atomic<size_t> count(0);
+    size_t count_seen = 0;
+
+    std::vector<JobHandle> predecessors;
+    for (size_t job = 0; job < 100; ++job) {
+      predecessors.push_back(jobs.Submit([&count] { ++count; }));
+    }
+    JobHandle after = jobs.Then(predecessors, [&count, &count_seen] {
+      count_seen = count;
+    });
+    jobs.Wait(after);
+
+    REQUIRE(count_seen == 100);
+  }
+
+  SECTION("Runs after a canceled predecessor") {
+    JobSystem jobs(0);
+    CancellationToken token;
+    bool has_run = false;
+
+    token.Cancel();
+    JobHandle first = jobs.Submit([] {}, JobPriority::kNormal, token);
+    JobHandle second = jobs.Then(first, [&has_run] { has_run = true; });
+    jobs.Wait(second);
+
+    REQUIRE(first.WasCanceled());
+    REQUIRE(has_run);
+  }
+
+  SECTION("Finished predecessor edge case") {
+    JobSystem jobs(1);
+    bool has_run = false;
+
+    JobHandle first = jobs.Submit([] {});
+    jobs.Wait(first);
+    JobHandle second = jobs.Then(first, [&has_run] { has_run = true; });
+    jobs.Wait(second);
+
+    REQUIRE(has_run);
+  }
+}
@@ -0,0 +1,52 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <jobs/work_stealing_deque.h>
+
+using adventure::WorkStealingDeque;
+
+TEST_CASE("Work stealing deque pop") {
+  WorkStealingDeque<int> deque;
+  int item = 0;
+
+  SECTION("Empty edge case") {
+    REQUIRE(deque.empty());
+    REQUIRE_FALSE(deque.Pop(item));
+  }
+
+  SECTION("Most recent first") {
+    deque.Push(1);
+    deque.Push(2);
+    deque.Push(3);
+
+    REQUIRE(deque.size() == 3);
+    REQUIRE(deque.Pop(item));
+    REQUIRE(item == 3);
+    REQUIRE(deque.Pop(item));
+    REQUIRE(item == 2);
+  }
+}
+
+TEST_CASE("Work stealing deque steal") {
+  WorkStealingDeque<int> deque;
+  int item = 0;
+
+  SECTION("Empty edge case") {
+    REQUIRE_FALSE(deque.Steal(item));
+  }
+
+  SECTION("Oldest first") {
+    deque.Push(1);
+    deque.Push(2);
+    deque.Push(3);
+
+    REQUIRE(deque.Steal(item));
+    REQUIRE(item == 1);
+    REQUIRE(deque.Pop(item));
+    REQUIRE(item == 3);
+    REQUIRE(deque.Steal(item));
+    REQUIRE(item == 2);
+    REQUIRE(deque.empty());
+  }
+}
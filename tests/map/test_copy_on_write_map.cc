@@ -0,0 +1,104 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <map/copy_on_write_map.h>
+
+#include <fstream>
+
+using adventure::CopyOnWriteMap;
+using adventure::Dungeon;
+using adventure::Room;
+
+TEST_CASE("CopyOnWriteMap constructor") {
+  SECTION("Successful") {
+    CopyOnWriteMap map(std::make_shared<const Dungeon>());
+
+    REQUIRE(map.empty());
+    REQUIRE(map.GetNumberOfModifiedRooms() == 0);
+  }
+
+  SECTION("Dungeon not specified") {
+    REQUIRE_THROWS_AS(CopyOnWriteMap(std::shared_ptr<const Dungeon>()),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("CopyOnWriteMap modify") {
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+  std::shared_ptr<Dungeon> dungeon = std::make_shared<Dungeon>();
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> *dungeon;
+
+    input_file.close();
+  }
+
+  CopyOnWriteMap first(dungeon);
+  CopyOnWriteMap second(dungeon);
+
+  SECTION("Reads come from the dungeon") {
+    REQUIRE(first.size() == dungeon->GetMap().size());
+    REQUIRE(&first.at(1) == &dungeon->GetMap()[1]);
+  }
+
+  SECTION("Writes copy only the modified room") {
+    first.Modify(1).IncrementNumberOfKeys();
+
+    REQUIRE(first.GetNumberOfModifiedRooms() == 1);
+    REQUIRE(first.at(1).GetNumberOfKeys() == 2);
+    REQUIRE(&first.at(2) == &dungeon->GetMap()[2]);
+  }
+
+  SECTION("Maps sharing a dungeon stay independent") {
+    first.Modify(1).IncrementNumberOfKeys();
+
+    REQUIRE(second.at(1).GetNumberOfKeys() == 1);
+    REQUIRE(dungeon->GetMap()[1].GetNumberOfKeys() == 1);
+  }
+
+  SECTION("Modified references stay valid") {
+    Room& room = first.Modify(1);
+
+    for (size_t index = 0; index < first.size(); ++index) {
+      first.Modify(index);
+    }
+
+    REQUIRE(&room == &first.at(1));
+  }
+
+  SECTION("Iteration yields modified rooms") {
+    first.Modify(2).IncrementNumberOfKeys();
+
+    size_t keys = 0;
+    for (const Room& room : first) {
+      keys += room.GetNumberOfKeys();
+    }
+
+    REQUIRE(keys == 3);
+  }
+
+  SECTION("Modified room indices are sorted") {
+    first.Modify(2);
+    first.Modify(0);
+
+    REQUIRE(first.GetModifiedRoomIndices() == std::vector<size_t>({0, 2}));
+  }
+
+  SECTION("Reset reads from the dungeon again") {
+    first.Modify(1).IncrementNumberOfKeys();
+    first.Reset();
+
+    REQUIRE(first.GetNumberOfModifiedRooms() == 0);
+    REQUIRE(&first.at(1) == &dungeon->GetMap()[1]);
+  }
+
+  SECTION("Index out of range") {
+    REQUIRE_THROWS_AS(first.at(first.size()), std::out_of_range);
+    REQUIRE_THROWS_AS(first.Modify(first.size()), std::out_of_range);
+  }
+}
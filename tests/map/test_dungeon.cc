@@ -3,8 +3,10 @@
 #include <catch2/catch.hpp>
 
 #include <map/dungeon.h>
+#include <memory/allocation_counter.h>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 using adventure::Enemy;
 
@@ -14,6 +16,53 @@ using adventure::Door;
 using adventure::Dungeon;
 using adventure::Room;
 
+using adventure::GetNumberOfAllocations;
+using adventure::IsCountingAllocations;
+
+namespace {
+
+// A corridor of rooms with names too long to fit inside a std::string, each
+// with doors to its neighbours, three BATs, and a SWORD
+std::string GenerateDungeon(size_t number_of_rooms) {
+  std::ostringstream os;
+  os << "DUNGEON_LOAD_FINAL_PROJECT\n{\n  [\n";
+
+  for (size_t room = 0; room < number_of_rooms; ++room) {
+    os << "    {\n      THE GENERATED ROOM NUMBER " << room << "\n      R"
+       << room << "\n      [\n";
+    if (room + 1 < number_of_rooms) {
+      os << "        {\n          UP\n          R" << room + 1
+         << "\n          FALSE\n        }\n";
+    }
+    if (room > 0) {
+      os << "        {\n          DOWN\n          R" << room - 1
+         << "\n          FALSE\n        }\n";
+    }
+    os << "      ]\n      [\n";
+    for (size_t enemy = 0; enemy < 3; ++enemy) {
+      os << "        {\n          BAT\n          BAT\n          20\n"
+            "          5\n          5\n        }\n";
+    }
+    os << "      ]\n      [\n        {\n          SWORD\n          SWORD\n"
+          "          20\n          5\n        }\n      ]\n      1\n    }\n";
+  }
+
+  os << "  ]\n}\n";
+  return os.str();
+}
+
+// The heap allocations made while loading a dungeon of the given size
+size_t CountLoadAllocations(size_t number_of_rooms) {
+  std::istringstream is(GenerateDungeon(number_of_rooms));
+  Dungeon dungeon;
+
+  size_t allocations = GetNumberOfAllocations();
+  is >> dungeon;
+  return GetNumberOfAllocations() - allocations;
+}
+
+}   // namespace
+
 TEST_CASE("Dungeon constructor") {
   SECTION("Successful") {
     Dungeon dungeon;
@@ -122,4 +171,92 @@ TEST_CASE("Dungeon operator>> overload") {
       REQUIRE(map_room.GetNumberOfKeys() == actual.GetNumberOfKeys());
     }
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Dungeon find room index") {
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\UIUC\\"
+                         "2020-2021\\Spring 2021\\CS 126\\Cinder\\my-projects\\"
+                         "final-project-fvial2\\resources\\test.txt";
+  Dungeon dungeon;
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> dungeon;
+
+    input_file.close();
+  }
+
+  SECTION("Successful") {
+    REQUIRE(dungeon.FindRoomIndex("ENTRN") == 0);
+    REQUIRE(dungeon.FindRoomIndex("SKLTN") == 4);
+  }
+
+  SECTION("Room name not specified") {
+    REQUIRE_THROWS_AS(dungeon.FindRoomIndex(""), std::invalid_argument);
+  }
+
+  SECTION("Room not found") {
+    REQUIRE_THROWS_AS(dungeon.FindRoomIndex("VOID"), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Dungeon arena") {
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\UIUC\\"
+                         "2020-2021\\Spring 2021\\CS 126\\Cinder\\my-projects\\"
+                         "final-project-fvial2\\resources\\test.txt";
+  Dungeon dungeon;
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> dungeon;
+
+    input_file.close();
+  }
+
+  // Every section looks at the Rooms, which are not there without the file
+  REQUIRE(dungeon.GetMap().size() == 5);
+
+  SECTION("Rooms are placed in the arena") {
+    const Room& entrance = dungeon.GetMap()[0];
+
+    REQUIRE(dungeon.GetArena().GetNumberOfBlocks() == 1);
+    REQUIRE(entrance.GetDoors().get_allocator().GetArena() ==
+            &dungeon.GetArena());
+  }
+
+  SECTION("Copies are placed on the heap") {
+    Dungeon copy(dungeon);
+    const Room& entrance = copy.GetMap()[0];
+
+    REQUIRE(copy.GetArena().GetNumberOfBlocks() == 0);
+    REQUIRE(entrance.GetDoors().get_allocator().GetArena() == nullptr);
+    REQUIRE(entrance.GetDoors().size() == 4);
+    REQUIRE(copy.FindRoomIndex("SKLTN") == 4);
+  }
+
+  SECTION("Copies of rooms are placed on the heap") {
+    Room room = dungeon.GetMap()[2];
+    room.RemoveEnemyAt(0);
+
+    REQUIRE(room.GetEnemies().get_allocator().GetArena() == nullptr);
+    REQUIRE(dungeon.GetMap()[2].GetEnemies().size() == 1);
+  }
+}
+
+TEST_CASE("Dungeon load allocations") {
+  if (!IsCountingAllocations()) {
+    WARN("Allocations are not counted in this build");
+    return;
+  }
+
+  // Rooms are moved into place and their lists go into the arena, so the
+  // only allocation a Room makes on its own is for a name too long to fit
+  // inside a std::string. Everything else is a handful of arena blocks and
+  // the map growing
+  size_t small = CountLoadAllocations(10);
+  size_t large = CountLoadAllocations(1000);
+
+  REQUIRE(small <= 10 + 32);
+  REQUIRE(large <= 1000 + 32);
+  REQUIRE(large - small <= 990 + 16);
+}
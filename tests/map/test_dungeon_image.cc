@@ -0,0 +1,123 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <map/dungeon_image.h>
+#include <persistence/temporary_directory.h>
+
+#include <fstream>
+#include <string>
+
+using adventure::Enemy;
+
+using adventure::Weapon;
+
+using adventure::Dungeon;
+using adventure::DungeonImage;
+
+using adventure::TemporaryDirectory;
+
+namespace {
+
+const std::string kDirectoryPrefix = "dungeon-image-test";
+
+}   // namespace
+
+TEST_CASE("Dungeon image") {
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+  Dungeon dungeon;
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> dungeon;
+
+    input_file.close();
+  }
+
+  TemporaryDirectory directory(kDirectoryPrefix);
+  const std::string kImagePath = directory.GetPath() + "/dungeon.img";
+
+  DungeonImage::Write(dungeon, kImagePath);
+
+  SECTION("Matches the dungeon") {
+    DungeonImage image(kImagePath);
+
+    REQUIRE(image.GetNumberOfRooms() == dungeon.GetMap().size());
+    for (size_t room = 0; room < dungeon.GetMap().size(); ++room) {
+      const adventure::Room& source = dungeon.GetMap()[room];
+
+      REQUIRE(image.GetRoomName(room) == source.GetName());
+      REQUIRE(image.FindRoomIndex(source.GetNickname()) == room);
+      REQUIRE(image.GetNumberOfKeys(room) == source.GetNumberOfKeys());
+      REQUIRE(image.GetNumberOfDoors(room) == source.GetDoors().size());
+      REQUIRE(image.GetNumberOfEnemies(room) == source.GetEnemies().size());
+      REQUIRE(image.GetNumberOfWeapons(room) == source.GetWeapons().size());
+
+      for (size_t door = 0; door < source.GetDoors().size(); ++door) {
+        REQUIRE(image.GetDoorDirection(room, door) ==
+                source.GetDoors()[door].GetDirection());
+        REQUIRE(image.IsDoorLocked(room, door) ==
+                source.GetDoors()[door].IsLocked());
+      }
+    }
+  }
+
+  SECTION("Doors lead to room indices") {
+    DungeonImage image(kImagePath);
+    size_t entrance = image.FindRoomIndex("ENTRN");
+    size_t sword = image.GetAdjacentRoomIndex(
+        entrance, image.FindDoorIndex(entrance, "UP"));
+
+    REQUIRE(image.GetRoomNickname(sword) == "SWORD");
+    REQUIRE(image.GetAdjacentRoomIndex(sword, 0) == entrance);
+  }
+
+  SECTION("Items are read out of the image") {
+    DungeonImage image(kImagePath);
+    Weapon weapon = image.GetWeapon(image.FindRoomIndex("SWORD"), 0);
+    Enemy enemy = image.GetEnemy(image.FindRoomIndex("BOW"), 0);
+
+    REQUIRE(weapon.GetName() == "SWORD");
+    REQUIRE(weapon.GetStrength() == 20);
+    REQUIRE(enemy.GetNickname() == "BLOB");
+  }
+
+  SECTION("Room not found") {
+    DungeonImage image(kImagePath);
+
+    REQUIRE_THROWS_AS(image.FindRoomIndex("HALL"), std::invalid_argument);
+    REQUIRE_THROWS_AS(image.GetRoomName(image.GetNumberOfRooms()),
+                      std::invalid_argument);
+  }
+
+  SECTION("Door not found") {
+    DungeonImage image(kImagePath);
+
+    REQUIRE_THROWS_AS(image.FindDoorIndex(0, "BACK"), std::invalid_argument);
+    REQUIRE_THROWS_AS(image.IsDoorLocked(0, 4), std::invalid_argument);
+  }
+
+  SECTION("Truncated image") {
+    std::string bytes;
+    {
+      std::ifstream image_file(kImagePath, std::ios::binary);
+      bytes.assign(std::istreambuf_iterator<char>(image_file),
+                   std::istreambuf_iterator<char>());
+    }
+    {
+      std::ofstream image_file(kImagePath,
+                               std::ios::binary | std::ios::trunc);
+      image_file.write(bytes.data(), (std::streamsize)bytes.size() / 2);
+    }
+
+    REQUIRE_THROWS_AS(DungeonImage(kImagePath), std::invalid_argument);
+  }
+
+  SECTION("Dungeon map has no rooms") {
+    REQUIRE_THROWS_AS(DungeonImage::Write(Dungeon(), kImagePath),
+                      std::invalid_argument);
+  }
+}
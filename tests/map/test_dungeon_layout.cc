@@ -0,0 +1,152 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <map/dungeon_layout.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+using adventure::Dungeon;
+using adventure::DungeonLayout;
+using adventure::GridPosition;
+
+namespace {
+
+// A corridor of rooms, each with a door UP to the next and DOWN to the last
+std::string GenerateCorridor(size_t number_of_rooms) {
+  std::ostringstream os;
+  os << "DUNGEON_LOAD_FINAL_PROJECT\n{\n  [\n";
+
+  for (size_t room = 0; room < number_of_rooms; ++room) {
+    os << "    {\n      ROOM " << room << "\n      R" << room
+       << "\n      [\n";
+    if (room + 1 < number_of_rooms) {
+      os << "        {\n          UP\n          R" << room + 1
+         << "\n          FALSE\n        }\n";
+    }
+    if (room > 0) {
+      os << "        {\n          DOWN\n          R" << room - 1
+         << "\n          FALSE\n        }\n";
+    }
+    os << "      ]\n      [\n      ]\n      [\n      ]\n      0\n    }\n";
+  }
+
+  os << "  ]\n}\n";
+  return os.str();
+}
+
+}   // namespace
+
+TEST_CASE("Dungeon layout") {
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+  Dungeon dungeon;
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> dungeon;
+
+    input_file.close();
+  }
+
+  DungeonLayout layout(dungeon);
+
+  SECTION("Places every room by its doors") {
+    REQUIRE(layout.size() == dungeon.GetMap().size());
+
+    const GridPosition& entrance = layout.GetPosition(
+        dungeon.FindRoomIndex("ENTRN"));
+    const GridPosition& sword = layout.GetPosition(
+        dungeon.FindRoomIndex("SWORD"));
+    const GridPosition& bow = layout.GetPosition(
+        dungeon.FindRoomIndex("BOW"));
+    const GridPosition& bat = layout.GetPosition(
+        dungeon.FindRoomIndex("BAT"));
+    const GridPosition& skeleton = layout.GetPosition(
+        dungeon.FindRoomIndex("SKLTN"));
+
+    REQUIRE((entrance.x == 0 && entrance.y == 0));
+    REQUIRE((sword.x == 0 && sword.y == -1));
+    REQUIRE((bow.x == 0 && bow.y == 1));
+    REQUIRE((bat.x == -1 && bat.y == 0));
+    REQUIRE((skeleton.x == 1 && skeleton.y == 0));
+  }
+
+  SECTION("Bounds every room") {
+    REQUIRE(layout.GetMinimum().x == -1);
+    REQUIRE(layout.GetMinimum().y == -1);
+    REQUIRE(layout.GetMaximum().x == 1);
+    REQUIRE(layout.GetMaximum().y == 1);
+  }
+
+  SECTION("Finds only the rooms inside a window") {
+    std::vector<size_t> rooms;
+
+    layout.FindRooms(GridPosition{0, -1}, GridPosition{1, 0}, rooms);
+    std::sort(rooms.begin(), rooms.end());
+
+    std::vector<size_t> expected{dungeon.FindRoomIndex("ENTRN"),
+                                 dungeon.FindRoomIndex("SWORD"),
+                                 dungeon.FindRoomIndex("SKLTN")};
+    std::sort(expected.begin(), expected.end());
+
+    REQUIRE(rooms == expected);
+
+    layout.FindRooms(GridPosition{5, 5}, GridPosition{9, 9}, rooms);
+    REQUIRE(rooms.empty());
+  }
+
+  SECTION("Position out of range") {
+    REQUIRE_THROWS_AS(layout.GetPosition(dungeon.GetMap().size()),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("Dungeon layout of a corridor") {
+  size_t number_of_rooms = 1000;
+  std::istringstream is(GenerateCorridor(number_of_rooms));
+  Dungeon dungeon;
+  is >> dungeon;
+
+  DungeonLayout layout(dungeon);
+
+  SECTION("Runs the corridor upwards") {
+    for (size_t room = 0; room < number_of_rooms; ++room) {
+      REQUIRE(layout.GetPosition(room).x == 0);
+      REQUIRE(layout.GetPosition(room).y == -(int32_t)room);
+    }
+  }
+
+  SECTION("Finds a window across buckets") {
+    std::vector<size_t> rooms;
+
+    layout.FindRooms(GridPosition{-3, -520}, GridPosition{3, -500}, rooms);
+    std::sort(rooms.begin(), rooms.end());
+
+    REQUIRE(rooms.size() == 21);
+    REQUIRE(rooms.front() == 500);
+    REQUIRE(rooms.back() == 520);
+  }
+
+  SECTION("Places unconnected rooms past the others") {
+    Dungeon separate;
+    std::string text = GenerateCorridor(3);
+    // Cutting the doors between the second and third rooms splits them
+    size_t up = text.find("UP\n          R2");
+    text.replace(up, 2, "NOWHERE");
+    size_t down = text.find("DOWN\n          R1");
+    text.replace(down, 4, "NOWHERE");
+
+    std::istringstream is_separate(text);
+    is_separate >> separate;
+    DungeonLayout separate_layout(separate);
+
+    REQUIRE(separate_layout.GetPosition(1).x == 0);
+    REQUIRE(separate_layout.GetPosition(2).x == 2);
+    REQUIRE(separate_layout.GetPosition(2).y == -1);
+  }
+}
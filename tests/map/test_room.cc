@@ -10,6 +10,7 @@ using adventure::Weapon;
 
 using adventure::Door;
 using adventure::Room;
+using adventure::SlotHandle;
 
 TEST_CASE("Room constructor") {
   std::vector<Door> doors = {Door("RIGHT", "SKLKE", false)};
@@ -109,24 +110,31 @@ TEST_CASE("Room remove from weapons") {
   Room room("ENTRANCE", "ENTRN", doors, enemies, weapons, 5);
 
   SECTION("Successful") {
-    room.RemoveWeapon(Weapon("SWORD", "SWORD", 5, 5));
+    room.RemoveWeapon(room.FindWeapon("SWORD"));
     
     REQUIRE(room.GetWeapons().empty());
   }
 
-  SECTION("Weapons empty") {
-    room.RemoveWeapon(Weapon("SWORD", "SWORD", 5, 5));
-    
-    REQUIRE_THROWS_AS(room.RemoveWeapon(Weapon("SWORD", "SWORD", 5, 5)),
-                      std::invalid_argument);
-    REQUIRE(room.GetWeapons().empty());
+  SECTION("Stale handle") {
+    SlotHandle sword = room.FindWeapon("SWORD");
+    room.RemoveWeapon(sword);
+    room.AddWeapon(Weapon("SWORD", "SWORD", 5, 5));
+
+    REQUIRE_THROWS_AS(room.RemoveWeapon(sword), std::invalid_argument);
+    REQUIRE(room.GetWeapons().size() == 1);
   }
 
   SECTION("Weapons not found") {
-    REQUIRE_THROWS_AS(room.RemoveWeapon(Weapon("BOW", "BOW", 5, 5)),
-                      std::invalid_argument);
+    REQUIRE_THROWS_AS(room.FindWeapon("BOW"), std::invalid_argument);
     REQUIRE(room.GetWeapons().size() == 1);
   }
+
+  SECTION("Removed by index") {
+    room.RemoveWeaponAt(0);
+
+    REQUIRE(room.GetWeapons().empty());
+    REQUIRE_THROWS_AS(room.RemoveWeaponAt(0), std::invalid_argument);
+  }
 }
 
 TEST_CASE("Room remove from enemies") {
@@ -138,26 +146,91 @@ TEST_CASE("Room remove from enemies") {
   Room room("ENTRANCE", "ENTRN", doors, enemies, weapons, 5);
 
   SECTION("Successful") {
-    room.RemoveEnemy(Enemy("SKELETON", "SKLTN", 5, 5, 5));
+    room.RemoveEnemy(room.FindEnemy("SKLTN"));
 
     REQUIRE(room.GetEnemies().empty());
   }
 
-  SECTION("Enemies empty") {
-    room.RemoveEnemy(Enemy("SKELETON", "SKLTN", 5, 5, 5));
+  SECTION("Stale handle") {
+    SlotHandle skeleton = room.FindEnemy("SKLTN");
+    room.RemoveEnemy(skeleton);
 
-    REQUIRE_THROWS_AS(room.RemoveEnemy(Enemy("SKELETON", "SKLTN", 5, 5, 5)),
-                      std::invalid_argument);
+    REQUIRE_THROWS_AS(room.RemoveEnemy(skeleton), std::invalid_argument);
+    REQUIRE_THROWS_AS(room.RetrieveEnemy(skeleton), std::invalid_argument);
     REQUIRE(room.GetEnemies().empty());
   }
 
   SECTION("Enemy not found") {
-    REQUIRE_THROWS_AS(room.RemoveEnemy(Enemy("BAT", "BAT", 5, 5, 5)),
-                      std::invalid_argument);
+    REQUIRE_THROWS_AS(room.FindEnemy("BAT"), std::invalid_argument);
     REQUIRE(room.GetEnemies().size() == 1);
   }
 }
 
+TEST_CASE("Room enemies with the same name") {
+  std::vector<Enemy> enemies = {Enemy("BAT", "BAT", 10, 5, 5),
+                                Enemy("BAT", "BAT", 20, 5, 5),
+                                Enemy("BAT", "BAT", 30, 5, 5)};
+
+  Room room("CAVE", "CAVE", std::vector<Door>(), enemies,
+            std::vector<Weapon>(), 0);
+
+  SECTION("Removes exactly the handled Enemy") {
+    room.RemoveEnemy(room.FindEnemy("BAT"));
+
+    REQUIRE(room.GetEnemies().size() == 2);
+    REQUIRE(room.GetEnemies()[0].GetHealth() == 30);
+    REQUIRE(room.GetEnemies()[1].GetHealth() == 20);
+  }
+
+  SECTION("Handles follow their Enemy when it is moved") {
+    SlotHandle first = room.FindEnemy("BAT");
+    room.InsertEnemy(0, Enemy("BAT", "BAT", 40, 5, 5));
+
+    REQUIRE(room.GetEnemyIndex(first) == 3);
+    REQUIRE(room.RetrieveEnemy(first).GetHealth() == 10);
+  }
+
+  SECTION("Counted by kind") {
+    Enemy blob("BLOB", "BLOB", 30, 15, 10);
+    room.InsertEnemy(1, blob);
+
+    REQUIRE(room.CountEnemies(room.GetEnemies()[0].GetArchetype()) == 1);
+    REQUIRE(room.CountEnemies(blob.GetArchetype()) == 1);
+    REQUIRE(room.CountEnemies(Enemy("BAT", "BAT", 20, 5, 5).GetArchetype()) ==
+            1);
+  }
+
+  SECTION("Counts follow removals and insertions") {
+    Enemy blob("BLOB", "BLOB", 30, 15, 10);
+    room.InsertEnemy(0, blob);
+    room.InsertEnemy(2, blob);
+    room.RemoveEnemy(room.FindEnemy("BLOB"));
+
+    REQUIRE(room.CountEnemies(blob.GetArchetype()) == 1);
+
+    room.RemoveEnemyAt(room.GetEnemyIndex(room.FindEnemy("BLOB")));
+
+    REQUIRE(room.CountEnemies(blob.GetArchetype()) == 0);
+    REQUIRE(room.GetEnemies().size() == 3);
+
+    Room copy = room;
+    copy.InsertEnemy(3, blob);
+
+    REQUIRE(copy.CountEnemies(blob.GetArchetype()) == 1);
+    REQUIRE(room.CountEnemies(blob.GetArchetype()) == 0);
+  }
+
+  SECTION("Inserting undoes removing") {
+    Enemy middle = room.GetEnemies()[1];
+    room.RemoveEnemyAt(1);
+    room.InsertEnemy(1, middle);
+
+    REQUIRE(room.GetEnemies()[0].GetHealth() == 10);
+    REQUIRE(room.GetEnemies()[1].GetHealth() == 20);
+    REQUIRE(room.GetEnemies()[2].GetHealth() == 30);
+  }
+}
+
 TEST_CASE("Room retrieve weapon") {
   std::vector<Door> doors = {Door("RIGHT", "SKLKE", false)};
   std::vector<Enemy> enemies = {Enemy("SKELETON", "SKLTN", 5, 5, 5)};
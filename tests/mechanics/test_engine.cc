@@ -3,6 +3,9 @@
 #include <catch2/catch.hpp>
 
 #include <mechanics/engine.h>
+#include <memory/allocation_counter.h>
+
+#include <sstream>
 
 using adventure::Enemy;
 using adventure::Player;
@@ -13,7 +16,49 @@ using adventure::Door;
 using adventure::Dungeon;
 using adventure::Room;
 
+using adventure::Command;
+using adventure::DeltaType;
 using adventure::Engine;
+using adventure::Random;
+
+using adventure::GetNumberOfAllocations;
+using adventure::IsCountingAllocations;
+
+namespace {
+
+// Executes a random command with a qualifier the sub-panels could offer, so
+// that no command throws. Qualifiers are read straight out of the game, so
+// picking one allocates nothing either
+void ExecuteRandomCommand(Engine& engine, Random& random) {
+  static const std::string kKey = "KEY";
+  static const std::string kNone = "";
+
+  const Player& player = engine.GetPlayer();
+  const Room& room = engine.FindRoom(player.GetCurrentLocation());
+  Command command = (Command)random.Roll(6);
+
+  if (command == Command::kFight && !room.GetEnemies().empty()) {
+    size_t enemy = random.Roll(room.GetEnemies().size());
+    engine.Execute(command, room.GetEnemies()[enemy].GetNickname());
+  } else if (command == Command::kTake && !room.GetWeapons().empty() &&
+             random.Roll(2) == 0) {
+    size_t weapon = random.Roll(room.GetWeapons().size());
+    engine.Execute(command, room.GetWeapons()[weapon].GetNickname());
+  } else if (command == Command::kDrop && !player.GetWeapons().empty() &&
+             random.Roll(2) == 0) {
+    size_t weapon = random.Roll(player.GetWeapons().size());
+    engine.Execute(command, player.GetWeapons()[weapon].GetNickname());
+  } else if (command == Command::kGo && !room.GetDoors().empty()) {
+    size_t door = random.Roll(room.GetDoors().size());
+    engine.Execute(command, room.GetDoors()[door].GetDirection());
+  } else if (command == Command::kTake || command == Command::kDrop) {
+    engine.Execute(command, kKey);
+  } else {
+    engine.Execute(command, kNone);
+  }
+}
+
+}   // namespace
 
 TEST_CASE("Engine constructor") {
   std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
@@ -36,11 +81,75 @@ TEST_CASE("Engine constructor") {
     REQUIRE_NOTHROW(Engine(player, dungeon));
   }
 
+  SECTION("Taking ownership of a dungeon copies no rooms") {
+    std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                           "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                           "my-projects\\final-project-fvial2\\resources\\"
+                           "test.txt";
+    Dungeon dungeon;
+
+    std::ifstream input_file(filepath);
+    if (input_file.is_open()) {
+      input_file >> dungeon;
+
+      input_file.close();
+    }
+
+    const Room* entrance = &dungeon.GetMap().front();
+    Engine engine(player, std::move(dungeon));
+
+    REQUIRE(&engine.GetMap().front() == entrance);
+    REQUIRE(engine.GetMap().GetDungeon().GetArena().GetNumberOfBlocks() == 1);
+  }
+
   SECTION("Dungeon map has no rooms") {
     REQUIRE_THROWS_AS(Engine(player, Dungeon()),std::invalid_argument);
   }
 }
 
+TEST_CASE("Engine sessions sharing a dungeon") {
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player player("ENTRN", 100, 1, valid_weapons);
+
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+  std::shared_ptr<Dungeon> dungeon = std::make_shared<Dungeon>();
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> *dungeon;
+
+    input_file.close();
+  }
+
+  Engine first(player, dungeon);
+  Engine second(player, dungeon);
+
+  SECTION("New sessions copy no rooms") {
+    REQUIRE(first.GetMap().GetNumberOfModifiedRooms() == 0);
+    REQUIRE(&first.GetMap().front() == &second.GetMap().front());
+  }
+
+  SECTION("Moving copies no rooms") {
+    first.SetQualifier("UP");
+    first.Go();
+
+    REQUIRE(first.GetMap().GetNumberOfModifiedRooms() == 0);
+  }
+
+  SECTION("Changes stay within their session") {
+    first.SetQualifier("KEY");
+    first.Drop();
+
+    REQUIRE(first.GetMap().GetNumberOfModifiedRooms() == 1);
+    REQUIRE(first.GetMap().front().GetNumberOfKeys() == 1);
+    REQUIRE(second.GetMap().front().GetNumberOfKeys() == 0);
+    REQUIRE(dungeon->GetMap().front().GetNumberOfKeys() == 0);
+  }
+}
+
 TEST_CASE("Engine go") {
   std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
   Player player("ENTRN", 100, 0, valid_weapons);
@@ -170,6 +279,20 @@ TEST_CASE("Engine take") {
     REQUIRE(engine.GetMap().at(2).GetWeapons().size() == 1);
     REQUIRE(engine.GetMessage() == "YOU ARE CARRYING TOO MANY WEAPONS");
   }
+
+  SECTION("Weapon limit raised") {
+    player.SetMaxWeapons(5);
+    Engine looting(player, dungeon);
+
+    looting.Execute(Command::kGo, "UP");
+    looting.Execute(Command::kTake, "SWORD");
+    looting.Execute(Command::kGo, "DOWN");
+    looting.Execute(Command::kGo, "DOWN");
+    looting.Execute(Command::kTake, "BOW");
+
+    REQUIRE(looting.GetPlayer().GetWeapons().size() == 5);
+    REQUIRE(looting.GetMessage() == "YOU TOOK THE BOW");
+  }
 }
 
 TEST_CASE("Engine drop") {
@@ -225,3 +348,389 @@ TEST_CASE("Engine drop") {
     REQUIRE(engine.GetMessage() == "THERE ARE NO ITEMS ON YOUR PERSON");
   }
 }
+
+TEST_CASE("Engine fight") {
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player player("ENTRN", 100, 1, valid_weapons);
+  Dungeon dungeon;
+
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> dungeon;
+
+    input_file.close();
+  }
+
+  Engine engine(player, dungeon);
+
+  SECTION("There are no enemies in this room") {
+    engine.SetQualifier("BLOB");
+    engine.Fight();
+
+    REQUIRE(engine.GetPlayer().GetHealth() == 100);
+    REQUIRE(engine.GetMessage() == "THERE ARE NO ENEMIES IN THIS ROOM");
+  }
+
+  SECTION("Fighting with no weapons") {
+    engine.SetQualifier("SPELL");
+    engine.Drop();
+
+    engine.SetQualifier("DOWN");
+    engine.Go();
+
+    engine.SetQualifier("BLOB");
+    engine.Fight();
+
+    REQUIRE(engine.GetPlayer().GetHealth() == 100);
+    REQUIRE(engine.GetMap().at(2).GetEnemies().front().GetHealth() == 30);
+    REQUIRE(engine.GetMessage() == "YOU HAVE NO WEAPONS");
+  }
+}
+
+TEST_CASE("Engine undo and redo") {
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player player("ENTRN", 100, 1, valid_weapons);
+  Dungeon dungeon;
+
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> dungeon;
+
+    input_file.close();
+  }
+
+  Engine engine(player, dungeon);
+
+  SECTION("Nothing to undo") {
+    engine.Undo();
+
+    REQUIRE(engine.GetMessage() == "THERE IS NOTHING TO UNDO");
+  }
+
+  SECTION("Nothing to redo") {
+    engine.Redo();
+
+    REQUIRE(engine.GetMessage() == "THERE IS NOTHING TO REDO");
+  }
+
+  SECTION("Undo go") {
+    engine.SetQualifier("UP");
+    engine.Go();
+    engine.Undo();
+
+    REQUIRE(engine.GetPlayer().GetCurrentLocation() == "ENTRN");
+    REQUIRE(engine.GetMessage() == "YOU UNDID YOUR LAST ACTION");
+
+    engine.Redo();
+
+    REQUIRE(engine.GetPlayer().GetCurrentLocation() == "SWORD");
+    REQUIRE(engine.GetMessage() == "YOU REDID YOUR LAST ACTION");
+  }
+
+  SECTION("Undo unlock") {
+    engine.SetQualifier("LEFT");
+    engine.Go();
+    engine.Undo();
+
+    REQUIRE(engine.GetMap().front().GetDoors()[2].IsLocked());
+    REQUIRE(engine.GetPlayer().GetNumberOfKeys() == 1);
+  }
+
+  SECTION("Undo take weapon") {
+    engine.SetQualifier("DOWN");
+    engine.Go();
+
+    engine.SetQualifier("BOW");
+    engine.Take();
+    engine.Undo();
+
+    REQUIRE(engine.GetPlayer().GetWeapons().size() == 1);
+    REQUIRE(engine.GetMap().at(2).GetWeapons().front().GetName() == "BOW");
+
+    engine.Redo();
+
+    REQUIRE(engine.GetPlayer().GetWeapons().size() == 2);
+    REQUIRE(engine.GetMap().at(2).GetWeapons().empty());
+  }
+
+  SECTION("Undo drop key") {
+    engine.SetQualifier("KEY");
+    engine.Drop();
+    engine.Undo();
+
+    REQUIRE(engine.GetPlayer().GetNumberOfKeys() == 1);
+    REQUIRE(engine.GetMap().front().GetNumberOfKeys() == 0);
+  }
+
+  SECTION("Undo fight") {
+    engine.SetQualifier("DOWN");
+    engine.Go();
+
+    engine.SetQualifier("BLOB");
+    engine.Fight();
+
+    size_t health = engine.GetPlayer().GetHealth();
+    size_t enemies = engine.GetMap().at(2).GetEnemies().size();
+
+    engine.Undo();
+
+    REQUIRE(engine.GetPlayer().GetHealth() == 100);
+    REQUIRE(engine.GetMap().at(2).GetEnemies().size() == 1);
+    REQUIRE(engine.GetMap().at(2).GetEnemies().front().GetHealth() == 30);
+
+    engine.Redo();
+
+    REQUIRE(engine.GetPlayer().GetHealth() == health);
+    REQUIRE(engine.GetMap().at(2).GetEnemies().size() == enemies);
+  }
+
+  SECTION("Undo several commands") {
+    engine.SetQualifier("UP");
+    engine.Go();
+    engine.SetQualifier("SWORD");
+    engine.Take();
+
+    engine.Undo();
+    engine.Undo();
+
+    REQUIRE(engine.GetPlayer().GetCurrentLocation() == "ENTRN");
+    REQUIRE(engine.GetPlayer().GetWeapons().size() == 1);
+    REQUIRE(engine.GetMap().at(1).GetWeapons().size() == 1);
+  }
+
+  SECTION("Last deltas follow the last command") {
+    engine.Execute(Command::kGo, "LEFT");
+
+    REQUIRE(engine.GetLastDeltas().size() == 2);
+    REQUIRE(engine.GetLastDeltas()[0].type == DeltaType::kLockSwitched);
+    REQUIRE(engine.GetLastDeltas()[1].type == DeltaType::kPlayerKeys);
+
+    engine.Execute(Command::kUndo, "");
+
+    REQUIRE(engine.GetLastDeltas().size() == 2);
+
+    engine.Execute(Command::kUndo, "");
+
+    REQUIRE(engine.GetMessage() == "THERE IS NOTHING TO UNDO");
+    REQUIRE(engine.GetLastDeltas().empty());
+  }
+}
+
+TEST_CASE("Engine save and restore") {
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player player("ENTRN", 1000, 1, valid_weapons);
+  Dungeon dungeon;
+
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> dungeon;
+
+    input_file.close();
+  }
+
+  Engine engine(player, dungeon);
+  engine.SetRandomState(7);
+  engine.Execute(Command::kGo, "UP");
+  engine.Execute(Command::kTake, "SWORD");
+  engine.Execute(Command::kGo, "DOWN");
+  engine.Execute(Command::kGo, "DOWN");
+
+  // Fights until the Enemy falls, so the snapshot holds a fallen Enemy
+  for (size_t round = 0;
+       round < 100 && !engine.GetMap().at(2).GetEnemies().empty(); ++round) {
+    engine.Execute(Command::kFight, "BLOB");
+  }
+
+  std::stringstream stream;
+  stream << engine;
+
+  SECTION("Successful") {
+    Engine restored(player, dungeon);
+    stream >> restored;
+
+    REQUIRE(restored.ComputeChecksum() == engine.ComputeChecksum());
+    REQUIRE(restored.GetPlayer().GetMaxHealth() == 1000);
+    REQUIRE(restored.GetPlayer().GetMaxWeapons() ==
+            Player::kDefaultMaxWeapons);
+    REQUIRE(restored.GetMap().GetNumberOfModifiedRooms() ==
+            engine.GetMap().GetNumberOfModifiedRooms());
+  }
+
+  SECTION("Undo and redo behave the same after a restore") {
+    Engine restored(player, dungeon);
+    stream >> restored;
+
+    engine.Execute(Command::kUndo, "");
+    restored.Execute(Command::kUndo, "");
+
+    REQUIRE(restored.GetMap().at(2).GetEnemies().size() == 1);
+    REQUIRE(restored.ComputeChecksum() == engine.ComputeChecksum());
+
+    engine.Execute(Command::kRedo, "");
+    restored.Execute(Command::kRedo, "");
+
+    REQUIRE(restored.ComputeChecksum() == engine.ComputeChecksum());
+  }
+
+  SECTION("Weapon limit kept") {
+    player.SetMaxWeapons(50);
+    Engine looting(player, dungeon);
+    std::stringstream looting_stream;
+    looting_stream << looting;
+
+    Engine restored(Player(), dungeon);
+    looting_stream >> restored;
+
+    REQUIRE(restored.GetPlayer().GetMaxWeapons() == 50);
+  }
+
+  SECTION("Dungeon does not match snapshot") {
+    Dungeon other;
+    std::stringstream other_stream("DUNGEON_LOAD_FINAL_PROJECT\n"
+                                   "    {\n"
+                                   "      ENTRANCE\n"
+                                   "      ENTRN\n"
+                                   "      EMPTY\n"
+                                   "      EMPTY\n"
+                                   "      EMPTY\n"
+                                   "      0\n"
+                                   "    }\n");
+    other_stream >> other;
+    Engine restored(player, other);
+
+    REQUIRE_THROWS_AS(stream >> restored, std::invalid_argument);
+  }
+
+  SECTION("Invalid snapshot") {
+    Engine restored(player, dungeon);
+    std::stringstream invalid("NOT A SNAPSHOT");
+
+    REQUIRE_THROWS_AS(invalid >> restored, std::invalid_argument);
+    REQUIRE(restored.GetPlayer().GetCurrentLocation() == "ENTRN");
+  }
+}
+
+TEST_CASE("Engine revision") {
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player player("ENTRN", 100, 1, valid_weapons);
+  Dungeon dungeon;
+
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> dungeon;
+
+    input_file.close();
+  }
+
+  Engine engine(player, dungeon);
+  uint64_t revision = engine.GetRevision();
+
+  SECTION("Reading leaves it unchanged") {
+    engine.FindRoom("ENTRN");
+    engine.GetMap();
+    engine.ComputeChecksum();
+
+    REQUIRE(engine.GetRevision() == revision);
+  }
+
+  SECTION("Every command changes it") {
+    engine.Execute(Command::kGo, "UP");
+    REQUIRE(engine.GetRevision() > revision);
+
+    revision = engine.GetRevision();
+    engine.Execute(Command::kUndo, "");
+    REQUIRE(engine.GetRevision() > revision);
+
+    // Even a command that fails changes the message
+    revision = engine.GetRevision();
+    engine.Execute(Command::kUndo, "");
+    REQUIRE(engine.GetMessage() == "THERE IS NOTHING TO UNDO");
+    REQUIRE(engine.GetRevision() > revision);
+  }
+
+  SECTION("Setting the message changes it") {
+    engine.SetMessage("WHAT WILL YOU DO?");
+
+    REQUIRE(engine.GetRevision() > revision);
+  }
+
+  SECTION("Setting the same message leaves it unchanged") {
+    engine.SetMessage("WHAT WILL YOU DO?");
+    revision = engine.GetRevision();
+
+    engine.SetMessage("WHAT WILL YOU DO?");
+    engine.SetMessage(std::string("WHAT WILL YOU DO?"));
+
+    REQUIRE(engine.GetRevision() == revision);
+  }
+
+  SECTION("Restoring changes it") {
+    std::stringstream stream;
+    stream << engine;
+
+    Engine restored(player, dungeon);
+    uint64_t restored_revision = restored.GetRevision();
+    stream >> restored;
+
+    REQUIRE(restored.GetRevision() > restored_revision);
+  }
+}
+
+TEST_CASE("Engine steady state allocations") {
+  if (!IsCountingAllocations()) {
+    WARN("Allocations are not counted in this build");
+    return;
+  }
+
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player player("ENTRN", 1000, 0, valid_weapons);
+
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+  Dungeon dungeon;
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> dungeon;
+
+    input_file.close();
+  }
+
+  Engine engine(player, std::move(dungeon));
+  Random random(42);
+
+  // Warming up copies every Room the commands change out of the Dungeon
+  // and fills the Journal once
+  for (size_t command = 0; command < 2000; ++command) {
+    ExecuteRandomCommand(engine, random);
+  }
+
+  size_t allocations = GetNumberOfAllocations();
+  for (size_t command = 0; command < 20000; ++command) {
+    ExecuteRandomCommand(engine, random);
+  }
+
+  REQUIRE(GetNumberOfAllocations() == allocations);
+}
@@ -0,0 +1,321 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <mechanics/game_controller.h>
+#include <memory/allocation_counter.h>
+
+#include <fstream>
+#include <sstream>
+
+using adventure::Player;
+using adventure::Weapon;
+
+using adventure::Dungeon;
+
+using adventure::Engine;
+using adventure::GameController;
+using adventure::GameSnapshot;
+using adventure::Key;
+using adventure::SubPanel;
+
+using adventure::Random;
+
+using adventure::GetNumberOfAllocations;
+using adventure::IsCountingAllocations;
+
+namespace {
+
+Engine LoadTestEngine(size_t health = 100) {
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player player("ENTRN", health, 0, valid_weapons);
+
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+  Dungeon dungeon;
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> dungeon;
+
+    input_file.close();
+  }
+
+  return Engine(player, dungeon);
+}
+
+// A single room holding the given number of tough enemies, E0, E1, and so on
+Engine LoadCrowdedEngine(size_t number_of_enemies) {
+  std::ostringstream os;
+  os << "DUNGEON_LOAD_FINAL_PROJECT\n{\n  [\n    {\n      CROWDED ROOM\n"
+        "      CROWD\n      [\n      ]\n      [\n";
+  for (size_t enemy = 0; enemy < number_of_enemies; ++enemy) {
+    os << "        {\n          ENEMY\n          E" << enemy
+       << "\n          1000\n          1\n          0\n        }\n";
+  }
+  os << "      ]\n      [\n      ]\n      0\n    }\n  ]\n}\n";
+
+  std::istringstream is(os.str());
+  Dungeon dungeon;
+  is >> dungeon;
+
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  return Engine(Player("CROWD", 100, 0, valid_weapons), dungeon);
+}
+
+/**
+ * Picks a key for a random walk through the game that backs out of every
+ * fight in the last room, so the game is never won and every key keeps
+ * playing it.
+ */
+Key PickRandomKey(const GameSnapshot& snapshot, Random& random) {
+  const Key kKeys[] = {Key::kLeft, Key::kRight, Key::kReturn};
+  const Key kRetreatKeys[] = {Key::kLeft, Key::kRight, Key::kEscape};
+
+  if (snapshot.sub_panel == SubPanel::kEnemies &&
+      snapshot.player.GetCurrentLocation() == "SKLTN") {
+    return kRetreatKeys[random.Roll(3)];
+  }
+
+  return kKeys[random.Roll(3)];
+}
+
+}   // namespace
+
+TEST_CASE("Game controller constructor") {
+  GameController controller(LoadTestEngine());
+  GameSnapshot snapshot;
+  controller.FillSnapshot(snapshot);
+
+  SECTION("Successful") {
+    REQUIRE(snapshot.message == "WHAT WILL YOU DO?");
+    REQUIRE(snapshot.main_selection == 0);
+    REQUIRE_FALSE(snapshot.has_toggled_panels);
+    REQUIRE(snapshot.sub_panel == SubPanel::kNone);
+    REQUIRE(snapshot.player.GetCurrentLocation() == "ENTRN");
+  }
+
+  SECTION("Marks the locked doors") {
+    // The entrance's LEFT and RIGHT doors, its third and fourth, are locked
+    REQUIRE(snapshot.locked_doors == 12);
+  }
+}
+
+TEST_CASE("Game controller moving the selection") {
+  GameController controller(LoadTestEngine());
+  GameSnapshot snapshot;
+
+  SECTION("Right") {
+    controller.HandleKey(Key::kRight);
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE(snapshot.main_selection == 1);
+  }
+
+  SECTION("Right wraps around") {
+    for (size_t press = 0; press < 4; ++press) {
+      controller.HandleKey(Key::kRight);
+    }
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE(snapshot.main_selection == 0);
+  }
+
+  SECTION("Left wraps around") {
+    controller.HandleKey(Key::kLeft);
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE(snapshot.main_selection == 3);
+  }
+
+  SECTION("Leaves the game unchanged") {
+    controller.FillSnapshot(snapshot);
+    uint64_t revision = snapshot.engine_revision;
+
+    controller.HandleKey(Key::kRight);
+    controller.HandleKey(Key::kLeft);
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE(snapshot.engine_revision == revision);
+  }
+}
+
+TEST_CASE("Game controller executing commands") {
+  GameController controller(LoadTestEngine());
+  GameSnapshot snapshot;
+
+  SECTION("Toggles the sub-panels") {
+    controller.HandleKey(Key::kLeft);
+    controller.HandleKey(Key::kReturn);
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE(snapshot.has_toggled_panels);
+    REQUIRE(snapshot.sub_panel == SubPanel::kDoors);
+    REQUIRE(snapshot.doors.size() == 4);
+    REQUIRE(snapshot.doors[0].GetDirection() == "UP");
+  }
+
+  SECTION("Executes the selected sub-action") {
+    controller.HandleKey(Key::kLeft);
+    controller.HandleKey(Key::kReturn);
+    controller.HandleKey(Key::kReturn);
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE_FALSE(snapshot.has_toggled_panels);
+    REQUIRE(snapshot.sub_panel == SubPanel::kNone);
+    REQUIRE(snapshot.player.GetCurrentLocation() == "SWORD");
+    REQUIRE(snapshot.message == "YOU WENT UP");
+  }
+
+  SECTION("Lists the Room's Weapons to take") {
+    controller.HandleKey(Key::kLeft);
+    controller.HandleKey(Key::kReturn);
+    controller.HandleKey(Key::kReturn);
+    controller.HandleKey(Key::kRight);
+    controller.HandleKey(Key::kRight);
+    controller.HandleKey(Key::kReturn);
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE(snapshot.sub_panel == SubPanel::kWeapons);
+    REQUIRE(snapshot.weapons.size() == 1);
+    REQUIRE(snapshot.weapons[0].GetNickname() == "SWORD");
+  }
+
+  SECTION("No sub-actions edge case") {
+    controller.HandleKey(Key::kReturn);
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE_FALSE(snapshot.has_toggled_panels);
+    REQUIRE(snapshot.message == "THERE ARE NO ENEMIES IN THIS ROOM");
+  }
+}
+
+TEST_CASE("Game controller paging the sub-actions") {
+  GameController controller(LoadCrowdedEngine(10));
+  GameSnapshot snapshot;
+
+  // Opens the list of enemies to fight
+  controller.HandleKey(Key::kReturn);
+
+  SECTION("Copies only the first page") {
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE(snapshot.sub_panel == SubPanel::kEnemies);
+    REQUIRE(snapshot.number_of_sub_actions == 10);
+    REQUIRE(snapshot.first_sub_action == 0);
+    REQUIRE(snapshot.enemies.size() == GameSnapshot::kSubPanelPageSize);
+    REQUIRE(snapshot.enemies[0].GetNickname() == "E0");
+  }
+
+  SECTION("Turns the page with the selection") {
+    for (size_t key = 0; key < GameSnapshot::kSubPanelPageSize; ++key) {
+      controller.HandleKey(Key::kRight);
+    }
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE(snapshot.sub_selection == 4);
+    REQUIRE(snapshot.first_sub_action == 4);
+    REQUIRE(snapshot.enemies[0].GetNickname() == "E4");
+  }
+
+  SECTION("Wraps around to the last page") {
+    controller.HandleKey(Key::kLeft);
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE(snapshot.sub_selection == 9);
+    REQUIRE(snapshot.first_sub_action == 8);
+    REQUIRE(snapshot.enemies.size() == 2);
+    REQUIRE(snapshot.enemies[1].GetNickname() == "E9");
+  }
+
+  SECTION("Down stops at the last sub-action") {
+    controller.HandleKey(Key::kDown);
+    controller.HandleKey(Key::kDown);
+    controller.HandleKey(Key::kDown);
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE(snapshot.sub_selection == 9);
+    REQUIRE(snapshot.first_sub_action == 8);
+  }
+
+  SECTION("Up stops at the first sub-action") {
+    controller.HandleKey(Key::kRight);
+    controller.HandleKey(Key::kDown);
+    controller.HandleKey(Key::kUp);
+    controller.HandleKey(Key::kUp);
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE(snapshot.sub_selection == 0);
+  }
+
+  SECTION("Fights the selected enemy on a later page") {
+    controller.HandleKey(Key::kDown);
+    controller.HandleKey(Key::kReturn);
+
+    const adventure::Room& room = controller.GetEngine().FindRoom("CROWD");
+    REQUIRE(room.GetEnemies()[4].GetHealth() < 1000);
+    REQUIRE(room.GetEnemies()[3].GetHealth() == 1000);
+  }
+
+  SECTION("Up and down leave the main selection alone") {
+    controller.HandleKey(Key::kEscape);
+    controller.HandleKey(Key::kDown);
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE_FALSE(snapshot.has_toggled_panels);
+    REQUIRE(snapshot.main_selection == 0);
+    REQUIRE(snapshot.number_of_sub_actions == 0);
+  }
+}
+
+TEST_CASE("Game controller escape") {
+  GameController controller(LoadTestEngine());
+
+  SECTION("Closes the sub-panels") {
+    GameSnapshot snapshot;
+
+    controller.HandleKey(Key::kLeft);
+    controller.HandleKey(Key::kReturn);
+    controller.HandleKey(Key::kEscape);
+    controller.FillSnapshot(snapshot);
+
+    REQUIRE_FALSE(snapshot.has_toggled_panels);
+    REQUIRE_FALSE(controller.IsQuitRequested());
+  }
+
+  SECTION("Asks to quit") {
+    controller.HandleKey(Key::kEscape);
+
+    REQUIRE(controller.IsQuitRequested());
+  }
+}
+
+TEST_CASE("Game controller steady state allocations") {
+  if (!IsCountingAllocations()) {
+    WARN("Allocations are not counted in this build");
+    return;
+  }
+
+  // Healthy enough that the game is not over before the measurement ends
+  GameController controller(LoadTestEngine(1000000));
+  GameSnapshot snapshot;
+  Random random(42);
+
+  // Every frame fills a snapshot and presses a key. The warm-up is long
+  // enough for every room to be copied and every list to reach its longest
+  for (size_t frame = 0; frame < 20000; ++frame) {
+    controller.HandleKey(PickRandomKey(snapshot, random));
+    controller.FillSnapshot(snapshot);
+  }
+
+  size_t allocations = GetNumberOfAllocations();
+  for (size_t frame = 0; frame < 20000; ++frame) {
+    controller.HandleKey(PickRandomKey(snapshot, random));
+    controller.FillSnapshot(snapshot);
+  }
+
+  REQUIRE(GetNumberOfAllocations() == allocations);
+  REQUIRE_FALSE(controller.IsQuitRequested());
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <mechanics/game_thread.h>
+
+#include <fstream>
+
+using adventure::Player;
+using adventure::Weapon;
+
+using adventure::Dungeon;
+
+using adventure::Engine;
+using adventure::GameController;
+using adventure::GameSnapshot;
+using adventure::GameThread;
+using adventure::Key;
+
+TEST_CASE("Game thread") {
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player player("ENTRN", 100, 0, valid_weapons);
+
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+  Dungeon dungeon;
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> dungeon;
+
+    input_file.close();
+  }
+
+  std::unique_ptr<GameController> controller(
+      new GameController(Engine(player, dungeon)));
+
+  SECTION("Publishes the starting state") {
+    GameThread game(std::move(controller));
+
+    REQUIRE(game.GetSnapshot().version == 1);
+    REQUIRE(game.GetSnapshot().message == "WHAT WILL YOU DO?");
+  }
+
+  SECTION("Publishes the state after keys") {
+    GameThread game(std::move(controller));
+
+    REQUIRE(game.PushKey(Key::kLeft));
+    REQUIRE(game.PushKey(Key::kReturn));
+    REQUIRE(game.PushKey(Key::kReturn));
+
+    while (game.GetSnapshot().player.GetCurrentLocation() != "SWORD") {
+      game.UpdateSnapshot();
+    }
+
+    REQUIRE(game.GetSnapshot().message == "YOU WENT UP");
+    REQUIRE(game.GetSnapshot().version > 1);
+  }
+
+  SECTION("Stop finishes the queued keys") {
+    GameThread game(std::move(controller));
+
+    game.PushKey(Key::kRight);
+    game.Stop();
+
+    GameSnapshot snapshot;
+    game.GetController().FillSnapshot(snapshot);
+    REQUIRE(snapshot.main_selection == 1);
+  }
+
+  SECTION("Controller not specified") {
+    REQUIRE_THROWS_AS(GameThread(std::unique_ptr<GameController>()),
+                      std::invalid_argument);
+  }
+}
@@ -0,0 +1,183 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <mechanics/journal.h>
+
+#include <sstream>
+
+using adventure::Delta;
+using adventure::DeltaType;
+using adventure::Journal;
+
+TEST_CASE("Journal constructor") {
+  SECTION("Successful") {
+    Journal journal(8);
+
+    REQUIRE(journal.GetCapacity() == 8);
+    REQUIRE(journal.GetSize() == 0);
+    REQUIRE_FALSE(journal.CanUndo());
+    REQUIRE_FALSE(journal.CanRedo());
+  }
+
+  SECTION("Zero capacity records nothing") {
+    Journal journal(0);
+
+    journal.BeginCommand();
+    journal.Record(Delta{DeltaType::kLocation, 0, 0, 0, 1});
+
+    REQUIRE(journal.GetSize() == 0);
+    REQUIRE_FALSE(journal.CanUndo());
+  }
+}
+
+TEST_CASE("Journal undo and redo") {
+  Journal journal(8);
+  std::vector<uint32_t> visited;
+
+  journal.BeginCommand();
+  journal.Record(Delta{DeltaType::kLocation, 0, 0, 0, 1});
+  journal.Record(Delta{DeltaType::kPlayerHealth, 0, 0, 90, 100});
+
+  SECTION("Empty commands leave no trace") {
+    journal.BeginCommand();
+
+    REQUIRE(journal.GetSize() == 3);
+  }
+
+  SECTION("Undo visits the command in reverse") {
+    journal.Undo([&](const Delta& delta) { visited.push_back(delta.after); });
+
+    REQUIRE(visited == std::vector<uint32_t>({100, 1}));
+    REQUIRE_FALSE(journal.CanUndo());
+    REQUIRE(journal.CanRedo());
+  }
+
+  SECTION("Redo visits the command in order") {
+    journal.Undo([](const Delta&) {});
+    journal.Redo([&](const Delta& delta) { visited.push_back(delta.after); });
+
+    REQUIRE(visited == std::vector<uint32_t>({1, 100}));
+    REQUIRE(journal.CanUndo());
+    REQUIRE_FALSE(journal.CanRedo());
+  }
+
+  SECTION("New commands discard the redo history") {
+    journal.Undo([](const Delta&) {});
+
+    journal.BeginCommand();
+    journal.Record(Delta{DeltaType::kLocation, 0, 0, 0, 2});
+
+    REQUIRE_FALSE(journal.CanRedo());
+    REQUIRE(journal.GetSize() == 2);
+  }
+}
+
+TEST_CASE("Journal eviction") {
+  Journal journal(4);
+
+  SECTION("Oldest commands are dropped whole") {
+    for (uint32_t command = 0; command < 3; ++command) {
+      journal.BeginCommand();
+      journal.Record(Delta{DeltaType::kLocation, 0, 0, command, command + 1});
+    }
+
+    std::vector<uint32_t> visited;
+    while (journal.CanUndo()) {
+      journal.Undo([&](const Delta& delta) {
+        visited.push_back(delta.after);
+      });
+    }
+
+    REQUIRE(visited == std::vector<uint32_t>({3, 2}));
+  }
+
+  SECTION("Commands larger than the buffer are not recorded") {
+    journal.BeginCommand();
+    for (uint32_t delta = 0; delta < 5; ++delta) {
+      journal.Record(Delta{DeltaType::kLocation, 0, 0, delta, delta + 1});
+    }
+
+    REQUIRE_FALSE(journal.CanUndo());
+  }
+
+  SECTION("A full buffer overflowed by one command") {
+    Journal full(6);
+
+    // Three commands of a marker and one Delta fill the buffer
+    for (uint32_t command = 0; command < 3; ++command) {
+      full.BeginCommand();
+      full.Record(Delta{DeltaType::kLocation, 0, 0, command, command + 1});
+    }
+    REQUIRE(full.GetSize() == 6);
+
+    // Four records only need the two oldest commands evicted
+    full.BeginCommand();
+    for (uint32_t delta = 0; delta < 3; ++delta) {
+      full.Record(Delta{DeltaType::kPlayerHealth, 0, 0, 100, 90 - delta});
+    }
+    REQUIRE(full.GetSize() == 6);
+
+    std::vector<uint32_t> visited;
+    while (full.CanUndo()) {
+      full.Undo([&](const Delta& delta) { visited.push_back(delta.after); });
+    }
+    REQUIRE(visited == std::vector<uint32_t>({88, 89, 90, 3}));
+
+    // A command that cannot fit by itself is dropped, and the next one is
+    // recorded as usual
+    while (full.CanRedo()) {
+      full.Redo([](const Delta&) {});
+    }
+    full.BeginCommand();
+    for (uint32_t delta = 0; delta < 7; ++delta) {
+      full.Record(Delta{DeltaType::kLocation, 0, 0, delta, delta + 1});
+    }
+    REQUIRE(full.GetSize() == 0);
+    REQUIRE_FALSE(full.CanUndo());
+
+    full.BeginCommand();
+    full.Record(Delta{DeltaType::kLocation, 0, 0, 7, 8});
+    REQUIRE(full.GetSize() == 2);
+    REQUIRE(full.CanUndo());
+  }
+}
+
+TEST_CASE("Journal save and restore") {
+  Journal journal(8);
+
+  for (uint32_t command = 0; command < 3; ++command) {
+    journal.BeginCommand();
+    journal.Record(Delta{DeltaType::kLocation, 0, 0, command, command + 1});
+  }
+  journal.Undo([](const Delta&) {});
+
+  std::stringstream stream;
+  stream << journal;
+
+  SECTION("Successful") {
+    Journal restored(8);
+    stream >> restored;
+
+    REQUIRE(restored.GetSize() == journal.GetSize());
+    REQUIRE(restored.CanRedo());
+
+    std::vector<uint32_t> visited;
+    restored.Redo([&](const Delta& delta) {
+      visited.push_back(delta.after);
+    });
+    while (restored.CanUndo()) {
+      restored.Undo([&](const Delta& delta) {
+        visited.push_back(delta.after);
+      });
+    }
+
+    REQUIRE(visited == std::vector<uint32_t>({3, 3, 2, 1}));
+  }
+
+  SECTION("Too large for the capacity") {
+    Journal restored(4);
+
+    REQUIRE_THROWS_AS(stream >> restored, std::invalid_argument);
+  }
+}
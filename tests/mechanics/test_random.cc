@@ -0,0 +1,43 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <mechanics/random.h>
+
+using adventure::Random;
+
+TEST_CASE("Random constructor") {
+  SECTION("Successful") {
+    Random random(5);
+
+    REQUIRE(random.GetState() == 5);
+  }
+
+  SECTION("Zero seed edge case") {
+    Random random(0);
+
+    REQUIRE(random.GetState() != 0);
+  }
+}
+
+TEST_CASE("Random roll") {
+  SECTION("Within bound") {
+    Random random(5);
+
+    for (size_t roll = 0; roll < 1000; ++roll) {
+      REQUIRE(random.Roll(100) < 100);
+    }
+  }
+
+  SECTION("Same state rolls the same") {
+    Random first(5);
+    Random second(9);
+
+    first.Roll(100);
+    second.SetState(first.GetState());
+
+    for (size_t roll = 0; roll < 10; ++roll) {
+      REQUIRE(first.Roll(100) == second.Roll(100));
+    }
+  }
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <mechanics/shared_world.h>
+
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using adventure::Player;
+using adventure::Weapon;
+
+using adventure::Dungeon;
+
+using adventure::Command;
+using adventure::SharedWorld;
+
+TEST_CASE("Shared world") {
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player player("ENTRN", 100, 1, valid_weapons);
+
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+  std::shared_ptr<Dungeon> dungeon = std::make_shared<Dungeon>();
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> *dungeon;
+
+    input_file.close();
+  }
+
+  SharedWorld world(dungeon, 8);
+  size_t first = world.AddPlayer(player);
+  size_t second = world.AddPlayer(player);
+
+  SECTION("Players act independently") {
+    world.Execute(first, Command::kGo, "UP");
+
+    REQUIRE(world.GetPlayer(first).GetCurrentLocation() == "SWORD");
+    REQUIRE(world.GetPlayer(second).GetCurrentLocation() == "ENTRN");
+    REQUIRE(world.GetMessage(first) == "YOU WENT UP");
+  }
+
+  SECTION("A taken weapon is gone for everyone") {
+    world.Execute(first, Command::kGo, "UP");
+    world.Execute(second, Command::kGo, "UP");
+    uint64_t version = world.GetRoomVersion(1);
+
+    world.Execute(first, Command::kTake, "SWORD");
+
+    REQUIRE(world.GetPlayer(first).GetWeapons().size() == 2);
+    REQUIRE(world.GetRoomVersion(1) == version + 1);
+    REQUIRE(world.CopyRoom(1).GetWeapons().empty());
+
+    REQUIRE_THROWS_AS(world.Execute(second, Command::kTake, "SWORD"),
+                      std::invalid_argument);
+    REQUIRE(world.GetPlayer(second).GetWeapons().size() == 1);
+  }
+
+  SECTION("A fallen enemy is gone for everyone") {
+    world.Execute(first, Command::kGo, "DOWN");
+    world.Execute(second, Command::kGo, "DOWN");
+
+    world.Execute(first, Command::kFight, "BLOB");
+    REQUIRE(world.GetMessage(first) == "YOU FOUGHT THE BLOB");
+
+    world.Execute(second, Command::kFight, "BLOB");
+    REQUIRE(world.GetMessage(second) == "THERE ARE NO ENEMIES IN THIS ROOM");
+  }
+
+  SECTION("An unlocked door is unlocked for everyone") {
+    world.Execute(first, Command::kGo, "LEFT");
+    REQUIRE(world.GetMessage(first) == "YOU UNLOCKED THE DOOR");
+
+    world.Execute(second, Command::kGo, "LEFT");
+    REQUIRE(world.GetPlayer(second).GetCurrentLocation() == "BAT");
+    REQUIRE(world.GetPlayer(second).GetNumberOfKeys() == 1);
+  }
+
+  SECTION("Keys are only taken from rooms that have them") {
+    world.Execute(first, Command::kDrop, "KEY");
+    world.Execute(second, Command::kTake, "KEY");
+    world.Execute(first, Command::kTake, "KEY");
+
+    REQUIRE(world.GetMessage(first) == "THERE ARE NO ITEMS IN THIS ROOM");
+    REQUIRE(world.GetPlayer(first).GetNumberOfKeys() == 0);
+    REQUIRE(world.GetPlayer(second).GetNumberOfKeys() == 2);
+  }
+
+  SECTION("Players in different rooms act in parallel") {
+    const size_t kCommands = 2000;
+
+    std::vector<size_t> players{first, second};
+    while (players.size() < 8) {
+      players.push_back(world.AddPlayer(player));
+    }
+
+    // Half the players trade keys in the entrance while the others walk
+    // between the entrance and the sword room
+    std::vector<std::thread> threads;
+    for (size_t index = 0; index < players.size(); ++index) {
+      threads.emplace_back([&world, &players, index, kCommands] {
+        for (size_t command = 0; command < kCommands; ++command) {
+          if (index % 2 == 0) {
+            world.Execute(players[index],
+                          command % 2 == 0 ? Command::kDrop : Command::kTake,
+                          "KEY");
+          } else {
+            world.Execute(players[index], Command::kGo,
+                          command % 2 == 0 ? "UP" : "DOWN");
+          }
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    size_t keys = world.CopyRoom(0).GetNumberOfKeys();
+    for (size_t id : players) {
+      keys += world.GetPlayer(id).GetNumberOfKeys();
+      REQUIRE(world.GetPlayer(id).GetCurrentLocation() == "ENTRN");
+    }
+    REQUIRE(keys == players.size());
+  }
+
+  SECTION("Undo not available") {
+    REQUIRE_THROWS_AS(world.Execute(first, Command::kUndo, ""),
+                      std::invalid_argument);
+  }
+
+  SECTION("Player not found") {
+    REQUIRE_THROWS_AS(world.Execute(2, Command::kGo, "UP"),
+                      std::invalid_argument);
+  }
+
+  SECTION("Too many players") {
+    SharedWorld small_world(dungeon, 1);
+    small_world.AddPlayer(player);
+
+    REQUIRE_THROWS_AS(small_world.AddPlayer(player), std::invalid_argument);
+  }
+}
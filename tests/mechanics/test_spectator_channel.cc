@@ -0,0 +1,143 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <mechanics/spectator_channel.h>
+#include <serialization/checksum.h>
+
+#include <fstream>
+#include <memory>
+
+using adventure::Player;
+using adventure::Weapon;
+
+using adventure::Dungeon;
+
+using adventure::Checksum;
+using adventure::Command;
+using adventure::Engine;
+using adventure::Spectator;
+using adventure::SpectatorChannel;
+
+namespace {
+
+// Hashes everything a spectator can see
+uint64_t ComputeView(const Player& player, const std::string& message,
+                     const adventure::CopyOnWriteMap& map) {
+  Checksum checksum;
+
+  checksum.Add(player);
+  checksum.Add(message);
+  checksum.Add(map);
+
+  return checksum.GetValue();
+}
+
+uint64_t ComputeView(const Engine& engine) {
+  return ComputeView(engine.GetPlayer(), engine.GetMessage(),
+                     engine.GetMap());
+}
+
+uint64_t ComputeView(const Spectator& spectator) {
+  return ComputeView(spectator.GetPlayer(), spectator.GetMessage(),
+                     spectator.GetMap());
+}
+
+void Run(SpectatorChannel& channel, Engine& engine, Command command,
+         const std::string& qualifier) {
+  engine.Execute(command, qualifier);
+  channel.Publish(engine);
+}
+
+}   // namespace
+
+TEST_CASE("Spectator channel") {
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player player("ENTRN", 100, 1, valid_weapons);
+
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+  std::shared_ptr<Dungeon> dungeon = std::make_shared<Dungeon>();
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> *dungeon;
+
+    input_file.close();
+  }
+
+  Engine engine(player, dungeon);
+  SpectatorChannel channel(64 * 1024, 1000);
+  channel.PublishKeyframe(engine);
+
+  Spectator spectator(channel, dungeon);
+
+  SECTION("Follows every kind of change") {
+    Run(channel, engine, Command::kGo, "UP");
+    Run(channel, engine, Command::kTake, "SWORD");
+    Run(channel, engine, Command::kTake, "KEY");
+    Run(channel, engine, Command::kGo, "DOWN");
+    Run(channel, engine, Command::kGo, "LEFT");
+    Run(channel, engine, Command::kGo, "DOWN");
+    Run(channel, engine, Command::kFight, "BLOB");
+    Run(channel, engine, Command::kDrop, "SWORD");
+
+    REQUIRE(spectator.Update());
+    REQUIRE(spectator.IsSynced());
+    REQUIRE(ComputeView(spectator) == ComputeView(engine));
+    REQUIRE(channel.GetNumberOfFrames() == 9);
+  }
+
+  SECTION("Follows undo and redo") {
+    Run(channel, engine, Command::kGo, "UP");
+    Run(channel, engine, Command::kTake, "SWORD");
+    Run(channel, engine, Command::kUndo, "");
+    spectator.Update();
+
+    REQUIRE(spectator.GetPlayer().GetWeapons().size() == 1);
+    REQUIRE(ComputeView(spectator) == ComputeView(engine));
+
+    Run(channel, engine, Command::kRedo, "");
+    spectator.Update();
+
+    REQUIRE(ComputeView(spectator) == ComputeView(engine));
+  }
+
+  SECTION("Late joiners start from the newest keyframe") {
+    Run(channel, engine, Command::kGo, "UP");
+    Run(channel, engine, Command::kTake, "SWORD");
+    channel.PublishKeyframe(engine);
+    Run(channel, engine, Command::kGo, "DOWN");
+
+    Spectator late(channel, dungeon);
+    REQUIRE(late.Update());
+    REQUIRE(ComputeView(late) == ComputeView(engine));
+  }
+
+  SECTION("Nothing new edge case") {
+    spectator.Update();
+
+    REQUIRE_FALSE(spectator.Update());
+  }
+
+  SECTION("Overrun spectators catch up at a keyframe") {
+    SpectatorChannel small_channel(1024, 4);
+    small_channel.PublishKeyframe(engine);
+    Spectator slow(small_channel, dungeon);
+
+    for (size_t round = 0; round < 100; ++round) {
+      Run(small_channel, engine, Command::kGo, round % 2 == 0 ? "UP" : "DOWN");
+    }
+    slow.Update();
+
+    REQUIRE(slow.GetNumberOfOverruns() > 0);
+    REQUIRE(slow.IsSynced());
+    REQUIRE(ComputeView(slow) == ComputeView(engine));
+  }
+
+  SECTION("Keyframe interval equals zero") {
+    REQUIRE_THROWS_AS(SpectatorChannel(1024, 0), std::invalid_argument);
+  }
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <memory/arena.h>
+
+#include <cstdint>
+#include <string>
+
+using adventure::Arena;
+using adventure::ArenaAllocator;
+using adventure::ArenaVector;
+
+TEST_CASE("Arena allocation") {
+  Arena arena(64);
+
+  SECTION("No blocks until the first allocation") {
+    REQUIRE(arena.GetNumberOfBlocks() == 0);
+    REQUIRE(arena.GetCapacity() == 0);
+  }
+
+  SECTION("Allocations share a block") {
+    char* first = (char*)arena.Allocate(8, 8);
+    char* second = (char*)arena.Allocate(8, 8);
+
+    REQUIRE(second == first + 8);
+    REQUIRE(arena.GetNumberOfBlocks() == 1);
+    REQUIRE(arena.GetNumberOfBytes() == 16);
+  }
+
+  SECTION("Allocations are aligned") {
+    arena.Allocate(1, 1);
+    void* aligned = arena.Allocate(16, 16);
+
+    REQUIRE((uintptr_t)aligned % 16 == 0);
+  }
+
+  SECTION("Blocks grow") {
+    for (size_t allocation = 0; allocation < 8; ++allocation) {
+      arena.Allocate(32, 8);
+    }
+
+    REQUIRE(arena.GetNumberOfBlocks() == 3);
+    REQUIRE(arena.GetCapacity() == 64 + 128 + 256);
+  }
+
+  SECTION("Large allocations get their own block") {
+    arena.Allocate(1000, 8);
+
+    REQUIRE(arena.GetNumberOfBlocks() == 1);
+    REQUIRE(arena.GetCapacity() >= 1000);
+  }
+
+  SECTION("Invalid alignment") {
+    REQUIRE_THROWS_AS(arena.Allocate(8, 3), std::invalid_argument);
+  }
+
+  SECTION("Block size equals zero") {
+    REQUIRE_THROWS_AS(Arena(0), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Arena allocator") {
+  Arena arena;
+
+  SECTION("Vectors are placed in the arena") {
+    ArenaVector<std::string> names{ArenaAllocator<std::string>(&arena)};
+    names.push_back("BAT");
+    names.push_back("BLOB");
+
+    REQUIRE(arena.GetNumberOfBlocks() == 1);
+    REQUIRE(names[1] == "BLOB");
+  }
+
+  SECTION("Copies are placed on the heap") {
+    ArenaVector<int> numbers{ArenaAllocator<int>(&arena)};
+    numbers.push_back(1);
+    size_t number_of_bytes = arena.GetNumberOfBytes();
+
+    ArenaVector<int> copy(numbers);
+    copy.push_back(2);
+
+    REQUIRE(copy.get_allocator().GetArena() == nullptr);
+    REQUIRE(arena.GetNumberOfBytes() == number_of_bytes);
+    REQUIRE(copy.size() == 2);
+  }
+
+  SECTION("Moves stay in the arena") {
+    ArenaVector<int> numbers{ArenaAllocator<int>(&arena)};
+    numbers.push_back(1);
+
+    ArenaVector<int> moved(std::move(numbers));
+
+    REQUIRE(moved.get_allocator().GetArena() == &arena);
+  }
+}
@@ -0,0 +1,109 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <memory/slot_map.h>
+
+#include <string>
+
+using adventure::Arena;
+using adventure::ArenaAllocator;
+using adventure::SlotHandle;
+using adventure::SlotMap;
+
+TEST_CASE("SlotMap insert") {
+  SlotMap<std::string> map;
+  SlotHandle sword = map.Insert("SWORD");
+  SlotHandle bow = map.Insert("BOW");
+
+  SECTION("Values are packed in order") {
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.GetValues()[0] == "SWORD");
+    REQUIRE(map.GetValues()[1] == "BOW");
+  }
+
+  SECTION("Handles name their values") {
+    REQUIRE(map.Get(sword) == "SWORD");
+    REQUIRE(map.Get(bow) == "BOW");
+    REQUIRE(map.GetIndex(bow) == 1);
+    REQUIRE(map.GetHandle(1) == bow);
+    REQUIRE(sword != bow);
+  }
+
+  SECTION("Inserted in the middle") {
+    SlotHandle axe = map.InsertAt(0, "AXE");
+
+    REQUIRE(map.GetValues()[0] == "AXE");
+    REQUIRE(map.GetValues()[2] == "SWORD");
+    REQUIRE(map.GetIndex(axe) == 0);
+    REQUIRE(map.GetIndex(sword) == 2);
+  }
+
+  SECTION("Index out of range") {
+    REQUIRE_THROWS_AS(map.InsertAt(3, "AXE"), std::invalid_argument);
+    REQUIRE_THROWS_AS(map.GetAt(2), std::invalid_argument);
+    REQUIRE_THROWS_AS(map.GetHandle(2), std::invalid_argument);
+  }
+}
+
+TEST_CASE("SlotMap remove") {
+  SlotMap<std::string> map;
+  SlotHandle sword = map.Insert("SWORD");
+  SlotHandle bow = map.Insert("BOW");
+  SlotHandle axe = map.Insert("AXE");
+
+  SECTION("The last value takes the removed value's place") {
+    map.Remove(sword);
+
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.GetValues()[0] == "AXE");
+    REQUIRE(map.GetIndex(axe) == 0);
+    REQUIRE(map.Get(bow) == "BOW");
+  }
+
+  SECTION("Removed handles are stale") {
+    map.Remove(bow);
+
+    REQUIRE_FALSE(map.Contains(bow));
+    REQUIRE_THROWS_AS(map.Get(bow), std::invalid_argument);
+    REQUIRE_THROWS_AS(map.Remove(bow), std::invalid_argument);
+  }
+
+  SECTION("Reused slots do not revive stale handles") {
+    map.Remove(bow);
+    SlotHandle spear = map.Insert("SPEAR");
+
+    REQUIRE(spear.slot == bow.slot);
+    REQUIRE(spear.generation != bow.generation);
+    REQUIRE_FALSE(map.Contains(bow));
+    REQUIRE(map.Get(spear) == "SPEAR");
+  }
+
+  SECTION("Inserting at the index undoes removing") {
+    map.RemoveAt(0);
+    map.InsertAt(0, "SWORD");
+
+    REQUIRE(map.GetValues()[0] == "SWORD");
+    REQUIRE(map.GetValues()[1] == "BOW");
+    REQUIRE(map.GetValues()[2] == "AXE");
+    REQUIRE(map.GetIndex(axe) == 2);
+  }
+
+  SECTION("Index out of range") {
+    REQUIRE_THROWS_AS(map.RemoveAt(3), std::invalid_argument);
+  }
+}
+
+TEST_CASE("SlotMap in an arena") {
+  Arena arena;
+  SlotMap<int> map((ArenaAllocator<int>(&arena)));
+  map.reserve(8);
+
+  for (int value = 0; value < 8; ++value) {
+    map.Insert(value);
+  }
+
+  REQUIRE(arena.GetNumberOfBlocks() == 1);
+  REQUIRE(map.GetValues().get_allocator().GetArena() == &arena);
+  REQUIRE(map.GetAt(7) == 7);
+}
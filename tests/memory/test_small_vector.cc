@@ -0,0 +1,100 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <memory/small_vector.h>
+
+#include <string>
+
+using adventure::SmallVector;
+
+TEST_CASE("SmallVector inline storage") {
+  SmallVector<std::string, 2> vector;
+  vector.push_back("SWORD");
+  vector.push_back("BOW");
+
+  SECTION("Fits inline") {
+    REQUIRE(vector.IsInline());
+    REQUIRE(vector.size() == 2);
+    REQUIRE(vector.front() == "SWORD");
+    REQUIRE(vector.back() == "BOW");
+  }
+
+  SECTION("Moves to the heap once it outgrows it") {
+    vector.push_back(vector[0]);
+
+    REQUIRE_FALSE(vector.IsInline());
+    REQUIRE(vector.capacity() >= 3);
+    REQUIRE(vector[0] == "SWORD");
+    REQUIRE(vector[2] == "SWORD");
+  }
+}
+
+TEST_CASE("SmallVector insert and erase") {
+  SmallVector<std::string, 4> vector;
+  vector.push_back("SWORD");
+  vector.push_back("BOW");
+
+  SECTION("Inserted in the middle") {
+    vector.insert(1, "AXE");
+
+    REQUIRE(vector.size() == 3);
+    REQUIRE(vector[1] == "AXE");
+    REQUIRE(vector[2] == "BOW");
+  }
+
+  SECTION("Erased from the middle") {
+    vector.insert(0, "AXE");
+    vector.erase(1);
+
+    REQUIRE(vector.size() == 2);
+    REQUIRE(vector[0] == "AXE");
+    REQUIRE(vector[1] == "BOW");
+  }
+
+  SECTION("Index out of range") {
+    REQUIRE_THROWS_AS(vector.insert(3, "AXE"), std::invalid_argument);
+    REQUIRE_THROWS_AS(vector.erase(2), std::invalid_argument);
+  }
+}
+
+TEST_CASE("SmallVector copy and move") {
+  SmallVector<std::string, 2> small;
+  small.push_back("SWORD");
+
+  SmallVector<std::string, 2> large;
+  for (size_t value = 0; value < 5; ++value) {
+    large.push_back(std::to_string(value));
+  }
+
+  SECTION("Copies are independent") {
+    SmallVector<std::string, 2> copy = large;
+    copy[0] = "SWORD";
+
+    REQUIRE(large[0] == "0");
+    REQUIRE(copy.size() == 5);
+
+    copy = small;
+    REQUIRE(copy.size() == 1);
+    REQUIRE(copy[0] == "SWORD");
+  }
+
+  SECTION("Moving heap storage takes it") {
+    const std::string* data = &large[0];
+    SmallVector<std::string, 2> moved = std::move(large);
+
+    REQUIRE(&moved[0] == data);
+    REQUIRE(moved.size() == 5);
+    REQUIRE(large.empty());
+    REQUIRE(large.IsInline());
+  }
+
+  SECTION("Moving inline storage moves the values") {
+    SmallVector<std::string, 2> moved;
+    moved = std::move(small);
+
+    REQUIRE(moved.IsInline());
+    REQUIRE(moved[0] == "SWORD");
+    REQUIRE(small.empty());
+  }
+}
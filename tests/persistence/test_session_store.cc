@@ -0,0 +1,243 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <persistence/session_store.h>
+#include <persistence/temporary_directory.h>
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+
+using adventure::Player;
+
+using adventure::Weapon;
+
+using adventure::Dungeon;
+
+using adventure::Command;
+using adventure::Engine;
+using adventure::SessionStore;
+using adventure::TemporaryDirectory;
+
+namespace {
+
+const std::string kDirectoryPrefix = "session-store-test";
+
+void Run(SessionStore& store, uint64_t session, Engine& engine,
+         Command command, const std::string& qualifier) {
+  engine.Execute(command, qualifier);
+  store.Record(session, command, qualifier, engine);
+}
+
+}   // namespace
+
+TEST_CASE("SessionStore recovery") {
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player player("ENTRN", 100, 1, valid_weapons);
+  Dungeon dungeon;
+
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> dungeon;
+
+    input_file.close();
+  }
+
+  Engine initial(player, dungeon);
+  TemporaryDirectory directory(kDirectoryPrefix);
+
+  // A long interval keeps the periodic snapshots out of the way
+  std::chrono::milliseconds interval = std::chrono::hours(1);
+
+  SECTION("Nothing to recover") {
+    SessionStore store(directory.GetPath(), interval);
+
+    REQUIRE(store.Recover(initial).empty());
+  }
+
+  SECTION("Recovered from the log alone") {
+    Engine engine = initial;
+    {
+      SessionStore store(directory.GetPath(), interval);
+      store.Recover(initial);
+
+      engine.SetRandomState(42);
+      store.Open(1, engine);
+      Run(store, 1, engine, Command::kGo, "UP");
+      Run(store, 1, engine, Command::kTake, "SWORD");
+      Run(store, 1, engine, Command::kGo, "DOWN");
+    }
+
+    SessionStore store(directory.GetPath(), interval);
+    std::map<uint64_t, Engine> engines = store.Recover(initial);
+
+    REQUIRE(engines.size() == 1);
+    REQUIRE(engines.at(1).ComputeChecksum() == engine.ComputeChecksum());
+  }
+
+  SECTION("Recovered from a snapshot and the log after it") {
+    Engine engine = initial;
+    {
+      SessionStore store(directory.GetPath(), interval);
+      store.Recover(initial);
+
+      store.Open(1, engine);
+      Run(store, 1, engine, Command::kGo, "UP");
+      Run(store, 1, engine, Command::kTake, "SWORD");
+      store.Snapshot(1, engine);
+      store.WaitForSnapshots();
+
+      Run(store, 1, engine, Command::kGo, "DOWN");
+      Run(store, 1, engine, Command::kGo, "DOWN");
+    }
+
+    SessionStore store(directory.GetPath(), interval);
+    std::map<uint64_t, Engine> engines = store.Recover(initial);
+
+    REQUIRE(engines.at(1).ComputeChecksum() == engine.ComputeChecksum());
+
+    SECTION("Undo behaves the same after recovery") {
+      engine.Execute(Command::kUndo, "");
+      engines.at(1).Execute(Command::kUndo, "");
+
+      REQUIRE(engines.at(1).ComputeChecksum() == engine.ComputeChecksum());
+    }
+  }
+
+  SECTION("Recovered sessions keep recording") {
+    Engine engine = initial;
+    {
+      SessionStore store(directory.GetPath(), interval);
+      store.Recover(initial);
+
+      store.Open(1, engine);
+      Run(store, 1, engine, Command::kGo, "UP");
+    }
+    {
+      SessionStore store(directory.GetPath(), interval);
+      std::map<uint64_t, Engine> engines = store.Recover(initial);
+
+      Run(store, 1, engines.at(1), Command::kTake, "SWORD");
+      engine.Execute(Command::kTake, "SWORD");
+    }
+
+    SessionStore store(directory.GetPath(), interval);
+
+    REQUIRE(store.Recover(initial).at(1).ComputeChecksum() ==
+            engine.ComputeChecksum());
+  }
+
+  SECTION("Sessions are recovered separately") {
+    Engine first = initial;
+    Engine second = initial;
+    {
+      SessionStore store(directory.GetPath(), interval);
+      store.Recover(initial);
+
+      store.Open(1, first);
+      store.Open(2, second);
+      Run(store, 1, first, Command::kGo, "UP");
+      Run(store, 2, second, Command::kGo, "DOWN");
+      Run(store, 1, first, Command::kTake, "SWORD");
+    }
+
+    SessionStore store(directory.GetPath(), interval);
+    std::map<uint64_t, Engine> engines = store.Recover(initial);
+
+    REQUIRE(engines.size() == 2);
+    REQUIRE(engines.at(1).ComputeChecksum() == first.ComputeChecksum());
+    REQUIRE(engines.at(2).ComputeChecksum() == second.ComputeChecksum());
+  }
+
+  SECTION("Session not open") {
+    SessionStore store(directory.GetPath(), interval);
+    Engine engine = initial;
+
+    REQUIRE_THROWS_AS(store.Record(1, Command::kGo, "UP", engine),
+                      std::invalid_argument);
+  }
+
+  SECTION("Session already open") {
+    SessionStore store(directory.GetPath(), interval);
+    store.Open(1, initial);
+
+    REQUIRE_THROWS_AS(store.Open(1, initial), std::invalid_argument);
+  }
+
+  SECTION("Snapshot interval not positive") {
+    REQUIRE_THROWS_AS(SessionStore(directory.GetPath(),
+                                   std::chrono::milliseconds(0)),
+                      std::invalid_argument);
+  }
+
+  SECTION("Snapshot could not be written") {
+    SessionStore store(directory.GetPath(), interval);
+    Engine engine = initial;
+    store.Open(1, engine);
+
+    // A directory in the way of the temporary file fails the write on the
+    // snapshot thread, which carries on
+    REQUIRE(adventure::MakeDirectory(directory.GetPath() +
+                                     "/session-1.snapshot.tmp"));
+    Run(store, 1, engine, Command::kGo, "UP");
+    store.Snapshot(1, engine);
+
+    REQUIRE_THROWS_AS(store.WaitForSnapshots(), std::invalid_argument);
+    REQUIRE_THROWS_AS(store.Snapshot(1, engine), std::invalid_argument);
+    REQUIRE(store.GetNumberOfSnapshots() == 0);
+  }
+}
+
+TEST_CASE("SessionStore periodic snapshots") {
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player player("ENTRN", 100, 1, valid_weapons);
+  Dungeon dungeon;
+
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> dungeon;
+
+    input_file.close();
+  }
+
+  Engine initial(player, dungeon);
+  TemporaryDirectory directory(kDirectoryPrefix);
+
+  Engine engine = initial;
+  uint64_t first_segment;
+  {
+    SessionStore store(directory.GetPath(), std::chrono::milliseconds(5));
+    store.Recover(initial);
+    store.Open(1, engine);
+
+    for (size_t round = 0; round < 20; ++round) {
+      Run(store, 1, engine, Command::kGo, round % 2 == 0 ? "UP" : "DOWN");
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    store.WaitForSnapshots();
+
+    REQUIRE(store.GetNumberOfSnapshots() > 0);
+    first_segment = store.GetLog().GetFirstSegment();
+  }
+
+  // Segments covered by the snapshots were removed as the session went on
+  REQUIRE(first_segment > 0);
+
+  SessionStore store(directory.GetPath(), std::chrono::hours(1));
+  REQUIRE(store.Recover(initial).at(1).ComputeChecksum() ==
+          engine.ComputeChecksum());
+
+}
@@ -0,0 +1,38 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <persistence/mapped_file.h>
+#include <persistence/temporary_directory.h>
+
+#include <fstream>
+#include <string>
+
+using adventure::ListFiles;
+using adventure::TemporaryDirectory;
+
+TEST_CASE("TemporaryDirectory") {
+  SECTION("Each directory has its own name") {
+    TemporaryDirectory first("temporary-directory-test");
+    TemporaryDirectory second("temporary-directory-test");
+
+    REQUIRE(first.GetPath() != second.GetPath());
+    REQUIRE(ListFiles(first.GetPath()).empty());
+  }
+
+  SECTION("Directory is removed with its files") {
+    std::string path;
+    {
+      TemporaryDirectory directory("temporary-directory-test");
+      path = directory.GetPath();
+
+      std::ofstream file(path + "/file.txt");
+      file << "TEXT";
+      file.close();
+
+      REQUIRE(ListFiles(path).size() == 1);
+    }
+
+    REQUIRE_THROWS_AS(ListFiles(path), std::invalid_argument);
+  }
+}
@@ -0,0 +1,196 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <persistence/temporary_directory.h>
+#include <persistence/write_ahead_log.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using adventure::Command;
+using adventure::TemporaryDirectory;
+using adventure::WalRecord;
+using adventure::WriteAheadLog;
+
+namespace {
+
+const std::string kDirectoryPrefix = "write-ahead-log-test";
+
+std::vector<WalRecord> ReadRecords(const std::string& directory) {
+  std::vector<WalRecord> records;
+
+  WriteAheadLog log(directory);
+  log.Replay([&records](const WalRecord& record) {
+    records.push_back(record);
+  });
+
+  return records;
+}
+
+}   // namespace
+
+TEST_CASE("WriteAheadLog encode and decode") {
+  WalRecord record{7, 300, Command::kGo, "DOWN"};
+  std::string buffer;
+  WriteAheadLog::Encode(record, buffer);
+
+  SECTION("Round trip") {
+    WalRecord decoded;
+
+    REQUIRE(WriteAheadLog::Decode((const uint8_t*)buffer.data(),
+                                  buffer.size(), decoded) == buffer.size());
+    REQUIRE(decoded.session == 7);
+    REQUIRE(decoded.sequence == 300);
+    REQUIRE(decoded.command == Command::kGo);
+    REQUIRE(decoded.qualifier == "DOWN");
+  }
+
+  SECTION("Torn record") {
+    WalRecord decoded;
+
+    REQUIRE(WriteAheadLog::Decode((const uint8_t*)buffer.data(),
+                                  buffer.size() - 1, decoded) == 0);
+  }
+
+  SECTION("Corrupted record") {
+    WalRecord decoded;
+    buffer[3] ^= 0x01;
+
+    REQUIRE(WriteAheadLog::Decode((const uint8_t*)buffer.data(),
+                                  buffer.size(), decoded) == 0);
+  }
+}
+
+TEST_CASE("WriteAheadLog replay") {
+  TemporaryDirectory directory(kDirectoryPrefix);
+
+  {
+    WriteAheadLog log(directory.GetPath());
+    uint64_t segment;
+
+    log.Append(WalRecord{1, 1, Command::kGo, "UP"}, segment);
+    log.Append(WalRecord{2, 1, Command::kTake, "SWORD"}, segment);
+    uint64_t ticket = log.Append(WalRecord{1, 2, Command::kUndo, ""},
+                                 segment);
+    log.WaitUntilDurable(ticket);
+
+    REQUIRE(segment == 0);
+    REQUIRE(log.GetNumberOfSyncs() >= 1);
+    REQUIRE(log.GetNumberOfSyncs() <= 3);
+  }
+
+  SECTION("Records come back in order") {
+    std::vector<WalRecord> records = ReadRecords(directory.GetPath());
+
+    REQUIRE(records.size() == 3);
+    REQUIRE(records[0].session == 1);
+    REQUIRE(records[0].qualifier == "UP");
+    REQUIRE(records[1].session == 2);
+    REQUIRE(records[1].command == Command::kTake);
+    REQUIRE(records[2].sequence == 2);
+  }
+
+  SECTION("Records from every earlier run come back") {
+    {
+      WriteAheadLog log(directory.GetPath());
+      uint64_t segment;
+      log.Append(WalRecord{1, 3, Command::kRedo, ""}, segment);
+
+      REQUIRE(segment == 1);
+    }
+
+    std::vector<WalRecord> records = ReadRecords(directory.GetPath());
+
+    REQUIRE(records.size() == 4);
+    REQUIRE(records[3].command == Command::kRedo);
+  }
+
+  SECTION("A torn tail is dropped") {
+    {
+      std::ofstream segment_file(directory.GetPath() + "/wal-0.log",
+                                 std::ios::binary | std::ios::app);
+      std::string torn;
+      WriteAheadLog::Encode(WalRecord{1, 3, Command::kRedo, ""}, torn);
+      segment_file << torn.substr(0, torn.size() - 2);
+    }
+
+    REQUIRE(ReadRecords(directory.GetPath()).size() == 3);
+  }
+}
+
+TEST_CASE("WriteAheadLog segments") {
+  TemporaryDirectory directory(kDirectoryPrefix);
+
+  SECTION("Rotating an empty segment does nothing") {
+    WriteAheadLog log(directory.GetPath());
+
+    REQUIRE(log.Rotate() == 0);
+    REQUIRE(log.GetCurrentSegment() == 0);
+  }
+
+  SECTION("Records go to the current segment") {
+    WriteAheadLog log(directory.GetPath());
+    uint64_t segment;
+
+    log.Append(WalRecord{1, 1, Command::kGo, "UP"}, segment);
+    REQUIRE(segment == 0);
+
+    REQUIRE(log.Rotate() == 1);
+    log.Append(WalRecord{1, 2, Command::kGo, "DOWN"}, segment);
+    REQUIRE(segment == 1);
+  }
+
+  SECTION("Removed segments are not replayed") {
+    {
+      WriteAheadLog log(directory.GetPath());
+      uint64_t segment;
+
+      log.Append(WalRecord{1, 1, Command::kGo, "UP"}, segment);
+      log.Rotate();
+      uint64_t ticket = log.Append(WalRecord{1, 2, Command::kGo, "DOWN"},
+                                   segment);
+      log.WaitUntilDurable(ticket);
+
+      log.RemoveSegmentsBefore(1);
+      REQUIRE(log.GetFirstSegment() == 1);
+    }
+
+    std::vector<WalRecord> records = ReadRecords(directory.GetPath());
+
+    REQUIRE(records.size() == 1);
+    REQUIRE(records[0].qualifier == "DOWN");
+  }
+}
+
+TEST_CASE("WriteAheadLog write failures") {
+  TemporaryDirectory directory(kDirectoryPrefix);
+  WriteAheadLog log(directory.GetPath());
+  uint64_t segment;
+
+  uint64_t first = log.Append(WalRecord{1, 1, Command::kGo, "UP"}, segment);
+  log.WaitUntilDurable(first);
+
+  // A directory where the next segment goes leaves it unwritable
+  REQUIRE(adventure::MakeDirectory(directory.GetPath() + "/wal-1.log"));
+  log.Rotate();
+  uint64_t second = log.Append(WalRecord{1, 2, Command::kGo, "DOWN"},
+                               segment);
+
+  SECTION("Records after the failure are never durable") {
+    REQUIRE_THROWS_AS(log.WaitUntilDurable(second), std::invalid_argument);
+  }
+
+  SECTION("Records synced before the failure stay durable") {
+    REQUIRE_THROWS_AS(log.WaitUntilDurable(second), std::invalid_argument);
+    REQUIRE_NOTHROW(log.WaitUntilDurable(first));
+  }
+
+  SECTION("Appending after the failure") {
+    REQUIRE_THROWS_AS(log.WaitUntilDurable(second), std::invalid_argument);
+    REQUIRE_THROWS_AS(log.Append(WalRecord{1, 3, Command::kGo, "UP"},
+                                 segment),
+                      std::invalid_argument);
+  }
+}
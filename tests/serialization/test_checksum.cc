@@ -0,0 +1,39 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <serialization/checksum.h>
+
+using adventure::Checksum;
+using adventure::Enemy;
+
+TEST_CASE("Checksum add") {
+  Checksum first;
+  Checksum second;
+
+  SECTION("Same state hashes the same") {
+    first.Add(Enemy("BAT", "BAT", 5, 5, 50));
+    second.Add(Enemy("BAT", "BAT", 5, 5, 50));
+
+    REQUIRE(first.GetValue() == second.GetValue());
+  }
+
+  SECTION("Different state hashes differently") {
+    Enemy enemy("BAT", "BAT", 5, 5, 50);
+    first.Add(enemy);
+
+    enemy.TakeDamage(1);
+    second.Add(enemy);
+
+    REQUIRE(first.GetValue() != second.GetValue());
+  }
+
+  SECTION("Split strings hash differently") {
+    first.Add(std::string("AB"));
+    first.Add(std::string("C"));
+    second.Add(std::string("A"));
+    second.Add(std::string("BC"));
+
+    REQUIRE(first.GetValue() != second.GetValue());
+  }
+}
@@ -0,0 +1,152 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <serialization/checksum.h>
+#include <serialization/replay_log.h>
+
+#include <fstream>
+#include <sstream>
+
+using adventure::Player;
+
+using adventure::Weapon;
+
+using adventure::Dungeon;
+
+using adventure::Checksum;
+using adventure::Command;
+using adventure::Engine;
+using adventure::ReplayEntry;
+using adventure::ReplayLog;
+using adventure::ReplayReader;
+
+TEST_CASE("ReplayLog replay") {
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player player("ENTRN", 100, 0, valid_weapons);
+  Dungeon dungeon;
+
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> dungeon;
+
+    input_file.close();
+  }
+
+  Engine recorded(player, dungeon);
+  Checksum checksum;
+  checksum.Add(recorded.GetMap());
+
+  ReplayLog log(42, checksum.GetValue());
+  recorded.SetRandomState(log.GetSeed());
+
+  recorded.Execute(Command::kGo, "DOWN");
+  log.Record(Command::kGo, "DOWN", 10);
+  recorded.Execute(Command::kFight, "BLOB");
+  log.Record(Command::kFight, "BLOB", 20);
+  recorded.Execute(Command::kUndo, "");
+  log.Record(Command::kUndo, "", 30);
+  recorded.Execute(Command::kFight, "BLOB");
+  log.Record(Command::kFight, "BLOB", 40);
+  log.SetFinalChecksum(recorded.ComputeChecksum());
+
+  SECTION("Successful") {
+    Engine replayed(player, dungeon);
+
+    REQUIRE(log.Replay(replayed));
+    REQUIRE(replayed.GetPlayer().GetHealth() ==
+            recorded.GetPlayer().GetHealth());
+  }
+
+  SECTION("Drift is detected") {
+    Engine replayed(player, dungeon);
+    replayed.Execute(Command::kGo, "UP");
+
+    REQUIRE_FALSE(log.Replay(replayed));
+  }
+
+  SECTION("Dungeon does not match log") {
+    Engine replayed(player, dungeon);
+    replayed.Execute(Command::kGo, "DOWN");
+    replayed.Execute(Command::kTake, "KEY");
+
+    REQUIRE_THROWS_AS(log.Replay(replayed), std::invalid_argument);
+  }
+
+  SECTION("Round trip through a binary file") {
+    std::stringstream stream;
+    stream << log;
+
+    ReplayLog loaded;
+    stream >> loaded;
+
+    REQUIRE(loaded.GetSeed() == log.GetSeed());
+    REQUIRE(loaded.GetDungeonChecksum() == log.GetDungeonChecksum());
+    REQUIRE(loaded.GetFinalChecksum() == log.GetFinalChecksum());
+    REQUIRE(loaded.GetEntries().size() == 4);
+    REQUIRE(loaded.GetEntries()[1].command == Command::kFight);
+    REQUIRE(loaded.GetEntries()[1].qualifier == "BLOB");
+    REQUIRE(loaded.GetEntries()[3].elapsed_ms == 40);
+
+    Engine replayed(player, dungeon);
+    REQUIRE(loaded.Replay(replayed));
+  }
+
+  SECTION("Read in place") {
+    std::stringstream stream;
+    stream << log << log;
+    std::string bytes = stream.str();
+
+    ReplayReader reader((const uint8_t*)bytes.data(), bytes.size());
+    uint64_t seed;
+    uint64_t dungeon_checksum;
+    ReplayEntry entry;
+
+    reader.Begin(seed, dungeon_checksum);
+    REQUIRE(seed == log.GetSeed());
+    REQUIRE(dungeon_checksum == log.GetDungeonChecksum());
+
+    size_t number_of_entries = 0;
+    while (reader.Next(entry)) {
+      ++number_of_entries;
+    }
+    REQUIRE(number_of_entries == 4);
+    REQUIRE(entry.qualifier == "BLOB");
+    REQUIRE(reader.GetFinalChecksum() == log.GetFinalChecksum());
+    REQUIRE(reader.GetPosition() == bytes.size() / 2);
+    REQUIRE(reader.HasNext());
+  }
+
+  SECTION("Read in place cut short") {
+    std::stringstream stream;
+    stream << log;
+    std::string bytes = stream.str();
+
+    ReplayReader reader((const uint8_t*)bytes.data(), bytes.size() - 2);
+    uint64_t seed;
+    uint64_t dungeon_checksum;
+    ReplayEntry entry;
+
+    reader.Begin(seed, dungeon_checksum);
+    bool is_cut_short = false;
+    try {
+      while (reader.Next(entry)) {}
+    } catch (const std::invalid_argument&) {
+      is_cut_short = true;
+    }
+
+    REQUIRE(is_cut_short);
+  }
+
+  SECTION("Invalid file") {
+    std::stringstream stream("NOT A LOG");
+    ReplayLog loaded;
+
+    REQUIRE_THROWS_AS(stream >> loaded, std::invalid_argument);
+  }
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <serialization/varint.h>
+
+#include <sstream>
+
+using adventure::DecodeVarint;
+using adventure::EncodeVarint;
+using adventure::ReadVarint;
+using adventure::ReadVarintString;
+using adventure::WriteVarint;
+using adventure::WriteVarintString;
+
+TEST_CASE("Varint encode and decode") {
+  uint8_t buffer[adventure::kMaxVarintSize];
+  uint64_t value = 0;
+
+  SECTION("Single byte") {
+    REQUIRE(EncodeVarint(127, buffer) == 1);
+    REQUIRE(DecodeVarint(buffer, 1, value) == 1);
+    REQUIRE(value == 127);
+  }
+
+  SECTION("Multiple bytes") {
+    REQUIRE(EncodeVarint(300, buffer) == 2);
+    REQUIRE(buffer[0] == 0xAC);
+    REQUIRE(buffer[1] == 0x02);
+    REQUIRE(DecodeVarint(buffer, 2, value) == 2);
+    REQUIRE(value == 300);
+  }
+
+  SECTION("Largest value") {
+    REQUIRE(EncodeVarint(UINT64_MAX, buffer) == adventure::kMaxVarintSize);
+    REQUIRE(DecodeVarint(buffer, adventure::kMaxVarintSize, value) ==
+            adventure::kMaxVarintSize);
+    REQUIRE(value == UINT64_MAX);
+  }
+
+  SECTION("Cut short") {
+    EncodeVarint(300, buffer);
+
+    REQUIRE(DecodeVarint(buffer, 1, value) == 0);
+  }
+}
+
+TEST_CASE("Varint streams") {
+  std::stringstream stream;
+
+  SECTION("Integers and strings") {
+    WriteVarint(stream, 5);
+    WriteVarintString(stream, "SWORD");
+
+    REQUIRE(ReadVarint(stream) == 5);
+    REQUIRE(ReadVarintString(stream) == "SWORD");
+  }
+
+  SECTION("Cut short") {
+    REQUIRE_THROWS_AS(ReadVarint(stream), std::invalid_argument);
+  }
+}
@@ -0,0 +1,141 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <server/protocol.h>
+
+using adventure::Command;
+using adventure::DecodeReplicationFrame;
+using adventure::DecodeRequest;
+using adventure::DecodeStateUpdate;
+using adventure::EncodeReplicationFrame;
+using adventure::EncodeRequest;
+using adventure::EncodeStateUpdate;
+using adventure::ReplicationFrame;
+using adventure::ReplicationType;
+using adventure::Request;
+using adventure::StateUpdate;
+
+TEST_CASE("Protocol requests") {
+  std::string buffer;
+  Request request{7, Command::kGo, "LEFT"};
+  Request decoded;
+
+  SECTION("Round trip") {
+    EncodeRequest(request, buffer);
+
+    REQUIRE(DecodeRequest(buffer.data(), buffer.size(), decoded) ==
+            buffer.size());
+    REQUIRE(decoded.id == 7);
+    REQUIRE(decoded.command == Command::kGo);
+    REQUIRE(decoded.qualifier == "LEFT");
+  }
+
+  SECTION("Pipelined frames") {
+    EncodeRequest(request, buffer);
+    size_t first_size = buffer.size();
+    EncodeRequest(Request{8, Command::kFight, "BAT"}, buffer);
+
+    REQUIRE(DecodeRequest(buffer.data(), buffer.size(), decoded) ==
+            first_size);
+    REQUIRE(DecodeRequest(buffer.data() + first_size,
+                          buffer.size() - first_size, decoded) > 0);
+    REQUIRE(decoded.id == 8);
+    REQUIRE(decoded.qualifier == "BAT");
+  }
+
+  SECTION("Incomplete frame") {
+    EncodeRequest(request, buffer);
+
+    for (size_t size = 0; size < buffer.size(); ++size) {
+      REQUIRE(DecodeRequest(buffer.data(), size, decoded) == 0);
+    }
+  }
+
+  SECTION("Frame too large") {
+    buffer = std::string("\xFF\xFF\x01", 3);
+
+    REQUIRE_THROWS_AS(DecodeRequest(buffer.data(), buffer.size(), decoded),
+                      std::invalid_argument);
+  }
+
+  SECTION("Invalid command") {
+    buffer = std::string("\x03\x01\x7F\x00", 4);
+
+    REQUIRE_THROWS_AS(DecodeRequest(buffer.data(), buffer.size(), decoded),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("Protocol state updates") {
+  std::string buffer;
+  StateUpdate update{300, "YOU WENT LEFT", "BAT", 950, 1, 2};
+  StateUpdate decoded;
+
+  SECTION("Round trip") {
+    EncodeStateUpdate(update, buffer);
+
+    REQUIRE(DecodeStateUpdate(buffer.data(), buffer.size(), decoded) ==
+            buffer.size());
+    REQUIRE(decoded.id == 300);
+    REQUIRE(decoded.message == "YOU WENT LEFT");
+    REQUIRE(decoded.location == "BAT");
+    REQUIRE(decoded.health == 950);
+    REQUIRE(decoded.number_of_keys == 1);
+    REQUIRE(decoded.number_of_weapons == 2);
+  }
+
+  SECTION("Truncated payload") {
+    buffer = std::string("\x02\x01\x05", 3);
+
+    REQUIRE_THROWS_AS(DecodeStateUpdate(buffer.data(), buffer.size(),
+                                        decoded),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("Protocol replication frames") {
+  std::string buffer;
+  ReplicationFrame frame{ReplicationType::kCommand, 12, 40000, 1234567890123,
+                         Command::kTake, "SWORD"};
+  ReplicationFrame decoded;
+
+  SECTION("Round trip") {
+    EncodeReplicationFrame(frame, buffer);
+
+    REQUIRE(DecodeReplicationFrame(buffer.data(), buffer.size(), decoded) ==
+            buffer.size());
+    REQUIRE(decoded.type == ReplicationType::kCommand);
+    REQUIRE(decoded.session == 12);
+    REQUIRE(decoded.sequence == 40000);
+    REQUIRE(decoded.value == 1234567890123);
+    REQUIRE(decoded.command == Command::kTake);
+    REQUIRE(decoded.data == "SWORD");
+  }
+
+  SECTION("Snapshots larger than a request frame") {
+    frame.type = ReplicationType::kSessionStarted;
+    frame.data = std::string(100000, 'S');
+    EncodeReplicationFrame(frame, buffer);
+
+    REQUIRE(DecodeReplicationFrame(buffer.data(), buffer.size(), decoded) ==
+            buffer.size());
+    REQUIRE(decoded.data == frame.data);
+  }
+
+  SECTION("Incomplete frame") {
+    EncodeReplicationFrame(frame, buffer);
+
+    for (size_t size = 0; size < buffer.size(); ++size) {
+      REQUIRE(DecodeReplicationFrame(buffer.data(), size, decoded) == 0);
+    }
+  }
+
+  SECTION("Invalid frame type") {
+    buffer = std::string("\x06\x7F\x00\x00\x00\x00\x00", 7);
+
+    REQUIRE_THROWS_AS(DecodeReplicationFrame(buffer.data(), buffer.size(),
+                                             decoded),
+                      std::invalid_argument);
+  }
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <mechanics/engine.h>
+#include <persistence/temporary_directory.h>
+#include <statistics/game_statistics.h>
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+using adventure::Enemy;
+using adventure::Player;
+using adventure::Weapon;
+
+using adventure::Dungeon;
+
+using adventure::Command;
+using adventure::Engine;
+using adventure::GameStatistics;
+
+using adventure::TemporaryDirectory;
+
+TEST_CASE("Game statistics") {
+  std::string filepath = "C:\\Users\\cesco\\OneDrive\\Documents\\School\\"
+                         "UIUC\\2020-2021\\Spring 2021\\CS 126\\Cinder\\"
+                         "my-projects\\final-project-fvial2\\resources\\"
+                         "test.txt";
+  std::shared_ptr<Dungeon> dungeon = std::make_shared<Dungeon>();
+
+  std::ifstream input_file(filepath);
+  if (input_file.is_open()) {
+    input_file >> *dungeon;
+
+    input_file.close();
+  }
+
+  std::vector<Weapon> valid_weapons{Weapon("SPELL", "SPELL", 5, 5)};
+  Player strong_player("ENTRN", 1000, 1, valid_weapons);
+  Player weak_player("ENTRN", 1, 1, valid_weapons);
+
+  std::shared_ptr<GameStatistics> statistics =
+      std::make_shared<GameStatistics>(*dungeon, 2, 2);
+
+  SECTION("Engines report kills") {
+    Engine engine(strong_player, dungeon);
+    engine.ReportTo(statistics, 1);
+
+    engine.Execute(Command::kGo, "DOWN");
+    engine.Execute(Command::kFight, "BLOB");
+
+    REQUIRE(engine.GetMessage() == "YOU FOUGHT THE BLOB");
+    REQUIRE(statistics->GetKills("BLOB") == 1);
+    REQUIRE(statistics->GetKills("SKLTN") == 0);
+  }
+
+  SECTION("Engines report deaths") {
+    Engine engine(weak_player, dungeon);
+    engine.ReportTo(statistics, 1);
+
+    engine.Execute(Command::kGo, "DOWN");
+    engine.Execute(Command::kFight, "BLOB");
+
+    REQUIRE(engine.GetMessage() == "YOU LOSE");
+    REQUIRE(statistics->GetDeaths(dungeon->FindRoomIndex("BOW")) == 1);
+    REQUIRE(statistics->GetKills("BLOB") == 0);
+  }
+
+  SECTION("Engines report wins by number of commands") {
+    Engine engine(strong_player, dungeon);
+    engine.ReportTo(statistics, 7);
+
+    engine.Execute(Command::kGo, "RIGHT");
+    engine.Execute(Command::kGo, "RIGHT");
+    engine.Execute(Command::kFight, "SKLTN");
+
+    REQUIRE(engine.GetMessage() == "YOU WIN");
+    REQUIRE(statistics->GetWins() == 1);
+    REQUIRE(statistics->GetKills("SKLTN") == 1);
+    REQUIRE(statistics->GetWinHistogram()[2] == 1);
+    REQUIRE(statistics->GetFastestWins().size() == 1);
+    REQUIRE(statistics->GetFastestWins()[0].id == 7);
+    REQUIRE(statistics->GetFastestWins()[0].score == 3);
+  }
+
+  SECTION("Engines without statistics report nothing") {
+    Engine engine(strong_player, dungeon);
+
+    engine.Execute(Command::kGo, "DOWN");
+    engine.Execute(Command::kFight, "BLOB");
+
+    REQUIRE(statistics->GetKills("BLOB") == 0);
+  }
+
+  SECTION("Export") {
+    TemporaryDirectory directory("game-statistics-test");
+    const std::string kPath = directory.GetPath() + "/statistics.txt";
+    statistics->RecordKill(Enemy("BLOB", "BLOB", 30, 15, 10).GetArchetype());
+    statistics->RecordWin(3, 12);
+    statistics->Export(kPath);
+
+    std::ifstream snapshot_file(kPath);
+    std::stringstream snapshot;
+    snapshot << snapshot_file.rdbuf();
+    snapshot_file.close();
+
+    REQUIRE(snapshot.str().find("WINS 1\n") != std::string::npos);
+    REQUIRE(snapshot.str().find("KILLS BLOB 1\n") != std::string::npos);
+    REQUIRE(snapshot.str().find("DEATHS ENTRN 0\n") != std::string::npos);
+    REQUIRE(snapshot.str().find("WIN COMMANDS 8 1\n") != std::string::npos);
+    REQUIRE(snapshot.str().find("FASTEST WIN 3 12\n") != std::string::npos);
+  }
+
+  SECTION("Enemy not found") {
+    statistics->RecordKill(Enemy("DRAGN", "DRAGN", 50, 20, 5).GetArchetype());
+
+    REQUIRE_THROWS_AS(statistics->GetKills("DRAGN"), std::invalid_argument);
+  }
+
+  SECTION("Room index out of range") {
+    REQUIRE_THROWS_AS(statistics->RecordDeath(dungeon->GetMap().size()),
+                      std::invalid_argument);
+  }
+
+  SECTION("Dungeon map has no rooms") {
+    REQUIRE_THROWS_AS(GameStatistics(Dungeon(), 2, 2), std::invalid_argument);
+  }
+}
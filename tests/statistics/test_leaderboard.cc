@@ -0,0 +1,81 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <statistics/leaderboard.h>
+
+#include <thread>
+#include <vector>
+
+using adventure::Leaderboard;
+using adventure::LeaderboardEntry;
+
+TEST_CASE("Leaderboard") {
+  Leaderboard leaderboard(3, 2);
+
+  SECTION("Keeps the lowest scores in order") {
+    leaderboard.Submit(1, 40);
+    leaderboard.Submit(2, 10);
+    leaderboard.Submit(3, 30);
+    leaderboard.Submit(4, 20);
+    leaderboard.Submit(5, 50);
+
+    std::vector<LeaderboardEntry> top = leaderboard.GetTop();
+
+    REQUIRE(top.size() == 3);
+    REQUIRE(top[0].id == 2);
+    REQUIRE(top[1].id == 4);
+    REQUIRE(top[2].id == 3);
+    REQUIRE(top[2].score == 30);
+  }
+
+  SECTION("Ties are ordered by id") {
+    leaderboard.Submit(9, 10);
+    leaderboard.Submit(7, 10);
+
+    std::vector<LeaderboardEntry> top = leaderboard.GetTop();
+
+    REQUIRE(top.size() == 2);
+    REQUIRE(top[0].id == 7);
+    REQUIRE(top[1].id == 9);
+  }
+
+  SECTION("Tie with the last entry ranks by id once full") {
+    leaderboard.Submit(5, 10);
+    leaderboard.Submit(6, 20);
+    leaderboard.Submit(8, 30);
+    leaderboard.Submit(9, 30);
+    leaderboard.Submit(7, 30);
+
+    std::vector<LeaderboardEntry> top = leaderboard.GetTop();
+
+    REQUIRE(top.size() == 3);
+    REQUIRE(top[2].id == 7);
+    REQUIRE(top[2].score == 30);
+  }
+
+  SECTION("Merges every thread's submissions") {
+    std::vector<std::thread> threads;
+    for (uint64_t thread = 0; thread < 4; ++thread) {
+      threads.emplace_back([&leaderboard, thread] {
+        for (uint64_t score = 100; score > 0; --score) {
+          leaderboard.Submit(thread * 1000 + score, score * 4 + thread);
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    std::vector<LeaderboardEntry> top = leaderboard.GetTop();
+
+    REQUIRE(top.size() == 3);
+    REQUIRE(top[0].score == 4);
+    REQUIRE(top[1].score == 5);
+    REQUIRE(top[2].score == 6);
+  }
+
+  SECTION("Capacity not specified") {
+    REQUIRE_THROWS_AS(Leaderboard(0, 2), std::invalid_argument);
+  }
+}
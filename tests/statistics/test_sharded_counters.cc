@@ -0,0 +1,83 @@
+// Copyright (c) 2021 Francesco Vial. All rights reserved.
+
+#include <catch2/catch.hpp>
+
+#include <statistics/sharded_counters.h>
+
+#include <thread>
+#include <vector>
+
+using adventure::ShardedCounters;
+using adventure::ShardedHistogram;
+
+TEST_CASE("Sharded counters") {
+  ShardedCounters counters(3, 4);
+
+  SECTION("Counters start at zero") {
+    REQUIRE(counters.GetNumberOfCounters() == 3);
+    REQUIRE(counters.Get(0) == 0);
+    REQUIRE(counters.Get(2) == 0);
+  }
+
+  SECTION("Counters are independent") {
+    counters.Add(0);
+    counters.Add(2, 5);
+
+    REQUIRE(counters.Get(0) == 1);
+    REQUIRE(counters.Get(1) == 0);
+    REQUIRE(counters.Get(2) == 5);
+  }
+
+  SECTION("Adds from every thread are merged") {
+    const size_t kAdds = 10000;
+
+    // More threads than shards, so some shards are shared
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < 6; ++thread) {
+      threads.emplace_back([&counters, kAdds] {
+        for (size_t add = 0; add < kAdds; ++add) {
+          counters.Add(1);
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    REQUIRE(counters.Get(1) == 6 * kAdds);
+  }
+
+  SECTION("Counter index out of range") {
+    REQUIRE_THROWS_AS(counters.Add(3), std::invalid_argument);
+    REQUIRE_THROWS_AS(counters.Get(3), std::invalid_argument);
+  }
+
+  SECTION("Number of shards equals zero") {
+    REQUIRE_THROWS_AS(ShardedCounters(3, 0), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Sharded histogram") {
+  ShardedHistogram histogram(2);
+
+  SECTION("Values fall into power-of-two buckets") {
+    REQUIRE(ShardedHistogram::GetBucket(0) == 0);
+    REQUIRE(ShardedHistogram::GetBucket(1) == 1);
+    REQUIRE(ShardedHistogram::GetBucket(3) == 2);
+    REQUIRE(ShardedHistogram::GetBucket(4) == 3);
+    REQUIRE(ShardedHistogram::GetBucket(UINT64_MAX) == 64);
+  }
+
+  SECTION("Counts each bucket") {
+    histogram.Record(5);
+    histogram.Record(6);
+    histogram.Record(100);
+
+    std::vector<uint64_t> counts = histogram.GetCounts();
+
+    REQUIRE(counts.size() == ShardedHistogram::kNumberOfBuckets);
+    REQUIRE(counts[3] == 2);
+    REQUIRE(counts[7] == 1);
+    REQUIRE(counts[0] == 0);
+  }
+}